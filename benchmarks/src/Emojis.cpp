@@ -180,3 +180,44 @@ BENCHMARK_CAPTURE(
     "😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 "
     "😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 😂 ",
     61);
+BENCHMARK_CAPTURE(BM_EmojiParsing2, no_emoji,
+                  "the quick brown fox jumps over the lazy dog LUL", 0);
+BENCHMARK_CAPTURE(BM_EmojiParsing2, non_ascii_no_emoji,
+                  "Grüße aus Köln, schönes Wetter heute", 0);
+
+// Splits each word of a message like MessageBuilder does
+static void BM_EmojiParseSpans(benchmark::State &state, const QString &input,
+                               int expectedNumEmojis)
+{
+    Emojis emojis;
+
+    emojis.load();
+
+    auto words = input.split(' ');
+    for (auto _ : state)
+    {
+        int actualNumEmojis = 0;
+        for (const auto &word : words)
+        {
+            for (const auto &span : emojis.parseSpans(word))
+            {
+                if (span.emote)
+                {
+                    ++actualNumEmojis;
+                }
+            }
+        }
+
+        if (actualNumEmojis != expectedNumEmojis)
+        {
+            qDebug() << "BAD BENCH, EXPECTED NUM EMOJIS IS WRONG"
+                     << actualNumEmojis;
+        }
+    }
+}
+
+BENCHMARK_CAPTURE(BM_EmojiParseSpans, no_emoji,
+                  "the quick brown fox jumps over the lazy dog LUL", 0);
+BENCHMARK_CAPTURE(BM_EmojiParseSpans, two_emoji, "foo 🐧 bar 🐧", 2);
+BENCHMARK_CAPTURE(BM_EmojiParseSpans, mixed,
+                  "Grüße 👨🏻‍❤️‍💋‍👨🏻 aus Köln 🏴󠁧󠁢󠁥󠁮󠁧󠁿 schönes Wetter 😂😂", 4);
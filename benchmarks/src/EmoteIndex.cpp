@@ -0,0 +1,75 @@
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <random>
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::completion;
+
+namespace {
+
+/// An index with `count` emotes with random names of 4 to 12 letters
+EmoteIndex makeIndex(int64_t count)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::uniform_int_distribution<int> upper(0, 3);
+    std::uniform_int_distribution<qsizetype> length(4, 12);
+
+    std::vector<EmoteItem> items;
+    for (int64_t i = 0; i < count; i++)
+    {
+        QString name;
+        auto nameLength = length(rng);
+        for (qsizetype j = 0; j < nameLength; j++)
+        {
+            QChar c(letter(rng));
+            name.append(upper(rng) == 0 ? c.toUpper() : c);
+        }
+        items.push_back({.searchName = name});
+    }
+    return EmoteIndex(std::move(items));
+}
+
+void runQueries(benchmark::State &state, const std::vector<QString> &queries,
+                bool prefixOnly)
+{
+    auto index = makeIndex(state.range(0));
+    for (auto _ : state)
+    {
+        for (const auto &query : queries)
+        {
+            benchmark::DoNotOptimize(index.find(query, prefixOnly));
+        }
+    }
+}
+
+}  // namespace
+
+void BM_EmoteIndexBuild(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(makeIndex(state.range(0)));
+    }
+}
+
+/// Typing "clapper" one letter at a time
+void BM_EmoteIndexPrefix(benchmark::State &state)
+{
+    runQueries(state, {"c", "cl", "cla", "clap", "clapp", "clappe", "clapper"},
+               true);
+}
+
+void BM_EmoteIndexContains(benchmark::State &state)
+{
+    runQueries(state, {"c", "cl", "cla", "clap", "clapp", "clappe", "clapper"},
+               false);
+}
+
+BENCHMARK(BM_EmoteIndexBuild)->Arg(500)->Arg(5000);
+BENCHMARK(BM_EmoteIndexPrefix)->Arg(500)->Arg(5000);
+BENCHMARK(BM_EmoteIndexContains)->Arg(500)->Arg(5000);
@@ -0,0 +1,123 @@
+#include "common/Literals.hpp"
+#include "messages/Emote.hpp"
+#include "messages/EmoteLookup.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+/// The emotes of the 7TV fixture, spread over all six layers of a lookup
+class Fixture
+{
+public:
+    Fixture()
+    {
+        QFile file(u":/bench/seventvemotes-nymn.json"_s);
+        if (!file.open(QFile::ReadOnly))
+        {
+            return;
+        }
+        auto emotes = seventv::detail::parseEmotes(
+            QJsonDocument::fromJson(file.readAll())
+                .object()["emote_set"_L1]
+                .toObject()["emotes"_L1]
+                .toArray(),
+            false);
+
+        std::array<EmoteMap, 6> layers;
+        size_t i = 0;
+        for (const auto &[name, emote] : emotes)
+        {
+            layers[i % layers.size()].emplace(name, emote);
+            // Most words in chat aren't emotes
+            this->words.push_back(name);
+            this->words.push_back({name.string + u"x"_s});
+            i++;
+        }
+
+        for (size_t layer = 0; layer < layers.size(); layer++)
+        {
+            this->maps[layer] =
+                std::make_shared<const EmoteMap>(std::move(layers[layer]));
+        }
+        this->sources = {
+            .ffzChannel = this->maps[0],
+            .bttvChannel = this->maps[1],
+            .seventvChannel = this->maps[2],
+            .ffzGlobal = this->maps[3],
+            .bttvGlobal = this->maps[4],
+            .seventvGlobal = this->maps[5],
+        };
+    }
+
+    mock::BaseApplication app;
+    /// In the order of their precedence
+    std::array<std::shared_ptr<const EmoteMap>, 6> maps;
+    EmoteLookup::Sources sources;
+    std::vector<EmoteName> words;
+};
+
+}  // namespace
+
+/// Looks up each word in all maps until it's found, like before the maps
+/// were merged
+void BM_EmoteLookupLayered(benchmark::State &state)
+{
+    Fixture fixture;
+    for (auto _ : state)
+    {
+        for (const auto &word : fixture.words)
+        {
+            for (const auto &map : fixture.maps)
+            {
+                auto it = map->find(word);
+                if (it != map->end())
+                {
+                    benchmark::DoNotOptimize(it->second);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void BM_EmoteLookupMerged(benchmark::State &state)
+{
+    Fixture fixture;
+    auto lookup = EmoteLookup::build(fixture.sources);
+    for (auto _ : state)
+    {
+        for (const auto &word : fixture.words)
+        {
+            benchmark::DoNotOptimize(lookup->find(word));
+        }
+    }
+}
+
+/// Rebuilding the lookup after a channel's emotes changed
+void BM_EmoteLookupBuild(benchmark::State &state)
+{
+    Fixture fixture;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(EmoteLookup::build(fixture.sources));
+    }
+}
+
+BENCHMARK(BM_EmoteLookupLayered);
+BENCHMARK(BM_EmoteLookupMerged);
+BENCHMARK(BM_EmoteLookupBuild);
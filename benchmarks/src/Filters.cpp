@@ -0,0 +1,102 @@
+#include "common/Literals.hpp"
+#include "controllers/filters/lang/Filter.hpp"
+#include "lib/BuildingApplication.hpp"
+#include "messages/Message.hpp"
+#include "providers/bttv/BttvEmotes.hpp"
+#include "providers/ffz/FfzEmotes.hpp"
+#include "providers/recentmessages/Impl.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QFile>
+#include <QJsonDocument>
+#include <QString>
+
+#include <optional>
+#include <variant>
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::filters;
+using namespace literals;
+
+namespace {
+
+class FilterFixture
+{
+public:
+    explicit FilterFixture(const QString &filterText)
+        : chan(u"nymn"_s)
+    {
+        QFile file(u":/bench/recentmessages-nymn.json"_s);
+        if (!file.open(QFile::ReadOnly))
+        {
+            _exit(1);
+        }
+        auto doc = QJsonDocument::fromJson(file.readAll());
+
+        auto parsed =
+            recentmessages::detail::parseRecentMessages(doc.object());
+        this->messages =
+            recentmessages::detail::buildRecentMessages(parsed, &this->chan);
+
+        auto result = Filter::fromString(filterText);
+        if (!std::holds_alternative<Filter>(result))
+        {
+            _exit(1);
+        }
+        this->filter.emplace(std::move(std::get<Filter>(result)));
+    }
+
+    ~FilterFixture()
+    {
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    bench::BuildingApplication app;
+    TwitchChannel chan;
+    std::vector<MessagePtr> messages;
+    std::optional<Filter> filter;
+};
+
+void BM_FilterContextMap(benchmark::State &state, const QString &filterText)
+{
+    FilterFixture fixture(filterText);
+    for (auto _ : state)
+    {
+        for (const auto &message : fixture.messages)
+        {
+            auto context = buildContextMap(message, &fixture.chan);
+            auto result = fixture.filter->execute(context);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+void BM_FilterCompiled(benchmark::State &state, const QString &filterText)
+{
+    FilterFixture fixture(filterText);
+    for (auto _ : state)
+    {
+        for (const auto &message : fixture.messages)
+        {
+            MessageIdentifierSource source(*message, &fixture.chan);
+            auto result = fixture.filter->execute(source);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+}  // namespace
+
+// clang-format off
+BENCHMARK_CAPTURE(BM_FilterContextMap, name, u"author.name == \"nymn\""_s);
+BENCHMARK_CAPTURE(BM_FilterCompiled, name, u"author.name == \"nymn\""_s);
+BENCHMARK_CAPTURE(BM_FilterContextMap, flags, u"!flags.sub_message && !flags.system_message"_s);
+BENCHMARK_CAPTURE(BM_FilterCompiled, flags, u"!flags.sub_message && !flags.system_message"_s);
+BENCHMARK_CAPTURE(BM_FilterContextMap, badges, u"author.badges contains \"moderator\" || author.sub_length > 12"_s);
+BENCHMARK_CAPTURE(BM_FilterCompiled, badges, u"author.badges contains \"moderator\" || author.sub_length > 12"_s);
+BENCHMARK_CAPTURE(BM_FilterContextMap, regex, u"message.content match r\"^!\\w+\" || message.length > 200"_s);
+BENCHMARK_CAPTURE(BM_FilterCompiled, regex, u"message.content match r\"^!\\w+\" || message.length > 200"_s);
+// clang-format on
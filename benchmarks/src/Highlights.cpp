@@ -0,0 +1,162 @@
+#include "common/Literals.hpp"
+#include "controllers/accounts/AccountController.hpp"
+#include "controllers/highlights/HighlightController.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "providers/recentmessages/Impl.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "providers/twitch/TwitchIrc.hpp"
+
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    explicit MockApplication(const QString &settingsData)
+        : mock::BaseApplication(settingsData)
+        , highlights(this->settings, &this->accounts)
+    {
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    HighlightController *getHighlights() override
+    {
+        return &this->highlights;
+    }
+
+    AccountController accounts;
+    HighlightController highlights;
+};
+
+QJsonObject phrase(const QString &pattern, bool isRegex)
+{
+    return {
+        {"pattern"_L1, pattern},
+        {"showInMentions"_L1, true},
+        {"alert"_L1, false},
+        {"sound"_L1, false},
+        {"regex"_L1, isRegex},
+        {"case"_L1, false},
+        {"soundUrl"_L1, ""_L1},
+        {"color"_L1, "#7f7f3f49"_L1},
+    };
+}
+
+/// Settings with `count` message highlights (a quarter of which are regular
+/// expressions), `count` user highlights and a few badge highlights
+QString settingsWithHighlights(int count)
+{
+    QJsonArray highlights;
+    QJsonArray users;
+    for (int i = 0; i < count; i++)
+    {
+        if (i % 4 == 0)
+        {
+            highlights.append(phrase(u"\\bpattern%1\\d+"_s.arg(i), true));
+        }
+        else
+        {
+            highlights.append(phrase(u"phrase %1"_s.arg(i), false));
+        }
+        users.append(phrase(u"user%1"_s.arg(i), false));
+    }
+    // Some that actually match
+    highlights.append(phrase(u"nymn"_s, false));
+    highlights.append(phrase(u"^!\\w+"_s, true));
+    users.append(phrase(u"nymn"_s, false));
+
+    QJsonArray badges;
+    for (const auto *name : {"moderator", "vip", "subscriber/12", "founder"})
+    {
+        badges.append(QJsonObject{
+            {"name"_L1, QString::fromLatin1(name)},
+            {"displayName"_L1, QString::fromLatin1(name)},
+            {"alert"_L1, false},
+            {"sound"_L1, false},
+            {"soundUrl"_L1, ""_L1},
+            {"color"_L1, "#7f427f00"_L1},
+        });
+    }
+
+    QJsonObject root{
+        {"highlighting"_L1,
+         QJsonObject{
+             {"highlights"_L1, highlights},
+             {"users"_L1, users},
+             {"badges"_L1, badges},
+         }},
+    };
+    return QString::fromUtf8(QJsonDocument(root).toJson());
+}
+
+struct HighlightInput {
+    std::vector<Badge> badges;
+    QString senderName;
+    QString content;
+};
+
+std::vector<HighlightInput> loadInputs()
+{
+    QFile file(u":/bench/recentmessages-nymn.json"_s);
+    if (!file.open(QFile::ReadOnly))
+    {
+        _exit(1);
+    }
+    auto doc = QJsonDocument::fromJson(file.readAll());
+
+    std::vector<HighlightInput> inputs;
+    for (const auto &message :
+         recentmessages::detail::parseRecentMessages(doc.object()))
+    {
+        if (message->type() == Communi::IrcMessage::Private)
+        {
+            inputs.push_back({
+                .badges = parseBadgeTag(message->tags()),
+                .senderName = message->nick(),
+                .content = message->parameter(1),
+            });
+        }
+    }
+    return inputs;
+}
+
+void BM_HighlightCheck(benchmark::State &state)
+{
+    MockApplication app(settingsWithHighlights(
+        static_cast<int>(state.range(0))));
+    auto inputs = loadInputs();
+    MessageParseArgs args;
+    MessageFlags flags;
+
+    for (auto _ : state)
+    {
+        for (const auto &input : inputs)
+        {
+            auto result = app.highlights.check(args, input.badges,
+                                               input.senderName,
+                                               input.content, flags);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_HighlightCheck)->Arg(10)->Arg(100)->Arg(500);
@@ -0,0 +1,122 @@
+#include "common/Literals.hpp"
+#include "messages/Image.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "mocks/Emotes.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QBuffer>
+#include <QFile>
+#include <QImageReader>
+#include <QString>
+
+#include <algorithm>
+#include <memory>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    IEmotes *getEmotes() override
+    {
+        return &this->emotes;
+    }
+
+    mock::Emotes emotes;
+};
+
+QByteArray readFixture(const QString &name)
+{
+    QFile file(u":/bench/" + name);
+    if (!file.open(QFile::ReadOnly))
+    {
+        return {};
+    }
+    return file.readAll();
+}
+
+/// Reads the image like Image::actuallyLoad, either decoding all frames or
+/// only the first one
+std::unique_ptr<detail::Frames> loadFrames(const QByteArray &data,
+                                           bool streamed)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer);
+    Url url{u"bench"_s};
+
+    if (streamed)
+    {
+        return std::make_unique<detail::Frames>(
+            detail::scanFrames(reader, url), data);
+    }
+    return std::make_unique<detail::Frames>(detail::readFrames(reader, url));
+}
+
+}  // namespace
+
+static void BM_AnimatedImageLoad(benchmark::State &state, const QString &name,
+                                 bool streamed)
+{
+    auto data = readFixture(name);
+    if (data.isEmpty())
+    {
+        state.SkipWithError("Missing fixture");
+        return;
+    }
+
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        auto frames = loadFrames(data, streamed);
+        bytes = frames->memoryUsage();
+    }
+    state.counters["bytes"] = double(bytes);
+}
+
+// Plays the animation as if it was painted on every tick of the GIF timer.
+// Streamed frames are decoded on the queue before the next tick.
+static void BM_AnimatedImagePlayback(benchmark::State &state,
+                                     const QString &name, bool streamed)
+{
+    auto data = readFixture(name);
+    if (data.isEmpty())
+    {
+        state.SkipWithError("Missing fixture");
+        return;
+    }
+
+    MockApplication app;
+    auto frames = loadFrames(data, streamed);
+    int64_t maxBytes = frames->memoryUsage();
+    for (auto _ : state)
+    {
+        frames->advance();
+        auto pixmap = frames->current();
+        benchmark::DoNotOptimize(pixmap);
+        app.emotes.getImageDecodeQueue().waitForDone();
+        maxBytes = std::max(maxBytes, frames->memoryUsage());
+    }
+    state.counters["bytes"] = double(maxBytes);
+}
+
+BENCHMARK_CAPTURE(BM_AnimatedImageLoad, moving_decoded, u"moving.gif"_s,
+                  false);
+BENCHMARK_CAPTURE(BM_AnimatedImageLoad, moving_streamed, u"moving.gif"_s,
+                  true);
+BENCHMARK_CAPTURE(BM_AnimatedImageLoad, splitting_decoded, u"splitting.gif"_s,
+                  false);
+BENCHMARK_CAPTURE(BM_AnimatedImageLoad, splitting_streamed,
+                  u"splitting.gif"_s, true);
+
+BENCHMARK_CAPTURE(BM_AnimatedImagePlayback, moving_decoded, u"moving.gif"_s,
+                  false);
+BENCHMARK_CAPTURE(BM_AnimatedImagePlayback, moving_streamed, u"moving.gif"_s,
+                  true);
+BENCHMARK_CAPTURE(BM_AnimatedImagePlayback, splitting_decoded,
+                  u"splitting.gif"_s, false);
+BENCHMARK_CAPTURE(BM_AnimatedImagePlayback, splitting_streamed,
+                  u"splitting.gif"_s, true);
@@ -2,8 +2,10 @@
 
 #include <benchmark/benchmark.h>
 
+#include <atomic>
 #include <memory>
 #include <numeric>
+#include <thread>
 #include <vector>
 
 using namespace chatterino;
@@ -90,6 +92,51 @@ void BM_LimitedQueue_Snapshot_ExpensiveCopy(benchmark::State &state)
     }
 }
 
+void BM_LimitedQueue_Snapshot_AfterPush(benchmark::State &state)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue.pushBack(std::make_shared<int>(i));
+    }
+
+    auto item = std::make_shared<int>(0);
+    for (auto _ : state)
+    {
+        queue.pushBack(item);
+        auto snapshot = queue.getSnapshot();
+        benchmark::DoNotOptimize(snapshot);
+    }
+}
+
+/// Takes snapshots while another thread keeps pushing to the queue
+void BM_LimitedQueue_Snapshot_Contended(benchmark::State &state)
+{
+    LimitedQueue<std::shared_ptr<int>> queue(1000);
+    for (int i = 0; i < 1000; ++i)
+    {
+        queue.pushBack(std::make_shared<int>(i));
+    }
+
+    std::atomic<bool> stop = false;
+    std::thread writer([&] {
+        auto item = std::make_shared<int>(0);
+        while (!stop)
+        {
+            queue.pushBack(item);
+        }
+    });
+
+    for (auto _ : state)
+    {
+        auto snapshot = queue.getSnapshot();
+        benchmark::DoNotOptimize(snapshot[snapshot.size() / 2]);
+    }
+
+    stop = true;
+    writer.join();
+}
+
 void BM_LimitedQueue_Find(benchmark::State &state)
 {
     LimitedQueue<int> queue(1000);
@@ -113,4 +160,6 @@ BENCHMARK(BM_LimitedQueue_PushFront_Many);
 BENCHMARK(BM_LimitedQueue_Replace);
 BENCHMARK(BM_LimitedQueue_Snapshot);
 BENCHMARK(BM_LimitedQueue_Snapshot_ExpensiveCopy);
+BENCHMARK(BM_LimitedQueue_Snapshot_AfterPush);
+BENCHMARK(BM_LimitedQueue_Snapshot_Contended)->UseRealTime();
 BENCHMARK(BM_LimitedQueue_Find);
@@ -0,0 +1,136 @@
+#include "controllers/accounts/AccountController.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageSimilarity.hpp"
+#include "mocks/BaseApplication.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+#include <QTime>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+class MockApplication : public mock::BaseApplication
+{
+public:
+    MockApplication()
+        : mock::BaseApplication(R"({
+            "similarity": {
+                "similarityEnabled": true,
+                "hideSimilarMaxDelay": 120,
+                "hideSimilarMaxMessagesToCheck": 5,
+                "hideSimilarBySameUser": false
+            }
+        })")
+    {
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    AccountController accounts;
+};
+
+MessagePtr makeMessage(const QString &text, int user)
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = QString("user%1").arg(user);
+    message->messageText = text;
+    message->parseTime = QTime::currentTime();
+    return message;
+}
+
+QString randomText(std::mt19937 &rng, qsizetype length)
+{
+    std::uniform_int_distribution<int> letter('a', 'z');
+    QString text;
+    text.reserve(length);
+    for (qsizetype i = 0; i < length; i++)
+    {
+        text.append(i % 6 == 5 ? QChar(' ') : QChar(letter(rng)));
+    }
+    return text;
+}
+
+/// Compares each message of `flood` with the ones before it, like a
+/// channel would when they arrive
+void runFlood(benchmark::State &state, const std::vector<MessagePtr> &flood)
+{
+    MockApplication app;
+    MessageSimilarityCache cache;
+
+    std::vector<MessagePtr> previous;
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        const auto &message = flood[next];
+        setSimilarityFlags(message, previous, cache);
+
+        previous.push_back(message);
+        if (previous.size() > 5)
+        {
+            previous.erase(previous.begin());
+        }
+        next = (next + 1) % flood.size();
+    }
+}
+
+}  // namespace
+
+/// The same message is sent over and over
+void BM_SimilarityCopypasta(benchmark::State &state)
+{
+    std::mt19937 rng(42);
+    auto text = randomText(rng, state.range(0));
+
+    std::vector<MessagePtr> flood;
+    for (int i = 0; i < 100; i++)
+    {
+        flood.push_back(makeMessage(text, i));
+    }
+    runFlood(state, flood);
+}
+
+/// Variations of a message - a few characters differ
+void BM_SimilarityVariations(benchmark::State &state)
+{
+    std::mt19937 rng(42);
+    auto text = randomText(rng, state.range(0));
+    std::uniform_int_distribution<qsizetype> pos(0, text.size() - 1);
+
+    std::vector<MessagePtr> flood;
+    for (int i = 0; i < 100; i++)
+    {
+        auto variation = text;
+        for (int j = 0; j < 3; j++)
+        {
+            variation[pos(rng)] = QChar('!');
+        }
+        flood.push_back(makeMessage(variation, i));
+    }
+    runFlood(state, flood);
+}
+
+/// Unrelated messages of the same length
+void BM_SimilarityDistinct(benchmark::State &state)
+{
+    std::mt19937 rng(42);
+
+    std::vector<MessagePtr> flood;
+    for (int i = 0; i < 100; i++)
+    {
+        flood.push_back(makeMessage(randomText(rng, state.range(0)), i));
+    }
+    runFlood(state, flood);
+}
+
+BENCHMARK(BM_SimilarityCopypasta)->Arg(50)->Arg(500);
+BENCHMARK(BM_SimilarityVariations)->Arg(50)->Arg(500);
+BENCHMARK(BM_SimilarityDistinct)->Arg(50)->Arg(500);
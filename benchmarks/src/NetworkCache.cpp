@@ -0,0 +1,83 @@
+#include "common/Literals.hpp"
+#include "common/network/NetworkCache.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QBuffer>
+#include <QFile>
+#include <QImageReader>
+#include <QTemporaryDir>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+QByteArray readFixture(const QString &name)
+{
+    QFile file(u":/bench/" + name);
+    if (!file.open(QFile::ReadOnly))
+    {
+        return {};
+    }
+    return file.readAll();
+}
+
+void decodeFirstFrame(const QByteArray &data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer);
+    auto image = reader.read();
+    benchmark::DoNotOptimize(image);
+}
+
+}  // namespace
+
+// Loads state.range(0) cached images like Image::actuallyLoad, either reading
+// each body into memory or mapping it
+static void BM_CachedImageLoad(benchmark::State &state, bool mapped)
+{
+    auto data = readFixture(u"moving.gif"_s);
+    if (data.isEmpty())
+    {
+        state.SkipWithError("Missing fixture");
+        return;
+    }
+
+    QTemporaryDir dir;
+    NetworkCache cache(dir.path(), qint64(1) << 30);
+    std::vector<QString> keys;
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        keys.push_back(QString::number(i));
+        // Make every body unique, so they aren't deduplicated (GIF decoders
+        // ignore data after the trailer)
+        cache.store(keys.back(), data + QByteArray::number(i), {}, {});
+    }
+    cache.flush();
+
+    for (auto _ : state)
+    {
+        for (const auto &key : keys)
+        {
+            auto entry = cache.find(key);
+            if (mapped)
+            {
+                auto mapping = cache.map(key, *entry);
+                decodeFirstFrame(mapping->data());
+            }
+            else
+            {
+                decodeFirstFrame(*cache.read(key, *entry));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            data.size());
+}
+
+BENCHMARK_CAPTURE(BM_CachedImageLoad, read, false)->Arg(100)->Arg(1000);
+BENCHMARK_CAPTURE(BM_CachedImageLoad, mapped, true)->Arg(100)->Arg(1000);
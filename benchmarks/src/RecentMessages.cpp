@@ -1,23 +1,15 @@
 #include "common/Literals.hpp"
-#include "controllers/accounts/AccountController.hpp"
-#include "controllers/highlights/HighlightController.hpp"
+#include "lib/BuildingApplication.hpp"
 #include "messages/Emote.hpp"
-#include "mocks/BaseApplication.hpp"
-#include "mocks/DisabledStreamerMode.hpp"
-#include "mocks/Emotes.hpp"
-#include "mocks/LinkResolver.hpp"
-#include "mocks/Logging.hpp"
-#include "mocks/TwitchIrcServer.hpp"
-#include "mocks/UserData.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/layouts/MessageLayoutContext.hpp"
+#include "messages/MessageElement.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
-#include "providers/chatterino/ChatterinoBadges.hpp"
-#include "providers/ffz/FfzBadges.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/recentmessages/Impl.hpp"
-#include "providers/seventv/SeventvBadges.hpp"
 #include "providers/seventv/SeventvEmotes.hpp"
-#include "providers/twitch/TwitchBadges.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
+#include "singletons/Fonts.hpp"
 #include "singletons/Resources.hpp"
 
 #include <benchmark/benchmark.h>
@@ -25,114 +17,17 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QString>
+#include <QtConcurrent>
 
+#include <memory>
 #include <optional>
+#include <vector>
 
 using namespace chatterino;
 using namespace literals;
 
 namespace {
 
-class MockApplication : public mock::BaseApplication
-{
-public:
-    MockApplication()
-        : highlights(this->settings, &this->accounts)
-    {
-    }
-
-    IEmotes *getEmotes() override
-    {
-        return &this->emotes;
-    }
-
-    IUserDataController *getUserData() override
-    {
-        return &this->userData;
-    }
-
-    AccountController *getAccounts() override
-    {
-        return &this->accounts;
-    }
-
-    ITwitchIrcServer *getTwitch() override
-    {
-        return &this->twitch;
-    }
-
-    ChatterinoBadges *getChatterinoBadges() override
-    {
-        return &this->chatterinoBadges;
-    }
-
-    FfzBadges *getFfzBadges() override
-    {
-        return &this->ffzBadges;
-    }
-
-    SeventvBadges *getSeventvBadges() override
-    {
-        return &this->seventvBadges;
-    }
-
-    HighlightController *getHighlights() override
-    {
-        return &this->highlights;
-    }
-
-    TwitchBadges *getTwitchBadges() override
-    {
-        return &this->twitchBadges;
-    }
-
-    BttvEmotes *getBttvEmotes() override
-    {
-        return &this->bttvEmotes;
-    }
-
-    FfzEmotes *getFfzEmotes() override
-    {
-        return &this->ffzEmotes;
-    }
-
-    SeventvEmotes *getSeventvEmotes() override
-    {
-        return &this->seventvEmotes;
-    }
-
-    IStreamerMode *getStreamerMode() override
-    {
-        return &this->streamerMode;
-    }
-
-    ILinkResolver *getLinkResolver() override
-    {
-        return &this->linkResolver;
-    }
-
-    ILogging *getChatLogger() override
-    {
-        return &this->logging;
-    }
-
-    mock::EmptyLogging logging;
-    AccountController accounts;
-    mock::Emotes emotes;
-    mock::UserDataController userData;
-    mock::MockTwitchIrcServer twitch;
-    mock::EmptyLinkResolver linkResolver;
-    ChatterinoBadges chatterinoBadges;
-    FfzBadges ffzBadges;
-    SeventvBadges seventvBadges;
-    HighlightController highlights;
-    TwitchBadges twitchBadges;
-    BttvEmotes bttvEmotes;
-    FfzEmotes ffzEmotes;
-    SeventvEmotes seventvEmotes;
-    DisabledStreamerMode streamerMode;
-};
-
 std::optional<QJsonDocument> tryReadJsonFile(const QString &path)
 {
     QFile file(path);
@@ -211,7 +106,7 @@ public:
 
 protected:
     QString name;
-    MockApplication app;
+    bench::BuildingApplication app;
     TwitchChannel chan;
     QJsonDocument messages;
 };
@@ -256,6 +151,99 @@ public:
     }
 };
 
+/// Builds the same backlog for several channels on the thread pool, like
+/// joining channels at startup
+class BuildRecentMessagesConcurrently : public RecentMessages
+{
+public:
+    explicit BuildRecentMessagesConcurrently(const QString &name_)
+        : RecentMessages(name_)
+    {
+    }
+
+    void run(benchmark::State &state)
+    {
+        auto parsed = recentmessages::detail::parseRecentMessages(
+            this->messages.object());
+
+        std::vector<std::unique_ptr<TwitchChannel>> channels;
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            auto &channel =
+                channels.emplace_back(std::make_unique<TwitchChannel>(
+                    u"%1%2"_s.arg(this->name).arg(i)));
+            channel->setSeventvEmotes(this->chan.seventvEmotes());
+            channel->setBttvEmotes(this->chan.bttvEmotes());
+            channel->setFfzEmotes(this->chan.ffzEmotes());
+        }
+
+        for (auto _ : state)
+        {
+            QtConcurrent::blockingMap(channels, [&](const auto &channel) {
+                QDate lastDate;
+                auto built = recentmessages::detail::buildRecentMessages(
+                    parsed, channel.get(), lastDate);
+                benchmark::DoNotOptimize(built);
+            });
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) *
+                                static_cast<int64_t>(parsed.size()));
+    }
+};
+
+/// Lays out all messages at several widths, like resizing a split
+class LayoutRecentMessages : public RecentMessages
+{
+public:
+    explicit LayoutRecentMessages(const QString &name_)
+        : RecentMessages(name_)
+    {
+    }
+
+    void run(benchmark::State &state)
+    {
+        this->app.fonts.setWordWidthCacheSize(size_t(state.range(0)));
+
+        auto parsed = recentmessages::detail::parseRecentMessages(
+            this->messages.object());
+        auto built =
+            recentmessages::detail::buildRecentMessages(parsed, &this->chan);
+
+        std::vector<std::unique_ptr<MessageLayout>> layouts;
+        layouts.reserve(built.size());
+        for (const auto &message : built)
+        {
+            layouts.push_back(std::make_unique<MessageLayout>(message));
+        }
+
+        // Images aren't loaded in benchmarks, so emotes are shown as text
+        MessageElementFlags flags{
+            MessageElementFlag::Timestamp, MessageElementFlag::Username,
+            MessageElementFlag::Text,      MessageElementFlag::EmoteText,
+            MessageElementFlag::AlwaysShow,
+        };
+        MessageColors colors;
+        for (auto _ : state)
+        {
+            for (int width : {300, 500, 800, 1200})
+            {
+                for (const auto &layout : layouts)
+                {
+                    layout->layout(
+                        {
+                            .messageColors = colors,
+                            .flags = flags,
+                            .width = width,
+                            .scale = 1,
+                            .imageScale = 1,
+                        },
+                        false);
+                }
+            }
+        }
+    }
+};
+
 void BM_ParseRecentMessages(benchmark::State &state, const QString &name)
 {
     ParseRecentMessages bench(name);
@@ -268,7 +256,30 @@ void BM_BuildRecentMessages(benchmark::State &state, const QString &name)
     bench.run(state);
 }
 
+// state.range(0) is the number of channels built at the same time
+void BM_BuildRecentMessagesConcurrently(benchmark::State &state,
+                                        const QString &name)
+{
+    BuildRecentMessagesConcurrently bench(name);
+    bench.run(state);
+}
+
+// state.range(0) is the size of the word width cache (0 disables it)
+void BM_LayoutRecentMessages(benchmark::State &state, const QString &name)
+{
+    LayoutRecentMessages bench(name);
+    bench.run(state);
+}
+
 }  // namespace
 
 BENCHMARK_CAPTURE(BM_ParseRecentMessages, nymn, u"nymn"_s);
 BENCHMARK_CAPTURE(BM_BuildRecentMessages, nymn, u"nymn"_s);
+BENCHMARK_CAPTURE(BM_BuildRecentMessagesConcurrently, nymn, u"nymn"_s)
+    ->Arg(1)
+    ->Arg(8)
+    ->Arg(40)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_LayoutRecentMessages, nymn, u"nymn"_s)
+    ->Arg(0)
+    ->Arg(Fonts::DEFAULT_WORD_WIDTH_CACHE_SIZE);
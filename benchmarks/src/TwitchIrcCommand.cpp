@@ -0,0 +1,31 @@
+#include "common/Literals.hpp"
+#include "providers/twitch/TwitchIrcCommand.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+namespace {
+
+void BM_ParseTwitchIrcCommand(benchmark::State &state)
+{
+    std::vector<QString> commands{
+        u"PRIVMSG"_s,   u"USERNOTICE"_s, u"CLEARCHAT"_s, u"ROOMSTATE"_s,
+        u"USERSTATE"_s, u"NOTICE"_s,     u"JOIN"_s,      u"001"_s,
+    };
+    for (auto _ : state)
+    {
+        for (const auto &command : commands)
+        {
+            benchmark::DoNotOptimize(parseTwitchIrcCommand(command));
+        }
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_ParseTwitchIrcCommand);
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "controllers/accounts/AccountController.hpp"
+#include "controllers/highlights/HighlightController.hpp"
+#include "mocks/BaseApplication.hpp"
+#include "mocks/DisabledStreamerMode.hpp"
+#include "mocks/Emotes.hpp"
+#include "mocks/LinkResolver.hpp"
+#include "mocks/Logging.hpp"
+#include "mocks/TwitchIrcServer.hpp"
+#include "mocks/UserData.hpp"
+#include "providers/bttv/BttvEmotes.hpp"
+#include "providers/chatterino/ChatterinoBadges.hpp"
+#include "providers/ffz/FfzBadges.hpp"
+#include "providers/ffz/FfzEmotes.hpp"
+#include "providers/seventv/SeventvBadges.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+#include "providers/twitch/TwitchBadges.hpp"
+#include "singletons/WindowManager.hpp"
+
+namespace chatterino::bench {
+
+/// Application with everything needed to build and lay out Twitch messages
+/// (e.g. from recent messages)
+class BuildingApplication : public mock::BaseApplication
+{
+public:
+    BuildingApplication()
+        : highlights(this->settings, &this->accounts)
+        , windowManager(this->args, this->paths_, this->settings, this->theme,
+                        this->fonts)
+    {
+    }
+
+    IEmotes *getEmotes() override
+    {
+        return &this->emotes;
+    }
+
+    IUserDataController *getUserData() override
+    {
+        return &this->userData;
+    }
+
+    AccountController *getAccounts() override
+    {
+        return &this->accounts;
+    }
+
+    ITwitchIrcServer *getTwitch() override
+    {
+        return &this->twitch;
+    }
+
+    ChatterinoBadges *getChatterinoBadges() override
+    {
+        return &this->chatterinoBadges;
+    }
+
+    FfzBadges *getFfzBadges() override
+    {
+        return &this->ffzBadges;
+    }
+
+    SeventvBadges *getSeventvBadges() override
+    {
+        return &this->seventvBadges;
+    }
+
+    HighlightController *getHighlights() override
+    {
+        return &this->highlights;
+    }
+
+    TwitchBadges *getTwitchBadges() override
+    {
+        return &this->twitchBadges;
+    }
+
+    BttvEmotes *getBttvEmotes() override
+    {
+        return &this->bttvEmotes;
+    }
+
+    FfzEmotes *getFfzEmotes() override
+    {
+        return &this->ffzEmotes;
+    }
+
+    SeventvEmotes *getSeventvEmotes() override
+    {
+        return &this->seventvEmotes;
+    }
+
+    IStreamerMode *getStreamerMode() override
+    {
+        return &this->streamerMode;
+    }
+
+    ILinkResolver *getLinkResolver() override
+    {
+        return &this->linkResolver;
+    }
+
+    ILogging *getChatLogger() override
+    {
+        return &this->logging;
+    }
+
+    WindowManager *getWindows() override
+    {
+        return &this->windowManager;
+    }
+
+    mock::EmptyLogging logging;
+    AccountController accounts;
+    mock::Emotes emotes;
+    mock::UserDataController userData;
+    mock::MockTwitchIrcServer twitch;
+    mock::EmptyLinkResolver linkResolver;
+    ChatterinoBadges chatterinoBadges;
+    FfzBadges ffzBadges;
+    SeventvBadges seventvBadges;
+    HighlightController highlights;
+    TwitchBadges twitchBadges;
+    BttvEmotes bttvEmotes;
+    FfzEmotes ffzEmotes;
+    SeventvEmotes seventvEmotes;
+    DisabledStreamerMode streamerMode;
+    WindowManager windowManager;
+};
+
+}  // namespace chatterino::bench
@@ -28,11 +28,17 @@ public:
         return this->gifTimer;
     }
 
+    ImageDecodeQueue &getImageDecodeQueue() override
+    {
+        return this->imageDecodeQueue;
+    }
+
 private:
     TwitchEmotes twitch;
     Emojis emojis;
 
     GIFTimer gifTimer;
+    ImageDecodeQueue imageDecodeQueue;
 };
 
 }  // namespace chatterino::mock
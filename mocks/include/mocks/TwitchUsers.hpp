@@ -19,6 +19,11 @@ public:
         };
         return std::make_shared<TwitchUser>(u);
     }
+
+    TwitchUser resolveIDCopy(const UserId &id) override
+    {
+        return *this->resolveID(id);
+    }
 };
 
 }  // namespace chatterino::mock
@@ -258,7 +258,9 @@ void runGui(QApplication &a, const Paths &paths, Settings &settings,
 
     updates.deleteOldFiles();
 
-    // Clear the cache 1 minute after start.
+    // Clear the cache 1 minute after start. This only looks at the files
+    // directly in the cache directory, the network cache manages its own
+    // subdirectory.
     QTimer::singleShot(60 * 1000, [cachePath = paths.cacheDirectory(),
                                    crashDirectory = paths.crashdumpDirectory,
                                    avatarPath = paths.twitchProfileAvatars] {
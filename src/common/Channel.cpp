@@ -4,9 +4,11 @@
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageSimilarity.hpp"
+#include "messages/search/SearchIndex.hpp"
 #include "singletons/Logging.hpp"
 #include "singletons/Settings.hpp"
 #include "util/ChannelHelpers.hpp"
+#include "util/PostToThread.hpp"
 
 namespace chatterino {
 
@@ -79,33 +81,64 @@ LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot()
 void Channel::addMessage(MessagePtr message, MessageContext context,
                          std::optional<MessageFlags> overridingFlags)
 {
-    message->freeze();
+    this->addMessages({&message, 1}, context, overridingFlags);
+}
+
+void Channel::addMessages(std::span<const MessagePtr> messages,
+                          MessageContext context,
+                          std::optional<MessageFlags> overridingFlags)
+{
+    if (messages.empty())
+    {
+        return;
+    }
 
-    MessagePtr deleted;
+    for (const auto &message : messages)
+    {
+        message->freeze();
+    }
 
     if (context == MessageContext::Original && this->getType() != Type::None)
     {
-        // Only log original messages
-        auto isDoNotLogSet =
-            (overridingFlags && overridingFlags->has(MessageFlag::DoNotLog)) ||
-            message->flags.has(MessageFlag::DoNotLog);
-
-        if (!isDoNotLogSet)
+        for (const auto &message : messages)
         {
-            // Only log messages where the `DoNotLog` flag is not set
-            getApp()->getChatLogger()->addMessage(this->name_, message,
-                                                  this->platform_,
-                                                  this->getCurrentStreamID());
-            this->anythingLogged_ = true;
+            // Only log original messages
+            auto isDoNotLogSet =
+                (overridingFlags &&
+                 overridingFlags->has(MessageFlag::DoNotLog)) ||
+                message->flags.has(MessageFlag::DoNotLog);
+
+            if (!isDoNotLogSet)
+            {
+                // Only log messages where the `DoNotLog` flag is not set
+                getApp()->getChatLogger()->addMessage(
+                    this->name_, message, this->platform_,
+                    this->getCurrentStreamID());
+                this->anythingLogged_ = true;
+            }
         }
     }
 
-    if (this->messages_.pushBack(message, deleted))
+    std::vector<MessagePtr> deleted;
+    {
+        std::unique_lock lock(this->searchIndexMutex_);
+        this->messages_.pushBack(messages, &deleted);
+        if (this->searchIndex_)
+        {
+            this->searchIndex_->append(messages);
+            this->searchIndex_->removeFront(deleted.size());
+        }
+    }
+    for (const auto &message : deleted)
     {
-        this->messageRemovedFromStart(deleted);
+        this->messageRemovedFromStart(message);
     }
 
-    this->messageAppended.invoke(message, overridingFlags);
+    for (auto message : messages)
+    {
+        this->messageAppended.invoke(message, overridingFlags);
+    }
+    this->messagesAppended.invoke(messages, overridingFlags);
 }
 
 void Channel::addSystemMessage(const QString &contents)
@@ -164,8 +197,15 @@ void Channel::addMessagesAtStart(const std::vector<MessagePtr> &_messages)
         msg->freeze();
     }
 
-    std::vector<MessagePtr> addedMessages =
-        this->messages_.pushFront(_messages);
+    std::vector<MessagePtr> addedMessages;
+    {
+        std::unique_lock lock(this->searchIndexMutex_);
+        addedMessages = this->messages_.pushFront(_messages);
+        if (this->searchIndex_)
+        {
+            this->searchIndex_->prepend(addedMessages);
+        }
+    }
 
     if (addedMessages.size() != 0)
     {
@@ -184,12 +224,18 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
         msg->freeze();
     }
 
+    // The messages are inserted in the middle, which the index can't follow,
+    // so it's rebuilt on the next search
+    std::unique_lock lock(this->searchIndexMutex_);
+    this->searchIndex_.reset();
+
     auto snapshot = this->getMessageSnapshot();
     if (snapshot.size() == 0)
     {
         // There are no messages in this channel yet so we can just insert them
         // at the front in order
         this->messages_.pushFront(messages);
+        lock.unlock();
         this->filledInMessages.invoke(messages);
         return;
     }
@@ -255,6 +301,7 @@ void Channel::fillInMissingMessages(const std::vector<MessagePtr> &messages)
             lastMsg = msg;
         }
     }
+    lock.unlock();
 
     if (anyInserted)
     {
@@ -268,7 +315,15 @@ void Channel::replaceMessage(const MessagePtr &message,
                              const MessagePtr &replacement)
 {
     replacement->freeze();
-    int index = this->messages_.replaceItem(message, replacement);
+    int index = 0;
+    {
+        std::unique_lock lock(this->searchIndexMutex_);
+        index = this->messages_.replaceItem(message, replacement);
+        if (index >= 0 && this->searchIndex_)
+        {
+            this->searchIndex_->replace(index, message, replacement);
+        }
+    }
 
     if (index >= 0)
     {
@@ -281,7 +336,17 @@ void Channel::replaceMessage(size_t index, const MessagePtr &replacement)
     replacement->freeze();
 
     MessagePtr prev;
-    if (this->messages_.replaceItem(index, replacement, &prev))
+    bool replaced = false;
+    {
+        std::unique_lock lock(this->searchIndexMutex_);
+        replaced = this->messages_.replaceItem(index, replacement, &prev);
+        if (replaced && this->searchIndex_)
+        {
+            this->searchIndex_->replace(index, prev, replacement);
+        }
+    }
+
+    if (replaced)
     {
         this->messageReplaced.invoke(index, prev, replacement);
     }
@@ -292,7 +357,16 @@ void Channel::replaceMessage(size_t hint, const MessagePtr &message,
 {
     replacement->freeze();
 
-    auto index = this->messages_.replaceItem(hint, message, replacement);
+    int index = 0;
+    {
+        std::unique_lock lock(this->searchIndexMutex_);
+        index = this->messages_.replaceItem(hint, message, replacement);
+        if (index >= 0 && this->searchIndex_)
+        {
+            this->searchIndex_->replace(index, message, replacement);
+        }
+    }
+
     if (index >= 0)
     {
         this->messageReplaced.invoke(hint, message, replacement);
@@ -310,7 +384,11 @@ void Channel::disableMessage(const QString &messageID)
 
 void Channel::clearMessages()
 {
-    this->messages_.clear();
+    {
+        std::unique_lock lock(this->searchIndexMutex_);
+        this->messages_.clear();
+        this->searchIndex_.reset();
+    }
     this->messagesCleared.invoke();
 }
 
@@ -329,9 +407,23 @@ MessagePtr Channel::findMessageByID(QStringView messageID)
     return res;
 }
 
+LimitedQueueSnapshot<MessagePtr> Channel::lookUpMessages(
+    FunctionRef<void(const SearchIndex &)> lookup)
+{
+    std::unique_lock lock(this->searchIndexMutex_);
+    auto snapshot = this->messages_.getSnapshot();
+    if (!this->searchIndex_)
+    {
+        this->searchIndex_ = std::make_unique<SearchIndex>(snapshot);
+    }
+    lookup(*this->searchIndex_);
+    return snapshot;
+}
+
 void Channel::applySimilarityFilters(const MessagePtr &message) const
 {
-    setSimilarityFlags(message, this->messages_.getSnapshot());
+    setSimilarityFlags(message, this->messages_.getSnapshot(),
+                       this->similarityCache_);
 }
 
 MessageSinkTraits Channel::sinkTraits() const
@@ -342,6 +434,11 @@ MessageSinkTraits Channel::sinkTraits() const
     };
 }
 
+void Channel::runSideEffect(std::function<void()> fn)
+{
+    runInGuiThread(std::move(fn));
+}
+
 bool Channel::canSendMessage() const
 {
     return false;
@@ -4,7 +4,9 @@
 #include "controllers/completion/TabCompletionModel.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/MessageFlag.hpp"
+#include "messages/MessageSimilarity.hpp"
 #include "messages/MessageSink.hpp"
+#include "util/FunctionRef.hpp"
 
 #include <magic_enum/magic_enum.hpp>
 #include <pajlada/signals/signal.hpp>
@@ -13,12 +15,15 @@
 #include <QTimer>
 
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <span>
 
 namespace chatterino {
 
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
+class SearchIndex;
 
 class Channel : public std::enable_shared_from_this<Channel>, public MessageSink
 {
@@ -63,6 +68,11 @@ public:
         sendReplySignal;
     pajlada::Signals::Signal<MessagePtr &, std::optional<MessageFlags>>
         messageAppended;
+    /// Invoked once for messages appended together (after #messageAppended
+    /// was invoked for each of them)
+    pajlada::Signals::Signal<std::span<const MessagePtr>,
+                             std::optional<MessageFlags>>
+        messagesAppended;
     pajlada::Signals::Signal<std::vector<MessagePtr> &> messagesAddedAtStart;
     /// (index, prev-message, replacement)
     pajlada::Signals::Signal<size_t, const MessagePtr &, const MessagePtr &>
@@ -88,6 +98,10 @@ public:
     void addMessage(
         MessagePtr message, MessageContext context,
         std::optional<MessageFlags> overridingFlags = std::nullopt) final;
+    /// Appends `messages` like #addMessage, but views only update once
+    void addMessages(
+        std::span<const MessagePtr> messages, MessageContext context,
+        std::optional<MessageFlags> overridingFlags = std::nullopt);
     void addMessagesAtStart(const std::vector<MessagePtr> &messages_);
 
     void addSystemMessage(const QString &contents);
@@ -110,12 +124,27 @@ public:
 
     MessagePtr findMessageByID(QStringView messageID) final;
 
+    /**
+     * @brief Calls `lookup` with the search index of this channel's messages.
+     *
+     * The index is built on the first search and kept up to date as messages
+     * are added, replaced and removed. It's locked while `lookup` runs, so
+     * `lookup` should only look up positions and leave checking the messages
+     * to the caller.
+     *
+     * @return the messages the positions in the index refer to
+     */
+    LimitedQueueSnapshot<MessagePtr> lookUpMessages(
+        FunctionRef<void(const SearchIndex &)> lookup);
+
     bool hasMessages() const;
 
     void applySimilarityFilters(const MessagePtr &message) const final;
 
     MessageSinkTraits sinkTraits() const final;
 
+    void runSideEffect(std::function<void()> fn) final;
+
     // CHANNEL INFO
     virtual bool canSendMessage() const;
     virtual bool isWritable() const;  // whether split input will be usable
@@ -144,6 +173,11 @@ protected:
 private:
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    /// Guards searchIndex_ and keeps it in sync with messages_
+    std::mutex searchIndexMutex_;
+    /// Index of messages_, only present once the channel was searched
+    std::unique_ptr<SearchIndex> searchIndex_;
+    mutable MessageSimilarityCache similarityCache_;
     Type type_;
     bool anythingLogged_ = false;
     QTimer clearCompletionModelTimer_;
@@ -0,0 +1,594 @@
+#include "common/network/NetworkCache.hpp"
+
+#include "Application.hpp"
+#include "common/QLogging.hpp"
+#include "singletons/Paths.hpp"
+#include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr quint32 INDEX_MAGIC = 0x43495831;  // "CIX1"
+constexpr auto SAVE_INTERVAL = std::chrono::minutes(5);
+
+qint64 now()
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+qint64 budgetFromSettings()
+{
+    return static_cast<qint64>(
+               std::max(getSettings()->cacheSizeLimit.getValue(), 0)) *
+           1024 * 1024;
+}
+
+std::mutex currentMutex;
+std::shared_ptr<NetworkCache> currentCache;
+
+}  // namespace
+
+namespace chatterino {
+
+bool NetworkCache::Entry::isStale(qint64 now) const
+{
+    return now - this->storedAt >
+           std::chrono::duration_cast<std::chrono::milliseconds>(MAX_AGE)
+               .count();
+}
+
+bool NetworkCache::Entry::canRevalidate() const
+{
+    return !this->etag.isEmpty() || !this->lastModified.isEmpty();
+}
+
+NetworkCache::Mapping::Mapping(const QString &path)
+    : file_(path)
+{
+    if (!this->file_.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    this->size_ = this->file_.size();
+    // Empty files can't be mapped
+    if (this->size_ > 0)
+    {
+        this->data_ = this->file_.map(0, this->size_);
+    }
+    if (this->data_)
+    {
+        DebugCount::increase("http cache mappings");
+        DebugCount::increase("http cache mapped bytes", this->size_);
+    }
+}
+
+NetworkCache::Mapping::~Mapping()
+{
+    if (this->data_)
+    {
+        this->file_.unmap(this->data_);
+        DebugCount::decrease("http cache mappings");
+        DebugCount::decrease("http cache mapped bytes", this->size_);
+    }
+}
+
+bool NetworkCache::Mapping::isValid() const
+{
+    return this->data_ != nullptr;
+}
+
+QByteArray NetworkCache::Mapping::data() const
+{
+    if (!this->data_)
+    {
+        return {};
+    }
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(this->data_),
+                                   static_cast<qsizetype>(this->size_));
+}
+
+NetworkCache::NetworkCache(QString directory, qint64 budget)
+    : directory_(std::move(directory))
+    , budget_(budget)
+    , lastSave_(std::chrono::steady_clock::now())
+{
+    DebugCount::configure("http cache bytes", DebugCount::Flag::DataSize);
+    DebugCount::configure("http cache mapped bytes",
+                          DebugCount::Flag::DataSize);
+    this->ioPool_.setMaxThreadCount(1);
+
+    QDir().mkpath(this->directory_);
+    this->loadIndex();
+    this->ioPool_.start([this] {
+        this->deleteOrphanedBlobs();
+    });
+}
+
+NetworkCache::~NetworkCache()
+{
+    this->flush();
+}
+
+std::shared_ptr<NetworkCache> NetworkCache::current()
+{
+    auto directory = getApp()->getPaths().cacheDirectory() + "/http";
+    auto budget = budgetFromSettings();
+
+    std::lock_guard guard(currentMutex);
+    if (!currentCache || currentCache->directory() != directory)
+    {
+        if (currentCache)
+        {
+            currentCache->flush();
+        }
+        currentCache = std::make_shared<NetworkCache>(directory, budget);
+        currentCache->removeLegacyFiles(
+            getApp()->getPaths().cacheDirectory());
+    }
+    else
+    {
+        currentCache->setBudget(budget);
+    }
+    return currentCache;
+}
+
+void NetworkCache::shutdown()
+{
+    std::shared_ptr<NetworkCache> cache;
+    {
+        std::lock_guard guard(currentMutex);
+        cache = std::move(currentCache);
+    }
+    if (cache)
+    {
+        cache->flush();
+    }
+}
+
+const QString &NetworkCache::directory() const
+{
+    return this->directory_;
+}
+
+std::optional<NetworkCache::Entry> NetworkCache::find(const QString &key)
+{
+    std::lock_guard guard(this->mutex_);
+
+    auto it = this->entries_.find(key.toLatin1());
+    if (it == this->entries_.end())
+    {
+        return std::nullopt;
+    }
+
+    if (it->second.lru != this->lru_.begin())
+    {
+        this->lru_.splice(this->lru_.begin(), this->lru_, it->second.lru);
+        this->reordered_ = true;
+    }
+    return it->second.entry;
+}
+
+std::optional<QByteArray> NetworkCache::read(const QString &key,
+                                             const Entry &entry)
+{
+    QFile file(this->blobPath(entry.blob));
+    if (file.open(QIODevice::ReadOnly))
+    {
+        auto bytes = file.readAll();
+        if (bytes.size() == entry.size)
+        {
+            return bytes;
+        }
+    }
+
+    this->removeMissing(key, entry);
+    return std::nullopt;
+}
+
+std::shared_ptr<const NetworkCache::Mapping> NetworkCache::map(
+    const QString &key, const Entry &entry)
+{
+    auto mapping = std::make_shared<const Mapping>(this->blobPath(entry.blob));
+    if (mapping->isValid() && mapping->data().size() == entry.size)
+    {
+        return mapping;
+    }
+
+    this->removeMissing(key, entry);
+    return nullptr;
+}
+
+void NetworkCache::store(const QString &key, QByteArray body, QByteArray etag,
+                         QByteArray lastModified)
+{
+    this->ioPool_.start([this, key = key.toLatin1(), body = std::move(body),
+                         etag = std::move(etag),
+                         lastModified = std::move(lastModified)] {
+        Entry entry{
+            .blob = QCryptographicHash::hash(body, QCryptographicHash::Sha256)
+                        .toHex(),
+            .size = body.size(),
+            .storedAt = now(),
+            .etag = etag,
+            .lastModified = lastModified,
+        };
+
+        auto path = this->blobPath(entry.blob);
+        if (!QFile::exists(path))
+        {
+            QDir().mkpath(QFileInfo(path).path());
+            QSaveFile file(path);
+            if (!file.open(QIODevice::WriteOnly) ||
+                file.write(body) != body.size() || !file.commit())
+            {
+                qCWarning(chatterinoCache)
+                    << "Failed to write" << path << file.errorString();
+                return;
+            }
+        }
+
+        bool saveDue = false;
+        {
+            std::lock_guard guard(this->mutex_);
+            this->insertLocked(key, std::move(entry), true);
+            this->evictLocked();
+            this->updateDebugCountsLocked();
+            saveDue = std::chrono::steady_clock::now() - this->lastSave_ >
+                      SAVE_INTERVAL;
+        }
+
+        this->deleteUnusedBlobs();
+
+        if (saveDue)
+        {
+            this->saveIndex();
+        }
+    });
+}
+
+void NetworkCache::markRevalidated(const QString &key)
+{
+    std::lock_guard guard(this->mutex_);
+
+    auto it = this->entries_.find(key.toLatin1());
+    if (it != this->entries_.end())
+    {
+        it->second.entry.storedAt = now();
+        this->dirty_ = true;
+    }
+}
+
+void NetworkCache::setBudget(qint64 budget)
+{
+    {
+        std::lock_guard guard(this->mutex_);
+        if (this->budget_ == budget)
+        {
+            return;
+        }
+        this->budget_ = budget;
+        this->evictLocked();
+        this->updateDebugCountsLocked();
+    }
+    this->ioPool_.start([this] {
+        this->deleteUnusedBlobs();
+    });
+}
+
+qint64 NetworkCache::budget() const
+{
+    std::lock_guard guard(this->mutex_);
+    return this->budget_;
+}
+
+qint64 NetworkCache::totalBytes() const
+{
+    std::lock_guard guard(this->mutex_);
+    return this->totalBytes_;
+}
+
+size_t NetworkCache::entryCount() const
+{
+    std::lock_guard guard(this->mutex_);
+    return this->entries_.size();
+}
+
+void NetworkCache::clear()
+{
+    this->ioPool_.waitForDone();
+
+    std::lock_guard saveGuard(this->saveMutex_);
+    std::lock_guard guard(this->mutex_);
+    this->entries_.clear();
+    this->lru_.clear();
+    this->blobRefs_.clear();
+    this->unusedBlobs_.clear();
+    this->totalBytes_ = 0;
+    this->dirty_ = false;
+    this->reordered_ = false;
+    this->updateDebugCountsLocked();
+
+    QDir(this->directory_).removeRecursively();
+    QDir().mkpath(this->directory_);
+}
+
+void NetworkCache::removeLegacyFiles(const QString &directory)
+{
+    this->ioPool_.start([directory] {
+        // Responses used to be stored as files named by the hex SHA-256 of
+        // the request. Other files in the directory (e.g. cached emote
+        // responses) are kept.
+        static const QRegularExpression legacyName("^[0-9a-f]{64}$");
+
+        size_t deletedCount = 0;
+        for (const auto &info : QDir(directory).entryInfoList(QDir::Files))
+        {
+            if (legacyName.match(info.fileName()).hasMatch() &&
+                QFile::remove(info.filePath()))
+            {
+                deletedCount++;
+            }
+        }
+        if (deletedCount > 0)
+        {
+            qCDebug(chatterinoCache) << "Deleted" << deletedCount
+                                     << "legacy cache files in" << directory;
+        }
+    });
+}
+
+void NetworkCache::flush()
+{
+    this->ioPool_.waitForDone();
+    this->saveIndex(true);
+}
+
+void NetworkCache::removeMissing(const QString &key, const Entry &entry)
+{
+    qCDebug(chatterinoCache) << "Body of" << key << "is missing";
+
+    std::lock_guard guard(this->mutex_);
+    auto it = this->entries_.find(key.toLatin1());
+    if (it != this->entries_.end() && it->second.entry.blob == entry.blob)
+    {
+        this->removeLocked(it->first);
+        this->updateDebugCountsLocked();
+    }
+}
+
+QString NetworkCache::blobPath(const QByteArray &blob) const
+{
+    auto name = QString::fromLatin1(blob);
+    return this->directory_ + '/' + name.left(2) + '/' + name;
+}
+
+void NetworkCache::loadIndex()
+{
+    QFile file(this->directory_ + "/index");
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0;
+    quint32 count = 0;
+    stream >> magic >> count;
+    if (magic != INDEX_MAGIC)
+    {
+        qCWarning(chatterinoCache) << "Ignoring invalid cache index";
+        return;
+    }
+
+    std::lock_guard guard(this->mutex_);
+    for (quint32 i = 0; i < count; i++)
+    {
+        QByteArray key;
+        Entry entry;
+        stream >> key >> entry.blob >> entry.size >> entry.storedAt >>
+            entry.etag >> entry.lastModified;
+        if (stream.status() != QDataStream::Ok)
+        {
+            qCWarning(chatterinoCache) << "Cache index is truncated";
+            break;
+        }
+        // Entries are saved most recently used first
+        this->insertLocked(key.toHex(), std::move(entry), false);
+    }
+    this->evictLocked();
+    this->updateDebugCountsLocked();
+
+    qCDebug(chatterinoCache) << "Loaded" << this->entries_.size()
+                             << "cached responses from" << this->directory_;
+}
+
+void NetworkCache::saveIndex(bool includeOrder)
+{
+    std::lock_guard saveGuard(this->saveMutex_);
+
+    QByteArray bytes;
+    {
+        QDataStream stream(&bytes, QIODevice::WriteOnly);
+        stream.setVersion(QDataStream::Qt_5_15);
+
+        std::lock_guard guard(this->mutex_);
+        if (!this->dirty_ && !(includeOrder && this->reordered_))
+        {
+            return;
+        }
+        this->dirty_ = false;
+        this->reordered_ = false;
+        this->lastSave_ = std::chrono::steady_clock::now();
+
+        stream << INDEX_MAGIC << static_cast<quint32>(this->entries_.size());
+        for (const auto &key : this->lru_)
+        {
+            const auto &entry = this->entries_.at(key).entry;
+            stream << QByteArray::fromHex(key) << entry.blob << entry.size
+                   << entry.storedAt << entry.etag << entry.lastModified;
+        }
+    }
+
+    QSaveFile file(this->directory_ + "/index");
+    if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size() ||
+        !file.commit())
+    {
+        qCWarning(chatterinoCache)
+            << "Failed to save cache index" << file.errorString();
+    }
+}
+
+void NetworkCache::insertLocked(const QByteArray &key, Entry entry,
+                                bool mostRecent)
+{
+    this->removeLocked(key);
+
+    auto &refs = this->blobRefs_[entry.blob];
+    if (refs++ == 0)
+    {
+        this->totalBytes_ += entry.size;
+    }
+
+    auto lru = mostRecent ? this->lru_.insert(this->lru_.begin(), key)
+                          : this->lru_.insert(this->lru_.end(), key);
+    this->entries_.emplace(key, Node{
+                                    .entry = std::move(entry),
+                                    .lru = lru,
+                                });
+    this->dirty_ = true;
+}
+
+void NetworkCache::removeLocked(const QByteArray &key)
+{
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        return;
+    }
+
+    const auto &entry = it->second.entry;
+    auto refs = this->blobRefs_.find(entry.blob);
+    assert(refs != this->blobRefs_.end());
+    if (--refs->second == 0)
+    {
+        this->blobRefs_.erase(refs);
+        this->totalBytes_ -= entry.size;
+        this->unusedBlobs_.push_back(entry.blob);
+    }
+
+    this->lru_.erase(it->second.lru);
+    this->entries_.erase(it);
+    this->dirty_ = true;
+}
+
+void NetworkCache::evictLocked()
+{
+    while (!this->lru_.empty() && this->totalBytes_ > this->budget_)
+    {
+        // copy the key, since removing the entry erases it from lru_
+        auto key = this->lru_.back();
+        this->removeLocked(key);
+    }
+}
+
+void NetworkCache::updateDebugCountsLocked() const
+{
+    DebugCount::set("http cache bytes", this->totalBytes_);
+    DebugCount::set("http cache entries",
+                    static_cast<int64_t>(this->entries_.size()));
+}
+
+void NetworkCache::deleteUnusedBlobs()
+{
+    std::vector<QByteArray> blobs;
+    {
+        std::lock_guard guard(this->mutex_);
+        blobs.swap(this->unusedBlobs_);
+        // A blob might have been stored again after it was released
+        std::erase_if(blobs, [this](const auto &blob) {
+            return this->blobRefs_.contains(blob);
+        });
+    }
+
+    std::vector<QByteArray> failed;
+    for (auto &blob : blobs)
+    {
+        // Mapped files can't be deleted on Windows, try again later
+        auto path = this->blobPath(blob);
+        if (!QFile::remove(path) && QFile::exists(path))
+        {
+            failed.push_back(std::move(blob));
+        }
+    }
+
+    if (!failed.empty())
+    {
+        std::lock_guard guard(this->mutex_);
+        this->unusedBlobs_.insert(this->unusedBlobs_.end(),
+                                  std::make_move_iterator(failed.begin()),
+                                  std::make_move_iterator(failed.end()));
+    }
+}
+
+void NetworkCache::deleteOrphanedBlobs()
+{
+    static const QRegularExpression shardName("^[0-9a-f]{2}$");
+
+    size_t deletedCount = 0;
+    // Files next to the index (e.g. left behind by an interrupted save)
+    for (const auto &info : QDir(this->directory_).entryInfoList(QDir::Files))
+    {
+        if (info.fileName() != "index" && QFile::remove(info.filePath()))
+        {
+            deletedCount++;
+        }
+    }
+
+    auto shards = QDir(this->directory_)
+                      .entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const auto &shard : shards)
+    {
+        if (!shardName.match(shard.fileName()).hasMatch())
+        {
+            continue;
+        }
+
+        auto files = QDir(shard.filePath()).entryInfoList(QDir::Files);
+        for (const auto &info : files)
+        {
+            bool indexed = false;
+            {
+                std::lock_guard guard(this->mutex_);
+                indexed = this->blobRefs_.contains(info.fileName().toLatin1());
+            }
+            if (!indexed && QFile::remove(info.filePath()))
+            {
+                deletedCount++;
+            }
+        }
+    }
+
+    if (deletedCount > 0)
+    {
+        qCDebug(chatterinoCache)
+            << "Deleted" << deletedCount << "files that weren't indexed";
+    }
+}
+
+}  // namespace chatterino
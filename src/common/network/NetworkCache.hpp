@@ -0,0 +1,184 @@
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QThreadPool>
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+/// NetworkCache stores the responses of cached requests
+/// (NetworkRequest::cache) on disk.
+///
+/// Bodies are content-addressed: every distinct body is stored once, named by
+/// its SHA-256 in one of 256 shard directories (e.g. `ab/abcdef...`). An index
+/// maps the hash of a request (NetworkData::getHash) to its body, to the
+/// validators the server sent (ETag and Last-Modified) and to the time it was
+/// stored. The index is kept in memory and saved to `index` in the cache's
+/// directory, so starting up doesn't have to look at every file.
+///
+/// Bodies that aren't in the index when it's loaded (the app didn't save it
+/// before exiting) and other unknown files in the directory are deleted.
+///
+/// Using an entry only moves it in memory. The new order is saved with the
+/// next change to the index, or when the cache is flushed.
+///
+/// Once the bodies take up more than the budget, the least recently used
+/// entries are evicted. Entries older than MAX_AGE have to be revalidated
+/// with the server before they're used again.
+///
+/// Bodies are written on a background thread. This class is thread safe.
+class NetworkCache
+{
+public:
+    static constexpr std::chrono::days MAX_AGE{14};
+
+    struct Entry {
+        /// SHA-256 of the body
+        QByteArray blob;
+        qint64 size = 0;
+        /// When the body was stored or last revalidated (ms since epoch)
+        qint64 storedAt = 0;
+        QByteArray etag;
+        QByteArray lastModified;
+
+        bool isStale(qint64 now) const;
+        bool canRevalidate() const;
+    };
+
+    /// A body mapped into memory. Bodies are never modified once they're
+    /// written, so the mapping stays valid even if the entry is evicted.
+    class Mapping
+    {
+    public:
+        explicit Mapping(const QString &path);
+        ~Mapping();
+
+        Mapping(const Mapping &) = delete;
+        Mapping(Mapping &&) = delete;
+        Mapping &operator=(const Mapping &) = delete;
+        Mapping &operator=(Mapping &&) = delete;
+
+        bool isValid() const;
+
+        /// Returns the mapped bytes without copying them. The returned array
+        /// must not outlive this mapping.
+        QByteArray data() const;
+
+    private:
+        QFile file_;
+        uchar *data_ = nullptr;
+        qint64 size_ = 0;
+    };
+
+    NetworkCache(QString directory, qint64 budget);
+    ~NetworkCache();
+
+    NetworkCache(const NetworkCache &) = delete;
+    NetworkCache(NetworkCache &&) = delete;
+    NetworkCache &operator=(const NetworkCache &) = delete;
+    NetworkCache &operator=(NetworkCache &&) = delete;
+
+    /// Returns the cache in the current cache directory (see
+    /// Paths::cacheDirectory) with the budget from the settings
+    static std::shared_ptr<NetworkCache> current();
+    /// Saves the index of the current cache (at shutdown)
+    static void shutdown();
+
+    const QString &directory() const;
+
+    /// Returns the entry for the request with the hash `key` and marks it as
+    /// recently used
+    std::optional<Entry> find(const QString &key);
+
+    /// Reads the body of `entry`. If it's missing, the entry is removed.
+    std::optional<QByteArray> read(const QString &key, const Entry &entry);
+
+    /// Maps the body of `entry` into memory instead of reading it. If it's
+    /// missing, the entry is removed and nullptr is returned.
+    std::shared_ptr<const Mapping> map(const QString &key, const Entry &entry);
+
+    /// Stores `body` as the response to `key` (in the background)
+    void store(const QString &key, QByteArray body, QByteArray etag,
+               QByteArray lastModified);
+
+    /// Marks the entry for `key` as fresh after the server confirmed it
+    void markRevalidated(const QString &key);
+
+    void setBudget(qint64 budget);
+    qint64 budget() const;
+    /// Size of all bodies
+    qint64 totalBytes() const;
+    size_t entryCount() const;
+
+    /// Removes all entries and their bodies
+    void clear();
+
+    /// Deletes the responses cached by older versions directly in
+    /// `directory` (in the background)
+    void removeLegacyFiles(const QString &directory);
+
+    /// Waits for pending writes and saves the index
+    void flush();
+
+private:
+    struct Node {
+        Entry entry;
+        std::list<QByteArray>::iterator lru;
+    };
+
+    QString blobPath(const QByteArray &blob) const;
+
+    /// Removes the entry for `key` if its body is missing
+    void removeMissing(const QString &key, const Entry &entry);
+
+    void loadIndex();
+    /// Saves the index if entries changed, or if they were used and
+    /// `includeOrder` is set
+    void saveIndex(bool includeOrder = false);
+
+    void insertLocked(const QByteArray &key, Entry entry, bool mostRecent);
+    void removeLocked(const QByteArray &key);
+    void evictLocked();
+    void updateDebugCountsLocked() const;
+
+    /// Deletes the bodies that were released (on the IO thread)
+    void deleteUnusedBlobs();
+    /// Deletes the bodies that aren't in the index, e.g. because they were
+    /// stored after the index was last saved, and unknown files (on the IO
+    /// thread)
+    void deleteOrphanedBlobs();
+
+    const QString directory_;
+
+    mutable std::mutex mutex_;
+    qint64 budget_;
+    qint64 totalBytes_ = 0;
+    std::unordered_map<QByteArray, Node> entries_;
+    /// Keys of the entries, most recently used first
+    std::list<QByteArray> lru_;
+    /// Number of entries using each body
+    std::unordered_map<QByteArray, size_t> blobRefs_;
+    std::vector<QByteArray> unusedBlobs_;
+    /// Entries were added, removed or revalidated since the index was saved
+    bool dirty_ = false;
+    /// Entries were used since the index was saved
+    bool reordered_ = false;
+    std::chrono::steady_clock::time_point lastSave_;
+
+    /// Serializes saving the index
+    std::mutex saveMutex_;
+
+    /// Writes and deletes bodies (a single thread)
+    QThreadPool ioPool_;
+};
+
+}  // namespace chatterino
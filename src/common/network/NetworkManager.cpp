@@ -1,5 +1,8 @@
 #include "common/network/NetworkManager.hpp"
 
+#include "common/network/NetworkCache.hpp"
+#include "common/websockets/IoRuntime.hpp"
+
 #include <QNetworkAccessManager>
 
 namespace chatterino {
@@ -39,6 +42,9 @@ void NetworkManager::deinit()
 
     NetworkManager::workerThread->deleteLater();
     NetworkManager::workerThread = nullptr;
+
+    NetworkCache::shutdown();
+    IoRuntime::shutdown();
 }
 
 }  // namespace chatterino
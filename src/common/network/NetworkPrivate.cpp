@@ -1,11 +1,11 @@
 #include "common/network/NetworkPrivate.hpp"
 
 #include "Application.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/network/NetworkTask.hpp"
 #include "common/QLogging.hpp"
-#include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
 #include "util/PostToThread.hpp"
@@ -13,8 +13,8 @@
 
 #include <magic_enum/magic_enum.hpp>
 #include <QCryptographicHash>
+#include <QDateTime>
 #include <QElapsedTimer>
-#include <QFile>
 #include <QNetworkReply>
 #include <QtConcurrent>
 
@@ -59,23 +59,61 @@ void loadUncached(std::shared_ptr<NetworkData> &&data)
 
 void loadCached(std::shared_ptr<NetworkData> &&data)
 {
-    QFile cachedFile(getApp()->getPaths().cacheDirectory() + "/" +
-                     data->getHash());
+    auto key = data->getHash();
+    auto cache = NetworkCache::current();
+    auto entry = cache->find(key);
 
-    if (!cachedFile.exists() || !cachedFile.open(QIODevice::ReadOnly))
+    if (entry && entry->isStale(QDateTime::currentMSecsSinceEpoch()))
     {
+        if (entry->canRevalidate())
+        {
+            // Ask the server whether our copy is still up to date
+            if (!entry->etag.isEmpty())
+            {
+                data->request.setRawHeader("If-None-Match", entry->etag);
+            }
+            if (!entry->lastModified.isEmpty())
+            {
+                data->request.setRawHeader("If-Modified-Since",
+                                           entry->lastModified);
+            }
+            data->revalidatedEntry = std::move(entry);
+            loadUncached(std::move(data));
+            return;
+        }
+        entry.reset();
+    }
+
+    std::optional<NetworkResult> result;
+    if (entry && data->mapCached)
+    {
+        if (auto mapping = cache->map(key, *entry))
+        {
+            auto bytes = mapping->data();
+            result.emplace(NetworkResult::NetworkError::NoError, QVariant(200),
+                           std::move(bytes), std::move(mapping));
+        }
+    }
+    else if (entry)
+    {
+        if (auto bytes = cache->read(key, *entry))
+        {
+            result.emplace(NetworkResult::NetworkError::NoError, QVariant(200),
+                           std::move(*bytes));
+        }
+    }
+    if (!result)
+    {
+        DebugCount::increase("http cache misses");
         loadUncached(std::move(data));
         return;
     }
 
-    // XXX: check if bytes is empty?
-    QByteArray bytes = cachedFile.readAll();
-
+    DebugCount::increase("http cache hits");
     qCDebug(chatterinoHTTP).noquote() << data->typeString() << "[CACHED] 200"
                                       << data->request.url().toString();
 
-    data->emitSuccess(
-        {NetworkResult::NetworkError::NoError, QVariant(200), bytes});
+    data->emitSuccess(std::move(*result));
     data->emitFinally();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/Common.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkCommon.hpp"
 
 #include <QHttpMultiPart>
@@ -39,6 +40,12 @@ public:
     bool hasCaller{};
     QPointer<QObject> caller;
     bool cache{};
+    /// The stale cache entry this request is revalidating (see
+    /// NetworkCache::Entry::canRevalidate)
+    std::optional<NetworkCache::Entry> revalidatedEntry;
+    /// Cached bodies are mapped instead of read (see
+    /// NetworkRequest::cacheMapped)
+    bool mapCached{};
     bool executeConcurrently{};
 
     NetworkSuccessCallback onSuccess;
@@ -164,6 +164,13 @@ NetworkRequest NetworkRequest::cache() &&
     return std::move(*this);
 }
 
+NetworkRequest NetworkRequest::cacheMapped() &&
+{
+    this->data->cache = true;
+    this->data->mapCached = true;
+    return std::move(*this);
+}
+
 void NetworkRequest::execute()
 {
     this->executed_ = true;
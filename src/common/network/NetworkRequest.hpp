@@ -49,6 +49,11 @@ public:
 
     NetworkRequest payload(const QByteArray &payload) &&;
     NetworkRequest cache() &&;
+    /// Like cache(), but cached bodies are mapped into memory instead of
+    /// being read. The data of a cached result is only valid while the
+    /// result exists, so callers must not keep it (or copies of the
+    /// QByteArray) around.
+    NetworkRequest cacheMapped() &&;
     /// NetworkRequest makes sure that the `caller` object still exists when the
     /// callbacks are executed. Cannot be used with concurrent() since we can't
     /// make sure that the object doesn't get deleted while the callback is
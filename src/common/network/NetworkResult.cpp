@@ -20,6 +20,13 @@ NetworkResult::NetworkResult(NetworkError error, const QVariant &httpStatusCode,
     }
 }
 
+NetworkResult::NetworkResult(NetworkError error, const QVariant &httpStatusCode,
+                             QByteArray data, std::shared_ptr<const void> owner)
+    : NetworkResult(error, httpStatusCode, std::move(data))
+{
+    this->owner_ = std::move(owner);
+}
+
 QJsonObject NetworkResult::parseJson() const
 {
     QJsonDocument jsonDoc(QJsonDocument::fromJson(this->data_));
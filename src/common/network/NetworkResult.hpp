@@ -5,6 +5,7 @@
 #include <QNetworkReply>
 #include <rapidjson/document.h>
 
+#include <memory>
 #include <optional>
 
 namespace chatterino {
@@ -16,6 +17,10 @@ public:
 
     NetworkResult(NetworkError error, const QVariant &httpStatusCode,
                   QByteArray data);
+    /// Creates a result whose data is owned by `owner` (e.g. a cached body
+    /// mapped into memory, see NetworkRequest::cacheMapped)
+    NetworkResult(NetworkError error, const QVariant &httpStatusCode,
+                  QByteArray data, std::shared_ptr<const void> owner);
 
     /// Parses the result as json and returns the root as an object.
     /// Returns empty object if parsing failed.
@@ -32,6 +37,8 @@ public:
 
     /// Parses the result as json and returns the document.
     rapidjson::Document parseRapidJson() const;
+    /// The body of the reply. If the result has an owner, the data is only
+    /// valid as long as the result or a copy of it exists.
     const QByteArray &getData() const;
 
     /// The error code of the reply.
@@ -53,6 +60,7 @@ public:
 
 private:
     QByteArray data_;
+    std::shared_ptr<const void> owner_;
 
     NetworkError error_;
     std::optional<int> status_;
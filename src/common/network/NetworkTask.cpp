@@ -1,17 +1,14 @@
 #include "common/network/NetworkTask.hpp"
 
-#include "Application.hpp"
+#include "common/network/NetworkCache.hpp"
 #include "common/network/NetworkManager.hpp"
 #include "common/network/NetworkPrivate.hpp"
 #include "common/network/NetworkResult.hpp"
 #include "common/QLogging.hpp"
-#include "singletons/Paths.hpp"
 #include "util/AbandonObject.hpp"
 #include "util/DebugCount.hpp"
 
-#include <QFile>
 #include <QNetworkReply>
-#include <QtConcurrent>
 
 namespace chatterino::network::detail {
 
@@ -140,15 +137,44 @@ void NetworkTask::logReply()
 
 void NetworkTask::writeToCache(const QByteArray &bytes) const
 {
-    std::ignore = QtConcurrent::run([data = this->data_, bytes] {
-        QFile cachedFile(getApp()->getPaths().cacheDirectory() + "/" +
-                         data->getHash());
+    NetworkCache::current()->store(this->data_->getHash(), bytes,
+                                   this->reply_->rawHeader("ETag"),
+                                   this->reply_->rawHeader("Last-Modified"));
+}
+
+bool NetworkTask::finishRevalidation()
+{
+    auto cache = NetworkCache::current();
+    auto key = this->data_->getHash();
+    const auto &entry = *this->data_->revalidatedEntry;
 
-        if (cachedFile.open(QIODevice::WriteOnly))
+    std::optional<NetworkResult> result;
+    if (this->data_->mapCached)
+    {
+        if (auto mapping = cache->map(key, entry))
         {
-            cachedFile.write(bytes);
+            auto bytes = mapping->data();
+            result.emplace(NetworkResult::NetworkError::NoError, QVariant(200),
+                           std::move(bytes), std::move(mapping));
         }
-    });
+    }
+    else if (auto bytes = cache->read(key, entry))
+    {
+        result.emplace(NetworkResult::NetworkError::NoError, QVariant(200),
+                       std::move(*bytes));
+    }
+
+    this->logReply();
+    if (!result)
+    {
+        return false;
+    }
+
+    cache->markRevalidated(key);
+    DebugCount::increase("http cache revalidations");
+    this->data_->emitSuccess(std::move(*result));
+    this->data_->emitFinally();
+    return true;
 }
 
 void NetworkTask::timeout()
@@ -198,6 +224,18 @@ void NetworkTask::finished()
         return;
     }
 
+    if (status.toInt() == 304 && this->data_->revalidatedEntry)
+    {
+        if (!this->finishRevalidation())
+        {
+            // The cached body vanished since the request was sent
+            this->data_->emitError(
+                {QNetworkReply::UnknownContentError, status, {}});
+            this->data_->emitFinally();
+        }
+        return;
+    }
+
     QByteArray bytes = reply->readAll();
 
     if (this->data_->cache)
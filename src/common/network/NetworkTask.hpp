@@ -37,6 +37,9 @@ private:
 
     void logReply();
     void writeToCache(const QByteArray &bytes) const;
+    /// Answers a revalidated request from the cache after the server replied
+    /// 304 Not Modified. Returns false if the cached body is gone.
+    bool finishRevalidation();
 
     std::shared_ptr<NetworkData> data_;
     QNetworkReply *reply_{};  // parent: default (accessManager)
@@ -0,0 +1,317 @@
+#include "common/websockets/IoRuntime.hpp"
+
+#include "Application.hpp"
+#include "common/Args.hpp"
+#include "common/QLogging.hpp"
+#include "singletons/Settings.hpp"
+#include "util/OnceFlag.hpp"
+#include "util/RenameThread.hpp"
+
+#include <boost/certify/https_verification.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+constexpr auto LAG_PROBE_INTERVAL = 1s;
+constexpr auto CLOSE_TIMEOUT = 1s;
+
+std::mutex currentMutex;
+std::shared_ptr<IoRuntime> currentRuntime;
+
+void setTlsOptions(boost::asio::ssl::context &ctx)
+{
+    boost::system::error_code ec;
+    auto _ = ctx.set_options(
+        boost::asio::ssl::context::no_tlsv1 |
+            boost::asio::ssl::context::no_tlsv1_1 |
+            boost::asio::ssl::context::default_workarounds |
+            boost::asio::ssl::context::single_dh_use,
+        ec);
+    if (ec)
+    {
+        qCWarning(chatterinoWebsocket) << "Failed to set SSL context options"
+                                       << QString::fromStdString(ec.message());
+    }
+}
+
+bool shouldVerifyPeers()
+{
+    auto *app = tryGetApp();
+    if (!app)
+    {
+        return true;
+    }
+
+#ifdef CHATTERINO_WITH_TESTS
+    if (app->isTest())
+    {
+        return false;
+    }
+#endif
+#ifndef NDEBUG
+    if (app->getArgs().useLocalEventsub)
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+// MARK: IoClientState
+
+namespace detail {
+
+IoClientState::IoClientState(QString queueName_)
+    : queueName(std::move(queueName_))
+{
+}
+
+void IoClientState::dropPending()
+{
+    std::unordered_map<const void *, std::shared_ptr<void>> dropped;
+    {
+        std::lock_guard guard(this->mutex);
+        dropped.swap(this->pending);
+    }
+    DebugCount::decrease(this->queueName,
+                         static_cast<int64_t>(dropped.size()));
+    // The functions are destroyed here, outside of the lock
+}
+
+}  // namespace detail
+
+// MARK: IoClient
+
+IoClient::IoClient(std::shared_ptr<IoRuntime> runtime,
+                   std::shared_ptr<detail::IoClientState> state)
+    : runtime_(std::move(runtime))
+    , strand_(boost::asio::make_strand(this->runtime_->context()))
+    , state_(std::move(state))
+{
+}
+
+IoRuntime &IoClient::runtime() const
+{
+    return *this->runtime_;
+}
+
+boost::asio::io_context &IoClient::context() const
+{
+    return this->runtime_->context();
+}
+
+const IoClient::Strand &IoClient::strand() const
+{
+    return this->strand_;
+}
+
+void IoClient::close()
+{
+    assert(!this->strand_.running_in_this_thread());
+    if (this->state_->closed || this->context().stopped())
+    {
+        this->state_->closed = true;
+        return;
+    }
+
+    // Anything that's running on the strand will be done once this runs
+    auto closedFlag = std::make_shared<OnceFlag>();
+    boost::asio::post(this->strand_, [state{this->state_}, closedFlag] {
+        state->closed = true;
+        closedFlag->set();
+    });
+    if (!closedFlag->waitFor(CLOSE_TIMEOUT))
+    {
+        qCWarning(chatterinoWebsocket)
+            << "Timed out waiting for" << this->state_->queueName
+            << "to close";
+    }
+    this->state_->closed = true;
+}
+
+bool IoClient::isClosed() const
+{
+    return this->state_->closed;
+}
+
+// MARK: IoRuntime
+
+IoRuntime::IoRuntime(size_t threadCount)
+    : work_(this->context_.get_executor())
+    , lagTimer_(this->context_)
+{
+    threadCount = std::max<size_t>(threadCount, 1);
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        auto &thread = this->threads_.emplace_back([this] {
+            this->context_.run();
+        });
+        renameThread(thread, "IoRuntime");
+    }
+
+    this->scheduleLagProbe();
+}
+
+IoRuntime::~IoRuntime()
+{
+    this->stop();
+}
+
+IoRuntime &IoRuntime::instance()
+{
+    std::lock_guard guard(currentMutex);
+    if (!currentRuntime)
+    {
+        auto threadCount = getSettings()->ioThreadCount.getValue();
+        currentRuntime = std::make_shared<IoRuntime>(
+            static_cast<size_t>(std::clamp(threadCount, 1, 8)));
+    }
+    return *currentRuntime;
+}
+
+void IoRuntime::shutdown()
+{
+    std::shared_ptr<IoRuntime> runtime;
+    {
+        std::lock_guard guard(currentMutex);
+        runtime = std::move(currentRuntime);
+    }
+    if (runtime)
+    {
+        // Clients might still reference the runtime if they were leaked
+        runtime->stop();
+    }
+}
+
+std::shared_ptr<IoClient> IoRuntime::registerClient(const QString &name)
+{
+    auto state = std::make_shared<detail::IoClientState>(
+        QStringLiteral("io queue (%1)").arg(name));
+    {
+        std::lock_guard guard(this->clientsMutex_);
+        std::erase_if(this->clients_, [](const auto &client) {
+            return client.expired();
+        });
+        this->clients_.emplace_back(state);
+    }
+    return std::make_shared<IoClient>(this->shared_from_this(),
+                                      std::move(state));
+}
+
+boost::asio::io_context &IoRuntime::context()
+{
+    return this->context_;
+}
+
+boost::asio::ssl::context &IoRuntime::tls()
+{
+    std::lock_guard guard(this->tlsMutex_);
+    if (this->tls_)
+    {
+        return *this->tls_;
+    }
+
+    auto ctx = std::make_unique<boost::asio::ssl::context>(
+        boost::asio::ssl::context::tls_client);
+    setTlsOptions(*ctx);
+
+    if (shouldVerifyPeers())
+    {
+        ctx->set_verify_mode(boost::asio::ssl::verify_peer |
+                             boost::asio::ssl::verify_fail_if_no_peer_cert);
+        ctx->set_default_verify_paths();
+
+        boost::certify::enable_native_https_server_verification(*ctx);
+    }
+
+    this->tls_ = std::move(ctx);
+    return *this->tls_;
+}
+
+std::shared_ptr<boost::asio::ssl::context> IoRuntime::unverifiedTls()
+{
+    std::lock_guard guard(this->tlsMutex_);
+    if (!this->unverifiedTls_)
+    {
+        this->unverifiedTls_ = std::make_shared<boost::asio::ssl::context>(
+            boost::asio::ssl::context::tls_client);
+        setTlsOptions(*this->unverifiedTls_);
+    }
+    return this->unverifiedTls_;
+}
+
+void IoRuntime::retain(std::shared_ptr<void> object)
+{
+    std::lock_guard guard(this->retainedMutex_);
+    this->retained_.emplace_back(std::move(object));
+}
+
+void IoRuntime::stop()
+{
+    if (this->threads_.empty())
+    {
+        return;
+    }
+
+    this->work_.reset();
+    this->context_.stop();
+    for (auto &thread : this->threads_)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    this->threads_.clear();
+
+    // The pending handlers stay in the context until it's destroyed. Their
+    // functions might own a client (e.g. through a connection), which would
+    // keep this runtime alive.
+    std::vector<std::shared_ptr<detail::IoClientState>> clients;
+    {
+        std::lock_guard guard(this->clientsMutex_);
+        for (const auto &weak : this->clients_)
+        {
+            if (auto client = weak.lock())
+            {
+                clients.emplace_back(std::move(client));
+            }
+        }
+    }
+    for (const auto &client : clients)
+    {
+        client->closed = true;
+        client->dropPending();
+    }
+}
+
+void IoRuntime::scheduleLagProbe()
+{
+    auto expected = std::chrono::steady_clock::now() + LAG_PROBE_INTERVAL;
+    this->lagTimer_.expires_at(expected);
+    this->lagTimer_.async_wait([this, expected](const auto &ec) {
+        if (ec)
+        {
+            return;
+        }
+
+        // The time the timer fired late is the time handlers had to wait for
+        // a free thread
+        auto lag = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - expected);
+        DebugCount::set("io runtime lag (ms)", lag.count());
+        this->scheduleLagProbe();
+    });
+}
+
+}  // namespace chatterino
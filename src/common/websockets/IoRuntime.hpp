@@ -0,0 +1,216 @@
+#pragma once
+
+#include "util/DebugCount.hpp"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/ssl/context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <QString>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+class IoRuntime;
+
+namespace detail {
+
+/// State shared by an IoClient and the handlers posted through it
+///
+/// Handlers only hold this (and not the client), so pending handlers don't
+/// keep the client and its runtime alive.
+struct IoClientState {
+    explicit IoClientState(QString queueName_);
+
+    /// Stores `fn` until its handler runs or the runtime stops
+    template <typename Fn>
+    std::weak_ptr<std::decay_t<Fn>> track(Fn &&fn)
+    {
+        auto owned = std::make_shared<std::decay_t<Fn>>(std::forward<Fn>(fn));
+        std::lock_guard guard(this->mutex);
+        this->pending.emplace(owned.get(), owned);
+        return owned;
+    }
+
+    /// Returns the function tracked as `weak` unless it was dropped
+    template <typename T>
+    std::shared_ptr<T> take(const std::weak_ptr<T> &weak)
+    {
+        auto owned = weak.lock();
+        if (owned)
+        {
+            std::lock_guard guard(this->mutex);
+            this->pending.erase(owned.get());
+        }
+        return owned;
+    }
+
+    /// Destroys the functions of the handlers that didn't run yet
+    void dropPending();
+
+    const QString queueName;
+    std::atomic<bool> closed = false;
+
+    std::mutex mutex;
+    std::unordered_map<const void *, std::shared_ptr<void>> pending;
+};
+
+}  // namespace detail
+
+/// A user of the IoRuntime (e.g. a websocket pool).
+///
+/// Handlers posted through a client run on its strand, so they never run
+/// concurrently with each other. Once the client is closed, handlers posted to
+/// its strand are dropped. Once the runtime is stopped, the functions of all
+/// handlers that didn't run are destroyed, so they can't keep their client
+/// (and the runtime) alive.
+class IoClient
+{
+public:
+    using Strand = boost::asio::strand<boost::asio::io_context::executor_type>;
+
+    IoClient(std::shared_ptr<IoRuntime> runtime,
+             std::shared_ptr<detail::IoClientState> state);
+
+    IoClient(const IoClient &) = delete;
+    IoClient(IoClient &&) = delete;
+    IoClient &operator=(const IoClient &) = delete;
+    IoClient &operator=(IoClient &&) = delete;
+
+    IoRuntime &runtime() const;
+    boost::asio::io_context &context() const;
+    const Strand &strand() const;
+
+    /// Runs `fn` on the strand of this client unless it's closed
+    template <typename Fn>
+    void post(Fn &&fn)
+    {
+        DebugCount::increase(this->state_->queueName);
+        boost::asio::post(
+            this->strand_,
+            [state{this->state_},
+             weak{this->state_->track(std::forward<Fn>(fn))}] {
+                DebugCount::decrease(state->queueName);
+                auto fn = state->take(weak);
+                if (fn && !state->closed)
+                {
+                    (*fn)();
+                }
+            });
+    }
+
+    /// Runs `fn` on `executor` (e.g. the strand of a connection of this
+    /// client), counting it towards the queue of this client
+    template <typename Fn>
+    void post(const boost::asio::any_io_executor &executor, Fn &&fn)
+    {
+        DebugCount::increase(this->state_->queueName);
+        boost::asio::post(
+            executor, [state{this->state_},
+                       weak{this->state_->track(std::forward<Fn>(fn))}] {
+                DebugCount::decrease(state->queueName);
+                if (auto fn = state->take(weak))
+                {
+                    (*fn)();
+                }
+            });
+    }
+
+    /// Closes this client
+    ///
+    /// Waits for the handler currently running on the strand (if any) to
+    /// finish. Handlers posted to the strand afterwards won't run.
+    /// Must not be called from the strand.
+    void close();
+
+    bool isClosed() const;
+
+private:
+    std::shared_ptr<IoRuntime> runtime_;
+    Strand strand_;
+    std::shared_ptr<detail::IoClientState> state_;
+};
+
+/// IoRuntime runs the event loop shared by all websocket clients.
+///
+/// The number of threads running the loop is set by the "ioThreadCount"
+/// setting. Each client (see IoClient) and each connection is bound to its own
+/// strand, so their handlers are serialized even if multiple threads are used.
+class IoRuntime : public std::enable_shared_from_this<IoRuntime>
+{
+public:
+    explicit IoRuntime(size_t threadCount);
+    ~IoRuntime();
+
+    IoRuntime(const IoRuntime &) = delete;
+    IoRuntime(IoRuntime &&) = delete;
+    IoRuntime &operator=(const IoRuntime &) = delete;
+    IoRuntime &operator=(IoRuntime &&) = delete;
+
+    /// Returns the runtime of this process, starting it if necessary
+    static IoRuntime &instance();
+
+    /// Stops the runtime of this process (if it was started)
+    ///
+    /// Clients should be closed before this is called.
+    static void shutdown();
+
+    /// Registers a client named `name` (used in the debug counts)
+    std::shared_ptr<IoClient> registerClient(const QString &name);
+
+    boost::asio::io_context &context();
+
+    /// Returns the TLS context to be used for connections
+    ///
+    /// Peers are verified unless this is a test or the local EventSub server
+    /// is used. Throws boost::system::system_error if the context couldn't be
+    /// created.
+    boost::asio::ssl::context &tls();
+
+    /// Returns a TLS context that doesn't verify peers
+    ///
+    /// This is used by the websocketpp clients, which never verified peers.
+    std::shared_ptr<boost::asio::ssl::context> unverifiedTls();
+
+    /// Keeps `object` alive until the runtime is destroyed
+    ///
+    /// This is used for objects that are still referenced by pending handlers
+    /// (e.g. a websocketpp client whose connections didn't close in time).
+    void retain(std::shared_ptr<void> object);
+
+    /// Stops the event loop and joins all threads
+    ///
+    /// The functions of the handlers that didn't run are destroyed.
+    void stop();
+
+private:
+    void scheduleLagProbe();
+
+    std::mutex clientsMutex_;
+    std::vector<std::weak_ptr<detail::IoClientState>> clients_;
+
+    // Destroyed after the context, as its handlers might reference these
+    std::mutex retainedMutex_;
+    std::vector<std::shared_ptr<void>> retained_;
+
+    boost::asio::io_context context_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+        work_;
+    boost::asio::steady_timer lagTimer_;
+    std::vector<std::thread> threads_;
+
+    std::mutex tlsMutex_;
+    std::unique_ptr<boost::asio::ssl::context> tls_;
+    std::shared_ptr<boost::asio::ssl::context> unverifiedTls_;
+};
+
+}  // namespace chatterino
@@ -3,6 +3,7 @@
 #include "common/QLogging.hpp"
 #include "common/websockets/detail/WebSocketConnectionImpl.hpp"
 #include "common/websockets/detail/WebSocketPoolImpl.hpp"
+#include "common/websockets/IoRuntime.hpp"
 
 namespace chatterino {
 
@@ -17,9 +18,9 @@ WebSocketPool::~WebSocketPool()
         }
         else
         {
-            // Note: We can't detatch the IO-thread here but have to leak the
-            // pool, because the IO-thread still references the IO-context which
-            // is stored in the pool (otherwise we'd have a use-after-free).
+            // Note: We have to leak the pool here, because the connections
+            // still running on the IO runtime reference it (otherwise we'd
+            // have a use-after-free).
             qCWarning(chatterinoWebsocket)
                 << "Failed to shutdown within 1s, leaking";
             this->impl.release();  // NOLINT
@@ -56,13 +57,13 @@ WebSocketHandle WebSocketPool::createSocket(
     {
         conn = std::make_shared<ws::detail::TlsWebSocketConnection>(
             std::move(options), this->impl->nextID++, std::move(listener),
-            this->impl.get(), this->impl->ioc, this->impl->ssl);
+            this->impl.get(), this->impl->io, this->impl->io->runtime().tls());
     }
     else if (options.url.scheme() == "ws")
     {
         conn = std::make_shared<ws::detail::TcpWebSocketConnection>(
             std::move(options), this->impl->nextID++, std::move(listener),
-            this->impl.get(), this->impl->ioc);
+            this->impl.get(), this->impl->io);
     }
     else
     {
@@ -75,7 +76,7 @@ WebSocketHandle WebSocketPool::createSocket(
         this->impl->connections.push_back(conn);
     }
 
-    boost::asio::post(this->impl->ioc, [conn] {
+    this->impl->io->post(conn->executor(), [conn] {
         conn->run();
     });
 
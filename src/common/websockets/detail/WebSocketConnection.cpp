@@ -1,20 +1,20 @@
 #include "common/websockets/detail/WebSocketConnection.hpp"
 
 #include "common/QLogging.hpp"
+#include "common/websockets/IoRuntime.hpp"
 #include "WebSocketPoolImpl.hpp"
 
-#include <boost/asio/strand.hpp>
-
 namespace chatterino::ws::detail {
 
 WebSocketConnection::WebSocketConnection(
     WebSocketOptions options, int id,
     std::unique_ptr<WebSocketListener> listener, WebSocketPoolImpl *pool,
-    boost::asio::io_context &ioc)
+    std::shared_ptr<IoClient> io, const boost::asio::any_io_executor &executor)
     : options(std::move(options))
     , listener(std::move(listener))
     , pool(pool)
-    , resolver(boost::asio::make_strand(ioc))
+    , io(std::move(io))
+    , resolver(executor)
     , id(id)
 {
     qCDebug(chatterinoWebsocket) << *this << "Created";
@@ -26,6 +26,12 @@ WebSocketConnection::~WebSocketConnection()
     qCDebug(chatterinoWebsocket) << *this << "Destroyed";
 }
 
+boost::asio::any_io_executor WebSocketConnection::executor()
+{
+    // the resolver is bound to the same strand as the stream
+    return this->resolver.get_executor();
+}
+
 QDebug operator<<(QDebug dbg, const WebSocketConnection &conn)
 {
     QDebugStateSaver state(dbg);
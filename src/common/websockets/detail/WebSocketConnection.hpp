@@ -3,7 +3,7 @@
 #include "common/websockets/WebSocketPool.hpp"
 #include "util/QByteArrayBuffer.hpp"
 
-#include <boost/asio/io_context.hpp>
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <QDebug>
@@ -12,6 +12,12 @@
 #include <memory>
 #include <utility>
 
+namespace chatterino {
+
+class IoClient;
+
+}  // namespace chatterino
+
 namespace chatterino::ws::detail {
 
 class WebSocketPoolImpl;
@@ -24,7 +30,8 @@ class WebSocketConnection
 public:
     WebSocketConnection(WebSocketOptions options, int id,
                         std::unique_ptr<WebSocketListener> listener,
-                        WebSocketPoolImpl *pool, boost::asio::io_context &ioc);
+                        WebSocketPoolImpl *pool, std::shared_ptr<IoClient> io,
+                        const boost::asio::any_io_executor &executor);
     virtual ~WebSocketConnection();
 
     WebSocketConnection(const WebSocketConnection &) = delete;
@@ -34,9 +41,12 @@ public:
 
     /// Start connecting.
     ///
-    /// Must be called from the desired executor.
+    /// Must be called from the executor of this connection.
     virtual void run() = 0;
 
+    /// The executor (strand) this connection runs on.
+    boost::asio::any_io_executor executor();
+
     /// Close this connection gracefully (if possible).
     ///
     /// Can be called from any thread.
@@ -65,6 +75,8 @@ protected:
     std::unique_ptr<WebSocketListener> listener;
     // nullable, used for signalling a disconnect
     WebSocketPoolImpl *pool;
+    // the IO client of the pool, used to post work to this connection
+    const std::shared_ptr<IoClient> io;
 
     boost::asio::ip::tcp::resolver resolver;
 
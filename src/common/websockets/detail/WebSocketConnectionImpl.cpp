@@ -2,6 +2,7 @@
 
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
+#include "common/websockets/IoRuntime.hpp"
 
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core/bind_handler.hpp>
@@ -18,9 +19,9 @@ template <typename Derived, typename Inner>
 WebSocketConnectionHelper<Derived, Inner>::WebSocketConnectionHelper(
     WebSocketOptions options, int id,
     std::unique_ptr<WebSocketListener> listener, WebSocketPoolImpl *pool,
-    asio::io_context &ioc, Stream stream)
+    std::shared_ptr<IoClient> io, Stream stream)
     : WebSocketConnection(std::move(options), id, std::move(listener), pool,
-                          ioc)
+                          std::move(io), stream.get_executor())
     , stream(std::move(stream))
 {
 }
@@ -28,7 +29,8 @@ WebSocketConnectionHelper<Derived, Inner>::WebSocketConnectionHelper(
 template <typename Derived, typename Inner>
 void WebSocketConnectionHelper<Derived, Inner>::post(auto &&fn)
 {
-    asio::post(this->stream.get_executor(), std::forward<decltype(fn)>(fn));
+    this->io->post(this->stream.get_executor(),
+                   std::forward<decltype(fn)>(fn));
 }
 
 template <typename Derived, typename Inner>
@@ -329,9 +331,10 @@ void WebSocketConnectionHelper<Derived, Inner>::fail(
 TlsWebSocketConnection::TlsWebSocketConnection(
     WebSocketOptions options, int id,
     std::unique_ptr<WebSocketListener> listener, WebSocketPoolImpl *pool,
-    asio::io_context &ioc, asio::ssl::context &ssl)
+    const std::shared_ptr<IoClient> &io, asio::ssl::context &ssl)
     : WebSocketConnectionHelper(std::move(options), id, std::move(listener),
-                                pool, ioc, Stream{asio::make_strand(ioc), ssl})
+                                pool, io,
+                                Stream{asio::make_strand(io->context()), ssl})
 {
 }
 
@@ -375,9 +378,10 @@ void TlsWebSocketConnection::afterTcpHandshake()
 TcpWebSocketConnection::TcpWebSocketConnection(
     WebSocketOptions options, int id,
     std::unique_ptr<WebSocketListener> listener, WebSocketPoolImpl *pool,
-    asio::io_context &ioc)
+    const std::shared_ptr<IoClient> &io)
     : WebSocketConnectionHelper(std::move(options), id, std::move(listener),
-                                pool, ioc, Stream{asio::make_strand(ioc)})
+                                pool, io,
+                                Stream{asio::make_strand(io->context())})
 {
 }
 
@@ -53,7 +53,7 @@ private:
     WebSocketConnectionHelper(WebSocketOptions options, int id,
                               std::unique_ptr<WebSocketListener> listener,
                               WebSocketPoolImpl *pool,
-                              boost::asio::io_context &ioc, Stream stream);
+                              std::shared_ptr<IoClient> io, Stream stream);
 
     void onResolve(boost::system::error_code ec,
                    const boost::asio::ip::tcp::resolver::results_type &results);
@@ -80,7 +80,7 @@ public:
     TlsWebSocketConnection(WebSocketOptions options, int id,
                            std::unique_ptr<WebSocketListener> listener,
                            WebSocketPoolImpl *pool,
-                           boost::asio::io_context &ioc,
+                           const std::shared_ptr<IoClient> &io,
                            boost::asio::ssl::context &ssl);
 
 protected:
@@ -103,7 +103,7 @@ public:
     TcpWebSocketConnection(WebSocketOptions options, int id,
                            std::unique_ptr<WebSocketListener> listener,
                            WebSocketPoolImpl *pool,
-                           boost::asio::io_context &ioc);
+                           const std::shared_ptr<IoClient> &io);
 
 protected:
     void afterTcpHandshake();
@@ -2,13 +2,17 @@
 
 #include "util/OnceFlag.hpp"
 
-#include <boost/asio/io_context.hpp>
-#include <boost/asio/ssl/context.hpp>
-
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <mutex>
-#include <thread>
+#include <vector>
+
+namespace chatterino {
+
+class IoClient;
+
+}  // namespace chatterino
 
 namespace chatterino::ws::detail {
 
@@ -33,19 +37,18 @@ public:
     /// this pool should be leaked.
     bool tryShutdown(std::chrono::milliseconds timeout);
 
-    std::unique_ptr<std::thread> ioThread;
-    boost::asio::io_context ioc;
-    boost::asio::ssl::context ssl;
-    boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
-        work;
+    std::shared_ptr<IoClient> io;
 
     std::vector<std::shared_ptr<WebSocketConnection>> connections;
     std::mutex connectionMutex;
 
-    bool closing = false;
+    std::atomic<bool> closing = false;
     int nextID = 1;
 
-    OnceFlag shutdownFlag;
+    // Set once all connections are closed. This is shared with the
+    // connections, as the last one might still set it while the pool is
+    // destroyed.
+    std::shared_ptr<OnceFlag> shutdownFlag = std::make_shared<OnceFlag>();
 };
 
 }  // namespace chatterino::ws::detail
@@ -353,6 +353,8 @@ CommandController::CommandController(const Paths &paths)
 
     this->registerCommand("/usercard", &commands::openUsercard);
 
+    this->registerCommand("/searchlogs", &commands::searchLogs);
+
     this->registerCommand("/requests", &commands::requests);
 
     this->registerCommand("/lowtrust", &commands::lowtrust);
@@ -9,11 +9,14 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "singletons/helper/CompressedLog.hpp"
+#include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Clipboard.hpp"
 #include "util/FormatTime.hpp"
 #include "util/IncognitoBrowser.hpp"
+#include "util/PostToThread.hpp"
 #include "util/StreamLink.hpp"
 #include "util/Twitch.hpp"
 #include "widgets/dialogs/UserInfoPopup.hpp"
@@ -25,11 +28,21 @@
 
 #include <QCommandLineParser>
 #include <QDesktopServices>
+#include <QDir>
 #include <QString>
+#include <QtConcurrent>
 #include <QUrl>
 
+#include <algorithm>
 #include <optional>
 
+namespace {
+
+/// Number of messages /searchlogs shows at most
+constexpr std::size_t MAX_LOG_SEARCH_RESULTS = 50;
+
+}  // namespace
+
 namespace chatterino::commands {
 
 QString follow(const CommandContext &ctx)
@@ -725,4 +738,115 @@ QString openUsercard(const CommandContext &ctx)
     return "";
 }
 
+QString searchLogs(const CommandContext &ctx)
+{
+    if (ctx.channel == nullptr)
+    {
+        return "";
+    }
+
+    if (ctx.twitchChannel == nullptr)
+    {
+        ctx.channel->addSystemMessage(
+            "The /searchlogs command only works in Twitch Channels.");
+        return "";
+    }
+
+    const auto usage = QStringLiteral(
+        "Usage: /searchlogs <user> [days] - Searches the compressed logs of "
+        "this channel for messages by <user> in the last [days] days "
+        "(default: 7).");
+    if (ctx.words.size() < 2)
+    {
+        ctx.channel->addSystemMessage(usage);
+        return "";
+    }
+
+    QString userName = ctx.words[1];
+    stripUserName(userName);
+
+    int days = 7;
+    if (ctx.words.size() > 2)
+    {
+        bool ok = false;
+        days = ctx.words[2].toInt(&ok);
+        if (!ok || days <= 0)
+        {
+            ctx.channel->addSystemMessage(usage);
+            return "";
+        }
+    }
+
+    QString logPath = getSettings()->logPath;
+    if (logPath.isEmpty())
+    {
+        logPath = getApp()->getPaths().messageLogDirectory;
+    }
+    auto channelName = ctx.channel->getName();
+    auto directory = logPath + QDir::separator() + "Twitch" +
+                     QDir::separator() + "Channels" + QDir::separator() +
+                     channelName;
+    CompressedLogQuery query{
+        .user = userName.toLower(),
+        .from = QDateTime::currentDateTime().addDays(-days),
+    };
+
+    // Searching might decompress many blocks, don't block the GUI thread
+    std::ignore = QtConcurrent::run([weak = std::weak_ptr(ctx.channel),
+                                     directory, channelName, query, userName,
+                                     days] {
+        auto entries = CompressedLogReader::searchChannel(directory,
+                                                          channelName, query);
+        // Stream logs contain the same messages as the daily logs. Messages
+        // sent at the same time aren't necessarily next to each other, so
+        // sort them by their text as well.
+        std::ranges::sort(entries, [](const auto &a, const auto &b) {
+            if (a.timestamp != b.timestamp)
+            {
+                return a.timestamp < b.timestamp;
+            }
+            return a.text < b.text;
+        });
+        auto duplicates = std::ranges::unique(
+            entries, [](const auto &a, const auto &b) {
+                return a.timestamp == b.timestamp && a.text == b.text;
+            });
+        entries.erase(duplicates.begin(), duplicates.end());
+
+        runInGuiThread([weak, entries = std::move(entries), userName, days] {
+            auto channel = weak.lock();
+            if (!channel)
+            {
+                return;
+            }
+
+            if (entries.empty())
+            {
+                channel->addSystemMessage(
+                    QString("No messages by %1 in the compressed logs of the "
+                            "last %2 days.")
+                        .arg(userName)
+                        .arg(days));
+                return;
+            }
+
+            auto shown = std::min(entries.size(), MAX_LOG_SEARCH_RESULTS);
+            channel->addSystemMessage(
+                QString("Found %1 messages by %2 in the last %3 days%4:")
+                    .arg(entries.size())
+                    .arg(userName)
+                    .arg(days)
+                    .arg(shown < entries.size()
+                             ? QString(", showing the last %1").arg(shown)
+                             : QString()));
+            for (auto i = entries.size() - shown; i < entries.size(); i++)
+            {
+                channel->addSystemMessage(entries[i].text);
+            }
+        });
+    });
+
+    return "";
+}
+
 }  // namespace chatterino::commands
@@ -29,5 +29,6 @@ QString injectStreamUpdateNoStream(const CommandContext &ctx);
 QString copyToClipboard(const CommandContext &ctx);
 QString unstableSetUserClientSideColor(const CommandContext &ctx);
 QString openUsercard(const CommandContext &ctx);
+QString searchLogs(const CommandContext &ctx);
 
 }  // namespace chatterino::commands
@@ -0,0 +1,226 @@
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
+#include "providers/emoji/Emojis.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+using namespace chatterino::completion;
+
+constexpr qsizetype GRAM_LENGTH = 3;
+
+uint64_t trigramAt(QStringView text, qsizetype pos)
+{
+    return (uint64_t{text[pos].unicode()} << 32) |
+           (uint64_t{text[pos + 1].unicode()} << 16) |
+           uint64_t{text[pos + 2].unicode()};
+}
+
+struct CachedIndex {
+    /// Makes sure the key isn't the address of a newer map
+    std::weak_ptr<const EmoteMap> map;
+    std::shared_ptr<const EmoteIndex> index;
+};
+
+struct CachedEmojiIndex {
+    std::weak_ptr<EmojiData> first;
+    size_t size = 0;
+    std::shared_ptr<const EmoteIndex> index;
+};
+
+struct Cache {
+    std::mutex mutex;
+    std::map<std::pair<const EmoteMap *, QString>, CachedIndex> maps;
+    CachedEmojiIndex emojis;
+};
+
+Cache &indexCache()
+{
+    // Never destroyed, as the indexes hold emotes which can't be destroyed
+    // after the application
+    static auto *cache = new Cache;
+    return *cache;
+}
+
+}  // namespace
+
+namespace chatterino::completion {
+
+EmoteIndex::EmoteIndex(std::vector<EmoteItem> items)
+    : items_(std::move(items))
+{
+    this->folded_.reserve(this->items_.size());
+    for (const auto &item : this->items_)
+    {
+        this->folded_.push_back(item.searchName.toCaseFolded());
+    }
+
+    this->byName_.resize(this->items_.size());
+    std::iota(this->byName_.begin(), this->byName_.end(), 0);
+    std::ranges::sort(this->byName_, [this](uint32_t a, uint32_t b) {
+        return this->folded_[a] < this->folded_[b];
+    });
+
+    for (uint32_t i = 0; i < this->folded_.size(); i++)
+    {
+        QStringView name = this->folded_[i];
+        for (qsizetype pos = 0; pos + GRAM_LENGTH <= name.size(); pos++)
+        {
+            auto &postings = this->trigrams_[trigramAt(name, pos)];
+            // Names can contain a trigram more than once
+            if (postings.empty() || postings.back() != i)
+            {
+                postings.push_back(i);
+            }
+        }
+    }
+}
+
+std::shared_ptr<const EmoteIndex> EmoteIndex::forMap(
+    const std::shared_ptr<const EmoteMap> &map, const QString &providerName)
+{
+    auto &cache = indexCache();
+    std::lock_guard guard(cache.mutex);
+
+    auto key = std::make_pair(map.get(), providerName);
+    auto it = cache.maps.find(key);
+    if (it != cache.maps.end() && it->second.map.lock() == map)
+    {
+        return it->second.index;
+    }
+
+    // Drop the indexes of maps that were replaced in the meantime
+    std::erase_if(cache.maps, [](const auto &entry) {
+        return entry.second.map.expired();
+    });
+
+    std::vector<EmoteItem> items;
+    items.reserve(map->size());
+    for (const auto &[name, emote] : *map)
+    {
+        items.push_back({.emote = emote,
+                         .searchName = name.string,
+                         .tabCompletionName = name.string,
+                         .displayName = emote->name.string,
+                         .providerName = providerName,
+                         .isEmoji = false});
+    }
+
+    auto index = std::make_shared<const EmoteIndex>(std::move(items));
+    cache.maps[key] = {.map = map, .index = index};
+    return index;
+}
+
+std::shared_ptr<const EmoteIndex> EmoteIndex::forEmojis(
+    const std::vector<EmojiPtr> &emojis)
+{
+    auto &cache = indexCache();
+    std::lock_guard guard(cache.mutex);
+
+    auto first = emojis.empty() ? nullptr : emojis.front();
+    if (cache.emojis.index && cache.emojis.size == emojis.size() &&
+        cache.emojis.first.lock() == first)
+    {
+        return cache.emojis.index;
+    }
+
+    std::vector<EmoteItem> items;
+    for (const auto &emoji : emojis)
+    {
+        for (const auto &shortCode : emoji->shortCodes)
+        {
+            items.push_back(
+                {.emote = emoji->emote,
+                 .searchName = shortCode,
+                 .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
+                 .displayName = shortCode,
+                 .providerName = "Emoji",
+                 .isEmoji = true});
+        }
+    }
+
+    cache.emojis = {
+        .first = first,
+        .size = emojis.size(),
+        .index = std::make_shared<const EmoteIndex>(std::move(items)),
+    };
+    return cache.emojis.index;
+}
+
+const std::vector<EmoteItem> &EmoteIndex::items() const
+{
+    return this->items_;
+}
+
+QStringView EmoteIndex::foldedName(size_t index) const
+{
+    return this->folded_[index];
+}
+
+std::vector<uint32_t> EmoteIndex::find(QStringView foldedQuery,
+                                       bool prefixOnly) const
+{
+    std::vector<uint32_t> found;
+
+    if (prefixOnly)
+    {
+        auto it = std::ranges::lower_bound(
+            this->byName_, foldedQuery, std::less<>{}, [this](uint32_t i) {
+                return QStringView(this->folded_[i]);
+            });
+        for (; it != this->byName_.end() &&
+               this->folded_[*it].startsWith(foldedQuery);
+             it++)
+        {
+            found.push_back(*it);
+        }
+        std::ranges::sort(found);
+        return found;
+    }
+
+    if (foldedQuery.size() < GRAM_LENGTH)
+    {
+        // Short queries match too many items for the trigrams to help
+        for (uint32_t i = 0; i < this->folded_.size(); i++)
+        {
+            if (this->folded_[i].contains(foldedQuery))
+            {
+                found.push_back(i);
+            }
+        }
+        return found;
+    }
+
+    // Only the items with the rarest trigram of the query need to be checked
+    const std::vector<uint32_t> *candidates = nullptr;
+    for (qsizetype pos = 0; pos + GRAM_LENGTH <= foldedQuery.size(); pos++)
+    {
+        auto it = this->trigrams_.find(trigramAt(foldedQuery, pos));
+        if (it == this->trigrams_.end())
+        {
+            return found;
+        }
+        if (!candidates || it->second.size() < candidates->size())
+        {
+            candidates = &it->second;
+        }
+    }
+
+    for (auto i : *candidates)
+    {
+        if (this->folded_[i].contains(foldedQuery))
+        {
+            found.push_back(i);
+        }
+    }
+    return found;
+}
+
+}  // namespace chatterino::completion
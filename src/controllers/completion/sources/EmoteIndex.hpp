@@ -0,0 +1,82 @@
+#pragma once
+
+#include "messages/Emote.hpp"
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+struct EmojiData;
+using EmojiPtr = std::shared_ptr<EmojiData>;
+}  // namespace chatterino
+
+namespace chatterino::completion {
+
+struct EmoteItem {
+    /// Emote image to show in input popup
+    EmotePtr emote{};
+    /// Name to check completion queries against
+    QString searchName{};
+    /// Name to insert into split input upon tab completing
+    QString tabCompletionName{};
+    /// Display name within input popup
+    QString displayName{};
+    /// Emote provider name for input popup
+    QString providerName{};
+    /// Whether emote is emoji
+    bool isEmoji{};
+};
+
+/// @brief An EmoteIndex holds the completion items of one emote map (or of
+/// the emojis) and finds the items matching a query without scanning them.
+///
+/// Items are kept sorted by their case-folded search name, so items starting
+/// with a query form a range. Items containing a query are found through the
+/// trigrams of their names.
+///
+/// Indexes are cached per emote map. Emote maps are replaced rather than
+/// modified when emotes change, so only the index of a changed map is rebuilt.
+class EmoteIndex
+{
+public:
+    explicit EmoteIndex(std::vector<EmoteItem> items);
+
+    /// @brief Returns the index of the emotes in `map`
+    /// @param map Emote map to index
+    /// @param providerName Emote provider name for input popup
+    static std::shared_ptr<const EmoteIndex> forMap(
+        const std::shared_ptr<const EmoteMap> &map,
+        const QString &providerName);
+
+    /// @brief Returns the index of the short codes of `emojis`
+    static std::shared_ptr<const EmoteIndex> forEmojis(
+        const std::vector<EmojiPtr> &emojis);
+
+    /// @brief Returns the items in the order they were added
+    const std::vector<EmoteItem> &items() const;
+
+    /// @brief Returns the case-folded search name of the item at `index`
+    QStringView foldedName(size_t index) const;
+
+    /// @brief Finds the items matching a query, ignoring case
+    /// @param foldedQuery Case-folded query
+    /// @param prefixOnly If set, items have to start with the query. Otherwise
+    /// they have to contain it.
+    /// @return Indices of the matching items in ascending order
+    std::vector<uint32_t> find(QStringView foldedQuery, bool prefixOnly) const;
+
+private:
+    std::vector<EmoteItem> items_;
+    std::vector<QString> folded_;
+    /// Indices of the items sorted by their case-folded name
+    std::vector<uint32_t> byName_;
+    /// Indices of the items containing each trigram (in ascending order)
+    std::unordered_map<uint64_t, std::vector<uint32_t>> trigrams_;
+};
+
+}  // namespace chatterino::completion
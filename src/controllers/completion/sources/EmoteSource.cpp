@@ -13,39 +13,23 @@
 #include "singletons/Emotes.hpp"
 #include "widgets/splits/InputCompletionItem.hpp"
 
+#include <algorithm>
+
 namespace chatterino::completion {
 
 namespace {
 
-void addEmotes(std::vector<EmoteItem> &out, const EmoteMap &map,
-               const QString &providerName)
+bool rankedBefore(const EmoteMatch &a, const EmoteMatch &b)
 {
-    for (auto &&emote : map)
+    if (a.cost != b.cost)
     {
-        out.push_back({.emote = emote.second,
-                       .searchName = emote.first.string,
-                       .tabCompletionName = emote.first.string,
-                       .displayName = emote.second->name.string,
-                       .providerName = providerName,
-                       .isEmoji = false});
+        return a.cost < b.cost;
     }
-}
-
-void addEmojis(std::vector<EmoteItem> &out, const std::vector<EmojiPtr> &map)
-{
-    for (const auto &emoji : map)
+    if (auto cmp = a.name.compare(b.name); cmp != 0)
     {
-        for (auto &&shortCode : emoji->shortCodes)
-        {
-            out.push_back(
-                {.emote = emoji->emote,
-                 .searchName = shortCode,
-                 .tabCompletionName = QStringLiteral(":%1:").arg(shortCode),
-                 .displayName = shortCode,
-                 .providerName = "Emoji",
-                 .isEmoji = true});
-        }
-    };
+        return cmp < 0;
+    }
+    return a.position < b.position;
 }
 
 }  // namespace
@@ -62,35 +46,57 @@ EmoteSource::EmoteSource(const Channel *channel,
 void EmoteSource::update(const QString &query)
 {
     this->output_.clear();
+    this->rankedCount_ = 0;
     if (this->strategy_)
     {
-        this->strategy_->apply(this->items_, this->output_, query);
+        this->strategy_->apply(this->indexes_, this->output_, query);
     }
 }
 
 void EmoteSource::addToListModel(GenericListModel &model, size_t maxCount) const
 {
-    addVecToListModel(this->output_, model, maxCount,
-                      [this](const EmoteItem &e) {
-                          return std::make_unique<InputCompletionItem>(
-                              e.emote, e.displayName + " - " + e.providerName,
-                              this->callback_);
-                      });
+    const size_t count = this->rank(maxCount);
+    model.reserve(model.rowCount() + count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto &e = *this->output_[i].item;
+        model.addItem(std::make_unique<InputCompletionItem>(
+            e.emote, e.displayName + " - " + e.providerName, this->callback_));
+    }
 }
 
 void EmoteSource::addToStringList(QStringList &list, size_t maxCount,
                                   bool /* isFirstWord */) const
 {
-    addVecToStringList(this->output_, list, maxCount, [](const EmoteItem &e) {
-        return e.tabCompletionName + " ";
-    });
+    const size_t count = this->rank(maxCount);
+    list.reserve(list.count() + count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        list.push_back(this->output_[i].item->tabCompletionName + " ");
+    }
+}
+
+size_t EmoteSource::rank(size_t count) const
+{
+    count = sizeWithinLimit(this->output_.size(), count);
+    if (count > this->rankedCount_)
+    {
+        // The first rankedCount_ matches are the lowest ones already
+        std::partial_sort(this->output_.begin() + this->rankedCount_,
+                          this->output_.begin() + count, this->output_.end(),
+                          rankedBefore);
+        this->rankedCount_ = count;
+    }
+    return count;
 }
 
 void EmoteSource::initializeFromChannel(const Channel *channel)
 {
     auto *app = getApp();
 
-    std::vector<EmoteItem> emotes;
+    EmoteIndexList indexes;
     const auto *tc = dynamic_cast<const TwitchChannel *>(channel);
     // returns true also for special Twitch channels (/live, /mentions, /whispers, etc.)
     if (channel->isTwitchChannel())
@@ -99,49 +105,62 @@ void EmoteSource::initializeFromChannel(const Channel *channel)
         {
             if (auto twitch = tc->localTwitchEmotes())
             {
-                addEmotes(emotes, *twitch, "Local Twitch Emotes");
+                indexes.push_back(
+                    EmoteIndex::forMap(twitch, "Local Twitch Emotes"));
             }
 
             auto user = getApp()->getAccounts()->twitch.getCurrent();
-            addEmotes(emotes, **user->accessEmotes(), "Twitch Emote");
+            indexes.push_back(
+                EmoteIndex::forMap(*user->accessEmotes(), "Twitch Emote"));
 
             // TODO extract "Channel {BetterTTV,7TV,FrankerFaceZ}" text into a #define.
             if (auto bttv = tc->bttvEmotes())
             {
-                addEmotes(emotes, *bttv, "Channel BetterTTV");
+                indexes.push_back(
+                    EmoteIndex::forMap(bttv, "Channel BetterTTV"));
             }
             if (auto ffz = tc->ffzEmotes())
             {
-                addEmotes(emotes, *ffz, "Channel FrankerFaceZ");
+                indexes.push_back(
+                    EmoteIndex::forMap(ffz, "Channel FrankerFaceZ"));
             }
             if (auto seventv = tc->seventvEmotes())
             {
-                addEmotes(emotes, *seventv, "Channel 7TV");
+                indexes.push_back(EmoteIndex::forMap(seventv, "Channel 7TV"));
             }
         }
 
         if (auto bttvG = app->getBttvEmotes()->emotes())
         {
-            addEmotes(emotes, *bttvG, "Global BetterTTV");
+            indexes.push_back(EmoteIndex::forMap(bttvG, "Global BetterTTV"));
         }
         if (auto ffzG = app->getFfzEmotes()->emotes())
         {
-            addEmotes(emotes, *ffzG, "Global FrankerFaceZ");
+            indexes.push_back(EmoteIndex::forMap(ffzG, "Global FrankerFaceZ"));
         }
         if (auto seventvG = app->getSeventvEmotes()->globalEmotes())
         {
-            addEmotes(emotes, *seventvG, "Global 7TV");
+            indexes.push_back(EmoteIndex::forMap(seventvG, "Global 7TV"));
         }
     }
 
-    addEmojis(emotes, app->getEmotes()->getEmojis()->getEmojis());
+    indexes.push_back(EmoteIndex::forEmojis(
+        app->getEmotes()->getEmojis()->getEmojis()));
 
-    this->items_ = std::move(emotes);
+    this->indexes_ = std::move(indexes);
 }
 
-const std::vector<EmoteItem> &EmoteSource::output() const
+std::vector<EmoteItem> EmoteSource::output() const
 {
-    return this->output_;
+    this->rank(0);
+
+    std::vector<EmoteItem> items;
+    items.reserve(this->output_.size());
+    for (const auto &match : this->output_)
+    {
+        items.push_back(*match.item);
+    }
+    return items;
 }
 
 }  // namespace chatterino::completion
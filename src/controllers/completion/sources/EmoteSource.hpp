@@ -1,11 +1,11 @@
 #pragma once
 
 #include "common/Channel.hpp"
+#include "controllers/completion/sources/EmoteIndex.hpp"
 #include "controllers/completion/sources/Source.hpp"
-#include "controllers/completion/strategies/Strategy.hpp"
-#include "messages/Emote.hpp"
 
 #include <QString>
+#include <QStringView>
 
 #include <functional>
 #include <memory>
@@ -13,26 +13,41 @@
 
 namespace chatterino::completion {
 
-struct EmoteItem {
-    /// Emote image to show in input popup
-    EmotePtr emote{};
-    /// Name to check completion queries against
-    QString searchName{};
-    /// Name to insert into split input upon tab completing
-    QString tabCompletionName{};
-    /// Display name within input popup
-    QString displayName{};
-    /// Emote provider name for input popup
-    QString providerName{};
-    /// Whether emote is emoji
-    bool isEmoji{};
+/// @brief An item matching a completion query and the keys it's ranked by.
+///
+/// Matches are ranked by their cost, then by their name, then by their
+/// position (lowest first).
+struct EmoteMatch {
+    const EmoteItem *item{};
+    int cost{};
+    /// Name to compare if the costs are equal. Has to outlive the match.
+    QStringView name{};
+    /// Position of the item within the source
+    size_t position{};
+};
+
+using EmoteIndexList = std::vector<std::shared_ptr<const EmoteIndex>>;
+
+/// @brief An EmoteStrategy finds the items matching a query in the indexes of
+/// an EmoteSource and decides how they're ranked.
+class EmoteStrategy
+{
+public:
+    virtual ~EmoteStrategy() = default;
+
+    /// @brief Applies the strategy, storing the matching items in output.
+    /// @param indexes Indexes to consider. Items are positioned in this order.
+    /// @param output Output vector for matches. The source ranks them lazily.
+    /// @param query Completion query
+    virtual void apply(const EmoteIndexList &indexes,
+                       std::vector<EmoteMatch> &output,
+                       const QString &query) const = 0;
 };
 
 class EmoteSource : public Source
 {
 public:
     using ActionCallback = std::function<void(const QString &)>;
-    using EmoteStrategy = Strategy<EmoteItem>;
 
     /// @brief Initializes a source for EmoteItems from the given channel
     /// @param channel Channel to initialize emotes from
@@ -48,16 +63,24 @@ public:
     void addToStringList(QStringList &list, size_t maxCount = 0,
                          bool isFirstWord = false) const override;
 
-    const std::vector<EmoteItem> &output() const;
+    std::vector<EmoteItem> output() const;
 
 private:
     void initializeFromChannel(const Channel *channel);
 
+    /// Ranks the first `count` matches (all if zero) and returns how many
+    /// there are
+    size_t rank(size_t count) const;
+
     std::unique_ptr<EmoteStrategy> strategy_;
     ActionCallback callback_;
 
-    std::vector<EmoteItem> items_{};
-    std::vector<EmoteItem> output_{};
+    EmoteIndexList indexes_{};
+
+    // Only the matches that are shown have to be ranked, so this is done
+    // lazily when they're added to a model or list
+    mutable std::vector<EmoteMatch> output_{};
+    mutable size_t rankedCount_{};
 };
 
 }  // namespace chatterino::completion
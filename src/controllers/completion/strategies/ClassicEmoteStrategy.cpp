@@ -15,8 +15,8 @@ const auto &LOG = chatterinoCompletion;
 
 }  // namespace
 
-void ClassicEmoteStrategy::apply(const std::vector<EmoteItem> &items,
-                                 std::vector<EmoteItem> &output,
+void ClassicEmoteStrategy::apply(const EmoteIndexList &indexes,
+                                 std::vector<EmoteMatch> &output,
                                  const QString &query) const
 {
     qCDebug(LOG) << "ClassicEmoteStrategy apply" << query;
@@ -32,46 +32,42 @@ void ClassicEmoteStrategy::apply(const std::vector<EmoteItem> &items,
         zeroWidthOnly = true;
     }
 
-    // First pass: filter by zero-width only and contains match
-    for (const auto &item : items)
+    // First pass: filter by zero-width only and contains match.
+    // Matches are ranked by their position.
+    auto foldedQuery = normalizedQuery.toCaseFolded();
+    size_t position = 0;
+    for (const auto &index : indexes)
     {
-        if (zeroWidthOnly && !item.emote->zeroWidth)
+        for (auto i : index->find(foldedQuery, false))
         {
-            continue;
-        }
+            const auto &item = index->items()[i];
+            if (zeroWidthOnly && !item.emote->zeroWidth)
+            {
+                continue;
+            }
 
-        if (item.searchName.contains(normalizedQuery, Qt::CaseInsensitive))
-        {
-            output.push_back(item);
+            output.push_back({.item = &item, .position = position + i});
         }
+        position += index->items().size();
     }
 
     // Second pass: if there is an exact match, put that emote first
     for (size_t i = 1; i < output.size(); i++)
     {
-        auto emoteText = output.at(i).searchName;
+        const auto &emoteText = output.at(i).item->searchName;
 
         // test for match or match with colon at start for emotes like ":)"
         if (emoteText.compare(normalizedQuery, Qt::CaseInsensitive) == 0 ||
             emoteText.compare(":" + normalizedQuery, Qt::CaseInsensitive) == 0)
         {
-            auto emote = output[i];
-            output.erase(output.begin() + int(i));
-            output.insert(output.begin(), emote);
+            output[i].cost = -1;
             break;
         }
     }
 }
 
-struct CompletionEmoteOrder {
-    bool operator()(const EmoteItem &a, const EmoteItem &b) const
-    {
-        return compareEmoteStrings(a.searchName, b.searchName);
-    }
-};
-
-void ClassicTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
-                                    std::vector<EmoteItem> &output,
+void ClassicTabEmoteStrategy::apply(const EmoteIndexList &indexes,
+                                    std::vector<EmoteMatch> &output,
                                     const QString &query) const
 {
     qCDebug(LOG) << "ClassicTabEmoteStrategy apply" << query;
@@ -82,38 +78,48 @@ void ClassicTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
         // TODO(Qt6): use sliced
         normalizedQuery = normalizedQuery.mid(1);
     }
-
-    std::set<EmoteItem, CompletionEmoteOrder> emotes;
-
-    for (const auto &item : items)
+    bool prefixOnly = getSettings()->prefixOnlyEmoteCompletion;
+
+    // Emojis are matched against the normalized query and only when
+    // completing with ':'
+    auto foldedQuery = query.toCaseFolded();
+    auto foldedNormalizedQuery = normalizedQuery.toString().toCaseFolded();
+    std::vector<const EmoteItem *> emotes;
+    for (const auto &index : indexes)
     {
-        QStringView itemQuery;
-        if (item.isEmoji)
+        for (auto i : index->find(foldedQuery, prefixOnly))
         {
-            if (colonStart)
+            if (!index->items()[i].isEmoji)
             {
-                itemQuery = normalizedQuery;
-            }
-            else
-            {
-                continue;  // ignore emojis when not completing with ':'
+                emotes.push_back(&index->items()[i]);
             }
         }
-        else
+        if (colonStart)
         {
-            itemQuery = query;
-        }
-
-        if (startsWithOrContains(item.searchName, itemQuery,
-                                 Qt::CaseInsensitive,
-                                 getSettings()->prefixOnlyEmoteCompletion))
-        {
-            emotes.insert(item);
+            for (auto i : index->find(foldedNormalizedQuery, prefixOnly))
+            {
+                if (index->items()[i].isEmoji)
+                {
+                    emotes.push_back(&index->items()[i]);
+                }
+            }
         }
     }
 
+    // Emotes with the same name are only added once
+    std::ranges::stable_sort(emotes, [](const auto *a, const auto *b) {
+        return compareEmoteStrings(a->searchName, b->searchName);
+    });
+    auto duplicates = std::ranges::unique(emotes, [](auto *a, auto *b) {
+        return a->searchName == b->searchName;
+    });
+    emotes.erase(duplicates.begin(), duplicates.end());
+
     output.reserve(emotes.size());
-    output.assign(emotes.begin(), emotes.end());
+    for (size_t i = 0; i < emotes.size(); i++)
+    {
+        output.push_back({.item = emotes[i], .position = i});
+    }
 }
 
 }  // namespace chatterino::completion
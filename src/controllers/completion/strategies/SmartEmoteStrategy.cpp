@@ -66,13 +66,44 @@ int costOfEmote(QStringView query, QStringView emote, bool prioritizeUpper)
     return score;
 };
 
-// This contains the brains of emote tab completion. Updates output to sorted completions.
-// Ensure that the query string is already normalized, that is doesn't have a leading ':'
-// matchingFunction is used for testing if the emote should be included in the search.
+/// An item matching a query when ignoring case
+struct Candidate {
+    const EmoteItem *item;
+    QStringView foldedName;
+    size_t position;
+};
+
+/// Adds the items of `index` matching `foldedQuery` (ignoring case) that are
+/// accepted by `filter` to `candidates`
+template <typename Filter>
+void addCandidates(std::vector<Candidate> &candidates, const EmoteIndex &index,
+                   size_t position, QStringView foldedQuery, bool prefixOnly,
+                   Filter filter)
+{
+    for (auto i : index.find(foldedQuery, prefixOnly))
+    {
+        const auto &item = index.items()[i];
+        if (filter(item))
+        {
+            candidates.push_back({
+                .item = &item,
+                .foldedName = index.foldedName(i),
+                .position = position + i,
+            });
+        }
+    }
+}
+
+// This contains the brains of emote tab completion. Updates output to the
+// ranked completions. Ensure that the query string is already normalized, that
+// is doesn't have a leading ':'. candidates are the items matching the query
+// when ignoring case. matchingFunction is used for testing if the emote should
+// be included in a case sensitive search.
 void completeEmotes(
-    const std::vector<EmoteItem> &items, std::vector<EmoteItem> &output,
+    const std::vector<Candidate> &candidates, std::vector<EmoteMatch> &output,
     QStringView query, bool ignoreColonForCost, bool ignoreTildeForCost,
-    const std::function<bool(EmoteItem, Qt::CaseSensitivity)> &matchingFunction)
+    const std::function<bool(const EmoteItem &, Qt::CaseSensitivity)>
+        &matchingFunction)
 {
     // Given these emotes: pajaW, PAJAW
     // There are a few cases of input:
@@ -89,90 +120,66 @@ void completeEmotes(
             return c.isUpper();
         });
 
-    // First search, for case 1 it will be case insensitive,
-    // for cases 2, 3 and 4 it will be case sensitive
-    for (const auto &item : items)
+    // The candidates are the results of the search for case 1 and 5.
+    // For cases 2, 3 and 4 the search is case sensitive.
+    std::vector<const Candidate *> matches;
+    for (const auto &candidate : candidates)
     {
-        if (matchingFunction(
-                item, haveUpper ? Qt::CaseSensitive : Qt::CaseInsensitive))
+        if (!haveUpper ||
+            matchingFunction(*candidate.item, Qt::CaseSensitive))
         {
-            output.push_back(item);
+            matches.push_back(&candidate);
         }
     }
 
     // if case 3: then true; false otherwise
     bool prioritizeUpper = false;
 
-    // No results from search
-    if (output.empty())
+    // No results from the case sensitive search from case 2, therefore we can
+    // only be in case 3 or 4. Use the case insensitive results.
+    if (matches.empty() && haveUpper)
     {
-        if (!haveUpper)
+        prioritizeUpper = true;
+        for (const auto &candidate : candidates)
         {
-            // Optimisation: First search was case insensitive, but we found nothing
-            // There is nothing to be found: case 5.
-            return;
+            matches.push_back(&candidate);
         }
-        // Case sensitive search from case 2 found nothing, therefore we can
-        // only be in case 3 or 4.
+    }
 
-        prioritizeUpper = true;
-        // Run the search again but this time without case sensitivity
-        for (const auto &item : items)
+    // The cost of each match is calculated once, only the matches that are
+    // shown are sorted by the source
+    output.reserve(matches.size());
+    for (const auto *match : matches)
+    {
+        QStringView name = match->item->searchName;
+        qsizetype stripped = 0;
+        if (ignoreColonForCost && name.startsWith(u':'))
         {
-            if (matchingFunction(item, Qt::CaseInsensitive))
-            {
-                output.push_back(item);
-            }
+            name = name.mid(1);
+            stripped++;
         }
-        if (output.empty())
+        if (ignoreTildeForCost && name.startsWith(u'~'))
         {
-            // The second search found nothing, so don't even try to sort: case 4
-            return;
+            name = name.mid(1);
+            stripped++;
         }
-    }
 
-    std::sort(output.begin(), output.end(),
-              [query, prioritizeUpper, ignoreColonForCost, ignoreTildeForCost](
-                  const EmoteItem &a, const EmoteItem &b) -> bool {
-                  auto tempA = a.searchName;
-                  auto tempB = b.searchName;
-                  if (ignoreColonForCost && tempA.startsWith(":"))
-                  {
-                      tempA = tempA.mid(1);
-                  }
-                  if (ignoreTildeForCost && tempA.startsWith("~"))
-                  {
-                      tempA = tempA.mid(1);
-                  }
-                  if (ignoreColonForCost && tempB.startsWith(":"))
-                  {
-                      tempB = tempB.mid(1);
-                  }
-                  if (ignoreTildeForCost && tempB.startsWith("~"))
-                  {
-                      tempB = tempB.mid(1);
-                  }
-
-                  auto costA = costOfEmote(query, tempA, prioritizeUpper);
-                  auto costB = costOfEmote(query, tempB, prioritizeUpper);
-                  if (costA == costB)
-                  {
-                      // Case difference and length came up tied for (a, b), break the tie
-                      return QString::compare(tempA, tempB,
-                                              Qt::CaseInsensitive) < 0;
-                  }
-
-                  return costA < costB;
-              });
+        output.push_back({
+            .item = match->item,
+            .cost = costOfEmote(query, name, prioritizeUpper),
+            // Case difference and length came up tied, break the tie
+            .name = match->foldedName.mid(stripped),
+            .position = match->position,
+        });
+    }
 }
 }  // namespace
 
-void SmartEmoteStrategy::apply(const std::vector<EmoteItem> &items,
-                               std::vector<EmoteItem> &output,
+void SmartEmoteStrategy::apply(const EmoteIndexList &indexes,
+                               std::vector<EmoteMatch> &output,
                                const QString &query) const
 {
     qCDebug(LOG) << "SmartEmoteStrategy apply" << query;
-    std::vector<EmoteItem> filteredItems = items;
     QString normalizedQuery = query;
     bool ignoreColonForCost = false;
     bool zeroWidthOnly = false;
@@ -185,25 +192,31 @@ void SmartEmoteStrategy::apply(const std::vector<EmoteItem> &items,
     {
         normalizedQuery = normalizedQuery.mid(1);
         zeroWidthOnly = true;
+    }
 
-        auto [first, last] = std::ranges::remove_if(
-            filteredItems, [](const EmoteItem &emoteItem) {
-                return !emoteItem.emote->zeroWidth;
-            });
-        filteredItems.erase(first, last);
+    auto foldedQuery = normalizedQuery.toCaseFolded();
+    std::vector<Candidate> candidates;
+    size_t position = 0;
+    for (const auto &index : indexes)
+    {
+        addCandidates(candidates, *index, position, foldedQuery, false,
+                      [zeroWidthOnly](const EmoteItem &item) {
+                          return !zeroWidthOnly || item.emote->zeroWidth;
+                      });
+        position += index->items().size();
     }
 
-    completeEmotes(filteredItems, output, normalizedQuery, ignoreColonForCost,
+    completeEmotes(candidates, output, normalizedQuery, ignoreColonForCost,
                    zeroWidthOnly,
-                   [normalizedQuery](const EmoteItem &left,
-                                     Qt::CaseSensitivity caseHandling) {
+                   [&normalizedQuery](const EmoteItem &left,
+                                      Qt::CaseSensitivity caseHandling) {
                        return left.searchName.contains(normalizedQuery,
                                                        caseHandling);
                    });
 }
 
-void SmartTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
-                                  std::vector<EmoteItem> &output,
+void SmartTabEmoteStrategy::apply(const EmoteIndexList &indexes,
+                                  std::vector<EmoteMatch> &output,
                                   const QString &query) const
 {
     qCDebug(LOG) << "SmartTabEmoteStrategy apply" << query;
@@ -214,30 +227,37 @@ void SmartTabEmoteStrategy::apply(const std::vector<EmoteItem> &items,
         // TODO(Qt6): use sliced
         normalizedQuery = normalizedQuery.mid(1);
     }
+    bool prefixOnly = getSettings()->prefixOnlyEmoteCompletion;
+
+    // Emojis are matched against the normalized query and only when
+    // completing with ':'
+    auto foldedQuery = query.toCaseFolded();
+    auto foldedNormalizedQuery = normalizedQuery.toString().toCaseFolded();
+    std::vector<Candidate> candidates;
+    size_t position = 0;
+    for (const auto &index : indexes)
+    {
+        addCandidates(candidates, *index, position, foldedQuery, prefixOnly,
+                      [](const EmoteItem &item) {
+                          return !item.isEmoji;
+                      });
+        if (colonStart)
+        {
+            addCandidates(candidates, *index, position, foldedNormalizedQuery,
+                          prefixOnly, [](const EmoteItem &item) {
+                              return item.isEmoji;
+                          });
+        }
+        position += index->items().size();
+    }
 
     completeEmotes(
-        items, output, normalizedQuery, false, false,
+        candidates, output, normalizedQuery, false, false,
         [&](const EmoteItem &item, Qt::CaseSensitivity caseHandling) -> bool {
-            QStringView itemQuery;
-            if (item.isEmoji)
-            {
-                if (colonStart)
-                {
-                    itemQuery = normalizedQuery;
-                }
-                else
-                {
-                    return false;  // ignore emojis when not completing with ':'
-                }
-            }
-            else
-            {
-                itemQuery = query;
-            }
-
             return startsWithOrContains(
-                item.searchName, itemQuery, caseHandling,
-                getSettings()->prefixOnlyEmoteCompletion);
+                item.searchName,
+                item.isEmoji ? normalizedQuery : QStringView(query),
+                caseHandling, prefixOnly);
         });
 }
 
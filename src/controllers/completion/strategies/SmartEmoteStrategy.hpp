@@ -1,21 +1,18 @@
 #pragma once
 
 #include "controllers/completion/sources/EmoteSource.hpp"
-#include "controllers/completion/strategies/Strategy.hpp"
 
 namespace chatterino::completion {
 
-class SmartEmoteStrategy : public Strategy<EmoteItem>
+class SmartEmoteStrategy : public EmoteStrategy
 {
-    void apply(const std::vector<EmoteItem> &items,
-               std::vector<EmoteItem> &output,
+    void apply(const EmoteIndexList &indexes, std::vector<EmoteMatch> &output,
                const QString &query) const override;
 };
 
-class SmartTabEmoteStrategy : public Strategy<EmoteItem>
+class SmartTabEmoteStrategy : public EmoteStrategy
 {
-    void apply(const std::vector<EmoteItem> &items,
-               std::vector<EmoteItem> &output,
+    void apply(const EmoteIndexList &indexes, std::vector<EmoteMatch> &output,
                const QString &query) const override;
 };
 
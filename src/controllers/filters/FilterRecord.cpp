@@ -58,10 +58,10 @@ bool FilterRecord::valid() const
     return this->filter_ != nullptr;
 }
 
-bool FilterRecord::filter(const filters::ContextMap &context) const
+bool FilterRecord::filter(filters::IdentifierSource &source) const
 {
     assert(this->valid());
-    return this->filter_->execute(context).toBool();
+    return filters::valueToBool(this->filter_->execute(source));
 }
 
 bool FilterRecord::operator==(const FilterRecord &other) const
@@ -28,7 +28,7 @@ public:
 
     bool valid() const;
 
-    bool filter(const filters::ContextMap &context) const;
+    bool filter(filters::IdentifierSource &source) const;
 
     bool operator==(const FilterRecord &other) const;
 
@@ -42,10 +42,10 @@ bool FilterSet::filter(const MessagePtr &m, ChannelPtr channel) const
         return true;
     }
 
-    filters::ContextMap context = filters::buildContextMap(m, channel.get());
-    for (const auto &f : this->filters_.values())
+    filters::MessageIdentifierSource source(*m, channel.get());
+    for (const auto &f : this->filters_)
     {
-        if (!f->valid() || !f->filter(context))
+        if (!f->valid() || !f->filter(source))
         {
             return false;
         }
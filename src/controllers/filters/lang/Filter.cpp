@@ -8,175 +8,170 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 
+#include <algorithm>
+
 namespace chatterino::filters {
 
-const QMap<QString, Type> MESSAGE_TYPING_CONTEXT{
-    {"author.badges", Type::StringList},
-    {"author.color", Type::Color},
-    {"author.name", Type::String},
-    {"author.user_id", Type::String},
-    {"author.no_color", Type::Bool},
-    {"author.subbed", Type::Bool},
-    {"author.sub_length", Type::Int},
-    {"channel.name", Type::String},
-    {"channel.watching", Type::Bool},
-    {"channel.live", Type::Bool},
-    {"flags.action", Type::Bool},
-    {"flags.highlighted", Type::Bool},
-    {"flags.points_redeemed", Type::Bool},
-    {"flags.sub_message", Type::Bool},
-    {"flags.system_message", Type::Bool},
-    {"flags.reward_message", Type::Bool},
-    {"flags.first_message", Type::Bool},
-    {"flags.elevated_message", Type::Bool},
-    {"flags.hype_chat", Type::Bool},
-    {"flags.cheer_message", Type::Bool},
-    {"flags.whisper", Type::Bool},
-    {"flags.reply", Type::Bool},
-    {"flags.automod", Type::Bool},
-    {"flags.restricted", Type::Bool},
-    {"flags.monitored", Type::Bool},
-    {"flags.shared", Type::Bool},
-    {"flags.similar", Type::Bool},
-    {"message.content", Type::String},
-    {"message.length", Type::Int},
-    {"reward.title", Type::String},
-    {"reward.cost", Type::Int},
-    {"reward.id", Type::String},
-};
+const QMap<QString, Type> MESSAGE_TYPING_CONTEXT = [] {
+    QMap<QString, Type> map;
+    for (std::size_t i = 0; i < IDENTIFIER_COUNT; ++i)
+    {
+        const auto &info = identifierInfo(static_cast<Identifier>(i));
+        map.insert(info.name, info.type);
+    }
+    return map;
+}();
 
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
 {
-    auto watchingChannel = getApp()->getTwitch()->getWatchingChannel().get();
-
-    /* 
-     * Looking to add a new identifier to filters? Here's what to do: 
-     *  1. Update validIdentifiersMap in Tokenizer.cpp
-     *  2. Add the identifier to the list below
-     *  3. Add the type of the identifier to MESSAGE_TYPING_CONTEXT in Filter.hpp
-     *  4. Add the value for the identifier to the ContextMap returned by this function
-     * 
-     * List of identifiers:
-     *
-     * author.badges
-     * author.color
-     * author.name
-     * author.user_id
-     * author.no_color
-     * author.subbed
-     * author.sub_length
-     *
-     * channel.name
-     * channel.watching
-     *
-     * flags.highlighted
-     * flags.points_redeemed
-     * flags.sub_message
-     * flags.system_message
-     * flags.reward_message
-     * flags.first_message
-     * flags.elevated_message
-     * flags.cheer_message
-     * flags.whisper
-     * flags.reply
-     * flags.automod
-     * flags.restricted
-     * flags.monitored
-     * flags.shared
-     *
-     * message.content
-     * message.length
-     *
-     * reward.title
-     * reward.cost
-     * reward.id
-     */
-
-    using MessageFlag = chatterino::MessageFlag;
+    MessageIdentifierSource source(*m, channel);
 
-    QStringList badges;
-    badges.reserve(m->badges.size());
-    for (const auto &e : m->badges)
+    ContextMap vars;
+    for (std::size_t i = 0; i < IDENTIFIER_COUNT; ++i)
     {
-        badges << e.key_;
+        auto identifier = static_cast<Identifier>(i);
+        vars.insert(identifierToString(identifier),
+                    valueToVariant(source.value(identifier)));
     }
+    return vars;
+}
 
-    bool watching = !watchingChannel->getName().isEmpty() &&
-                    watchingChannel->getName().compare(
-                        m->channelName, Qt::CaseInsensitive) == 0;
+MessageIdentifierSource::MessageIdentifierSource(const Message &message,
+                                                 Channel *channel)
+    : message_(message)
+    , channel_(channel)
+{
+}
 
-    bool subscribed = false;
-    int subLength = 0;
-    for (const auto &subBadge : {"subscriber", "founder"})
+Value MessageIdentifierSource::value(Identifier identifier)
+{
+    auto &cached = this->values_[static_cast<std::size_t>(identifier)];
+    if (!cached)
     {
-        if (!badges.contains(subBadge))
-        {
-            continue;
-        }
-        subscribed = true;
-        if (m->badgeInfos.find(subBadge) != m->badgeInfos.end())
+        cached = this->compute(identifier);
+    }
+    return *cached;
+}
+
+Value MessageIdentifierSource::compute(Identifier identifier) const
+{
+    using MessageFlag = chatterino::MessageFlag;
+    const auto &m = this->message_;
+
+    // Returns whether the author is subscribed and for how many months
+    const auto subscription = [&m]() -> std::pair<bool, int> {
+        bool subscribed = false;
+        int subLength = 0;
+        for (const auto *subBadge : {"subscriber", "founder"})
         {
-            subLength = m->badgeInfos.at(subBadge).toInt();
+            bool hasBadge = std::any_of(m.badges.begin(), m.badges.end(),
+                                        [&](const auto &badge) {
+                                            return badge.key_ == subBadge;
+                                        });
+            if (!hasBadge)
+            {
+                continue;
+            }
+            subscribed = true;
+            auto it = m.badgeInfos.find(subBadge);
+            if (it != m.badgeInfos.end())
+            {
+                subLength = it->second.toInt();
+            }
         }
-    }
-    ContextMap vars = {
-        {"author.badges", std::move(badges)},
-        {"author.color", m->usernameColor},
-        {"author.name", m->displayName},
-        {"author.user_id", m->userID},
-        {"author.no_color", !m->usernameColor.isValid()},
-        {"author.subbed", subscribed},
-        {"author.sub_length", subLength},
-
-        {"channel.name", m->channelName},
-        {"channel.watching", watching},
-
-        {"flags.action", m->flags.has(MessageFlag::Action)},
-        {"flags.highlighted", m->flags.has(MessageFlag::Highlighted)},
-        {"flags.points_redeemed", m->flags.has(MessageFlag::RedeemedHighlight)},
-        {"flags.sub_message", m->flags.has(MessageFlag::Subscription)},
-        {"flags.system_message", m->flags.has(MessageFlag::System)},
-        {"flags.reward_message",
-         m->flags.has(MessageFlag::RedeemedChannelPointReward)},
-        {"flags.first_message", m->flags.has(MessageFlag::FirstMessage)},
-        {"flags.elevated_message", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.hype_chat", m->flags.has(MessageFlag::ElevatedMessage)},
-        {"flags.cheer_message", m->flags.has(MessageFlag::CheerMessage)},
-        {"flags.whisper", m->flags.has(MessageFlag::Whisper)},
-        {"flags.reply", m->flags.has(MessageFlag::ReplyMessage)},
-        {"flags.automod", m->flags.has(MessageFlag::AutoMod)},
-        {"flags.restricted", m->flags.has(MessageFlag::RestrictedMessage)},
-        {"flags.monitored", m->flags.has(MessageFlag::MonitoredMessage)},
-        {"flags.shared", m->flags.has(MessageFlag::SharedMessage)},
-        {"flags.similar", m->flags.has(MessageFlag::Similar)},
-
-        {"message.content", m->messageText},
-        {"message.length", m->messageText.length()},
+        return {subscribed, subLength};
     };
+
+    switch (identifier)
     {
-        auto *tc = dynamic_cast<TwitchChannel *>(channel);
-        if (channel && !channel->isEmpty() && tc)
-        {
-            vars["channel.live"] = tc->isLive();
+        case Identifier::AuthorBadges: {
+            QStringList badges;
+            badges.reserve(static_cast<qsizetype>(m.badges.size()));
+            for (const auto &e : m.badges)
+            {
+                badges << e.key_;
+            }
+            return badges;
         }
-        else
-        {
-            vars["channel.live"] = false;
+        case Identifier::AuthorColor:
+            return m.usernameColor;
+        case Identifier::AuthorName:
+            return m.displayName;
+        case Identifier::AuthorUserID:
+            return m.userID;
+        case Identifier::AuthorNoColor:
+            return !m.usernameColor.isValid();
+        case Identifier::AuthorSubbed:
+            return subscription().first;
+        case Identifier::AuthorSubLength:
+            return subscription().second;
+
+        case Identifier::ChannelName:
+            return m.channelName;
+        case Identifier::ChannelWatching: {
+            auto watchingChannel =
+                getApp()->getTwitch()->getWatchingChannel().get();
+            return !watchingChannel->getName().isEmpty() &&
+                   watchingChannel->getName().compare(
+                       m.channelName, Qt::CaseInsensitive) == 0;
         }
+        case Identifier::ChannelLive: {
+            auto *tc = dynamic_cast<TwitchChannel *>(this->channel_);
+            return this->channel_ && !this->channel_->isEmpty() && tc &&
+                   tc->isLive();
+        }
+
+        case Identifier::FlagsAction:
+            return m.flags.has(MessageFlag::Action);
+        case Identifier::FlagsHighlighted:
+            return m.flags.has(MessageFlag::Highlighted);
+        case Identifier::FlagsPointsRedeemed:
+            return m.flags.has(MessageFlag::RedeemedHighlight);
+        case Identifier::FlagsSubMessage:
+            return m.flags.has(MessageFlag::Subscription);
+        case Identifier::FlagsSystemMessage:
+            return m.flags.has(MessageFlag::System);
+        case Identifier::FlagsRewardMessage:
+            return m.flags.has(MessageFlag::RedeemedChannelPointReward);
+        case Identifier::FlagsFirstMessage:
+            return m.flags.has(MessageFlag::FirstMessage);
+        case Identifier::FlagsElevatedMessage:
+        case Identifier::FlagsHypeChat:
+            return m.flags.has(MessageFlag::ElevatedMessage);
+        case Identifier::FlagsCheerMessage:
+            return m.flags.has(MessageFlag::CheerMessage);
+        case Identifier::FlagsWhisper:
+            return m.flags.has(MessageFlag::Whisper);
+        case Identifier::FlagsReply:
+            return m.flags.has(MessageFlag::ReplyMessage);
+        case Identifier::FlagsAutomod:
+            return m.flags.has(MessageFlag::AutoMod);
+        case Identifier::FlagsRestricted:
+            return m.flags.has(MessageFlag::RestrictedMessage);
+        case Identifier::FlagsMonitored:
+            return m.flags.has(MessageFlag::MonitoredMessage);
+        case Identifier::FlagsShared:
+            return m.flags.has(MessageFlag::SharedMessage);
+        case Identifier::FlagsSimilar:
+            return m.flags.has(MessageFlag::Similar);
+
+        case Identifier::MessageContent:
+            return m.messageText;
+        case Identifier::MessageLength:
+            return static_cast<int>(m.messageText.length());
+
+        case Identifier::RewardTitle:
+            return m.reward ? m.reward->title : QString("");
+        case Identifier::RewardCost:
+            return m.reward ? m.reward->cost : -1;
+        case Identifier::RewardID:
+            return m.reward ? m.reward->id : QString("");
+
+        case Identifier::Count:
+            break;
     }
-    if (m->reward != nullptr)
-    {
-        vars["reward.title"] = m->reward->title;
-        vars["reward.cost"] = m->reward->cost;
-        vars["reward.id"] = m->reward->id;
-    }
-    else
-    {
-        vars["reward.title"] = "";
-        vars["reward.cost"] = -1;
-        vars["reward.id"] = "";
-    }
-    return vars;
+
+    return QVariant();
 }
 
 FilterResult Filter::fromString(const QString &str)
@@ -196,6 +191,7 @@ FilterResult Filter::fromString(const QString &str)
 Filter::Filter(ExpressionPtr expression, Type returnType)
     : expression_(std::move(expression))
     , returnType_(returnType)
+    , program_(Program::compile(*this->expression_, MESSAGE_TYPING_CONTEXT))
 {
 }
 
@@ -209,6 +205,11 @@ QVariant Filter::execute(const ContextMap &context) const
     return this->expression_->execute(context);
 }
 
+Value Filter::execute(IdentifierSource &source) const
+{
+    return this->program_.execute(source);
+}
+
 QString Filter::filterString() const
 {
     return this->expression_->filterString();
@@ -219,4 +220,9 @@ QString Filter::debugString(const TypingContext &context) const
     return this->expression_->debug(context);
 }
 
+const Program &Filter::program() const
+{
+    return this->program_;
+}
+
 }  // namespace chatterino::filters
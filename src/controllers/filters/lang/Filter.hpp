@@ -1,11 +1,14 @@
 #pragma once
 
 #include "controllers/filters/lang/expressions/Expression.hpp"
+#include "controllers/filters/lang/Program.hpp"
 #include "controllers/filters/lang/Types.hpp"
 
 #include <QString>
 
+#include <array>
 #include <memory>
+#include <optional>
 #include <variant>
 
 namespace chatterino {
@@ -20,12 +23,37 @@ namespace chatterino::filters {
 
 // MESSAGE_TYPING_CONTEXT maps filter variables to their expected type at evaluation.
 // For example, flags.highlighted is a boolean variable, so it is marked as Type::Bool
-// below. These variable types will be used to check whether a filter "makes sense",
+// in Identifier.cpp. These variable types will be used to check whether a filter "makes sense",
 // i.e. if all the variables and operators being used have compatible types.
 extern const QMap<QString, Type> MESSAGE_TYPING_CONTEXT;
 
+/// Evaluates every identifier for the given message.
+///
+/// Filters don't need this, they read identifiers lazily through a
+/// MessageIdentifierSource.
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel);
 
+/// MessageIdentifierSource reads identifier values straight from a message.
+///
+/// Values are only computed when a compiled filter asks for them, so a filter
+/// that only checks `author.name` never looks at badges or channel state.
+/// Computed values are remembered, so a source should be shared by all
+/// filters evaluated for the same message.
+class MessageIdentifierSource : public IdentifierSource
+{
+public:
+    MessageIdentifierSource(const Message &message, Channel *channel);
+
+    Value value(Identifier identifier) override;
+
+private:
+    Value compute(Identifier identifier) const;
+
+    const Message &message_;
+    Channel *channel_;
+    std::array<std::optional<Value>, IDENTIFIER_COUNT> values_;
+};
+
 class Filter;
 struct FilterError {
     QString message;
@@ -40,15 +68,20 @@ public:
 
     Type returnType() const;
     QVariant execute(const ContextMap &context) const;
+    /// Evaluate the compiled form of this filter
+    Value execute(IdentifierSource &source) const;
 
     QString filterString() const;
     QString debugString(const TypingContext &context) const;
 
+    const Program &program() const;
+
 private:
     Filter(ExpressionPtr expression, Type returnType);
 
     ExpressionPtr expression_;
     Type returnType_;
+    Program program_;
 };
 
 }  // namespace chatterino::filters
@@ -0,0 +1,103 @@
+#include "controllers/filters/lang/Identifier.hpp"
+
+#include <QHash>
+
+#include <array>
+#include <cassert>
+
+namespace {
+
+using namespace chatterino::filters;
+
+using IdentifierTable = std::array<IdentifierInfo, IDENTIFIER_COUNT>;
+
+// This is a function so the table can be used to initialize other globals
+// (e.g. MESSAGE_TYPING_CONTEXT) regardless of static initialization order.
+const IdentifierTable &identifiers()
+{
+    // The order of this table must match the order of the Identifier enum
+    static const IdentifierTable IDENTIFIERS{{
+        {"author.badges", "author badges", Type::StringList},
+        {"author.color", "author color", Type::Color},
+        {"author.name", "author name", Type::String},
+        {"author.user_id", "author user id", Type::String},
+        {"author.no_color", "author has no color?", Type::Bool},
+        {"author.subbed", "author subscribed?", Type::Bool},
+        {"author.sub_length", "author sub length", Type::Int},
+
+        {"channel.name", "channel name", Type::String},
+        {"channel.watching", "/watching channel?", Type::Bool},
+        {"channel.live", "channel live?", Type::Bool},
+
+        {"flags.action", "action/me message?", Type::Bool},
+        {"flags.highlighted", "highlighted?", Type::Bool},
+        {"flags.points_redeemed", "redeemed points?", Type::Bool},
+        {"flags.sub_message", "sub/resub message?", Type::Bool},
+        {"flags.system_message", "system message?", Type::Bool},
+        {"flags.reward_message", "channel point reward message?", Type::Bool},
+        {"flags.first_message", "first message?", Type::Bool},
+        {"flags.elevated_message", "hype chat message?", Type::Bool},
+        // Ideally these values are unique, because ChannelFilterEditorDialog::ValueSpecifier::expressionText depends on
+        // std::map layout in Qt 6 and internal implementation in Qt 5.
+        {"flags.hype_chat", "hype chat message?", Type::Bool},
+        {"flags.cheer_message", "cheer message?", Type::Bool},
+        {"flags.whisper", "whisper message?", Type::Bool},
+        {"flags.reply", "reply message?", Type::Bool},
+        {"flags.automod", "automod message?", Type::Bool},
+        {"flags.restricted", "restricted message?", Type::Bool},
+        {"flags.monitored", "monitored message?", Type::Bool},
+        {"flags.shared", "shared message?", Type::Bool},
+        {"flags.similar", "r9k filtered message?", Type::Bool},
+
+        {"message.content", "message text", Type::String},
+        {"message.length", "message length", Type::Int},
+
+        {"reward.title", "point reward title", Type::String},
+        {"reward.cost", "point reward cost", Type::Int},
+        {"reward.id", "point reward id", Type::String},
+    }};
+    return IDENTIFIERS;
+}
+
+const QHash<QString, Identifier> &identifierLookup()
+{
+    static const QHash<QString, Identifier> lookup = [] {
+        QHash<QString, Identifier> map;
+        const auto &table = identifiers();
+        for (std::size_t i = 0; i < table.size(); ++i)
+        {
+            map.insert(table[i].name, static_cast<Identifier>(i));
+        }
+        return map;
+    }();
+    return lookup;
+}
+
+}  // namespace
+
+namespace chatterino::filters {
+
+const IdentifierInfo &identifierInfo(Identifier identifier)
+{
+    auto index = static_cast<std::size_t>(identifier);
+    assert(index < IDENTIFIER_COUNT);
+    return identifiers()[index];
+}
+
+std::optional<Identifier> identifierFromString(const QString &name)
+{
+    const auto &lookup = identifierLookup();
+    auto it = lookup.find(name);
+    if (it == lookup.end())
+    {
+        return std::nullopt;
+    }
+    return it.value();
+}
+
+QString identifierToString(Identifier identifier)
+{
+    return identifierInfo(identifier).name;
+}
+
+}  // namespace chatterino::filters
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "controllers/filters/lang/Types.hpp"
+
+#include <QString>
+
+#include <cstdint>
+#include <optional>
+
+namespace chatterino::filters {
+
+/// Identifier is the compiled form of a filter variable such as `author.name`.
+///
+/// Compiled filters refer to variables by this enum instead of by name, so
+/// looking up a variable at evaluation time is a switch instead of a string
+/// lookup in a map.
+///
+/// Looking to add a new identifier to filters? Here's what to do:
+///  1. Add the identifier to this enum
+///  2. Add its name, description and type to IDENTIFIERS in Identifier.cpp
+///  3. Return its value from MessageIdentifierSource::compute in Filter.cpp
+enum class Identifier : std::uint8_t {
+    AuthorBadges,
+    AuthorColor,
+    AuthorName,
+    AuthorUserID,
+    AuthorNoColor,
+    AuthorSubbed,
+    AuthorSubLength,
+
+    ChannelName,
+    ChannelWatching,
+    ChannelLive,
+
+    FlagsAction,
+    FlagsHighlighted,
+    FlagsPointsRedeemed,
+    FlagsSubMessage,
+    FlagsSystemMessage,
+    FlagsRewardMessage,
+    FlagsFirstMessage,
+    FlagsElevatedMessage,
+    FlagsHypeChat,
+    FlagsCheerMessage,
+    FlagsWhisper,
+    FlagsReply,
+    FlagsAutomod,
+    FlagsRestricted,
+    FlagsMonitored,
+    FlagsShared,
+    FlagsSimilar,
+
+    MessageContent,
+    MessageLength,
+
+    RewardTitle,
+    RewardCost,
+    RewardID,
+
+    // Must be last
+    Count,
+};
+
+constexpr std::size_t IDENTIFIER_COUNT =
+    static_cast<std::size_t>(Identifier::Count);
+
+struct IdentifierInfo {
+    /// The name used in filters (e.g. `author.name`)
+    QString name;
+    /// The description shown in the filter editor (e.g. `author name`)
+    QString description;
+    /// The type the identifier has during evaluation
+    Type type;
+};
+
+/// Returns the info for the given identifier
+const IdentifierInfo &identifierInfo(Identifier identifier);
+
+/// Returns the identifier for the given variable name (e.g. `author.name`)
+std::optional<Identifier> identifierFromString(const QString &name);
+
+/// Returns the variable name of the given identifier (e.g. `author.name`)
+QString identifierToString(Identifier identifier);
+
+}  // namespace chatterino::filters
@@ -0,0 +1,493 @@
+#include "controllers/filters/lang/Program.hpp"
+
+#include "controllers/filters/lang/expressions/BinaryOperation.hpp"
+#include "controllers/filters/lang/expressions/Expression.hpp"
+
+#include <QVarLengthArray>
+
+#include <algorithm>
+
+namespace chatterino::filters {
+
+QVariant valueToVariant(const Value &value)
+{
+    return std::visit(
+        [](const auto &inner) -> QVariant {
+            using T = std::decay_t<decltype(inner)>;
+            if constexpr (std::is_same_v<T, QVariant>)
+            {
+                return inner;
+            }
+            else
+            {
+                return QVariant::fromValue(inner);
+            }
+        },
+        value);
+}
+
+Value valueFromVariant(const QVariant &variant)
+{
+    if (variantIs(variant, QMetaType::Bool))
+    {
+        return variant.toBool();
+    }
+    if (variantIs(variant, QMetaType::Int))
+    {
+        return variant.toInt();
+    }
+    if (variantIs(variant, QMetaType::QString))
+    {
+        return variant.toString();
+    }
+    if (variantIs(variant, QMetaType::QStringList))
+    {
+        return variant.toStringList();
+    }
+    if (variantIs(variant, QMetaType::QColor))
+    {
+        return variant.value<QColor>();
+    }
+    return variant;
+}
+
+bool valueToBool(const Value &value)
+{
+    if (const auto *b = std::get_if<bool>(&value))
+    {
+        return *b;
+    }
+    return valueToVariant(value).toBool();
+}
+
+int valueToInt(const Value &value)
+{
+    if (const auto *i = std::get_if<int>(&value))
+    {
+        return *i;
+    }
+    return valueToVariant(value).toInt();
+}
+
+QString valueToString(const Value &value)
+{
+    if (const auto *s = std::get_if<QString>(&value))
+    {
+        return *s;
+    }
+    return valueToVariant(value).toString();
+}
+
+QStringList valueToStringList(const Value &value)
+{
+    if (const auto *list = std::get_if<QStringList>(&value))
+    {
+        return *list;
+    }
+    return valueToVariant(value).toStringList();
+}
+
+Program Program::compile(const Expression &expression,
+                         const TypingContext &context)
+{
+    ProgramBuilder builder(context);
+    builder.emitExpression(expression);
+    return builder.build();
+}
+
+const std::vector<Instruction> &Program::instructions() const
+{
+    return this->instructions_;
+}
+
+Value Program::execute(IdentifierSource &source) const
+{
+    QVarLengthArray<Value, 16> stack;
+
+    const auto pop = [&stack] {
+        auto value = std::move(stack.back());
+        stack.pop_back();
+        return value;
+    };
+    const auto intOp = [&](auto &&fn) {
+        auto rhs = valueToInt(pop());
+        auto lhs = valueToInt(stack.back());
+        stack.back() = fn(lhs, rhs);
+    };
+    const auto boolOp = [&](auto &&fn) {
+        auto rhs = valueToBool(pop());
+        auto lhs = valueToBool(stack.back());
+        stack.back() = fn(lhs, rhs);
+    };
+    const auto stringOp = [&](auto &&fn) {
+        auto rhs = valueToString(pop());
+        auto lhs = valueToString(stack.back());
+        stack.back() = fn(lhs, rhs);
+    };
+    const auto stringListOp = [&](auto &&fn) {
+        auto rhs = valueToString(pop());
+        auto lhs = valueToStringList(stack.back());
+        stack.back() = fn(lhs, rhs);
+    };
+
+    std::size_t pc = 0;
+    while (pc < this->instructions_.size())
+    {
+        const auto &instruction = this->instructions_[pc++];
+        switch (instruction.op)
+        {
+            case OpCode::PushConstant:
+                stack.push_back(this->constants_[instruction.arg]);
+                break;
+            case OpCode::PushIdentifier:
+                stack.push_back(
+                    source.value(static_cast<Identifier>(instruction.arg)));
+                break;
+            case OpCode::Pop:
+                stack.pop_back();
+                break;
+
+            case OpCode::JumpIfFalseOrPop:
+                if (!valueToBool(stack.back()))
+                {
+                    pc = instruction.arg;
+                }
+                else
+                {
+                    stack.pop_back();
+                }
+                break;
+            case OpCode::JumpIfTrueOrPop:
+                if (valueToBool(stack.back()))
+                {
+                    pc = instruction.arg;
+                }
+                else
+                {
+                    stack.pop_back();
+                }
+                break;
+
+            case OpCode::Not: {
+                auto &operand = stack.back();
+                if (const auto *b = std::get_if<bool>(&operand))
+                {
+                    operand = !*b;
+                    break;
+                }
+                // Same as UnaryOperation: values that can't be converted
+                // to a bool (e.g. invalid ones) negate to false
+                auto variant = valueToVariant(operand);
+                operand = variant.canConvert<bool>() && !variant.toBool();
+            }
+            break;
+
+            case OpCode::AddInt:
+                intOp([](int a, int b) {
+                    return a + b;
+                });
+                break;
+            case OpCode::SubtractInt:
+                intOp([](int a, int b) {
+                    return a - b;
+                });
+                break;
+            case OpCode::MultiplyInt:
+                intOp([](int a, int b) {
+                    return a * b;
+                });
+                break;
+            case OpCode::DivideInt:
+                intOp([](int a, int b) {
+                    return b == 0 ? 0 : a / b;
+                });
+                break;
+            case OpCode::ModInt:
+                intOp([](int a, int b) {
+                    return b == 0 ? 0 : a % b;
+                });
+                break;
+            case OpCode::EqInt:
+                intOp([](int a, int b) {
+                    return a == b;
+                });
+                break;
+            case OpCode::NeqInt:
+                intOp([](int a, int b) {
+                    return a != b;
+                });
+                break;
+            case OpCode::LtInt:
+                intOp([](int a, int b) {
+                    return a < b;
+                });
+                break;
+            case OpCode::GtInt:
+                intOp([](int a, int b) {
+                    return a > b;
+                });
+                break;
+            case OpCode::LteInt:
+                intOp([](int a, int b) {
+                    return a <= b;
+                });
+                break;
+            case OpCode::GteInt:
+                intOp([](int a, int b) {
+                    return a >= b;
+                });
+                break;
+
+            case OpCode::EqBool:
+                boolOp([](bool a, bool b) {
+                    return a == b;
+                });
+                break;
+            case OpCode::NeqBool:
+                boolOp([](bool a, bool b) {
+                    return a != b;
+                });
+                break;
+
+            case OpCode::Concat:
+                stringOp([](const QString &a, const QString &b) {
+                    return a + b;
+                });
+                break;
+            case OpCode::EqString:
+                stringOp([](const QString &a, const QString &b) {
+                    return a.compare(b, Qt::CaseInsensitive) == 0;
+                });
+                break;
+            case OpCode::NeqString:
+                stringOp([](const QString &a, const QString &b) {
+                    return a.compare(b, Qt::CaseInsensitive) != 0;
+                });
+                break;
+            case OpCode::ContainsString:
+                stringOp([](const QString &a, const QString &b) {
+                    return a.contains(b, Qt::CaseInsensitive);
+                });
+                break;
+            case OpCode::StartsWithString:
+                stringOp([](const QString &a, const QString &b) {
+                    return a.startsWith(b, Qt::CaseInsensitive);
+                });
+                break;
+            case OpCode::EndsWithString:
+                stringOp([](const QString &a, const QString &b) {
+                    return a.endsWith(b, Qt::CaseInsensitive);
+                });
+                break;
+            case OpCode::ContainsStringList:
+                stringListOp([](const QStringList &a, const QString &b) {
+                    return a.contains(b, Qt::CaseInsensitive);
+                });
+                break;
+            case OpCode::StartsWithStringList:
+                stringListOp([](const QStringList &a, const QString &b) {
+                    return !a.isEmpty() &&
+                           a.first().compare(b, Qt::CaseInsensitive) == 0;
+                });
+                break;
+            case OpCode::EndsWithStringList:
+                stringListOp([](const QStringList &a, const QString &b) {
+                    return !a.isEmpty() &&
+                           a.last().compare(b, Qt::CaseInsensitive) == 0;
+                });
+                break;
+
+            case OpCode::MatchRegex: {
+                const auto &matcher = this->matchers_[instruction.arg];
+                auto subject = valueToString(stack.back());
+                stack.back() = matcher.regex.match(subject).hasMatch();
+            }
+            break;
+            case OpCode::CaptureRegex: {
+                const auto &matcher = this->matchers_[instruction.arg];
+                auto subject = valueToString(stack.back());
+                auto match = matcher.regex.match(subject);
+                if (match.hasMatch())
+                {
+                    stack.back() = match.captured(matcher.captureGroup);
+                }
+                else
+                {
+                    stack.back() = QString("");
+                }
+            }
+            break;
+
+            case OpCode::MakeList: {
+                auto begin = stack.end() - instruction.arg;
+                bool allStrings =
+                    std::all_of(begin, stack.end(), [](const Value &value) {
+                        return std::holds_alternative<QString>(value);
+                    });
+
+                Value list;
+                if (allStrings)
+                {
+                    QStringList strings;
+                    strings.reserve(instruction.arg);
+                    for (auto it = begin; it != stack.end(); ++it)
+                    {
+                        strings.append(std::get<QString>(*it));
+                    }
+                    list = std::move(strings);
+                }
+                else
+                {
+                    QVariantList variants;
+                    variants.reserve(instruction.arg);
+                    for (auto it = begin; it != stack.end(); ++it)
+                    {
+                        variants.append(valueToVariant(*it));
+                    }
+                    list = QVariant(variants);
+                }
+
+                stack.resize(stack.size() - instruction.arg);
+                stack.push_back(std::move(list));
+            }
+            break;
+
+            case OpCode::Generic: {
+                auto rhs = valueToVariant(pop());
+                auto lhs = valueToVariant(stack.back());
+                stack.back() = valueFromVariant(BinaryOperation::evaluate(
+                    static_cast<TokenType>(instruction.arg), lhs, rhs));
+            }
+            break;
+        }
+    }
+
+    if (stack.isEmpty())
+    {
+        return QVariant();
+    }
+    return pop();
+}
+
+ProgramBuilder::ProgramBuilder(const TypingContext &context)
+    : context_(context)
+{
+}
+
+const TypingContext &ProgramBuilder::typingContext() const
+{
+    return this->context_;
+}
+
+void ProgramBuilder::emitExpression(const Expression &expression)
+{
+    auto &instructions = this->program_.instructions_;
+    auto start = instructions.size();
+
+    expression.compile(*this);
+
+    if (instructions.size() - start == 1 &&
+        instructions.back().op == OpCode::PushConstant)
+    {
+        // already a constant
+        return;
+    }
+
+    bool referencesIdentifier =
+        std::any_of(instructions.begin() + static_cast<std::ptrdiff_t>(start),
+                    instructions.end(), [](const Instruction &instruction) {
+                        return instruction.op == OpCode::PushIdentifier;
+                    });
+    if (referencesIdentifier)
+    {
+        return;
+    }
+
+    // The expression is constant, so evaluate it right away
+    instructions.resize(start);
+    this->emitConstant(valueFromVariant(expression.execute({})));
+}
+
+void ProgramBuilder::emit(OpCode op, int arg)
+{
+    this->program_.instructions_.push_back({op, arg});
+}
+
+void ProgramBuilder::emitConstant(Value value)
+{
+    auto &constants = this->program_.constants_;
+    constants.push_back(std::move(value));
+    this->emit(OpCode::PushConstant, static_cast<int>(constants.size() - 1));
+}
+
+void ProgramBuilder::emitIdentifier(Identifier identifier)
+{
+    this->emit(OpCode::PushIdentifier, static_cast<int>(identifier));
+}
+
+std::size_t ProgramBuilder::emitJump(OpCode op)
+{
+    this->emit(op, -1);
+    return this->program_.instructions_.size() - 1;
+}
+
+void ProgramBuilder::patchJump(std::size_t jump)
+{
+    this->program_.instructions_[jump].arg =
+        static_cast<int>(this->program_.instructions_.size());
+}
+
+bool ProgramBuilder::tryEmitMatch()
+{
+    auto &instructions = this->program_.instructions_;
+    if (instructions.empty() ||
+        instructions.back().op != OpCode::PushConstant)
+    {
+        return false;
+    }
+
+    auto &last = instructions.back();
+    auto specifier = valueToVariant(this->program_.constants_[last.arg]);
+
+    if (variantIs(specifier, QMetaType::QRegularExpression))
+    {
+        this->program_.matchers_.push_back({
+            .regex = specifier.toRegularExpression(),
+        });
+        last = {
+            OpCode::MatchRegex,
+            static_cast<int>(this->program_.matchers_.size() - 1),
+        };
+        return true;
+    }
+
+    if (variantIs(specifier, QMetaType::QVariantList))
+    {
+        auto list = specifier.toList();
+        if (list.size() != 2 ||
+            variantIsNot(list.at(0), QMetaType::QRegularExpression) ||
+            variantIsNot(list.at(1), QMetaType::Int))
+        {
+            return false;
+        }
+
+        this->program_.matchers_.push_back({
+            .regex = list.at(0).toRegularExpression(),
+            .captureGroup = list.at(1).toInt(),
+        });
+        last = {
+            OpCode::CaptureRegex,
+            static_cast<int>(this->program_.matchers_.size() - 1),
+        };
+        return true;
+    }
+
+    return false;
+}
+
+Program ProgramBuilder::build()
+{
+    return std::move(this->program_);
+}
+
+}  // namespace chatterino::filters
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "controllers/filters/lang/Identifier.hpp"
+#include "controllers/filters/lang/Tokenizer.hpp"
+#include "controllers/filters/lang/Types.hpp"
+
+#include <QColor>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+namespace chatterino::filters {
+
+class Expression;
+
+/// Value is a single entry on the evaluation stack of a compiled filter.
+///
+/// The types a message identifier can have are stored unboxed. Everything else
+/// (regular expressions, lists of mixed types, ...) is stored as a QVariant.
+using Value = std::variant<bool, int, QString, QStringList, QColor, QVariant>;
+
+QVariant valueToVariant(const Value &value);
+Value valueFromVariant(const QVariant &variant);
+
+bool valueToBool(const Value &value);
+int valueToInt(const Value &value);
+QString valueToString(const Value &value);
+QStringList valueToStringList(const Value &value);
+
+/// IdentifierSource supplies the values of identifiers to a running Program.
+///
+/// A Program only asks for the identifiers it references, so a source can
+/// compute its values lazily.
+class IdentifierSource
+{
+public:
+    virtual ~IdentifierSource() = default;
+
+    virtual Value value(Identifier identifier) = 0;
+};
+
+enum class OpCode : std::uint8_t {
+    /// Push constants_[arg]
+    PushConstant,
+    /// Push the value of Identifier(arg)
+    PushIdentifier,
+    /// Discard the top of the stack
+    Pop,
+
+    /// If the top of the stack is false, jump to arg, otherwise pop it
+    JumpIfFalseOrPop,
+    /// If the top of the stack is true, jump to arg, otherwise pop it
+    JumpIfTrueOrPop,
+
+    Not,
+
+    AddInt,
+    SubtractInt,
+    MultiplyInt,
+    DivideInt,
+    ModInt,
+    EqInt,
+    NeqInt,
+    LtInt,
+    GtInt,
+    LteInt,
+    GteInt,
+
+    EqBool,
+    NeqBool,
+
+    /// String + (String | Int | Bool)
+    Concat,
+    // String comparisons are case-insensitive
+    EqString,
+    NeqString,
+    ContainsString,
+    StartsWithString,
+    EndsWithString,
+    ContainsStringList,
+    StartsWithStringList,
+    EndsWithStringList,
+
+    /// Replace the String on top of the stack with whether matchers_[arg]
+    /// matches it
+    MatchRegex,
+    /// Replace the String on top of the stack with the capture group of
+    /// matchers_[arg]
+    CaptureRegex,
+
+    /// Pop arg values and push them as a list
+    MakeList,
+
+    /// Fallback for operand types without a specialized instruction.
+    /// arg is the TokenType of the operation. Operands are converted to
+    /// QVariant and evaluated like the expression tree would.
+    Generic,
+};
+
+struct Instruction {
+    OpCode op;
+    int arg = 0;
+};
+
+/// Program is a filter expression compiled into a flat list of typed
+/// instructions for a small stack machine.
+///
+/// Compiling happens after the expression has been type checked, so most
+/// operations can be resolved to an instruction that works on unboxed values.
+/// Sub-expressions that don't reference any identifier are evaluated once at
+/// compile time.
+class Program
+{
+public:
+    static Program compile(const Expression &expression,
+                           const TypingContext &context);
+
+    Value execute(IdentifierSource &source) const;
+
+    const std::vector<Instruction> &instructions() const;
+
+private:
+    struct Matcher {
+        QRegularExpression regex;
+        int captureGroup = 0;
+    };
+
+    std::vector<Instruction> instructions_;
+    std::vector<Value> constants_;
+    std::vector<Matcher> matchers_;
+
+    friend class ProgramBuilder;
+};
+
+/// ProgramBuilder is passed to Expression::compile to emit instructions
+class ProgramBuilder
+{
+public:
+    explicit ProgramBuilder(const TypingContext &context);
+
+    const TypingContext &typingContext() const;
+
+    /// Compile the given expression.
+    ///
+    /// If the expression doesn't reference any identifier, it's evaluated and
+    /// emitted as a single constant.
+    void emitExpression(const Expression &expression);
+
+    void emit(OpCode op, int arg = 0);
+    void emitConstant(Value value);
+    void emitIdentifier(Identifier identifier);
+
+    /// Emit a jump instruction whose target is set by patchJump
+    std::size_t emitJump(OpCode op);
+    /// Point the given jump to the next instruction to be emitted
+    void patchJump(std::size_t jump);
+
+    /// Try to turn the constant pushed by the last instruction into a
+    /// MatchRegex or CaptureRegex instruction.
+    ///
+    /// Returns false if the last instruction isn't a constant regular
+    /// expression or matching specifier.
+    bool tryEmitMatch();
+
+    Program build();
+
+private:
+    const TypingContext &context_;
+    Program program_;
+};
+
+}  // namespace chatterino::filters
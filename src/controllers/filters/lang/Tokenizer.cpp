@@ -1,6 +1,7 @@
 #include "controllers/filters/lang/Tokenizer.hpp"
 
 #include "common/QLogging.hpp"
+#include "controllers/filters/lang/Identifier.hpp"
 
 namespace {
 
@@ -16,42 +17,15 @@ const QRegularExpression TOKEN_REGEX(
 
 namespace chatterino::filters {
 
-const QMap<QString, QString> VALID_IDENTIFIERS_MAP{
-    {"author.badges", "author badges"},
-    {"author.color", "author color"},
-    {"author.name", "author name"},
-    {"author.user_id", "author user id"},
-    {"author.no_color", "author has no color?"},
-    {"author.subbed", "author subscribed?"},
-    {"author.sub_length", "author sub length"},
-    {"channel.name", "channel name"},
-    {"channel.watching", "/watching channel?"},
-    {"channel.live", "channel live?"},
-    {"flags.action", "action/me message?"},
-    {"flags.highlighted", "highlighted?"},
-    {"flags.points_redeemed", "redeemed points?"},
-    {"flags.sub_message", "sub/resub message?"},
-    {"flags.system_message", "system message?"},
-    {"flags.reward_message", "channel point reward message?"},
-    {"flags.first_message", "first message?"},
-    {"flags.elevated_message", "hype chat message?"},
-    // Ideally these values are unique, because ChannelFilterEditorDialog::ValueSpecifier::expressionText depends on
-    // std::map layout in Qt 6 and internal implementation in Qt 5.
-    {"flags.hype_chat", "hype chat message?"},
-    {"flags.cheer_message", "cheer message?"},
-    {"flags.whisper", "whisper message?"},
-    {"flags.reply", "reply message?"},
-    {"flags.automod", "automod message?"},
-    {"flags.restricted", "restricted message?"},
-    {"flags.monitored", "monitored message?"},
-    {"flags.shared", "shared message?"},
-    {"flags.similar", "r9k filtered message?"},
-    {"message.content", "message text"},
-    {"message.length", "message length"},
-    {"reward.title", "point reward title"},
-    {"reward.cost", "point reward cost"},
-    {"reward.id", "point reward id"},
-};
+const QMap<QString, QString> VALID_IDENTIFIERS_MAP = [] {
+    QMap<QString, QString> map;
+    for (std::size_t i = 0; i < IDENTIFIER_COUNT; ++i)
+    {
+        const auto &info = identifierInfo(static_cast<Identifier>(i));
+        map.insert(info.name, info.description);
+    }
+    return map;
+}();
 
 QString tokenTypeToInfoString(TokenType type)
 {
@@ -327,7 +301,7 @@ TokenType Tokenizer::tokenize(const QString &text)
             return TokenType::STRING;
         }
 
-        if (VALID_IDENTIFIERS_MAP.keys().contains(text))
+        if (identifierFromString(text).has_value())
         {
             return TokenType::IDENTIFIER;
         }
@@ -1,9 +1,15 @@
 #include "controllers/filters/lang/expressions/BinaryOperation.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
 #include <QRegularExpression>
 
+#include <optional>
+
 namespace {
 
+using namespace chatterino::filters;
+
 /// Loosely compares `lhs` with `rhs`.
 /// This attempts to convert both variants to a common type if they're not equal.
 bool looselyCompareVariants(QVariant &lhs, QVariant &rhs)
@@ -37,6 +43,117 @@ bool looselyCompareVariants(QVariant &lhs, QVariant &rhs)
     return lhs == rhs;
 }
 
+bool hasType(const PossibleType &possible, Type type)
+{
+    return isWellTyped(possible) && std::get<TypeClass>(possible) == type;
+}
+
+/// Returns the specialized instruction for `op` with operands of the given
+/// types, or std::nullopt if the operation needs the generic fallback.
+std::optional<OpCode> typedOpCode(TokenType op, const PossibleType &left,
+                                  const PossibleType &right)
+{
+    bool ints = hasType(left, Type::Int) && hasType(right, Type::Int);
+    bool bools = hasType(left, Type::Bool) && hasType(right, Type::Bool);
+    bool strings = hasType(left, Type::String) && hasType(right, Type::String);
+    bool stringList =
+        hasType(left, Type::StringList) && hasType(right, Type::String);
+
+    switch (op)
+    {
+        case PLUS:
+            if (ints)
+            {
+                return OpCode::AddInt;
+            }
+            if (hasType(left, Type::String) &&
+                (hasType(right, Type::String) || hasType(right, Type::Int) ||
+                 hasType(right, Type::Bool)))
+            {
+                return OpCode::Concat;
+            }
+            break;
+        case MINUS:
+            return ints ? std::optional(OpCode::SubtractInt) : std::nullopt;
+        case MULTIPLY:
+            return ints ? std::optional(OpCode::MultiplyInt) : std::nullopt;
+        case DIVIDE:
+            return ints ? std::optional(OpCode::DivideInt) : std::nullopt;
+        case MOD:
+            return ints ? std::optional(OpCode::ModInt) : std::nullopt;
+        case LT:
+            return ints ? std::optional(OpCode::LtInt) : std::nullopt;
+        case GT:
+            return ints ? std::optional(OpCode::GtInt) : std::nullopt;
+        case LTE:
+            return ints ? std::optional(OpCode::LteInt) : std::nullopt;
+        case GTE:
+            return ints ? std::optional(OpCode::GteInt) : std::nullopt;
+        case EQ:
+            if (ints)
+            {
+                return OpCode::EqInt;
+            }
+            if (bools)
+            {
+                return OpCode::EqBool;
+            }
+            if (strings)
+            {
+                return OpCode::EqString;
+            }
+            break;
+        case NEQ:
+            if (ints)
+            {
+                return OpCode::NeqInt;
+            }
+            if (bools)
+            {
+                return OpCode::NeqBool;
+            }
+            if (strings)
+            {
+                return OpCode::NeqString;
+            }
+            break;
+        case CONTAINS:
+            if (strings)
+            {
+                return OpCode::ContainsString;
+            }
+            if (stringList)
+            {
+                return OpCode::ContainsStringList;
+            }
+            break;
+        case STARTS_WITH:
+            if (strings)
+            {
+                return OpCode::StartsWithString;
+            }
+            if (stringList)
+            {
+                return OpCode::StartsWithStringList;
+            }
+            break;
+        case ENDS_WITH:
+            if (strings)
+            {
+                return OpCode::EndsWithString;
+            }
+            if (stringList)
+            {
+                return OpCode::EndsWithStringList;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return std::nullopt;
+}
+
 }  // namespace
 
 namespace chatterino::filters {
@@ -51,9 +168,13 @@ BinaryOperation::BinaryOperation(TokenType op, ExpressionPtr left,
 
 QVariant BinaryOperation::execute(const ContextMap &context) const
 {
-    auto left = this->left_->execute(context);
-    auto right = this->right_->execute(context);
-    switch (this->op_)
+    return BinaryOperation::evaluate(this->op_, this->left_->execute(context),
+                                     this->right_->execute(context));
+}
+
+QVariant BinaryOperation::evaluate(TokenType op, QVariant left, QVariant right)
+{
+    switch (op)
     {
         case PLUS:
             if (variantIs(left, QMetaType::QString) &&
@@ -79,13 +200,15 @@ QVariant BinaryOperation::execute(const ContextMap &context) const
             }
             return 0;
         case DIVIDE:
-            if (convertVariantTypes(left, right, QMetaType::Int))
+            if (convertVariantTypes(left, right, QMetaType::Int) &&
+                right.toInt() != 0)
             {
                 return left.toInt() / right.toInt();
             }
             return 0;
         case MOD:
-            if (convertVariantTypes(left, right, QMetaType::Int))
+            if (convertVariantTypes(left, right, QMetaType::Int) &&
+                right.toInt() != 0)
             {
                 return left.toInt() % right.toInt();
             }
@@ -384,6 +507,43 @@ PossibleType BinaryOperation::synthesizeType(const TypingContext &context) const
     }
 }
 
+void BinaryOperation::compile(ProgramBuilder &builder) const
+{
+    const auto &context = builder.typingContext();
+    auto left = this->left_->synthesizeType(context);
+    auto right = this->right_->synthesizeType(context);
+
+    if ((this->op_ == AND || this->op_ == OR) && hasType(left, Type::Bool) &&
+        hasType(right, Type::Bool))
+    {
+        // short-circuit: the right side is only evaluated if it's needed
+        builder.emitExpression(*this->left_);
+        auto jump = builder.emitJump(this->op_ == AND
+                                         ? OpCode::JumpIfFalseOrPop
+                                         : OpCode::JumpIfTrueOrPop);
+        builder.emitExpression(*this->right_);
+        builder.patchJump(jump);
+        return;
+    }
+
+    builder.emitExpression(*this->left_);
+    builder.emitExpression(*this->right_);
+
+    if (this->op_ == MATCH && hasType(left, Type::String) &&
+        builder.tryEmitMatch())
+    {
+        return;
+    }
+
+    if (auto opCode = typedOpCode(this->op_, left, right))
+    {
+        builder.emit(*opCode);
+        return;
+    }
+
+    builder.emit(OpCode::Generic, this->op_);
+}
+
 QString BinaryOperation::debug(const TypingContext &context) const
 {
     return QString("BinaryOp[%1](%2 : %3, %4 : %5)")
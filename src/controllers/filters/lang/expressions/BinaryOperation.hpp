@@ -10,10 +10,14 @@ class BinaryOperation : public Expression
 public:
     BinaryOperation(TokenType op, ExpressionPtr left, ExpressionPtr right);
 
+    /// Evaluate the operation on already evaluated operands
+    static QVariant evaluate(TokenType op, QVariant left, QVariant right);
+
     QVariant execute(const ContextMap &context) const override;
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    void compile(ProgramBuilder &builder) const override;
 
 private:
     TokenType op_;
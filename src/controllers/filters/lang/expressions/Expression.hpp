@@ -11,6 +11,8 @@
 
 namespace chatterino::filters {
 
+class ProgramBuilder;
+
 class Expression
 {
 public:
@@ -20,6 +22,9 @@ public:
     virtual PossibleType synthesizeType(const TypingContext &context) const = 0;
     virtual QString debug(const TypingContext &context) const = 0;
     virtual QString filterString() const = 0;
+
+    /// Emit the instructions evaluating this expression to the builder
+    virtual void compile(ProgramBuilder &builder) const = 0;
 };
 
 using ExpressionPtr = std::unique_ptr<Expression>;
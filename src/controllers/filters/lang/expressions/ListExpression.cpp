@@ -1,5 +1,7 @@
 #include "controllers/filters/lang/expressions/ListExpression.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
 namespace chatterino::filters {
 
 ListExpression::ListExpression(ExpressionList &&list)
@@ -81,6 +83,15 @@ QString ListExpression::debug(const TypingContext &context) const
     return QString("List(%1)").arg(debugs.join(", "));
 }
 
+void ListExpression::compile(ProgramBuilder &builder) const
+{
+    for (const auto &exp : this->list_)
+    {
+        builder.emitExpression(*exp);
+    }
+    builder.emit(OpCode::MakeList, static_cast<int>(this->list_.size()));
+}
+
 QString ListExpression::filterString() const
 {
     QStringList strings;
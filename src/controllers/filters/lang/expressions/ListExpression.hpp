@@ -14,6 +14,7 @@ public:
     PossibleType synthesizeType(const TypingContext &context) const override;
     QString debug(const TypingContext &context) const override;
     QString filterString() const override;
+    void compile(ProgramBuilder &builder) const override;
 
 private:
     ExpressionList list_;
@@ -1,5 +1,7 @@
 #include "controllers/filters/lang/expressions/RegexExpression.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
 namespace chatterino::filters {
 
 RegexExpression::RegexExpression(const QString &regex, bool caseInsensitive)
@@ -25,6 +27,11 @@ QString RegexExpression::debug(const TypingContext & /*context*/) const
     return QString("RegEx(%1)").arg(this->regexString_);
 }
 
+void RegexExpression::compile(ProgramBuilder &builder) const
+{
+    builder.emitConstant(QVariant(this->regex_));
+}
+
 QString RegexExpression::filterString() const
 {
     auto s = this->regexString_;
@@ -1,5 +1,7 @@
 #include "controllers/filters/lang/expressions/UnaryOperation.hpp"
 
+#include "controllers/filters/lang/Program.hpp"
+
 namespace chatterino::filters {
 
 UnaryOperation::UnaryOperation(TokenType op, ExpressionPtr right)
@@ -43,6 +45,21 @@ PossibleType UnaryOperation::synthesizeType(const TypingContext &context) const
     }
 }
 
+void UnaryOperation::compile(ProgramBuilder &builder) const
+{
+    builder.emitExpression(*this->right_);
+    switch (this->op_)
+    {
+        case NOT:
+            builder.emit(OpCode::Not);
+            break;
+        default:
+            builder.emit(OpCode::Pop);
+            builder.emitConstant(false);
+            break;
+    }
+}
+
 QString UnaryOperation::debug(const TypingContext &context) const
 {
     return QString("UnaryOp[%1](%2 : %3)")
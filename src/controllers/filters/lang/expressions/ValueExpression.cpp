@@ -1,5 +1,7 @@
 #include "controllers/filters/lang/expressions/ValueExpression.hpp"
 
+#include "controllers/filters/lang/Identifier.hpp"
+#include "controllers/filters/lang/Program.hpp"
 #include "controllers/filters/lang/Tokenizer.hpp"
 
 namespace chatterino::filters {
@@ -51,6 +53,26 @@ QString ValueExpression::debug(const TypingContext & /*context*/) const
     return QString("Val(%1)").arg(this->value_.toString());
 }
 
+void ValueExpression::compile(ProgramBuilder &builder) const
+{
+    if (this->type_ == TokenType::IDENTIFIER)
+    {
+        auto identifier = identifierFromString(this->value_.toString());
+        if (identifier)
+        {
+            builder.emitIdentifier(*identifier);
+        }
+        else
+        {
+            // Unbound identifiers evaluate to an invalid value
+            builder.emitConstant(QVariant());
+        }
+        return;
+    }
+
+    builder.emitConstant(valueFromVariant(this->value_));
+}
+
 QString ValueExpression::filterString() const
 {
     switch (this->type_)
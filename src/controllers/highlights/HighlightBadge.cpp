@@ -3,6 +3,8 @@
 #include "providers/twitch/TwitchBadge.hpp"
 #include "util/IrcHelpers.hpp"
 
+#include <QStringBuilder>
+
 namespace chatterino {
 
 QColor HighlightBadge::FALLBACK_HIGHLIGHT_COLOR = QColor(127, 63, 73, 127);
@@ -104,6 +106,42 @@ bool HighlightBadge::compare(const QString &id, const Badge &badge) const
     return id.compare(badge.key_, Qt::CaseInsensitive) == 0;
 }
 
+QStringList HighlightBadge::lookupKeys() const
+{
+    const auto ids =
+        this->isMulti_ ? this->badges_ : QStringList{this->badgeName_};
+    QStringList keys;
+    keys.reserve(ids.size());
+    for (const auto &id : ids)
+    {
+        if (this->hasVersions_)
+        {
+            auto parts = slashKeyValue(id);
+            keys.append(QString(parts.first.toCaseFolded() % u'/' %
+                                parts.second.toCaseFolded()));
+        }
+        else
+        {
+            keys.append(id.toCaseFolded());
+        }
+    }
+    return keys;
+}
+
+bool HighlightBadge::hasVersions() const
+{
+    return this->hasVersions_;
+}
+
+QString HighlightBadge::lookupKey(const Badge &badge, bool withVersion)
+{
+    if (withVersion)
+    {
+        return badge.key_.toCaseFolded() % u'/' % badge.value_.toCaseFolded();
+    }
+    return badge.key_.toCaseFolded();
+}
+
 bool HighlightBadge::hasCustomSound() const
 {
     return !this->soundUrl_.isEmpty();
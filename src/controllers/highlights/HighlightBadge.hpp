@@ -34,6 +34,27 @@ public:
     bool hasSound() const;
     bool isMatch(const Badge &badge) const;
 
+    /**
+     * @brief Returns the keys a badge has to be looked up by to match this
+     *        highlight.
+     *
+     * A badge matches this highlight if `lookupKey(badge, hasVersions())` is
+     * one of the returned keys.
+     */
+    QStringList lookupKeys() const;
+
+    /**
+     * @brief Check if this highlight matches a specific badge version (e.g.
+     *        `subscriber/12`) instead of any version of a badge.
+     */
+    bool hasVersions() const;
+
+    /**
+     * @brief Returns the key of a badge for comparing it against the
+     *        lookupKeys of highlights.
+     */
+    static QString lookupKey(const Badge &badge, bool withVersion);
+
     /**
      * @brief Check if this highlight phrase has a custom sound set.
      *
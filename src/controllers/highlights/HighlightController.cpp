@@ -12,47 +12,298 @@
 #include "providers/twitch/TwitchBadge.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
+#include "util/AhoCorasick.hpp"
+#include "util/RegexUnion.hpp"
+
+#include <QHash>
+#include <QVarLengthArray>
+
+#include <algorithm>
 
 namespace {
 
 using namespace chatterino;
 
-auto highlightPhraseCheck(const HighlightPhrase &highlight) -> HighlightCheck
+/// Merges `other` into `result`.
+///
+/// Flags are enabled if either result enables them, the sound and color of
+/// `result` take precedence over the ones of `other`.
+void mergeHighlightResult(HighlightResult &result, const HighlightResult &other)
+{
+    if (other.alert && !result.alert)
+    {
+        result.alert = other.alert;
+    }
+
+    if (other.playSound && !result.playSound)
+    {
+        result.playSound = other.playSound;
+    }
+
+    if (other.customSoundUrl && !result.customSoundUrl)
+    {
+        result.customSoundUrl = other.customSoundUrl;
+    }
+
+    if (other.color && !result.color)
+    {
+        result.color = other.color;
+    }
+
+    if (other.showInMentions && !result.showInMentions)
+    {
+        result.showInMentions = other.showInMentions;
+    }
+}
+
+/// Returns the result of a single matching HighlightPhrase or HighlightBadge
+template <typename Highlight>
+HighlightResult highlightResult(const Highlight &highlight)
 {
-    return HighlightCheck{
-        [highlight](const auto &args, const auto &badges,
-                    const auto &senderName, const auto &originalMessage,
-                    const auto &flags,
-                    const auto self) -> std::optional<HighlightResult> {
-            (void)args;        // unused
-            (void)badges;      // unused
-            (void)senderName;  // unused
-            (void)flags;       // unused
-
-            if (self)
+    std::optional<QUrl> highlightSoundUrl;
+    if (highlight.hasCustomSound())
+    {
+        highlightSoundUrl = highlight.getSoundUrl();
+    }
+
+    return HighlightResult{
+        highlight.hasAlert(),       highlight.hasSound(),
+        highlightSoundUrl,          highlight.getColor(),
+        highlight.showInMentions(),
+    };
+}
+
+/// Returns true if `name` only consists of ASCII word characters, like Twitch
+/// login names do
+bool isPlainName(const QString &name)
+{
+    return !name.isEmpty() &&
+           std::all_of(name.begin(), name.end(), [](QChar c) {
+               return (c >= u'a' && c <= u'z') || (c >= u'A' && c <= u'Z') ||
+                      (c >= u'0' && c <= u'9') || c == u'_';
+           });
+}
+
+/// PhraseMatcher checks a subject against a list of HighlightPhrases at once.
+///
+/// Plain phrases are found by a single Aho-Corasick scan over the case folded
+/// subject. If the subject is a plain name, a plain phrase can only match the
+/// whole subject, so they're looked up in a hash map instead.
+/// Regular expressions are combined into a RegexUnion, so a subject none of
+/// them match is rejected by a single scan.
+///
+/// Every candidate found this way is confirmed with HighlightPhrase::isMatch,
+/// so the result is the same as checking each phrase on its own.
+class PhraseMatcher
+{
+public:
+    explicit PhraseMatcher(std::vector<HighlightPhrase> phrases)
+        : phrases_(std::move(phrases))
+    {
+        for (std::size_t i = 0; i < this->phrases_.size(); i++)
+        {
+            const auto &phrase = this->phrases_[i];
+            if (!phrase.isValid())
             {
-                // Phrase checks should ignore highlights from the user
-                return std::nullopt;
+                continue;
             }
 
-            if (!highlight.isMatch(originalMessage))
+            if (!phrase.isRegex())
             {
-                return std::nullopt;
+                auto folded = phrase.getPattern().toCaseFolded();
+                this->plain_.addPattern(folded, i);
+                this->names_[folded].push_back(i);
+                continue;
             }
 
-            std::optional<QUrl> highlightSoundUrl;
-            if (highlight.hasCustomSound())
+            if (this->regexes_.add(phrase.getRegex(), i))
             {
-                highlightSoundUrl = highlight.getSoundUrl();
+                this->combined_.push_back(i);
             }
+            else
+            {
+                this->standalone_.push_back(i);
+            }
+        }
 
-            return HighlightResult{
-                highlight.hasAlert(),       highlight.hasSound(),
-                highlightSoundUrl,          highlight.getColor(),
-                highlight.showInMentions(),
-            };
-        }};
-}
+        this->plain_.build();
+
+        std::vector<std::size_t> rejected;
+        this->regexes_.build(&rejected);
+        if (!rejected.empty())
+        {
+            this->combined_.clear();
+            this->standalone_.insert(this->standalone_.end(), rejected.begin(),
+                                     rejected.end());
+        }
+    }
+
+    /// Returns the merged result of all phrases matching `subject`, or
+    /// std::nullopt if none match
+    std::optional<HighlightResult> check(const QString &subject) const
+    {
+        enum class Candidate : std::uint8_t {
+            None,
+            Maybe,
+            Match,
+        };
+
+        QVarLengthArray<Candidate, 128> candidates(
+            static_cast<qsizetype>(this->phrases_.size()));
+        std::fill(candidates.begin(), candidates.end(), Candidate::None);
+
+        if (isPlainName(subject))
+        {
+            auto it = this->names_.find(subject.toCaseFolded());
+            if (it != this->names_.end())
+            {
+                for (auto idx : *it)
+                {
+                    candidates[idx] = Candidate::Maybe;
+                }
+            }
+        }
+        else
+        {
+            this->plain_.findAll(subject.toCaseFolded(),
+                                 [&](const AhoCorasick::Match &match) {
+                                     candidates[match.id] = Candidate::Maybe;
+                                 });
+        }
+
+        if (auto first = this->regexes_.firstMatch(subject))
+        {
+            // Other expressions might match as well
+            for (auto idx : this->combined_)
+            {
+                candidates[idx] = Candidate::Maybe;
+            }
+            candidates[*first] = Candidate::Match;
+        }
+
+        for (auto idx : this->standalone_)
+        {
+            candidates[idx] = Candidate::Maybe;
+        }
+
+        std::optional<HighlightResult> result;
+        for (std::size_t i = 0; i < this->phrases_.size(); i++)
+        {
+            const auto &phrase = this->phrases_[i];
+            if (candidates[i] == Candidate::None ||
+                (candidates[i] == Candidate::Maybe && !phrase.isMatch(subject)))
+            {
+                continue;
+            }
+
+            if (!result)
+            {
+                result = HighlightResult::emptyResult();
+            }
+            mergeHighlightResult(*result, highlightResult(phrase));
+            if (result->full())
+            {
+                break;
+            }
+        }
+
+        return result;
+    }
+
+private:
+    std::vector<HighlightPhrase> phrases_;
+
+    AhoCorasick plain_;
+    /// Case folded plain phrase -> indices into phrases_
+    QHash<QString, std::vector<std::size_t>> names_;
+
+    RegexUnion regexes_;
+    /// Indices of the phrases in regexes_
+    std::vector<std::size_t> combined_;
+    /// Indices of the regular expressions that have to be checked on their
+    /// own
+    std::vector<std::size_t> standalone_;
+};
+
+/// BadgeMatcher checks the badges of a message against a list of
+/// HighlightBadges by looking each badge up in a hash map
+class BadgeMatcher
+{
+public:
+    explicit BadgeMatcher(std::vector<HighlightBadge> highlights)
+        : highlights_(std::move(highlights))
+    {
+        for (std::size_t i = 0; i < this->highlights_.size(); i++)
+        {
+            const auto &highlight = this->highlights_[i];
+            auto &lookup =
+                highlight.hasVersions() ? this->versioned_ : this->keys_;
+            for (const auto &key : highlight.lookupKeys())
+            {
+                auto &indices = lookup[key];
+                if (indices.empty() || indices.back() != i)
+                {
+                    indices.push_back(i);
+                }
+            }
+        }
+    }
+
+    /// Returns the merged result of all highlights matching any of `badges`,
+    /// or std::nullopt if none match
+    std::optional<HighlightResult> check(const std::vector<Badge> &badges) const
+    {
+        QVarLengthArray<std::size_t, 16> matched;
+        const auto lookup = [&](const auto &map, const QString &key) {
+            auto it = map.find(key);
+            if (it != map.end())
+            {
+                matched.append(it->data(), static_cast<qsizetype>(it->size()));
+            }
+        };
+
+        for (const Badge &badge : badges)
+        {
+            if (!this->keys_.isEmpty())
+            {
+                lookup(this->keys_, HighlightBadge::lookupKey(badge, false));
+            }
+            if (!this->versioned_.isEmpty())
+            {
+                lookup(this->versioned_,
+                       HighlightBadge::lookupKey(badge, true));
+            }
+        }
+
+        if (matched.isEmpty())
+        {
+            return std::nullopt;
+        }
+
+        // Highlights are merged in the order they're configured in
+        std::sort(matched.begin(), matched.end());
+        auto end = std::unique(matched.begin(), matched.end());
+
+        auto result = HighlightResult::emptyResult();
+        for (auto it = matched.begin(); it != end; ++it)
+        {
+            mergeHighlightResult(result,
+                                 highlightResult(this->highlights_[*it]));
+            if (result.full())
+            {
+                break;
+            }
+        }
+        return result;
+    }
+
+private:
+    std::vector<HighlightBadge> highlights_;
+
+    /// Lookup key -> indices into highlights_
+    QHash<QString, std::vector<std::size_t>> keys_;
+    QHash<QString, std::vector<std::size_t>> versioned_;
+};
 
 void rebuildSubscriptionHighlights(Settings &settings,
                                    std::vector<HighlightCheck> &checks)
@@ -186,23 +437,40 @@ void rebuildMessageHighlights(Settings &settings,
     auto currentUser = getApp()->getAccounts()->twitch.getCurrent();
     QString currentUsername = currentUser->getUserName();
 
+    std::vector<HighlightPhrase> phrases;
+
     if (settings.enableSelfHighlight && !currentUsername.isEmpty() &&
         !currentUser->isAnon())
     {
-        HighlightPhrase highlight(
+        phrases.emplace_back(
             currentUsername, settings.showSelfHighlightInMentions,
             settings.enableSelfHighlightTaskbar,
             settings.enableSelfHighlightSound, false, false,
             settings.selfHighlightSoundUrl.getValue(),
             ColorProvider::instance().color(ColorType::SelfHighlight));
-
-        checks.emplace_back(highlightPhraseCheck(highlight));
     }
 
     auto messageHighlights = settings.highlightedMessages.readOnly();
-    for (const auto &highlight : *messageHighlights)
+    phrases.insert(phrases.end(), messageHighlights->begin(),
+                   messageHighlights->end());
+
+    if (!phrases.empty())
     {
-        checks.emplace_back(highlightPhraseCheck(highlight));
+        auto matcher =
+            std::make_shared<const PhraseMatcher>(std::move(phrases));
+        checks.emplace_back(HighlightCheck{
+            [matcher](const auto & /*args*/, const auto & /*badges*/,
+                      const auto & /*senderName*/, const auto &originalMessage,
+                      const auto & /*flags*/,
+                      const auto self) -> std::optional<HighlightResult> {
+                if (self)
+                {
+                    // Phrase checks should ignore highlights from the user
+                    return std::nullopt;
+                }
+
+                return matcher->check(originalMessage);
+            }});
     }
 
     if (settings.enableAutomodHighlight)
@@ -277,37 +545,17 @@ void rebuildUserHighlights(Settings &settings,
             }});
     }
 
-    for (const auto &highlight : *userHighlights)
+    if (!userHighlights->empty())
     {
+        auto matcher = std::make_shared<const PhraseMatcher>(
+            std::vector<HighlightPhrase>(userHighlights->begin(),
+                                         userHighlights->end()));
         checks.emplace_back(HighlightCheck{
-            [highlight](const auto &args, const auto &badges,
-                        const auto &senderName, const auto &originalMessage,
-                        const auto &flags,
-                        const auto self) -> std::optional<HighlightResult> {
-                (void)args;             // unused
-                (void)badges;           // unused
-                (void)originalMessage;  // unused
-                (void)flags;            // unused
-                (void)self;             // unused
-
-                if (!highlight.isMatch(senderName))
-                {
-                    return std::nullopt;
-                }
-
-                std::optional<QUrl> highlightSoundUrl;
-                if (highlight.hasCustomSound())
-                {
-                    highlightSoundUrl = highlight.getSoundUrl();
-                }
-
-                return HighlightResult{
-                    highlight.hasAlert(),        //
-                    highlight.hasSound(),        //
-                    highlightSoundUrl,           //
-                    highlight.getColor(),        //
-                    highlight.showInMentions(),  //
-                };
+            [matcher](const auto & /*args*/, const auto & /*badges*/,
+                      const auto &senderName, const auto & /*originalMessage*/,
+                      const auto & /*flags*/,
+                      const auto /*self*/) -> std::optional<HighlightResult> {
+                return matcher->check(senderName);
             }});
     }
 }
@@ -317,40 +565,17 @@ void rebuildBadgeHighlights(Settings &settings,
 {
     auto badgeHighlights = settings.highlightedBadges.readOnly();
 
-    for (const auto &highlight : *badgeHighlights)
+    if (!badgeHighlights->empty())
     {
+        auto matcher = std::make_shared<const BadgeMatcher>(
+            std::vector<HighlightBadge>(badgeHighlights->begin(),
+                                        badgeHighlights->end()));
         checks.emplace_back(HighlightCheck{
-            [highlight](const auto &args, const auto &badges,
-                        const auto &senderName, const auto &originalMessage,
-                        const auto &flags,
-                        const auto self) -> std::optional<HighlightResult> {
-                (void)args;             // unused
-                (void)senderName;       // unused
-                (void)originalMessage;  // unused
-                (void)flags;            // unused
-                (void)self;             // unused
-
-                for (const Badge &badge : badges)
-                {
-                    if (highlight.isMatch(badge))
-                    {
-                        std::optional<QUrl> highlightSoundUrl;
-                        if (highlight.hasCustomSound())
-                        {
-                            highlightSoundUrl = highlight.getSoundUrl();
-                        }
-
-                        return HighlightResult{
-                            highlight.hasAlert(),        //
-                            highlight.hasSound(),        //
-                            highlightSoundUrl,           //
-                            highlight.getColor(),        //
-                            highlight.showInMentions(),  //
-                        };
-                    }
-                }
-
-                return std::nullopt;
+            [matcher](const auto & /*args*/, const auto &badges,
+                      const auto & /*senderName*/,
+                      const auto & /*originalMessage*/, const auto & /*flags*/,
+                      const auto /*self*/) -> std::optional<HighlightResult> {
+                return matcher->check(badges);
             }});
     }
 }
@@ -563,45 +788,7 @@ std::pair<bool, HighlightResult> HighlightController::check(
         {
             highlighted = true;
 
-            if (checkResult->alert)
-            {
-                if (!result.alert)
-                {
-                    result.alert = checkResult->alert;
-                }
-            }
-
-            if (checkResult->playSound)
-            {
-                if (!result.playSound)
-                {
-                    result.playSound = checkResult->playSound;
-                }
-            }
-
-            if (checkResult->customSoundUrl)
-            {
-                if (!result.customSoundUrl)
-                {
-                    result.customSoundUrl = checkResult->customSoundUrl;
-                }
-            }
-
-            if (checkResult->color)
-            {
-                if (!result.color)
-                {
-                    result.color = checkResult->color;
-                }
-            }
-
-            if (checkResult->showInMentions)
-            {
-                if (!result.showInMentions)
-                {
-                    result.showInMentions = checkResult->showInMentions;
-                }
-            }
+            mergeHighlightResult(result, *checkResult);
 
             if (result.full())
             {
@@ -124,6 +124,11 @@ bool HighlightPhrase::isCaseSensitive() const
     return this->isCaseSensitive_;
 }
 
+const QRegularExpression &HighlightPhrase::getRegex() const
+{
+    return this->regex_;
+}
+
 const QUrl &HighlightPhrase::getSoundUrl() const
 {
     return this->soundUrl_;
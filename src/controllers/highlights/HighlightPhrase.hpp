@@ -71,6 +71,14 @@ public:
     bool isValid() const;
     bool isMatch(const QString &subject) const;
     bool isCaseSensitive() const;
+
+    /**
+     * @brief Returns the regular expression subjects are matched against.
+     *
+     * For phrases that aren't regular expressions, this is the escaped
+     * pattern surrounded by word boundaries.
+     */
+    const QRegularExpression &getRegex() const;
     const QUrl &getSoundUrl() const;
     const std::shared_ptr<QColor> getColor() const;
 
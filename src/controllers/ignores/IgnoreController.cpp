@@ -5,12 +5,18 @@
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnorePhraseSet.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
 #include "singletons/Settings.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <optional>
+
 namespace {
 
+using namespace chatterino;
 using namespace chatterino::literals;
 
 /**
@@ -127,152 +133,181 @@ QString makeRegexReplacement(QStringView source,
     return dst;
 }
 
-}  // namespace
 
-namespace chatterino {
+using SizeType = QString::size_type;
 
-bool isIgnoredMessage(IgnoredMessageParameters &&params)
+/// A single occurrence of a replace phrase
+struct Replacement {
+    SizeType from;
+    SizeType length;
+    QString text;
+};
+
+/// A regular expression matching this often replaces the whole message with
+/// an error
+constexpr std::size_t MAX_REPLACEMENTS = 128;
+
+/// Finds the non-overlapping occurrences of `phrase` in `content` and what
+/// each of them is replaced with.
+///
+/// Returns std::nullopt if the phrase matches too often.
+std::optional<std::vector<Replacement>> collectReplacements(
+    const IgnorePhrase &phrase, const QString &content)
 {
-    if (!params.message.isEmpty())
+    std::vector<Replacement> replacements;
+
+    if (phrase.isRegex())
     {
-        // TODO(pajlada): Do we need to check if the phrase is valid first?
-        auto phrases = getSettings()->ignoredMessages.readOnly();
-        for (const auto &phrase : *phrases)
+        const auto &regex = phrase.getRegex();
+        auto it = regex.globalMatch(content);
+        while (it.hasNext())
         {
-            if (phrase.isBlock() && phrase.isMatch(params.message))
+            auto match = it.next();
+            auto text = phrase.getReplace();
+            if (regex.captureCount() > 0)
+            {
+                text = makeRegexReplacement(content, regex, match, text);
+            }
+            replacements.push_back({
+                .from = match.capturedStart(),
+                .length = match.capturedLength(),
+                .text = std::move(text),
+            });
+            if (replacements.size() >= MAX_REPLACEMENTS)
             {
-                qCDebug(chatterinoMessage)
-                    << "Blocking message because it contains ignored phrase"
-                    << phrase.getPattern();
-                return true;
+                return std::nullopt;
             }
         }
+        return replacements;
     }
 
-    if (getSettings()->enableTwitchBlockedUsers)
+    const auto &pattern = phrase.getPattern();
+    SizeType from = 0;
+    while ((from = content.indexOf(pattern, from, phrase.caseSensitivity())) !=
+           -1)
     {
-        bool isBlocked = false;
+        replacements.push_back({
+            .from = from,
+            .length = pattern.length(),
+            .text = phrase.getReplace(),
+        });
+        from += pattern.length();
+    }
+    return replacements;
+}
 
-        if (!params.twitchUserID.isEmpty())
-        {
-            isBlocked = getApp()
-                            ->getAccounts()
-                            ->twitch.getCurrent()
-                            ->blockedUserIds()
-                            .contains(params.twitchUserID);
-        }
-        else if (!params.twitchUserLogin.isEmpty())
-        {
-            isBlocked = getApp()
-                            ->getAccounts()
-                            ->twitch.getCurrent()
-                            ->blockedUserLogins()
-                            .contains(params.twitchUserLogin);
-        }
+/// Adds the emotes of the replacement text of `phrase` in `word`, which
+/// starts at `startIndex` in the message
+void addReplacementEmotes(const IgnorePhrase &phrase, QStringView word,
+                          SizeType startIndex,
+                          std::vector<TwitchEmoteOccurrence> &twitchEmotes)
+{
+    if (!phrase.containsEmote())
+    {
+        return;
+    }
 
-        if (isBlocked)
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    auto words = word.tokenize(u' ');
+#else
+    auto words = word.split(' ');
+#endif
+    SizeType pos = 0;
+    for (const auto &part : words)
+    {
+        for (const auto &emote : phrase.getEmotes())
         {
-            switch (static_cast<ShowIgnoredUsersMessages>(
-                getSettings()->showBlockedUsersMessages.getValue()))
+            if (part == emote.first.string)
             {
-                case ShowIgnoredUsersMessages::IfModerator:
-                    if (params.isMod || params.isBroadcaster)
-                    {
-                        return false;
-                    }
-                    break;
-                case ShowIgnoredUsersMessages::IfBroadcaster:
-                    if (params.isBroadcaster)
-                    {
-                        return false;
-                    }
-                    break;
-                case ShowIgnoredUsersMessages::Never:
-                    break;
+                if (emote.second == nullptr)
+                {
+                    qCDebug(chatterinoTwitch)
+                        << "emote null" << emote.first.string;
+                }
+                twitchEmotes.push_back(TwitchEmoteOccurrence{
+                    static_cast<int>(startIndex + pos),
+                    static_cast<int>(startIndex + pos +
+                                     emote.first.string.length()),
+                    emote.second,
+                    emote.first,
+                });
             }
-
-            return true;
         }
+        pos += part.length() + 1;
     }
-
-    return false;
 }
 
-void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
-                          QString &content,
-                          std::vector<TwitchEmoteOccurrence> &twitchEmotes)
+/// Applies all `replacements` of `phrase` to `content` at once.
+///
+/// Emotes after a replacement are moved, emotes inside a replacement are
+/// kept if they're still present in the word around the replacement.
+void applyReplacements(const IgnorePhrase &phrase,
+                       const std::vector<Replacement> &replacements,
+                       QString &content,
+                       std::vector<TwitchEmoteOccurrence> &twitchEmotes)
 {
-    using SizeType = QString::size_type;
+    QStringView source(content);
 
-    auto removeEmotesInRange = [&twitchEmotes](SizeType pos, SizeType len) {
-        // all emotes outside the range come before `it`
-        // all emotes in the range start at `it`
-        auto it = std::partition(
-            twitchEmotes.begin(), twitchEmotes.end(),
-            [pos, len](const auto &item) {
-                // returns true for emotes outside the range
-                return !((item.start >= pos) && item.start < (pos + len));
+    // 1. rebuild the message, remembering where each replacement ends up
+    SizeType newLength = content.size();
+    for (const auto &replacement : replacements)
+    {
+        newLength += replacement.text.size() - replacement.length;
+    }
+
+    QString result;
+    result.reserve(newLength);
+    std::vector<SizeType> newStarts;
+    newStarts.reserve(replacements.size());
+    SizeType lastEnd = 0;
+    for (const auto &replacement : replacements)
+    {
+        result += source.mid(lastEnd, replacement.from - lastEnd);
+        newStarts.push_back(result.size());
+        result += replacement.text;
+        lastEnd = replacement.from + replacement.length;
+    }
+    result += source.mid(lastEnd);
+
+    // 2. move emotes after a replacement, take out emotes inside one
+    std::vector<std::vector<TwitchEmoteOccurrence>> removedEmotes(
+        replacements.size());
+    std::vector<TwitchEmoteOccurrence> keptEmotes;
+    keptEmotes.reserve(twitchEmotes.size());
+    for (auto &emote : twitchEmotes)
+    {
+        // the first replacement ending after the start of the emote
+        auto it = std::upper_bound(
+            replacements.begin(), replacements.end(), emote.start,
+            [](int start, const Replacement &replacement) {
+                return start < replacement.from + replacement.length;
             });
-        std::vector<TwitchEmoteOccurrence> emotesInRange(it,
-                                                         twitchEmotes.end());
-        twitchEmotes.erase(it, twitchEmotes.end());
-        return emotesInRange;
-    };
+        auto index = static_cast<std::size_t>(it - replacements.begin());
 
-    auto shiftIndicesAfter = [&twitchEmotes](int pos, int by) {
-        for (auto &item : twitchEmotes)
+        if (it != replacements.end() && emote.start >= it->from)
         {
-            auto &index = item.start;
-            if (index >= pos)
-            {
-                index += by;
-                item.end += by;
-            }
+            removedEmotes[index].push_back(std::move(emote));
+            continue;
         }
-    };
 
-    auto addReplEmotes = [&twitchEmotes](const IgnorePhrase &phrase,
-                                         const auto &midrepl,
-                                         SizeType startIndex) {
-        if (!phrase.containsEmote())
+        if (index > 0)
         {
-            return;
+            const auto &previous = replacements[index - 1];
+            auto shift = newStarts[index - 1] + previous.text.size() -
+                         (previous.from + previous.length);
+            emote.start += static_cast<int>(shift);
+            emote.end += static_cast<int>(shift);
         }
+        keptEmotes.push_back(std::move(emote));
+    }
+    twitchEmotes = std::move(keptEmotes);
 
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        auto words = midrepl.tokenize(u' ');
-#else
-        auto words = midrepl.split(' ');
-#endif
-        SizeType pos = 0;
-        for (const auto &word : words)
-        {
-            for (const auto &emote : phrase.getEmotes())
-            {
-                if (word == emote.first.string)
-                {
-                    if (emote.second == nullptr)
-                    {
-                        qCDebug(chatterinoTwitch)
-                            << "emote null" << emote.first.string;
-                    }
-                    twitchEmotes.push_back(TwitchEmoteOccurrence{
-                        static_cast<int>(startIndex + pos),
-                        static_cast<int>(startIndex + pos +
-                                         emote.first.string.length()),
-                        emote.second,
-                        emote.first,
-                    });
-                }
-            }
-            pos += word.length() + 1;
-        }
-    };
+    content = std::move(result);
 
-    auto replaceMessageAt = [&](const IgnorePhrase &phrase, SizeType from,
-                                SizeType length, const QString &replacement) {
-        auto removedEmotes = removeEmotesInRange(from, length);
-        content.replace(from, length, replacement);
+    // 3. find emotes in and around each replacement
+    for (std::size_t i = 0; i < replacements.size(); i++)
+    {
+        auto from = newStarts[i];
         auto wordStart = from;
         while (wordStart > 0)
         {
@@ -282,7 +317,7 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
             }
             --wordStart;
         }
-        auto wordEnd = from + replacement.length();
+        auto wordEnd = from + replacements[i].text.length();
         while (wordEnd < content.length())
         {
             if (content[wordEnd] == ' ')
@@ -292,13 +327,10 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
             ++wordEnd;
         }
 
-        shiftIndicesAfter(static_cast<int>(from + length),
-                          static_cast<int>(replacement.length() - length));
-
         auto midExtendedRef =
             QStringView{content}.mid(wordStart, wordEnd - wordStart);
 
-        for (auto &emote : removedEmotes)
+        for (auto &emote : removedEmotes[i])
         {
             if (emote.ptr == nullptr)
             {
@@ -316,68 +348,120 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
 #endif
             if (match.hasMatch())
             {
-                emote.start = static_cast<int>(from + match.capturedStart());
-                emote.end = static_cast<int>(from + match.capturedEnd());
+                emote.start =
+                    static_cast<int>(wordStart + match.capturedStart());
+                emote.end = static_cast<int>(wordStart + match.capturedEnd());
                 twitchEmotes.push_back(std::move(emote));
             }
         }
 
-        addReplEmotes(phrase, midExtendedRef, wordStart);
-    };
+        addReplacementEmotes(phrase, midExtendedRef, wordStart, twitchEmotes);
+    }
+}
 
-    for (const auto &phrase : phrases)
+}  // namespace
+
+namespace chatterino {
+
+bool isIgnoredMessage(IgnoredMessageParameters &&params)
+{
+    if (!params.message.isEmpty())
     {
-        if (phrase.isBlock())
+        auto phrases = IgnorePhraseSet::current();
+        if (const auto *phrase = phrases->findBlock(params.message))
         {
-            continue;
+            qCDebug(chatterinoMessage)
+                << "Blocking message because it contains ignored phrase"
+                << phrase->getPattern();
+            return true;
         }
-        const auto &pattern = phrase.getPattern();
-        if (pattern.isEmpty())
+    }
+
+    if (getSettings()->enableTwitchBlockedUsers)
+    {
+        bool isBlocked = false;
+
+        if (!params.twitchUserID.isEmpty())
         {
-            continue;
+            isBlocked = getApp()
+                            ->getAccounts()
+                            ->twitch.getCurrent()
+                            ->isBlockedUserId(params.twitchUserID);
         }
-        if (phrase.isRegex())
+        else if (!params.twitchUserLogin.isEmpty())
         {
-            const auto &regex = phrase.getRegex();
-            if (!regex.isValid())
-            {
-                continue;
-            }
+            isBlocked = getApp()
+                            ->getAccounts()
+                            ->twitch.getCurrent()
+                            ->isBlockedUserLogin(params.twitchUserLogin);
+        }
 
-            QRegularExpressionMatch match;
-            size_t iterations = 0;
-            SizeType from = 0;
-            while ((from = content.indexOf(regex, from, &match)) != -1)
+        if (isBlocked)
+        {
+            switch (static_cast<ShowIgnoredUsersMessages>(
+                getSettings()->showBlockedUsersMessages.getValue()))
             {
-                auto replacement = phrase.getReplace();
-                if (regex.captureCount() > 0)
-                {
-                    replacement = makeRegexReplacement(content, regex, match,
-                                                       replacement);
-                }
-
-                replaceMessageAt(phrase, from, match.capturedLength(),
-                                 replacement);
-                from += phrase.getReplace().length();
-                iterations++;
-                if (iterations >= 128)
-                {
-                    content = u"Too many replacements - check your ignores!"_s;
-                    return;
-                }
+                case ShowIgnoredUsersMessages::IfModerator:
+                    if (params.isMod || params.isBroadcaster)
+                    {
+                        return false;
+                    }
+                    break;
+                case ShowIgnoredUsersMessages::IfBroadcaster:
+                    if (params.isBroadcaster)
+                    {
+                        return false;
+                    }
+                    break;
+                case ShowIgnoredUsersMessages::Never:
+                    break;
             }
 
-            continue;
+            return true;
         }
+    }
+
+    return false;
+}
+
+void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
+                          QString &content,
+                          std::vector<TwitchEmoteOccurrence> &twitchEmotes)
+{
+    processIgnorePhrases(
+        IgnorePhraseSet(std::make_shared<const std::vector<IgnorePhrase>>(
+            phrases)),
+        content, twitchEmotes);
+}
 
-        SizeType from = 0;
-        while ((from = content.indexOf(pattern, from,
-                                       phrase.caseSensitivity())) != -1)
+void processIgnorePhrases(const IgnorePhraseSet &phrases, QString &content,
+                          std::vector<TwitchEmoteOccurrence> &twitchEmotes)
+{
+    auto matching = phrases.findReplacements(content);
+    std::size_t i = 0;
+    while (i < matching.size())
+    {
+        auto index = matching[i];
+        const auto &phrase = phrases.phrases()[index];
+
+        auto replacements = collectReplacements(phrase, content);
+        if (!replacements)
+        {
+            content = u"Too many replacements - check your ignores!"_s;
+            return;
+        }
+        if (replacements->empty())
         {
-            replaceMessageAt(phrase, from, pattern.length(),
-                             phrase.getReplace());
-            from += phrase.getReplace().length();
+            i++;
+            continue;
         }
+
+        applyReplacements(phrase, *replacements, content, twitchEmotes);
+
+        // The replacements might have added or removed matches of the
+        // following phrases
+        matching = phrases.findReplacements(content, index + 1);
+        i = 0;
     }
 }
 
@@ -7,6 +7,7 @@
 namespace chatterino {
 
 class IgnorePhrase;
+class IgnorePhraseSet;
 struct TwitchEmoteOccurrence;
 
 enum class ShowIgnoredUsersMessages { Never, IfModerator, IfBroadcaster };
@@ -35,4 +36,13 @@ void processIgnorePhrases(const std::vector<IgnorePhrase> &phrases,
                           QString &content,
                           std::vector<TwitchEmoteOccurrence> &twitchEmotes);
 
+/// @brief Processes replacement ignore-phrases for a message
+///
+/// Same as above, but with phrases that have been compiled already (see
+/// IgnorePhraseSet::current).
+/// Only phrases matching the message are processed, and all occurrences of a
+/// phrase are replaced in a single rebuild of the message.
+void processIgnorePhrases(const IgnorePhraseSet &phrases, QString &content,
+                          std::vector<TwitchEmoteOccurrence> &twitchEmotes);
+
 }  // namespace chatterino
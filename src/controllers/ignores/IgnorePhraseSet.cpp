@@ -0,0 +1,179 @@
+#include "controllers/ignores/IgnorePhraseSet.hpp"
+
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "singletons/Settings.hpp"
+
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <mutex>
+
+namespace chatterino {
+
+IgnorePhraseSet::IgnorePhraseSet(
+    std::shared_ptr<const std::vector<IgnorePhrase>> phrases)
+    : phrases_(std::move(phrases))
+{
+    for (std::size_t i = 0; i < this->phrases_->size(); i++)
+    {
+        const auto &phrase = (*this->phrases_)[i];
+        if (phrase.getPattern().isEmpty() ||
+            (phrase.isRegex() && !phrase.isRegexValid()))
+        {
+            continue;
+        }
+
+        if (phrase.isBlock())
+        {
+            this->block_.add(phrase, i);
+        }
+        else
+        {
+            this->replace_.add(phrase, i);
+        }
+    }
+
+    this->block_.build();
+    this->replace_.build();
+}
+
+std::shared_ptr<const IgnorePhraseSet> IgnorePhraseSet::current()
+{
+    static std::mutex mutex;
+    static std::shared_ptr<const IgnorePhraseSet> cached;
+
+    // SignalVector replaces its read-only copy on every change
+    auto phrases = getSettings()->ignoredMessages.readOnly();
+
+    std::lock_guard lock(mutex);
+    if (!cached || cached->phrases_ != phrases)
+    {
+        cached = std::make_shared<const IgnorePhraseSet>(std::move(phrases));
+    }
+    return cached;
+}
+
+const std::vector<IgnorePhrase> &IgnorePhraseSet::phrases() const
+{
+    return *this->phrases_;
+}
+
+const IgnorePhrase *IgnorePhraseSet::findBlock(const QString &message) const
+{
+    const IgnorePhrase *found = nullptr;
+    this->forEachMatch(this->block_, message, 0, [&](std::size_t index) {
+        found = &(*this->phrases_)[index];
+        return false;
+    });
+    return found;
+}
+
+std::vector<std::size_t> IgnorePhraseSet::findReplacements(
+    const QString &content, std::size_t first) const
+{
+    std::vector<std::size_t> indices;
+    this->forEachMatch(this->replace_, content, first,
+                       [&](std::size_t index) {
+                           indices.push_back(index);
+                           return true;
+                       });
+    return indices;
+}
+
+void IgnorePhraseSet::forEachMatch(
+    const Matcher &matcher, const QString &subject, std::size_t first,
+    FunctionRef<bool(std::size_t)> onMatch) const
+{
+    if (matcher.empty())
+    {
+        return;
+    }
+
+    enum class Candidate : std::uint8_t {
+        None,
+        Maybe,
+        Match,
+    };
+
+    const auto &phrases = *this->phrases_;
+    QVarLengthArray<Candidate, 128> candidates(
+        static_cast<qsizetype>(phrases.size()));
+    std::fill(candidates.begin(), candidates.end(), Candidate::None);
+
+    matcher.plain.findAll(subject.toCaseFolded(),
+                          [&](const AhoCorasick::Match &match) {
+                              candidates[match.id] = Candidate::Maybe;
+                          });
+
+    if (auto id = matcher.regexes.firstMatch(subject))
+    {
+        // Other expressions might match as well
+        for (auto index : matcher.combined)
+        {
+            candidates[index] = Candidate::Maybe;
+        }
+        candidates[*id] = Candidate::Match;
+    }
+
+    for (auto index : matcher.standalone)
+    {
+        candidates[index] = Candidate::Maybe;
+    }
+
+    for (auto i = first; i < phrases.size(); i++)
+    {
+        if (candidates[i] == Candidate::None ||
+            (candidates[i] == Candidate::Maybe &&
+             !phrases[i].isMatch(subject)))
+        {
+            continue;
+        }
+
+        if (!onMatch(i))
+        {
+            return;
+        }
+    }
+}
+
+void IgnorePhraseSet::Matcher::add(const IgnorePhrase &phrase,
+                                   std::size_t index)
+{
+    if (!phrase.isRegex())
+    {
+        this->plain.addPattern(phrase.getPattern().toCaseFolded(), index);
+        return;
+    }
+
+    if (this->regexes.add(phrase.getRegex(), index))
+    {
+        this->combined.push_back(index);
+    }
+    else
+    {
+        this->standalone.push_back(index);
+    }
+}
+
+void IgnorePhraseSet::Matcher::build()
+{
+    this->plain.build();
+
+    std::vector<std::size_t> rejected;
+    this->regexes.build(&rejected);
+    if (!rejected.empty())
+    {
+        this->combined.clear();
+        this->standalone.insert(this->standalone.end(), rejected.begin(),
+                                rejected.end());
+        std::sort(this->standalone.begin(), this->standalone.end());
+    }
+}
+
+bool IgnorePhraseSet::Matcher::empty() const
+{
+    return this->plain.empty() && this->regexes.empty() &&
+           this->standalone.empty();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "util/AhoCorasick.hpp"
+#include "util/FunctionRef.hpp"
+#include "util/RegexUnion.hpp"
+
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class IgnorePhrase;
+
+/// IgnorePhraseSet is a list of IgnorePhrases compiled to match a message
+/// against all of them at once.
+///
+/// Plain phrases are found by a single Aho-Corasick scan over the case folded
+/// message and regular expressions are combined into a RegexUnion. Candidates
+/// are confirmed with IgnorePhrase::isMatch, so the result is the same as
+/// checking each phrase on its own.
+class IgnorePhraseSet
+{
+public:
+    explicit IgnorePhraseSet(
+        std::shared_ptr<const std::vector<IgnorePhrase>> phrases);
+
+    /// Returns the set of the ignoredMessages setting.
+    ///
+    /// The set is compiled again if the setting changed since the last call.
+    static std::shared_ptr<const IgnorePhraseSet> current();
+
+    const std::vector<IgnorePhrase> &phrases() const;
+
+    /// Returns the first block phrase matching `message` or nullptr if none
+    /// match
+    const IgnorePhrase *findBlock(const QString &message) const;
+
+    /// Returns the indices of the replace phrases matching `content` in
+    /// ascending order, starting at index `first`
+    std::vector<std::size_t> findReplacements(const QString &content,
+                                              std::size_t first = 0) const;
+
+private:
+    struct Matcher {
+        AhoCorasick plain;
+        RegexUnion regexes;
+        /// Indices of the phrases in regexes
+        std::vector<std::size_t> combined;
+        /// Indices of the regular expressions that have to be checked on
+        /// their own
+        std::vector<std::size_t> standalone;
+
+        void add(const IgnorePhrase &phrase, std::size_t index);
+        void build();
+        bool empty() const;
+    };
+
+    /// Calls `onMatch(index)` for every phrase of `matcher` matching
+    /// `subject` in ascending order, starting at index `first`. Stops once
+    /// `onMatch` returns false.
+    void forEachMatch(const Matcher &matcher, const QString &subject,
+                      std::size_t first,
+                      FunctionRef<bool(std::size_t)> onMatch) const;
+
+    std::shared_ptr<const std::vector<IgnorePhrase>> phrases_;
+    Matcher block_;
+    Matcher replace_;
+};
+
+}  // namespace chatterino
@@ -2,14 +2,16 @@
 
 namespace chatterino {
 
-ChannelLog::ChannelLog(QString channelName)
+ChannelLog::ChannelLog(QString channelName, bool compressed)
     : channelName_(std::move(channelName))
+    , compressed_(compressed)
 {
 }
 
 bool ChannelLog::operator==(const ChannelLog &other) const
 {
-    return this->channelName_ == other.channelName_;
+    return this->channelName_ == other.channelName_ &&
+           this->compressed_ == other.compressed_;
 }
 
 QString ChannelLog::channelName() const
@@ -22,6 +24,11 @@ QString ChannelLog::toString() const
     return this->channelName_;
 }
 
+bool ChannelLog::isCompressed() const
+{
+    return this->compressed_;
+}
+
 ChannelLog ChannelLog::createEmpty()
 {
     return {""};
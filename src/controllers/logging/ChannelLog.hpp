@@ -13,9 +13,10 @@ namespace chatterino {
 class ChannelLog
 {
     QString channelName_;
+    bool compressed_;
 
 public:
-    ChannelLog(QString channelName);
+    ChannelLog(QString channelName, bool compressed = false);
 
     bool operator==(const ChannelLog &other) const;
 
@@ -23,6 +24,10 @@ public:
 
     [[nodiscard]] QString toString() const;
 
+    /// Whether the channel is logged in the compressed format instead of
+    /// plain text
+    [[nodiscard]] bool isCompressed() const;
+
     [[nodiscard]] static ChannelLog createEmpty();
 };
 
@@ -38,6 +43,7 @@ struct Serialize<chatterino::ChannelLog> {
         rapidjson::Value ret(rapidjson::kObjectType);
 
         chatterino::rj::set(ret, "channelName", value.channelName(), a);
+        chatterino::rj::set(ret, "compressed", value.isCompressed(), a);
 
         return ret;
     }
@@ -62,7 +68,11 @@ struct Deserialize<chatterino::ChannelLog> {
             return chatterino::ChannelLog::createEmpty();
         }
 
-        return {channelName};
+        // Optional, plain text logs are the default
+        bool compressed = false;
+        chatterino::rj::getSafe(value, "compressed", compressed);
+
+        return {channelName, compressed};
     }
 };
 
@@ -13,13 +13,16 @@ ChannelLog ChannelLoggingModel::getItemFromRow(
     std::vector<QStandardItem *> &row, const ChannelLog & /*original*/)
 {
     auto channelName = row[Column::Channel]->data(Qt::DisplayRole).toString();
-    return {channelName};
+    auto compressed =
+        row[Column::Compressed]->data(Qt::CheckStateRole).toBool();
+    return {channelName, compressed};
 }
 
 void ChannelLoggingModel::getRowFromItem(const ChannelLog &item,
                                          std::vector<QStandardItem *> &row)
 {
     setStringItem(row[Column::Channel], item.channelName());
+    setBoolItem(row[Column::Compressed], item.isCompressed());
 }
 
 }  // namespace chatterino
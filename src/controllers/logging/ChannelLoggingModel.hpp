@@ -13,6 +13,7 @@ class ChannelLoggingModel : public SignalVectorModel<ChannelLog>
 
     enum Column {
         Channel,
+        Compressed,
         COUNT,
     };
 
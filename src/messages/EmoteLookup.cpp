@@ -0,0 +1,178 @@
+#include "messages/EmoteLookup.hpp"
+
+#include "Application.hpp"
+#include "messages/Emote.hpp"
+#include "messages/MessageElement.hpp"
+#include "providers/bttv/BttvEmotes.hpp"
+#include "providers/ffz/FfzEmotes.hpp"
+#include "providers/seventv/SeventvEmotes.hpp"
+
+#include <QSet>
+
+#include <mutex>
+
+namespace {
+
+using namespace chatterino;
+
+using Table = std::unordered_map<EmoteName, EmoteLookup::Entry>;
+
+/// Global BTTV emotes that are displayed on top of the previous emote
+const QSet<QString> ZERO_WIDTH_BTTV_EMOTES{
+    "SoSnowy",  "IceCold",   "SantaHat", "TopHat",
+    "ReinDeer", "CandyCane", "cvMask",   "cvHazmat",
+};
+
+enum class ZeroWidth : uint8_t {
+    Never,
+    /// The emote's `zeroWidth`
+    FromEmote,
+    /// Names in ZERO_WIDTH_BTTV_EMOTES
+    BttvGlobal,
+};
+
+/// Adds the emotes of `map` to `table`, replacing emotes with the same name
+void overlay(Table &table, const std::shared_ptr<const EmoteMap> &map,
+             MessageElementFlag flag, ZeroWidth zeroWidth)
+{
+    if (!map)
+    {
+        return;
+    }
+
+    for (const auto &[name, emote] : *map)
+    {
+        bool isZeroWidth = false;
+        switch (zeroWidth)
+        {
+            case ZeroWidth::Never:
+                break;
+            case ZeroWidth::FromEmote:
+                isZeroWidth = emote->zeroWidth;
+                break;
+            case ZeroWidth::BttvGlobal:
+                isZeroWidth = ZERO_WIDTH_BTTV_EMOTES.contains(name.string);
+                break;
+        }
+
+        table.insert_or_assign(name, EmoteLookup::Entry{
+                                         .emote = emote,
+                                         .flags = flag,
+                                         .zeroWidth = isZeroWidth,
+                                     });
+    }
+}
+
+struct GlobalTable {
+    std::mutex mutex;
+    EmoteLookup::Sources sources;
+    std::shared_ptr<const Table> table;
+};
+
+/// Returns the merged global emotes of `sources`
+std::shared_ptr<const Table> globalTable(const EmoteLookup::Sources &sources)
+{
+    // Never destroyed, as the table holds emotes which can't be destroyed
+    // after the application
+    static auto *cache = new GlobalTable;
+
+    EmoteLookup::Sources globals{
+        .ffzGlobal = sources.ffzGlobal,
+        .bttvGlobal = sources.bttvGlobal,
+        .seventvGlobal = sources.seventvGlobal,
+    };
+
+    std::lock_guard guard(cache->mutex);
+    if (cache->table && cache->sources == globals)
+    {
+        return cache->table;
+    }
+
+    // Lowest precedence first
+    auto table = std::make_shared<Table>();
+    overlay(*table, globals.seventvGlobal, MessageElementFlag::SevenTVEmote,
+            ZeroWidth::FromEmote);
+    overlay(*table, globals.bttvGlobal, MessageElementFlag::BttvEmote,
+            ZeroWidth::BttvGlobal);
+    overlay(*table, globals.ffzGlobal, MessageElementFlag::FfzEmote,
+            ZeroWidth::Never);
+
+    cache->sources = std::move(globals);
+    cache->table = table;
+    return table;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+EmoteLookup::Sources EmoteLookup::Sources::globals()
+{
+    auto *app = getApp();
+    return {
+        .ffzGlobal = app->getFfzEmotes()->emotes(),
+        .bttvGlobal = app->getBttvEmotes()->emotes(),
+        .seventvGlobal = app->getSeventvEmotes()->globalEmotes(),
+    };
+}
+
+EmoteLookup::EmoteLookup(Sources sources, Table table)
+    : sources_(std::move(sources))
+    , table_(std::move(table))
+{
+}
+
+std::shared_ptr<const EmoteLookup> EmoteLookup::build(const Sources &sources)
+{
+    auto table = *globalTable(sources);
+    overlay(table, sources.seventvChannel, MessageElementFlag::SevenTVEmote,
+            ZeroWidth::FromEmote);
+    overlay(table, sources.bttvChannel, MessageElementFlag::BttvEmote,
+            ZeroWidth::Never);
+    overlay(table, sources.ffzChannel, MessageElementFlag::FfzEmote,
+            ZeroWidth::Never);
+
+    return std::shared_ptr<const EmoteLookup>(
+        new EmoteLookup(sources, std::move(table)));
+}
+
+std::shared_ptr<const EmoteLookup> EmoteLookup::global()
+{
+    struct Cache {
+        std::mutex mutex;
+        std::shared_ptr<const EmoteLookup> lookup;
+    };
+    // Never destroyed, like the global table
+    static auto *cache = new Cache;
+
+    auto sources = Sources::globals();
+
+    std::lock_guard guard(cache->mutex);
+    if (!cache->lookup || !cache->lookup->isBuiltFrom(sources))
+    {
+        cache->lookup = build(sources);
+    }
+    return cache->lookup;
+}
+
+const EmoteLookup::Entry *EmoteLookup::find(const EmoteName &name) const
+{
+    auto it = this->table_.find(name);
+    if (it == this->table_.end())
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+bool EmoteLookup::isBuiltFrom(const Sources &sources) const
+{
+    return this->sources_ == sources;
+}
+
+size_t EmoteLookup::size() const
+{
+    return this->table_.size();
+}
+
+}  // namespace chatterino
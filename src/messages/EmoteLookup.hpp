@@ -0,0 +1,89 @@
+#pragma once
+
+#include "common/Aliases.hpp"
+#include "common/FlagsEnum.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+class EmoteMap;
+
+enum class MessageElementFlag : int64_t;
+using MessageElementFlags = FlagsEnum<MessageElementFlag>;
+
+/**
+ * @brief The third party emotes usable in a channel, merged into one table
+ *        so a word is looked up with a single probe.
+ *
+ * If an emote name is used by more than one provider, the emote with the
+ * highest precedence wins:
+ *  - FrankerFaceZ Channel
+ *  - BetterTTV Channel
+ *  - 7TV Channel
+ *  - FrankerFaceZ Global
+ *  - BetterTTV Global
+ *  - 7TV Global
+ *
+ * A lookup is immutable and can be shared between threads. Emote maps are
+ * replaced rather than modified, so a lookup is outdated once one of the maps
+ * it was built from is replaced.
+ */
+class EmoteLookup
+{
+public:
+    struct Entry {
+        EmotePtr emote;
+        /// The flag of the emote's provider (e.g. `BttvEmote`)
+        MessageElementFlags flags;
+        bool zeroWidth = false;
+    };
+
+    /// The maps a lookup is built from (missing maps are skipped)
+    struct Sources {
+        std::shared_ptr<const EmoteMap> ffzChannel;
+        std::shared_ptr<const EmoteMap> bttvChannel;
+        std::shared_ptr<const EmoteMap> seventvChannel;
+        std::shared_ptr<const EmoteMap> ffzGlobal;
+        std::shared_ptr<const EmoteMap> bttvGlobal;
+        std::shared_ptr<const EmoteMap> seventvGlobal;
+
+        /// Returns the current global emotes without any channel emotes
+        static Sources globals();
+
+        bool operator==(const Sources &other) const = default;
+    };
+
+    /**
+     * @brief Merges the maps of `sources`.
+     *
+     * The global emotes are merged once and shared by all lookups built from
+     * the same global maps. Only the channel emotes are merged for each
+     * lookup.
+     */
+    static std::shared_ptr<const EmoteLookup> build(const Sources &sources);
+
+    /// Returns a lookup of the current global emotes
+    static std::shared_ptr<const EmoteLookup> global();
+
+    /// Returns the emote named `name` or nullptr if there is none
+    const Entry *find(const EmoteName &name) const;
+
+    /// Returns true if this lookup was built from exactly `sources`
+    bool isBuiltFrom(const Sources &sources) const;
+
+    size_t size() const;
+
+private:
+    using Table = std::unordered_map<EmoteName, Entry>;
+
+    EmoteLookup(Sources sources, Table table);
+
+    Sources sources_;
+    Table table_;
+};
+
+}  // namespace chatterino
@@ -21,20 +21,171 @@
 #include <QNetworkRequest>
 #include <QTimer>
 
+#include <algorithm>
 #include <atomic>
+#include <unordered_set>
 
 // Duration between each check of every Image instance
 const auto IMAGE_POOL_CLEANUP_INTERVAL = std::chrono::minutes(1);
 // Duration since last usage of Image pixmap before expiration of frames
 const auto IMAGE_POOL_IMAGE_LIFETIME = std::chrono::minutes(10);
+// Duration since last usage of a streamed Image before its decoded frames
+// (besides the first one) are dropped
+const auto IMAGE_POOL_STREAMED_FRAMES_LIFETIME = std::chrono::seconds(30);
+
+namespace {
+
+int64_t frameBytes(const QPixmap &image)
+{
+    auto sz = image.size();
+    auto area = sz.width() * sz.height();
+    return int64_t(area) * image.depth() / 8;
+}
+
+int nextFrameDuration(const QImageReader &reader)
+{
+    // It seems that browsers have special logic for fast animations.
+    // This implements Chrome and Firefox's behavior which uses
+    // a duration of 100 ms for any frames that specify a duration of <= 10 ms.
+    // See http://webkit.org/b/36082 for more information.
+    // https://github.com/SevenTV/chatterino7/issues/46#issuecomment-1010595231
+    int duration = reader.nextImageDelay();
+    if (duration <= 10)
+    {
+        duration = 100;
+    }
+    return std::max(20, duration);
+}
+
+}  // namespace
 
 namespace chatterino::detail {
 
+/// FrameDecoder decodes the frames of a streamed image on a worker thread.
+///
+/// Frames of animated images usually depend on the previous frames, so they
+/// are decoded in order. Going back to an earlier frame (i.e. when the
+/// animation loops) starts over from the beginning.
+///
+/// Only one decode runs at a time (see #tryStart). The decoded frames are
+/// picked up by the GUI thread with #takeDecoded.
+class FrameDecoder
+{
+public:
+    using Index = QList<Frame>::size_type;
+
+    explicit FrameDecoder(QByteArray data)
+        : dataSize_(data.size())
+    {
+        this->buffer_.setData(std::move(data));
+    }
+
+    /// Marks the decoder as busy. Returns false if it already is.
+    bool tryStart()
+    {
+        return !this->busy_.exchange(true);
+    }
+
+    /// Decodes the frames at `indices` (in order) - like readFrames, frames
+    /// that can't be read are skipped. Has to be preceded by #tryStart.
+    void decodeFrames(const std::vector<Index> &indices)
+    {
+        for (auto index : indices)
+        {
+            auto pixmap = this->decode(index);
+            if (!pixmap.isNull())
+            {
+                std::lock_guard lock(this->decodedMutex_);
+                this->decoded_.emplace_back(index, std::move(pixmap));
+            }
+        }
+        this->busy_ = false;
+    }
+
+    /// Returns the frames decoded since the last call
+    std::vector<std::pair<Index, QPixmap>> takeDecoded()
+    {
+        std::lock_guard lock(this->decodedMutex_);
+        return std::exchange(this->decoded_, {});
+    }
+
+    int64_t dataSize() const
+    {
+        return this->dataSize_;
+    }
+
+private:
+    QPixmap decode(Index index)
+    {
+        if (!this->reader_ || index < this->nextIndex_)
+        {
+            this->restart();
+        }
+
+        QPixmap pixmap;
+        while (this->nextIndex_ <= index && this->read_ < this->imageCount_)
+        {
+            auto image = this->reader_->read();
+            this->read_++;
+            if (image.isNull())
+            {
+                continue;
+            }
+
+            if (this->nextIndex_ == index)
+            {
+                pixmap = QPixmap::fromImage(std::move(image));
+            }
+            this->nextIndex_++;
+        }
+        return pixmap;
+    }
+
+    void restart()
+    {
+        this->reader_.reset();
+        this->buffer_.close();
+        this->reader_ = std::make_unique<QImageReader>(&this->buffer_);
+        this->imageCount_ = this->reader_->imageCount();
+        this->read_ = 0;
+        this->nextIndex_ = 0;
+    }
+
+    const int64_t dataSize_;
+    std::atomic<bool> busy_ = false;
+
+    // only used by the running decode
+    QBuffer buffer_;
+    std::unique_ptr<QImageReader> reader_;
+    int imageCount_ = 0;
+    /// Number of images read, including the ones that couldn't be decoded
+    int read_ = 0;
+    Index nextIndex_ = 0;
+
+    std::mutex decodedMutex_;
+    std::vector<std::pair<Index, QPixmap>> decoded_;
+};
+
 Frames::Frames()
 {
     DebugCount::increase("images");
 }
 
+Frames::Frames(QList<Frame> &&frames, QByteArray data)
+    : Frames(std::move(frames))
+{
+    if (!this->animated())
+    {
+        return;
+    }
+
+    this->decoder_ = std::make_shared<FrameDecoder>(std::move(data));
+    DebugCount::increase("streamed images");
+    DebugCount::increase("image bytes", this->decoder_->dataSize());
+    DebugCount::increase("image bytes (ever loaded)",
+                         this->decoder_->dataSize());
+}
+
 Frames::Frames(QList<Frame> &&frames)
     : items_(std::move(frames))
 {
@@ -98,6 +249,10 @@ Frames::~Frames()
     {
         DebugCount::decrease("animated images");
     }
+    if (this->decoder_)
+    {
+        DebugCount::decrease("streamed images");
+    }
     DebugCount::decrease("image bytes", this->memoryUsage());
     DebugCount::increase("image bytes (ever unloaded)", this->memoryUsage());
 
@@ -109,11 +264,11 @@ int64_t Frames::memoryUsage() const
     int64_t usage = 0;
     for (const auto &frame : this->items_)
     {
-        auto sz = frame.image.size();
-        auto area = sz.width() * sz.height();
-        auto memory = area * frame.image.depth() / 8;
-
-        usage += memory;
+        usage += frameBytes(frame.image);
+    }
+    if (this->decoder_)
+    {
+        usage += this->decoder_->dataSize();
     }
     return usage;
 }
@@ -157,10 +312,17 @@ void Frames::clear()
     DebugCount::decrease("image bytes", this->memoryUsage());
     DebugCount::increase("image bytes (ever unloaded)", this->memoryUsage());
 
+    if (this->decoder_)
+    {
+        DebugCount::decrease("streamed images");
+    }
+
     this->items_.clear();
     this->index_ = 0;
     this->durationOffset_ = 0;
     this->gifTimerConnection_.disconnect();
+    this->decoder_.reset();
+    this->decodedFrames_.clear();
 }
 
 bool Frames::empty() const
@@ -173,13 +335,24 @@ bool Frames::animated() const
     return this->items_.size() > 1;
 }
 
-std::optional<QPixmap> Frames::current() const
+std::optional<QPixmap> Frames::current()
 {
     if (this->items_.empty())
     {
         return std::nullopt;
     }
 
+    if (this->decoder_)
+    {
+        this->takeDecoded();
+        this->decodeAhead();
+    }
+    if (this->items_[this->index_].image.isNull())
+    {
+        // The frame isn't decoded yet (or couldn't be decoded)
+        return this->items_.front().image;
+    }
+
     return this->items_[this->index_].image;
 }
 
@@ -193,6 +366,73 @@ std::optional<QPixmap> Frames::first() const
     return this->items_.front().image;
 }
 
+void Frames::decodeAhead()
+{
+    // The frames that are shown next, starting with the current one
+    std::vector<FrameDecoder::Index> missing;
+    for (size_t i = 0; i < maxStreamedFrames; i++)
+    {
+        auto index = (this->index_ + FrameDecoder::Index(i)) %
+                     this->items_.size();
+        if (this->items_[index].image.isNull())
+        {
+            missing.push_back(index);
+        }
+    }
+
+    auto *app = tryGetApp();
+    if (missing.empty() || app == nullptr || !this->decoder_->tryStart())
+    {
+        return;
+    }
+
+    std::weak_ptr<FrameDecoder> weak = this->decoder_;
+    app->getEmotes()->getImageDecodeQueue().push(
+        ImagePriority::Visible, weak,
+        [weak, missing = std::move(missing)] {
+            if (auto decoder = weak.lock())
+            {
+                decoder->decodeFrames(missing);
+            }
+        });
+}
+
+void Frames::takeDecoded()
+{
+    for (auto &[index, pixmap] : this->decoder_->takeDecoded())
+    {
+        auto &image = this->items_[index].image;
+        if (!image.isNull())
+        {
+            continue;
+        }
+        image = std::move(pixmap);
+        DebugCount::increase("image bytes", frameBytes(image));
+        this->decodedFrames_.push_back(index);
+    }
+
+    while (this->decodedFrames_.size() > maxStreamedFrames)
+    {
+        this->evictOldestFrame();
+    }
+}
+
+void Frames::dropDecodedFrames()
+{
+    while (!this->decodedFrames_.empty())
+    {
+        this->evictOldestFrame();
+    }
+}
+
+void Frames::evictOldestFrame()
+{
+    auto &evicted = this->items_[this->decodedFrames_.front()].image;
+    DebugCount::decrease("image bytes", frameBytes(evicted));
+    evicted = QPixmap();
+    this->decodedFrames_.pop_front();
+}
+
 QList<Frame> readFrames(QImageReader &reader, const Url &url)
 {
     QList<Frame> frames;
@@ -203,20 +443,9 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
         auto pixmap = QPixmap::fromImageReader(&reader);
         if (!pixmap.isNull())
         {
-            // It seems that browsers have special logic for fast animations.
-            // This implements Chrome and Firefox's behavior which uses
-            // a duration of 100 ms for any frames that specify a duration of <= 10 ms.
-            // See http://webkit.org/b/36082 for more information.
-            // https://github.com/SevenTV/chatterino7/issues/46#issuecomment-1010595231
-            int duration = reader.nextImageDelay();
-            if (duration <= 10)
-            {
-                duration = 100;
-            }
-            duration = std::max(20, duration);
             frames.append(Frame{
                 .image = std::move(pixmap),
-                .duration = duration,
+                .duration = nextFrameDuration(reader),
             });
         }
     }
@@ -230,23 +459,63 @@ QList<Frame> readFrames(QImageReader &reader, const Url &url)
     return frames;
 }
 
-void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed)
+QList<Frame> scanFrames(QImageReader &reader, const Url &url)
+{
+    QList<Frame> frames;
+    frames.reserve(reader.imageCount());
+
+    for (int index = 0; index < reader.imageCount(); ++index)
+    {
+        auto image = reader.read();
+        if (!image.isNull())
+        {
+            frames.append(Frame{
+                .image = frames.empty() ? QPixmap::fromImage(std::move(image))
+                                        : QPixmap(),
+                .duration = nextFrameDuration(reader),
+            });
+        }
+    }
+
+    if (frames.empty())
+    {
+        qCDebug(chatterinoImage) << "Error while reading image" << url.string
+                                 << ": '" << reader.errorString() << "'";
+    }
+
+    return frames;
+}
+
+void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed,
+                  QByteArray data)
 {
     static bool isPushQueued;
+    static std::unordered_set<const Image *> loadedImages;
 
-    auto cb = [parsed = std::move(parsed), weak = std::move(weak)]() mutable {
+    auto cb = [parsed = std::move(parsed), data = std::move(data),
+               weak = std::move(weak)]() mutable {
         auto shared = weak.lock();
         if (!shared)
         {
             return;
         }
-        shared->frames_ = std::make_unique<detail::Frames>(std::move(parsed));
+        if (data.isEmpty())
+        {
+            shared->frames_ =
+                std::make_unique<detail::Frames>(std::move(parsed));
+        }
+        else
+        {
+            shared->frames_ = std::make_unique<detail::Frames>(
+                std::move(parsed), std::move(data));
+        }
 
         // Avoid too many layouts in one event-loop iteration
         //
         // This callback is called for every image, so there might be multiple
         // callbacks queued on the event-loop in this iteration, but we only
         // want to generate one invalidation.
+        loadedImages.insert(shared.get());
         if (!isPushQueued)
         {
             isPushQueued = true;
@@ -256,10 +525,12 @@ void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed)
                 qApp,
                 [] {
                     isPushQueued = false;
+                    auto images = std::move(loadedImages);
+                    loadedImages.clear();
                     auto *app = tryGetApp();
                     if (app != nullptr)
                     {
-                        app->getWindows()->forceLayoutChannelViews();
+                        app->getWindows()->imagesLoaded.invoke(images);
                     }
                 },
                 Qt::QueuedConnection);
@@ -414,7 +685,7 @@ bool Image::loaded() const
 {
     assertInGuiThread();
 
-    return this->frames_->current().has_value();
+    return !this->frames_->empty();
 }
 
 std::optional<QPixmap> Image::pixmapOrLoad() const
@@ -435,15 +706,32 @@ void Image::load() const
 {
     assertInGuiThread();
 
+    auto priority = ImageLoadScope::currentPriority();
+    Image *this2 = const_cast<Image *>(this);
     if (this->shouldLoad_)
     {
-        Image *this2 = const_cast<Image *>(this);
         this2->shouldLoad_ = false;
+        this2->priority_ = priority;
         this2->actuallyLoad();
 #ifndef DISABLE_IMAGE_EXPIRATION_POOL
         ImageExpirationPool::instance().addImagePtr(this2->shared_from_this());
 #endif
     }
+    else if (priority > this->priority_)
+    {
+        this2->priority_ = priority;
+        auto job = this->decodeJob_.lock();
+        auto *app = tryGetApp();
+        if (job && app != nullptr)
+        {
+            app->getEmotes()->getImageDecodeQueue().raise(job, priority);
+        }
+    }
+
+    if (!this->empty_ && this->frames_ && this->frames_->empty())
+    {
+        ImageLoadScope::addPending(this);
+    }
 }
 
 qreal Image::scale() const
@@ -506,8 +794,7 @@ void Image::actuallyLoad()
 {
     auto weak = weakOf(this);
     NetworkRequest(this->url().string)
-        .concurrent()
-        .cache()
+        .cacheMapped()
         .onSuccess([weak](auto result) {
             auto shared = weak.lock();
             if (!shared)
@@ -517,49 +804,22 @@ void Image::actuallyLoad()
 
             assert(!isAppAboutToQuit());
 
-            QBuffer buffer;
-            buffer.setData(result.getData());
-            QImageReader reader(&buffer);
-
-            if (!reader.canRead())
-            {
-                qCDebug(chatterinoImage)
-                    << "Error: image cant be read " << shared->url().string;
-                shared->empty_ = true;
-                return;
-            }
-
-            const auto size = reader.size();
-            if (size.isEmpty())
-            {
-                shared->empty_ = true;
-                return;
-            }
-
-            // returns 1 for non-animated formats
-            if (reader.imageCount() <= 0)
+            auto *app = tryGetApp();
+            if (app == nullptr)
             {
-                qCDebug(chatterinoImage)
-                    << "Error: image has less than 1 frame "
-                    << shared->url().string << ": " << reader.errorString();
-                shared->empty_ = true;
                 return;
             }
 
-            // use "double" to prevent int overflows
-            if (double(size.width()) * double(size.height()) *
-                    double(reader.imageCount()) * 4.0 >
-                double(Image::maxBytesRam))
-            {
-                qCDebug(chatterinoImage) << "image too large in RAM";
-
-                shared->empty_ = true;
-                return;
-            }
-
-            auto parsed = detail::readFrames(reader, shared->url());
-
-            assignFrames(shared, parsed);
+            // The queue skips the job if the image is gone by the time it
+            // would be decoded. Cached images are mapped into memory, the
+            // result keeps the mapping alive until the job is done.
+            shared->decodeJob_ = app->getEmotes()->getImageDecodeQueue().push(
+                shared->priority_, weak, [weak, result = std::move(result)] {
+                    if (auto image = weak.lock())
+                    {
+                        image->decode(result.getData());
+                    }
+                });
         })
         .onError([weak](auto /*result*/) {
             auto shared = weak.lock();
@@ -576,6 +836,64 @@ void Image::actuallyLoad()
         .execute();
 }
 
+void Image::decode(const QByteArray &data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer);
+
+    if (!reader.canRead())
+    {
+        qCDebug(chatterinoImage)
+            << "Error: image cant be read " << this->url().string;
+        this->empty_ = true;
+        return;
+    }
+
+    const auto size = reader.size();
+    if (size.isEmpty())
+    {
+        this->empty_ = true;
+        return;
+    }
+
+    // returns 1 for non-animated formats
+    if (reader.imageCount() <= 0)
+    {
+        qCDebug(chatterinoImage)
+            << "Error: image has less than 1 frame " << this->url().string
+            << ": " << reader.errorString();
+        this->empty_ = true;
+        return;
+    }
+
+    // use "double" to prevent int overflows
+    auto decodedBytes = double(size.width()) * double(size.height()) *
+                        double(reader.imageCount()) * 4.0;
+    if (decodedBytes > double(Image::maxBytesRam))
+    {
+        qCDebug(chatterinoImage) << "image too large in RAM";
+
+        this->empty_ = true;
+        return;
+    }
+
+    if (reader.imageCount() > 1 &&
+        decodedBytes > double(Image::streamingThresholdBytes))
+    {
+        auto parsed = detail::scanFrames(reader, this->url());
+        // The frames are decoded later, so they need their own copy in case
+        // `data` refers to a mapped cache file
+        assignFrames(weakOf(this), parsed,
+                     QByteArray(data.constData(), data.size()));
+        return;
+    }
+
+    auto parsed = detail::readFrames(reader, this->url());
+
+    assignFrames(weakOf(this), parsed, {});
+}
+
 void Image::expireFrames()
 {
     assertInGuiThread();
@@ -583,6 +901,50 @@ void Image::expireFrames()
     this->shouldLoad_ = true;  // Mark as needing load again
 }
 
+ImageLoadScope *ImageLoadScope::current = nullptr;
+
+ImageLoadScope::ImageLoadScope(ImagePriority priority)
+    : parent_(current)
+    , priority_(priority)
+{
+    assertInGuiThread();
+    current = this;
+}
+
+ImageLoadScope::~ImageLoadScope()
+{
+    assert(current == this);
+    current = this->parent_;
+}
+
+ImagePriority ImageLoadScope::currentPriority()
+{
+    if (current == nullptr)
+    {
+        return ImagePriority::Visible;
+    }
+    return current->priority_;
+}
+
+const std::vector<const Image *> &ImageLoadScope::pendingImages() const
+{
+    return this->pendingImages_;
+}
+
+void ImageLoadScope::addPending(const Image *image)
+{
+    if (current == nullptr)
+    {
+        return;
+    }
+
+    auto &pending = current->pendingImages_;
+    if (std::ranges::find(pending, image) == pending.end())
+    {
+        pending.push_back(image);
+    }
+}
+
 #ifndef DISABLE_IMAGE_EXPIRATION_POOL
 
 ImageExpirationPool::ImageExpirationPool()
@@ -683,6 +1045,11 @@ void ImageExpirationPool::freeOld()
             it = this->allImages_.erase(it);
             continue;
         }
+        if (diff > IMAGE_POOL_STREAMED_FRAMES_LIFETIME)
+        {
+            // The image isn't on screen, so it doesn't need the next frames
+            img->frames_->dropDecodedFrames();
+        }
 
         ++it;
     }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "common/Aliases.hpp"
+#include "messages/ImageDecodeQueue.hpp"
+#include "messages/ImagePriority.hpp"
 
 #include <boost/variant.hpp>
 #include <pajlada/signals/signal.hpp>
+#include <QByteArray>
 #include <QList>
 #include <QPixmap>
 #include <QString>
@@ -12,10 +15,12 @@
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 namespace chatterino {
 
@@ -30,11 +35,22 @@ struct Frame {
     int duration;
 };
 
+class FrameDecoder;
+
 class Frames
 {
 public:
+    /// Number of frames a streamed image keeps decoded (besides the first)
+    static constexpr size_t maxStreamedFrames = 4;
+
     Frames();
     Frames(QList<Frame> &&frames);
+    /// Creates frames that are decoded from `data` when they're shown.
+    ///
+    /// Only the first frame in `frames` needs an image, the others are used
+    /// for their duration. The frames shown next are decoded ahead on the
+    /// ImageDecodeQueue, at most maxStreamedFrames are kept decoded.
+    Frames(QList<Frame> &&frames, QByteArray data);
     ~Frames();
 
     Frames(const Frames &) = delete;
@@ -47,20 +63,41 @@ public:
     bool empty() const;
     bool animated() const;
     void advance();
-    std::optional<QPixmap> current() const;
+    std::optional<QPixmap> current();
     std::optional<QPixmap> first() const;
 
-private:
+    /// Bytes of the decoded frames (and the encoded data if streamed)
     int64_t memoryUsage() const;
+
+    /// Drops the frames of a streamed image besides the first one
+    void dropDecodedFrames();
+
+private:
     void processOffset();
+    /// Queues the decoding of the next frames that aren't decoded
+    void decodeAhead();
+    /// Moves the frames decoded on the worker into `items_`
+    void takeDecoded();
+    void evictOldestFrame();
     QList<Frame> items_;
     QList<Frame>::size_type index_{0};
     int durationOffset_{0};
     pajlada::Signals::Connection gifTimerConnection_;
+
+    // Only set for streamed images (shared with the queued decode)
+    std::shared_ptr<FrameDecoder> decoder_;
+    /// Indices of the frames decoded on demand, oldest first
+    std::deque<QList<Frame>::size_type> decodedFrames_;
 };
 
 QList<Frame> readFrames(QImageReader &reader, const Url &url);
-void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed);
+/// Reads the durations of all frames like readFrames, but only keeps the
+/// image of the first frame
+QList<Frame> scanFrames(QImageReader &reader, const Url &url);
+/// Assigns the frames to the image on the GUI thread. If `data` isn't empty,
+/// the frames are streamed from it (see Frames).
+void assignFrames(std::weak_ptr<Image> weak, QList<Frame> parsed,
+                  QByteArray data);
 
 }  // namespace chatterino::detail
 
@@ -75,6 +112,9 @@ class Image : public std::enable_shared_from_this<Image>
 public:
     // Maximum amount of RAM used by the image in bytes.
     static constexpr int maxBytesRam = 20 * 1024 * 1024;
+    // Animated images taking up more RAM than this once decoded only keep
+    // their encoded data and decode their frames when they're shown.
+    static constexpr int streamingThresholdBytes = 512 * 1024;
 
     ~Image();
 
@@ -111,6 +151,9 @@ private:
 
     void setPixmap(const QPixmap &pixmap);
     void actuallyLoad();
+    /// Decodes the frames from `data` (on a worker thread). `data` might
+    /// refer to a mapped cache file, so it must not be kept.
+    void decode(const QByteArray &data);
     void expireFrames();
 
     const Url url_{};
@@ -129,10 +172,47 @@ private:
 
     // gui thread only
     std::unique_ptr<detail::Frames> frames_;
+    /// The highest priority this image was requested with while loading
+    ImagePriority priority_{ImagePriority::Prefetch};
+    std::weak_ptr<ImageDecodeQueue::Job> decodeJob_;
 
     friend class ImageExpirationPool;
     friend void detail::assignFrames(std::weak_ptr<Image>,
-                                     QList<detail::Frame>);
+                                     QList<detail::Frame>, QByteArray);
+};
+
+/// ImageLoadScope sets the priority of the images requested on the GUI thread
+/// while it's alive. It also collects the requested images that aren't
+/// loaded yet, so their users can be laid out again once they are.
+///
+/// Scopes can be nested. Outside of any scope, images are Visible.
+class ImageLoadScope
+{
+public:
+    explicit ImageLoadScope(ImagePriority priority);
+    ~ImageLoadScope();
+
+    ImageLoadScope(const ImageLoadScope &) = delete;
+    ImageLoadScope(ImageLoadScope &&) = delete;
+    ImageLoadScope &operator=(const ImageLoadScope &) = delete;
+    ImageLoadScope &operator=(ImageLoadScope &&) = delete;
+
+    /// Returns the priority of the innermost scope
+    static ImagePriority currentPriority();
+
+    /// Images requested in this scope that weren't loaded yet
+    const std::vector<const Image *> &pendingImages() const;
+
+private:
+    static void addPending(const Image *image);
+
+    static ImageLoadScope *current;
+
+    ImageLoadScope *parent_;
+    ImagePriority priority_;
+    std::vector<const Image *> pendingImages_;
+
+    friend class Image;
 };
 
 // forward-declarable function that calls Image::getEmpty() under the hood.
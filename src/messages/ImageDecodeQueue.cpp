@@ -0,0 +1,140 @@
+#include "messages/ImageDecodeQueue.hpp"
+
+#include "util/DebugCount.hpp"
+
+#include <QThread>
+
+#include <algorithm>
+
+namespace chatterino {
+
+struct ImageDecodeQueue::Job {
+    std::weak_ptr<const void> owner;
+    std::function<void()> decode;
+
+    // guarded by the queue's mutex
+    ImagePriority priority;
+    bool started = false;
+};
+
+ImageDecodeQueue::ImageDecodeQueue()
+    : ImageDecodeQueue(std::max(1, QThread::idealThreadCount() / 2))
+{
+}
+
+ImageDecodeQueue::ImageDecodeQueue(int maxThreadCount)
+{
+    this->pool_.setMaxThreadCount(maxThreadCount);
+}
+
+ImageDecodeQueue::~ImageDecodeQueue()
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        for (size_t priority = 0; priority < this->queues_.size(); priority++)
+        {
+            for (const auto &job : this->queues_[priority])
+            {
+                if (!job->started && size_t(job->priority) == priority)
+                {
+                    DebugCount::decrease("queued image decodes");
+                }
+            }
+            this->queues_[priority].clear();
+        }
+    }
+
+    this->pool_.clear();
+    this->pool_.waitForDone();
+}
+
+ImageDecodeQueue::JobPtr ImageDecodeQueue::push(
+    ImagePriority priority, std::weak_ptr<const void> owner,
+    std::function<void()> decode)
+{
+    auto job = std::make_shared<Job>(Job{
+        .owner = std::move(owner),
+        .decode = std::move(decode),
+        .priority = priority,
+    });
+
+    {
+        std::lock_guard lock(this->mutex_);
+        this->queues_[size_t(priority)].push_back(job);
+    }
+    DebugCount::increase("queued image decodes");
+
+    // Every task runs the most important job queued at the time it starts
+    this->pool_.start([this] {
+        this->runNext();
+    });
+
+    return job;
+}
+
+void ImageDecodeQueue::raise(const JobPtr &job, ImagePriority priority)
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        if (job->started || job->priority >= priority)
+        {
+            return;
+        }
+
+        job->priority = priority;
+        this->queues_[size_t(priority)].push_back(job);
+    }
+
+    this->pool_.start([this] {
+        this->runNext();
+    });
+}
+
+void ImageDecodeQueue::waitForDone()
+{
+    this->pool_.waitForDone();
+}
+
+void ImageDecodeQueue::runNext()
+{
+    auto job = this->takeNext();
+    if (!job)
+    {
+        // Another task already ran the job (it was raised)
+        return;
+    }
+    DebugCount::decrease("queued image decodes");
+
+    if (job->owner.expired())
+    {
+        DebugCount::increase("cancelled image decodes");
+        return;
+    }
+
+    job->decode();
+}
+
+ImageDecodeQueue::JobPtr ImageDecodeQueue::takeNext()
+{
+    std::lock_guard lock(this->mutex_);
+
+    for (auto priority = this->queues_.size(); priority-- > 0;)
+    {
+        auto &queue = this->queues_[priority];
+        while (!queue.empty())
+        {
+            auto job = std::move(queue.front());
+            queue.pop_front();
+
+            if (!job->started && size_t(job->priority) == priority)
+            {
+                job->started = true;
+                return job;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "messages/ImagePriority.hpp"
+
+#include <QThreadPool>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace chatterino {
+
+/// ImageDecodeQueue decodes images on a bounded number of worker threads.
+///
+/// Jobs run in the order of their priority, and in the order they were
+/// queued within a priority. A job is dropped without running if its owner
+/// (the Image) was destroyed while it waited.
+class ImageDecodeQueue
+{
+public:
+    struct Job;
+    using JobPtr = std::shared_ptr<Job>;
+
+    /// Uses half of the available cores
+    ImageDecodeQueue();
+    explicit ImageDecodeQueue(int maxThreadCount);
+    ~ImageDecodeQueue();
+
+    ImageDecodeQueue(const ImageDecodeQueue &) = delete;
+    ImageDecodeQueue(ImageDecodeQueue &&) = delete;
+    ImageDecodeQueue &operator=(const ImageDecodeQueue &) = delete;
+    ImageDecodeQueue &operator=(ImageDecodeQueue &&) = delete;
+
+    /// Queues `decode` to run on a worker thread unless `owner` expires
+    /// before that
+    JobPtr push(ImagePriority priority, std::weak_ptr<const void> owner,
+                std::function<void()> decode);
+
+    /// Moves `job` to a higher priority. Does nothing if the job already
+    /// started or if its priority isn't lower than `priority`.
+    void raise(const JobPtr &job, ImagePriority priority);
+
+    /// Blocks until all queued jobs finished (only used in tests)
+    void waitForDone();
+
+private:
+    static constexpr size_t PRIORITY_COUNT =
+        size_t(ImagePriority::Visible) + 1;
+
+    void runNext();
+    JobPtr takeNext();
+
+    std::mutex mutex_;
+    /// Queued jobs by their priority. Raised jobs stay in their old queue
+    /// too, but are skipped there.
+    std::array<std::deque<JobPtr>, PRIORITY_COUNT> queues_;
+
+    QThreadPool pool_;
+};
+
+}  // namespace chatterino
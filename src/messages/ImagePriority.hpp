@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace chatterino {
+
+/// How urgently an image is needed. Images with a higher priority are
+/// decoded first.
+enum class ImagePriority : uint8_t {
+    /// Images of messages that were laid out but aren't shown yet
+    Prefetch,
+    /// Images shown in the emote popup
+    Popup,
+    /// Images shown in a split (or anywhere else)
+    Visible,
+};
+
+}  // namespace chatterino
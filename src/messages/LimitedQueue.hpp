@@ -2,24 +2,36 @@
 
 #include "messages/LimitedQueueSnapshot.hpp"
 
-#include <boost/circular_buffer.hpp>
-
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <span>
 #include <utility>
 #include <vector>
 
 namespace chatterino {
 
+/// LimitedQueue is a thread-safe queue holding at most `limit` items. Once
+/// it's full, pushing to the back evicts the front.
+///
+/// Items are stored in fixed-size chunks that are shared with snapshots. A
+/// chunk is only copied when an item a snapshot can see is modified, so
+/// taking a snapshot is cheap and doesn't block writers for long.
 template <typename T>
 class LimitedQueue
 {
+    using Chunk = detail::LimitedQueueChunk<T>;
+    using Items = detail::LimitedQueueItems<T>;
+    static constexpr size_t CHUNK_SIZE = detail::LIMITED_QUEUE_CHUNK_SIZE;
+
 public:
     LimitedQueue(size_t limit = 1000)
         : limit_(limit)
-        , buffer_(limit)
     {
     }
 
@@ -32,7 +44,135 @@ private:
      */
     [[nodiscard]] size_t space() const
     {
-        return this->limit() - this->buffer_.size();
+        return this->limit() - this->size_;
+    }
+
+    /// Returns the item at `index`. This does not lock.
+    const T &itemAt(size_t index) const
+    {
+        assert(index < this->size_);
+        auto pos = this->offset_ + index;
+        return this->chunks_[pos / CHUNK_SIZE]->items[pos % CHUNK_SIZE];
+    }
+
+    /// Returns the item at `index` for writing, copying its chunk if a
+    /// snapshot shares it. This does not lock.
+    T &mutableItemAt(size_t index)
+    {
+        assert(index < this->size_);
+        auto pos = this->offset_ + index;
+        return this->mutableChunk(pos / CHUNK_SIZE).items[pos % CHUNK_SIZE];
+    }
+
+    Chunk &mutableChunk(size_t index)
+    {
+        auto &chunk = this->chunks_[index];
+        if (chunk.use_count() > 1)
+        {
+            chunk = std::make_shared<Chunk>(*chunk);
+        }
+        else
+        {
+            // Pairs with the release of the last snapshot that shared the
+            // chunk, which might have happened on another thread
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *chunk;
+    }
+
+    /// Drops the cached snapshot. Must be called (with the unique lock held)
+    /// before the items are modified.
+    void invalidateSnapshot()
+    {
+        this->published_.reset();
+    }
+
+    /// Appends an item to the back. This does not lock or evict.
+    void appendItem(const T &item)
+    {
+        auto pos = this->offset_ + this->size_;
+        if (pos / CHUNK_SIZE == this->chunks_.size())
+        {
+            this->chunks_.push_back(std::make_shared<Chunk>());
+        }
+        // The back never shrinks (unless the chunks are replaced), so no
+        // snapshot can see this slot and the chunk doesn't need to be copied.
+        this->chunks_[pos / CHUNK_SIZE]->items[pos % CHUNK_SIZE] = item;
+        this->size_++;
+    }
+
+    /// Prepends an item to the front. This does not lock or evict.
+    void prependItem(const T &item)
+    {
+        if (this->offset_ == 0)
+        {
+            this->chunks_.push_front(std::make_shared<Chunk>());
+            this->offset_ = CHUNK_SIZE;
+        }
+        this->offset_--;
+        // Snapshots taken before the previous front was evicted can still
+        // see this slot
+        this->mutableChunk(0).items[this->offset_] = item;
+        this->size_++;
+    }
+
+    /// Removes the item at the front. This does not lock.
+    ///
+    /// The item is destroyed together with its chunk once all items of the
+    /// chunk are removed.
+    void removeFront(T *deleted = nullptr)
+    {
+        assert(this->size_ > 0);
+        if (deleted)
+        {
+            *deleted = this->chunks_.front()->items[this->offset_];
+        }
+
+        this->offset_++;
+        this->size_--;
+        if (this->offset_ == CHUNK_SIZE)
+        {
+            this->chunks_.pop_front();
+            this->offset_ = 0;
+        }
+    }
+
+    /// Replaces all chunks with new ones holding `items`
+    void assign(const std::vector<T> &items)
+    {
+        assert(items.size() <= this->limit_);
+        this->chunks_.clear();
+        this->offset_ = 0;
+        this->size_ = 0;
+        for (const auto &item : items)
+        {
+            this->appendItem(item);
+        }
+    }
+
+    /// Inserts `item` before the item at `index`. If the queue is full, the
+    /// front is evicted, unless `index` is the front, in which case nothing
+    /// is inserted.
+    void insertAt(size_t index, const T &item)
+    {
+        bool full = this->size_ >= this->limit_;
+        if (full && index == 0)
+        {
+            return;
+        }
+
+        std::vector<T> items;
+        items.reserve(this->size_ + 1);
+        for (size_t i = full ? 1 : 0; i < index; i++)
+        {
+            items.push_back(this->itemAt(i));
+        }
+        items.push_back(item);
+        for (size_t i = index; i < this->size_; i++)
+        {
+            items.push_back(this->itemAt(i));
+        }
+        this->assign(items);
     }
 
 public:
@@ -51,7 +191,7 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        return this->buffer_.empty();
+        return this->size_ == 0;
     }
 
     /// Value Accessors
@@ -67,12 +207,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (index >= this->buffer_.size())
+        if (index >= this->size_)
         {
             return std::nullopt;
         }
 
-        return this->buffer_[index];
+        return this->itemAt(index);
     }
 
     /**
@@ -84,12 +224,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (this->buffer_.empty())
+        if (this->size_ == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.front();
+        return this->itemAt(0);
     }
 
     /**
@@ -101,12 +241,12 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        if (this->buffer_.empty())
+        if (this->size_ == 0)
         {
             return std::nullopt;
         }
 
-        return this->buffer_.back();
+        return this->itemAt(this->size_ - 1);
     }
 
     /// Modifiers
@@ -116,7 +256,10 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        this->buffer_.clear();
+        this->invalidateSnapshot();
+        this->chunks_.clear();
+        this->offset_ = 0;
+        this->size_ = 0;
     }
 
     /**
@@ -130,12 +273,18 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        bool full = this->buffer_.full();
+        if (this->limit_ == 0)
+        {
+            return true;
+        }
+
+        this->invalidateSnapshot();
+        bool full = this->size_ >= this->limit_;
         if (full)
         {
-            deleted = this->buffer_.front();
+            this->removeFront(&deleted);
         }
-        this->buffer_.push_back(item);
+        this->appendItem(item);
         return full;
     }
 
@@ -149,11 +298,69 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        bool full = this->buffer_.full();
-        this->buffer_.push_back(item);
+        if (this->limit_ == 0)
+        {
+            return true;
+        }
+
+        this->invalidateSnapshot();
+        bool full = this->size_ >= this->limit_;
+        if (full)
+        {
+            this->removeFront();
+        }
+        this->appendItem(item);
         return full;
     }
 
+    /**
+     * @brief Push items to the end of the queue
+     *
+     * Equivalent to pushing each item on its own, but takes the lock once.
+     *
+     * @param items the items to push
+     * @param[out] deleted the items that were deleted to make room (oldest
+     *             first, possibly including some of `items`)
+     * @return the number of items that were deleted to make room
+     */
+    size_t pushBack(std::span<const T> items, std::vector<T> *deleted = nullptr)
+    {
+        std::unique_lock lock(this->mutex_);
+
+        if (this->limit_ == 0)
+        {
+            return items.size();
+        }
+        if (items.empty())
+        {
+            return 0;
+        }
+
+        this->invalidateSnapshot();
+        auto total = this->size_ + items.size();
+        auto overflow = total > this->limit_ ? total - this->limit_ : 0;
+
+        auto fromQueue = std::min(overflow, this->size_);
+        for (size_t i = 0; i < fromQueue; i++)
+        {
+            this->removeFront(deleted ? &deleted->emplace_back() : nullptr);
+        }
+
+        // Pushing more items than the limit evicts the first ones right away
+        auto skipped = overflow - fromQueue;
+        if (deleted)
+        {
+            deleted->insert(deleted->end(), items.begin(),
+                            items.begin() + static_cast<ptrdiff_t>(skipped));
+        }
+        for (const auto &item : items.subspan(skipped))
+        {
+            this->appendItem(item);
+        }
+
+        return overflow;
+    }
+
     /**
      * @brief Push items into beginning of queue
      *
@@ -171,12 +378,16 @@ public:
         size_t numToPush = std::min(items.size(), this->space());
         std::vector<T> pushed;
         pushed.reserve(numToPush);
+        if (numToPush > 0)
+        {
+            this->invalidateSnapshot();
+        }
 
         size_t f = items.size() - numToPush;
         size_t b = items.size() - 1;
         for (; f < items.size(); ++f, --b)
         {
-            this->buffer_.push_front(items[b]);
+            this->prependItem(items[b]);
             pushed.push_back(items[f]);
         }
 
@@ -197,11 +408,12 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (size_t i = 0; i < this->buffer_.size(); ++i)
+        for (size_t i = 0; i < this->size_; ++i)
         {
-            if (eq(this->buffer_[i], needle))
+            if (eq(this->itemAt(i), needle))
             {
-                this->buffer_[i] = replacement;
+                this->invalidateSnapshot();
+                this->mutableItemAt(i) = replacement;
                 return static_cast<int>(i);
             }
         }
@@ -220,18 +432,19 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        if (index >= this->buffer_.size())
+        if (index >= this->size_)
         {
             return false;
         }
 
+        this->invalidateSnapshot();
         if (prev)
         {
-            *prev = std::exchange(this->buffer_[index], replacement);
+            *prev = std::exchange(this->mutableItemAt(index), replacement);
         }
         else
         {
-            this->buffer_[index] = replacement;
+            this->mutableItemAt(index) = replacement;
         }
         return true;
     }
@@ -248,17 +461,19 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        if (hint < this->buffer_.size() && this->buffer_[hint] == needle)
+        if (hint < this->size_ && this->itemAt(hint) == needle)
         {
-            this->buffer_[hint] = replacement;
+            this->invalidateSnapshot();
+            this->mutableItemAt(hint) = replacement;
             return static_cast<int>(hint);
         }
 
-        for (size_t i = 0; i < this->buffer_.size(); ++i)
+        for (size_t i = 0; i < this->size_; ++i)
         {
-            if (this->buffer_[i] == needle)
+            if (this->itemAt(i) == needle)
             {
-                this->buffer_[i] = replacement;
+                this->invalidateSnapshot();
+                this->mutableItemAt(i) = replacement;
                 return static_cast<int>(i);
             }
         }
@@ -279,11 +494,12 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        for (size_t i = 0; i < this->size_; ++i)
         {
-            if (eq(*it, needle))
+            if (eq(this->itemAt(i), needle))
             {
-                this->buffer_.insert(it, item);
+                this->invalidateSnapshot();
+                this->insertAt(i, item);
                 return true;
             }
         }
@@ -305,12 +521,12 @@ public:
         std::unique_lock lock(this->mutex_);
 
         Equals eq;
-        for (auto it = this->buffer_.begin(); it != this->buffer_.end(); ++it)
+        for (size_t i = 0; i < this->size_; ++i)
         {
-            if (eq(*it, needle))
+            if (eq(this->itemAt(i), needle))
             {
-                ++it;  // advance to insert after it
-                this->buffer_.insert(it, item);
+                this->invalidateSnapshot();
+                this->insertAt(i + 1, item);
                 return true;
             }
         }
@@ -318,10 +534,27 @@ public:
         return false;
     }
 
+    /**
+     * @brief Returns an immutable view of the current items
+     *
+     * Snapshots of an unchanged queue share their items, so this only
+     * copies a pointer per chunk after the queue was modified.
+     */
     [[nodiscard]] LimitedQueueSnapshot<T> getSnapshot() const
     {
         std::shared_lock lock(this->mutex_);
-        return LimitedQueueSnapshot<T>(this->buffer_);
+        std::lock_guard guard(this->snapshotMutex_);
+
+        if (!this->published_)
+        {
+            auto items = std::make_shared<Items>();
+            items->chunks.assign(this->chunks_.begin(), this->chunks_.end());
+            items->offset = this->offset_;
+            items->size = this->size_;
+            this->published_ = std::move(items);
+        }
+
+        return LimitedQueueSnapshot<T>(this->published_);
     }
 
     // Actions
@@ -342,11 +575,11 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        for (const auto &item : this->buffer_)
+        for (size_t i = 0; i < this->size_; ++i)
         {
-            if (pred(item))
+            if (pred(this->itemAt(i)))
             {
-                return item;
+                return this->itemAt(i);
             }
         }
 
@@ -364,16 +597,16 @@ public:
     {
         std::unique_lock lock(this->mutex_);
 
-        if (hint < this->buffer_.size() && predicate(this->buffer_[hint]))
+        if (hint < this->size_ && predicate(this->itemAt(hint)))
         {
-            return std::pair{hint, this->buffer_[hint]};
+            return std::pair{hint, this->itemAt(hint)};
         };
 
-        for (size_t i = 0; i < this->buffer_.size(); i++)
+        for (size_t i = 0; i < this->size_; i++)
         {
-            if (predicate(this->buffer_[i]))
+            if (predicate(this->itemAt(i)))
             {
-                return std::pair{i, this->buffer_[i]};
+                return std::pair{i, this->itemAt(i)};
             }
         }
         return std::nullopt;
@@ -395,11 +628,11 @@ public:
     {
         std::shared_lock lock(this->mutex_);
 
-        for (auto it = this->buffer_.rbegin(); it != this->buffer_.rend(); ++it)
+        for (size_t i = this->size_; i > 0; --i)
         {
-            if (pred(*it))
+            if (pred(this->itemAt(i - 1)))
             {
-                return *it;
+                return this->itemAt(i - 1);
             }
         }
 
@@ -410,7 +643,15 @@ private:
     mutable std::shared_mutex mutex_;
 
     const size_t limit_;
-    boost::circular_buffer<T> buffer_;
+
+    /// Items are stored from `offset_` in the first chunk onwards
+    std::deque<std::shared_ptr<Chunk>> chunks_;
+    size_t offset_ = 0;
+    size_t size_ = 0;
+
+    /// The items handed out by getSnapshot until the queue is modified
+    mutable std::shared_ptr<const Items> published_;
+    mutable std::mutex snapshotMutex_;
 };
 
 }  // namespace chatterino
@@ -1,8 +1,10 @@
 #pragma once
 
-#include <boost/circular_buffer.hpp>
-
+#include <array>
 #include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -11,52 +13,196 @@ namespace chatterino {
 template <typename T>
 class LimitedQueue;
 
+namespace detail {
+
+/// Number of items in one chunk of a LimitedQueue
+inline constexpr size_t LIMITED_QUEUE_CHUNK_SIZE = 64;
+
+template <typename T>
+struct LimitedQueueChunk {
+    std::array<T, LIMITED_QUEUE_CHUNK_SIZE> items{};
+};
+
+/// The items of a LimitedQueue at one point in time. The chunks are shared
+/// with the queue and other snapshots.
+template <typename T>
+struct LimitedQueueItems {
+    std::vector<std::shared_ptr<const LimitedQueueChunk<T>>> chunks;
+    /// Index of the first item in chunks[0]
+    size_t offset = 0;
+    size_t size = 0;
+
+    const T &operator[](size_t index) const
+    {
+        assert(index < this->size);
+        auto pos = this->offset + index;
+        return this->chunks[pos / LIMITED_QUEUE_CHUNK_SIZE]
+            ->items[pos % LIMITED_QUEUE_CHUNK_SIZE];
+    }
+};
+
+}  // namespace detail
+
+/// LimitedQueueSnapshot is an immutable view of the items of a LimitedQueue.
+///
+/// Taking a snapshot doesn't copy the items. The queue copies a chunk of
+/// items before it modifies items a snapshot can see.
 template <typename T>
 class LimitedQueueSnapshot
 {
 private:
     friend class LimitedQueue<T>;
 
-    LimitedQueueSnapshot(const boost::circular_buffer<T> &buf)
-        : buffer_(buf.begin(), buf.end())
+    using Items = detail::LimitedQueueItems<T>;
+
+    LimitedQueueSnapshot(std::shared_ptr<const Items> items)
+        : items_(std::move(items))
     {
     }
 
 public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        Iterator() = default;
+        Iterator(const Items *items, size_t index)
+            : items_(items)
+            , index_(index)
+        {
+        }
+
+        reference operator*() const
+        {
+            return (*this->items_)[this->index_];
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return *(*this + n);
+        }
+
+        Iterator &operator++()
+        {
+            ++this->index_;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        Iterator &operator--()
+        {
+            --this->index_;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+
+        Iterator &operator+=(difference_type n)
+        {
+            this->index_ =
+                static_cast<size_t>(static_cast<difference_type>(this->index_) +
+                                    n);
+            return *this;
+        }
+
+        Iterator &operator-=(difference_type n)
+        {
+            return *this += -n;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const Iterator &lhs,
+                                         const Iterator &rhs)
+        {
+            return static_cast<difference_type>(lhs.index_) -
+                   static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator &lhs, const Iterator &rhs)
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend std::strong_ordering operator<=>(const Iterator &lhs,
+                                                const Iterator &rhs)
+        {
+            return lhs.index_ <=> rhs.index_;
+        }
+
+    private:
+        const Items *items_ = nullptr;
+        size_t index_ = 0;
+    };
+
     LimitedQueueSnapshot() = default;
 
     size_t size() const
     {
-        return this->buffer_.size();
+        return this->items_ ? this->items_->size : 0;
     }
 
     const T &operator[](size_t index) const
     {
-        return this->buffer_[index];
+        return (*this->items_)[index];
     }
 
-    auto begin() const
+    Iterator begin() const
     {
-        return this->buffer_.begin();
+        return {this->items_.get(), 0};
     }
 
-    auto end() const
+    Iterator end() const
     {
-        return this->buffer_.end();
+        return {this->items_.get(), this->size()};
     }
 
     auto rbegin() const
     {
-        return this->buffer_.rbegin();
+        return std::reverse_iterator(this->end());
     }
 
     auto rend() const
     {
-        return this->buffer_.rend();
+        return std::reverse_iterator(this->begin());
     }
 
 private:
-    std::vector<T> buffer_;
+    std::shared_ptr<const Items> items_;
 };
 
 }  // namespace chatterino
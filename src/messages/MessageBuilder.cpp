@@ -8,21 +8,20 @@
 #include "controllers/highlights/HighlightController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnorePhraseSet.hpp"
 #include "controllers/userdata/UserDataController.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteLookup.hpp"
 #include "messages/Image.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageColor.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/MessageThread.hpp"
-#include "providers/bttv/BttvEmotes.hpp"
 #include "providers/chatterino/ChatterinoBadges.hpp"
 #include "providers/colors/ColorProvider.hpp"
 #include "providers/ffz/FfzBadges.hpp"
-#include "providers/ffz/FfzEmotes.hpp"
 #include "providers/links/LinkResolver.hpp"
 #include "providers/seventv/SeventvBadges.hpp"
-#include "providers/seventv/SeventvEmotes.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/ChannelPointReward.hpp"
 #include "providers/twitch/TwitchAccount.hpp"
@@ -31,6 +30,7 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "providers/twitch/TwitchUser.hpp"
 #include "providers/twitch/TwitchUsers.hpp"
 #include "providers/twitch/UserColor.hpp"
 #include "singletons/Emotes.hpp"
@@ -43,10 +43,8 @@
 #include "util/Helpers.hpp"
 #include "util/IrcHelpers.hpp"
 #include "util/QStringHash.hpp"
-#include "util/Variant.hpp"
 #include "widgets/Window.hpp"
 
-#include <boost/variant.hpp>
 #include <QApplication>
 #include <QColor>
 #include <QDateTime>
@@ -78,11 +76,6 @@ const QRegularExpression allUsernamesMentionRegex("^" + regexHelpString);
 
 const QRegularExpression SPACE_REGEX("\\s");
 
-const QSet<QString> zeroWidthEmotes{
-    "SoSnowy",  "IceCold",   "SantaHat", "TopHat",
-    "ReinDeer", "CandyCane", "cvMask",   "cvHazmat",
-};
-
 struct HypeChatPaidLevel {
     std::chrono::seconds duration;
     uint8_t numeric;
@@ -421,97 +414,6 @@ EmotePtr makeSharedChatBadge(const QString &sourceName,
     });
 }
 
-std::tuple<std::optional<EmotePtr>, MessageElementFlags, bool> parseEmote(
-    TwitchChannel *twitchChannel, const EmoteName &name)
-{
-    // Emote order:
-    //  - FrankerFaceZ Channel
-    //  - BetterTTV Channel
-    //  - 7TV Channel
-    //  - FrankerFaceZ Global
-    //  - BetterTTV Global
-    //  - 7TV Global
-
-    const auto *globalFfzEmotes = getApp()->getFfzEmotes();
-    const auto *globalBttvEmotes = getApp()->getBttvEmotes();
-    const auto *globalSeventvEmotes = getApp()->getSeventvEmotes();
-
-    std::optional<EmotePtr> emote{};
-
-    if (twitchChannel != nullptr)
-    {
-        // Check for channel emotes
-
-        emote = twitchChannel->ffzEmote(name);
-        if (emote)
-        {
-            return {
-                emote,
-                MessageElementFlag::FfzEmote,
-                false,
-            };
-        }
-
-        emote = twitchChannel->bttvEmote(name);
-        if (emote)
-        {
-            return {
-                emote,
-                MessageElementFlag::BttvEmote,
-                false,
-            };
-        }
-
-        emote = twitchChannel->seventvEmote(name);
-        if (emote)
-        {
-            return {
-                emote,
-                MessageElementFlag::SevenTVEmote,
-                emote.value()->zeroWidth,
-            };
-        }
-    }
-
-    // Check for global emotes
-
-    emote = globalFfzEmotes->emote(name);
-    if (emote)
-    {
-        return {
-            emote,
-            MessageElementFlag::FfzEmote,
-            false,
-        };
-    }
-
-    emote = globalBttvEmotes->emote(name);
-    if (emote)
-    {
-        return {
-            emote,
-            MessageElementFlag::BttvEmote,
-            zeroWidthEmotes.contains(name.string),
-        };
-    }
-
-    emote = globalSeventvEmotes->globalEmote(name);
-    if (emote)
-    {
-        return {
-            emote,
-            MessageElementFlag::SevenTVEmote,
-            emote.value()->zeroWidth,
-        };
-    }
-
-    return {
-        {},
-        {},
-        false,
-    };
-}
-
 }  // namespace
 
 namespace chatterino {
@@ -1653,7 +1555,11 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
 
     builder.appendUsername(tags, args);
 
-    TextState textState{.twitchChannel = twitchChannel};
+    TextState textState{
+        .twitchChannel = twitchChannel,
+        .emotes = twitchChannel ? twitchChannel->emoteLookup()
+                                : EmoteLookup::global(),
+    };
     QString bits;
 
     auto iterator = tags.find("bits");
@@ -1669,8 +1575,7 @@ std::pair<MessagePtrMut, HighlightAlert> MessageBuilder::makeIrcMessage(
         parseTwitchEmotes(tags, content, static_cast<int>(messageOffset));
 
     // This runs through all ignored phrases and runs its replacements on content
-    processIgnorePhrases(*getSettings()->ignoredMessages.readOnly(), content,
-                         twitchEmotes);
+    processIgnorePhrases(*IgnorePhraseSet::current(), content, twitchEmotes);
 
     std::ranges::sort(twitchEmotes, [](const auto &a, const auto &b) {
         return a.start < b.start;
@@ -1740,6 +1645,22 @@ void MessageBuilder::addEmoji(const EmotePtr &emote)
     this->emplace<EmoteElement>(emote, MessageElementFlag::EmojiAll);
 }
 
+void MessageBuilder::addEmojisOrText(TextState &state, const QString &text)
+{
+    auto spans = getApp()->getEmotes()->getEmojis()->parseSpans(text);
+    for (const auto &span : spans)
+    {
+        if (span.emote)
+        {
+            this->addEmoji(span.emote);
+        }
+        else
+        {
+            this->addTextOrEmote(state, text.mid(span.start, span.length));
+        }
+    }
+}
+
 void MessageBuilder::addTextOrEmote(TextState &state, QString string)
 {
     if (state.hasBits && this->tryAppendCheermote(state, string))
@@ -1753,7 +1674,7 @@ void MessageBuilder::addTextOrEmote(TextState &state, QString string)
     // Emote name: "forsenPuke" - if string in ignoredEmotes
     // Will match emote regardless of source (i.e. bttv, ffz)
     // Emote source + name: "bttv:nyanPls"
-    if (this->tryAppendEmote(state.twitchChannel, {string}))
+    if (this->tryAppendEmote(*state.emotes, {string}))
     {
         // Successfully appended an emote
         return;
@@ -2237,15 +2158,15 @@ void MessageBuilder::appendUsername(const QVariantMap &tags,
     }
 }
 
-Outcome MessageBuilder::tryAppendEmote(TwitchChannel *twitchChannel,
+Outcome MessageBuilder::tryAppendEmote(const EmoteLookup &emotes,
                                        const EmoteName &name)
 {
-    auto [emote, flags, zeroWidth] = parseEmote(twitchChannel, name);
-
-    if (!emote)
+    const auto *entry = emotes.find(name);
+    if (!entry)
     {
         return Failure;
     }
+    const auto &[emote, flags, zeroWidth] = *entry;
 
     if (zeroWidth && getSettings()->enableZeroWidthEmotes && !this->isEmpty())
     {
@@ -2259,7 +2180,7 @@ Outcome MessageBuilder::tryAppendEmote(TwitchChannel *twitchChannel,
             auto baseEmoteElement = this->releaseBack();
 
             std::vector<LayeredEmoteElement::Emote> layers = {
-                {baseEmote, baseEmoteElement->getFlags()}, {*emote, flags}};
+                {baseEmote, baseEmoteElement->getFlags()}, {emote, flags}};
             this->emplace<LayeredEmoteElement>(
                 std::move(layers), baseEmoteElement->getFlags() | flags,
                 this->textColor_);
@@ -2269,7 +2190,7 @@ Outcome MessageBuilder::tryAppendEmote(TwitchChannel *twitchChannel,
         auto *asLayered = dynamic_cast<LayeredEmoteElement *>(&this->back());
         if (asLayered)
         {
-            asLayered->addEmoteLayer({*emote, flags});
+            asLayered->addEmoteLayer({emote, flags});
             asLayered->addFlags(flags);
             return Success;
         }
@@ -2277,7 +2198,7 @@ Outcome MessageBuilder::tryAppendEmote(TwitchChannel *twitchChannel,
         // No emote to merge with, just show as regular emote
     }
 
-    this->emplace<EmoteElement>(*emote, flags, this->textColor_);
+    this->emplace<EmoteElement>(emote, flags, this->textColor_);
     return Success;
 }
 
@@ -2333,20 +2254,7 @@ void MessageBuilder::addWords(
 
             // 1. Add text before the emote
             QString preText = word.left(currentTwitchEmote.start - cursor);
-            for (auto variant :
-                 getApp()->getEmotes()->getEmojis()->parse(preText))
-            {
-                boost::apply_visitor(variant::Overloaded{
-                                         [&](const EmotePtr &emote) {
-                                             this->addEmoji(emote);
-                                         },
-                                         [&](QString text) {
-                                             this->addTextOrEmote(
-                                                 state, std::move(text));
-                                         },
-                                     },
-                                     variant);
-            }
+            this->addEmojisOrText(state, preText);
 
             cursor += preText.size();
 
@@ -2359,19 +2267,7 @@ void MessageBuilder::addWords(
         }
 
         // split words
-        for (auto variant : getApp()->getEmotes()->getEmojis()->parse(word))
-        {
-            boost::apply_visitor(variant::Overloaded{
-                                     [&](const EmotePtr &emote) {
-                                         this->addEmoji(emote);
-                                     },
-                                     [&](QString text) {
-                                         this->addTextOrEmote(state,
-                                                              std::move(text));
-                                     },
-                                 },
-                                 variant);
-        }
+        this->addEmojisOrText(state, word);
 
         cursor += word.size() + 1;
     }
@@ -2398,9 +2294,12 @@ void MessageBuilder::appendTwitchBadges(const QVariantMap &tags,
         }
         else
         {
-            auto twitchUser = getApp()->getTwitchUsers()->resolveID({sourceId});
-            sourceProfilePicture = twitchUser->profilePictureUrl;
-            sourceLogin = twitchUser->name;
+            // Messages are built outside of the GUI thread, where the shared
+            // user is updated
+            auto twitchUser =
+                getApp()->getTwitchUsers()->resolveIDCopy({sourceId});
+            sourceProfilePicture = twitchUser.profilePictureUrl;
+            sourceLogin = twitchUser.name;
 
             if (twitchChannel->roomId() == sourceId)
             {
@@ -2409,7 +2308,7 @@ void MessageBuilder::appendTwitchBadges(const QVariantMap &tags,
             }
             else
             {
-                sourceName = twitchUser->displayName;
+                sourceName = twitchUser.displayName;
             }
         }
 
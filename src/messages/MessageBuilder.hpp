@@ -26,6 +26,7 @@ class MessageElement;
 class TextElement;
 struct Emote;
 using EmotePtr = std::shared_ptr<const Emote>;
+class EmoteLookup;
 
 class Channel;
 class TwitchChannel;
@@ -255,15 +256,19 @@ public:
 private:
     struct TextState {
         TwitchChannel *twitchChannel = nullptr;
+        /// Fetched once per message, so each word is looked up only once
+        std::shared_ptr<const EmoteLookup> emotes;
         bool hasBits = false;
         bool bitsStacked = false;
         int bitsLeft = 0;
     };
     void addEmoji(const EmotePtr &emote);
     void addTextOrEmote(TextState &state, QString string);
+    /// Adds the emojis in `text` and the text between them
+    void addEmojisOrText(TextState &state, const QString &text);
 
     Outcome tryAppendCheermote(TextState &state, const QString &string);
-    Outcome tryAppendEmote(TwitchChannel *twitchChannel, const EmoteName &name);
+    Outcome tryAppendEmote(const EmoteLookup &emotes, const EmoteName &name);
 
     bool isEmpty() const;
     MessageElement &back();
@@ -9,6 +9,7 @@
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/layouts/TextPreparation.hpp"
 #include "providers/emoji/Emojis.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Settings.hpp"
@@ -602,9 +603,24 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
     {
         auto metrics =
             app->getFonts()->getFontMetrics(this->style_, container.getScale());
+        auto &wordWidths =
+            app->getFonts()->getWordWidths(this->style_, container.getScale());
 
-        for (const auto &word : this->words_)
+        const std::vector<qreal> *preparedWidths = nullptr;
+        if (ctx.preparedText)
         {
+            preparedWidths = ctx.preparedText->widths(this, this->style_);
+            if (preparedWidths &&
+                preparedWidths->size() != size_t(this->words_.size()))
+            {
+                preparedWidths = nullptr;
+            }
+        }
+
+        for (qsizetype wordIndex = 0; wordIndex < this->words_.size();
+             wordIndex++)
+        {
+            const auto &word = this->words_[wordIndex];
             auto wordId = container.nextWordId();
 
             auto getTextLayoutElement = [&](QString text, qreal width,
@@ -622,7 +638,8 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 return e;
             };
 
-            auto width = metrics.horizontalAdvance(word);
+            auto width = preparedWidths ? (*preparedWidths)[size_t(wordIndex)]
+                                        : wordWidths.width(word);
 
             // see if the text fits in the current line
             if (container.fitsInLine(width))
@@ -782,6 +799,11 @@ FontStyle TextElement::fontStyle() const noexcept
     return this->style_;
 }
 
+const QStringList &TextElement::words() const noexcept
+{
+    return this->words_;
+}
+
 void TextElement::appendText(QStringView text)
 {
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
@@ -849,6 +871,8 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
     {
         auto metrics =
             app->getFonts()->getFontMetrics(this->style_, container.getScale());
+        auto &wordWidths =
+            app->getFonts()->getWordWidths(this->style_, container.getScale());
 
         auto getTextLayoutElement = [&](QString text, qreal width,
                                         bool hasTrailingSpace) {
@@ -883,12 +907,13 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
             }
 
             bool done = false;
-            for (const auto &parsedWord :
-                 app->getEmotes()->getEmojis()->parse(word.text))
+            for (const auto &span :
+                 app->getEmotes()->getEmojis()->parseSpans(word.text))
             {
-                if (parsedWord.type() == typeid(QString))
+                if (!span.emote)
                 {
-                    currentText += boost::get<QString>(parsedWord);
+                    currentText.append(
+                        QStringView(word.text).mid(span.start, span.length));
                     QString prev =
                         currentText;  // only increments the ref-count
                     currentText =
@@ -900,17 +925,15 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
                         break;
                     }
                 }
-                else if (parsedWord.type() == typeid(EmotePtr))
+                else
                 {
-                    auto emote = boost::get<EmotePtr>(parsedWord);
-                    auto image =
-                        emote->images.getImageOrLoaded(container.getScale());
+                    auto image = span.emote->images.getImageOrLoaded(
+                        container.getScale());
                     if (!image->isEmpty())
                     {
                         auto emoteScale = getSettings()->emoteScale.getValue();
 
-                        auto currentWidth =
-                            metrics.horizontalAdvance(currentText);
+                        auto currentWidth = wordWidths.width(currentText);
                         auto emoteSize =
                             image->size() * emoteScale * container.getScale();
 
@@ -944,7 +967,7 @@ void SingleLineTextElement::addToContainer(MessageLayoutContainer &container,
         // Add the last of the pending message text to the container.
         if (!currentText.isEmpty())
         {
-            auto width = metrics.horizontalAdvance(currentText);
+            auto width = wordWidths.width(currentText);
             container.addElementNoLineBreak(
                 getTextLayoutElement(currentText, width, false));
         }
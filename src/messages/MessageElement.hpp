@@ -253,6 +253,7 @@ public:
 
     const MessageColor &color() const noexcept;
     FontStyle fontStyle() const noexcept;
+    const QStringList &words() const noexcept;
 
     void appendText(QStringView text);
     void appendText(const QString &text);
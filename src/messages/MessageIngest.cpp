@@ -0,0 +1,186 @@
+#include "messages/MessageIngest.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "util/DebugCount.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// Pool shared by all ingests, separate from the global pool so requests
+/// running there can't hold up live messages.
+QThreadPool &ingestPool()
+{
+    // Leaked on purpose: ingests might still post jobs during shutdown
+    static auto *pool = [] {
+        auto *pool = new QThreadPool;
+        pool->setMaxThreadCount(std::max(2, QThread::idealThreadCount() / 2));
+        return pool;
+    }();
+    return *pool;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+std::shared_ptr<MessageIngest> MessageIngest::create()
+{
+    return std::shared_ptr<MessageIngest>(new MessageIngest);
+}
+
+void MessageIngest::post(Job job)
+{
+    assertInGuiThread();
+
+    bool startWorker = false;
+    {
+        std::lock_guard lock(this->mutex_);
+        auto slot = this->firstSlot_ + this->slots_.size();
+        this->slots_.emplace_back();
+        this->jobs_.push_back({
+            .job = std::move(job),
+            .slot = slot,
+        });
+        startWorker = !this->running_;
+        this->running_ = true;
+    }
+    DebugCount::increase("queued message builds");
+
+    if (startWorker)
+    {
+        ingestPool().start([self = this->shared_from_this()] {
+            self->runJobs();
+        });
+    }
+}
+
+void MessageIngest::runInOrder(Apply apply)
+{
+    assertInGuiThread();
+
+    {
+        std::lock_guard lock(this->mutex_);
+        if (!this->slots_.empty())
+        {
+            this->slots_.push_back({
+                .apply = std::move(apply),
+                .ready = true,
+            });
+            return;
+        }
+    }
+
+    if (apply)
+    {
+        apply();
+    }
+}
+
+void MessageIngest::flush()
+{
+    assertInGuiThread();
+
+    std::vector<Apply> ready;
+    {
+        std::lock_guard lock(this->mutex_);
+        this->flushScheduled_ = false;
+        while (!this->slots_.empty() && this->slots_.front().ready)
+        {
+            ready.emplace_back(std::move(this->slots_.front().apply));
+            this->slots_.pop_front();
+            this->firstSlot_++;
+        }
+    }
+
+    for (const auto &apply : ready)
+    {
+        if (apply)
+        {
+            apply();
+        }
+    }
+
+    if (!ready.empty() && this->afterFlush_)
+    {
+        this->afterFlush_();
+    }
+}
+
+void MessageIngest::setAfterFlush(Apply afterFlush)
+{
+    assertInGuiThread();
+
+    this->afterFlush_ = std::move(afterFlush);
+}
+
+bool MessageIngest::isIdle() const
+{
+    std::lock_guard lock(this->mutex_);
+    return this->slots_.empty() && this->jobs_.empty() && !this->running_;
+}
+
+void MessageIngest::waitForDone()
+{
+    ingestPool().waitForDone();
+    this->flush();
+}
+
+void MessageIngest::runJobs()
+{
+    while (true)
+    {
+        QueuedJob next;
+        {
+            std::lock_guard lock(this->mutex_);
+            if (this->jobs_.empty())
+            {
+                this->running_ = false;
+                return;
+            }
+            next = std::move(this->jobs_.front());
+            this->jobs_.pop_front();
+        }
+
+        auto apply = next.job();
+        DebugCount::decrease("queued message builds");
+
+        bool schedule = false;
+        {
+            std::lock_guard lock(this->mutex_);
+            auto &slot = this->slots_[next.slot - this->firstSlot_];
+            slot.apply = std::move(apply);
+            slot.ready = true;
+
+            schedule = !this->flushScheduled_;
+            this->flushScheduled_ = true;
+        }
+
+        if (schedule)
+        {
+            this->scheduleFlush();
+        }
+    }
+}
+
+void MessageIngest::scheduleFlush()
+{
+    // Results arriving within one frame are applied together
+    postToThread([weak = this->weak_from_this()] {
+        QTimer::singleShot(FRAME_INTERVAL, QCoreApplication::instance(),
+                           [weak] {
+                               if (auto self = weak.lock())
+                               {
+                                   self->flush();
+                               }
+                           });
+    });
+}
+
+}  // namespace chatterino
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace chatterino {
+
+/// MessageIngest builds the messages of a channel on worker threads and
+/// applies them in the GUI thread in the order they were received.
+///
+/// Jobs posted to one ingest run one after another, so each job sees the
+/// effects of the earlier ones. Jobs of different ingests run in parallel.
+/// A job returns what has to be done in the GUI thread (e.g. adding the
+/// built messages to the channel). These results are applied in the order
+/// their jobs were posted, in batches of at most one per frame.
+class MessageIngest : public std::enable_shared_from_this<MessageIngest>
+{
+public:
+    using Apply = std::function<void()>;
+    using Job = std::function<Apply()>;
+
+    /// Time results are collected for before they're applied
+    static constexpr std::chrono::milliseconds FRAME_INTERVAL{16};
+
+    static std::shared_ptr<MessageIngest> create();
+
+    MessageIngest(const MessageIngest &) = delete;
+    MessageIngest(MessageIngest &&) = delete;
+    MessageIngest &operator=(const MessageIngest &) = delete;
+    MessageIngest &operator=(MessageIngest &&) = delete;
+
+    /// @brief Runs `job` on a worker thread after the earlier jobs
+    ///
+    /// The returned function is run in the GUI thread after the results of
+    /// the earlier jobs. Has to be called from the GUI thread.
+    void post(Job job);
+
+    /// @brief Runs `apply` in the GUI thread after the results of all jobs
+    /// posted so far
+    ///
+    /// If there are no pending jobs, `apply` runs right away. Has to be
+    /// called from the GUI thread.
+    void runInOrder(Apply apply);
+
+    /// Applies the results that are ready (in the GUI thread)
+    void flush();
+
+    /// @brief Sets a function that runs in the GUI thread after each flush
+    /// that applied results
+    ///
+    /// Results can defer work to it, so it's done once for all results
+    /// applied together. Has to be called from the GUI thread.
+    void setAfterFlush(Apply afterFlush);
+
+    /// Returns true if no job or result is pending
+    bool isIdle() const;
+
+    /// Blocks until all jobs ran and applies their results (only used in
+    /// tests)
+    void waitForDone();
+
+private:
+    MessageIngest() = default;
+
+    struct Slot {
+        Apply apply;
+        bool ready = false;
+    };
+
+    struct QueuedJob {
+        Job job;
+        uint64_t slot = 0;
+    };
+
+    /// Runs the queued jobs until there are none left (on a worker thread)
+    void runJobs();
+
+    void scheduleFlush();
+
+    mutable std::mutex mutex_;
+    /// Results in the order their jobs were posted
+    std::deque<Slot> slots_;
+    /// Sequence number of the first slot
+    uint64_t firstSlot_ = 0;
+    std::deque<QueuedJob> jobs_;
+    /// Whether a worker is running the queued jobs
+    bool running_ = false;
+    bool flushScheduled_ = false;
+
+    /// GUI thread only
+    Apply afterFlush_;
+};
+
+}  // namespace chatterino
@@ -7,59 +7,35 @@
 #include "singletons/Settings.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace {
 
 using namespace chatterino;
 
-float relativeSimilarity(QStringView str1, QStringView str2)
-{
-    using SizeType = QStringView::size_type;
+using Sketch = MessageSimilarityCache::Sketch;
 
-    // Longest Common Substring Problem
-    std::vector<std::vector<int>> tree(str1.size(),
-                                       std::vector<int>(str2.size(), 0));
-    int z = 0;
+/// Enough for every message checked for similarity in a busy channel
+constexpr size_t SKETCH_CACHE_SIZE = 64;
 
-    for (SizeType i = 0; i < str1.size(); ++i)
-    {
-        for (SizeType j = 0; j < str2.size(); ++j)
-        {
-            if (str1[i] == str2[j])
-            {
-                if (i == 0 || j == 0)
-                {
-                    tree[i][j] = 1;
-                }
-                else
-                {
-                    tree[i][j] = tree[i - 1][j - 1] + 1;
-                }
-                z = std::max(tree[i][j], z);
-            }
-            else
-            {
-                tree[i][j] = 0;
-            }
-        }
-    }
-
-    // ensure that no div by 0
-    if (z == 0)
-    {
-        return 0.F;
-    }
+size_t sketchBucket(QChar c)
+{
+    return c.unicode() % Sketch::BUCKETS;
+}
 
-    auto div = std::max<>({static_cast<SizeType>(1), str1.size(), str2.size()});
+float relativeSimilarity(qsizetype common, qsizetype size1, qsizetype size2)
+{
+    auto div = std::max<>({static_cast<qsizetype>(1), size1, size2});
 
-    return float(z) / float(div);
+    return float(common) / float(div);
 }
 
 template <std::ranges::bidirectional_range T>
-float inMessages(const MessagePtr &msg, const T &messages)
+bool isSimilarToAny(const MessagePtr &msg, const T &messages,
+                    MessageSimilarityCache &cache, float threshold)
 {
-    float similarityPercent = 0.0F;
+    auto sketch = cache.get(msg);
 
     for (const auto &prevMsg :
          messages | std::views::reverse |
@@ -75,20 +51,148 @@ float inMessages(const MessagePtr &msg, const T &messages)
         {
             continue;
         }
-        similarityPercent = std::max(
-            similarityPercent,
-            relativeSimilarity(msg->messageText, prevMsg->messageText));
+
+        auto prevSketch = cache.get(prevMsg);
+        auto bound = Sketch::commonUpperBound(sketch, prevSketch);
+        if (relativeSimilarity(bound, sketch.length, prevSketch.length) <=
+            threshold)
+        {
+            continue;
+        }
+
+        qsizetype common = 0;
+        if (sketch.hash == prevSketch.hash &&
+            msg->messageText == prevMsg->messageText)
+        {
+            // Copypasta
+            common = sketch.length;
+        }
+        else
+        {
+            common = longestCommonSubstring(msg->messageText,
+                                            prevMsg->messageText);
+        }
+
+        if (relativeSimilarity(common, sketch.length, prevSketch.length) >
+            threshold)
+        {
+            return true;
+        }
     }
 
-    return similarityPercent;
+    return false;
 }
 
 }  // namespace
 
 namespace chatterino {
 
+qsizetype longestCommonSubstring(QStringView str1, QStringView str2)
+{
+    if (str2.size() > str1.size())
+    {
+        std::swap(str1, str2);
+    }
+    if (str2.isEmpty())
+    {
+        return 0;
+    }
+
+    // Only the previous row of the table is needed. Walking each row
+    // backwards lets it be updated in place.
+    thread_local std::vector<qsizetype> row;
+    row.assign(static_cast<size_t>(str2.size()) + 1, 0);
+
+    qsizetype longest = 0;
+    for (auto c : str1)
+    {
+        for (auto j = str2.size(); j > 0; --j)
+        {
+            auto &cell = row[static_cast<size_t>(j)];
+            if (c == str2[j - 1])
+            {
+                cell = row[static_cast<size_t>(j - 1)] + 1;
+                longest = std::max(longest, cell);
+            }
+            else
+            {
+                cell = 0;
+            }
+        }
+        if (longest == str2.size())
+        {
+            break;
+        }
+    }
+
+    return longest;
+}
+
+MessageSimilarityCache::Sketch MessageSimilarityCache::Sketch::of(
+    QStringView text)
+{
+    Sketch sketch;
+    for (auto c : text)
+    {
+        auto &count = sketch.histogram[sketchBucket(c)];
+        if (count < std::numeric_limits<uint16_t>::max())
+        {
+            count++;
+        }
+    }
+    sketch.length = text.size();
+    sketch.hash = qHash(text);
+    return sketch;
+}
+
+qsizetype MessageSimilarityCache::Sketch::commonUpperBound(const Sketch &a,
+                                                         const Sketch &b)
+{
+    // A common substring can't contain more units of a bucket than either
+    // text. Saturated buckets are treated as unbounded.
+    qsizetype bound = 0;
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        auto count = std::min(a.histogram[i], b.histogram[i]);
+        if (count == std::numeric_limits<uint16_t>::max())
+        {
+            return std::min(a.length, b.length);
+        }
+        bound += count;
+    }
+    return bound;
+}
+
+MessageSimilarityCache::MessageSimilarityCache()
+    : entries_(SKETCH_CACHE_SIZE)
+{
+}
+
+MessageSimilarityCache::Sketch MessageSimilarityCache::get(
+    const MessagePtr &message)
+{
+    std::lock_guard lock(this->mutex_);
+
+    if (this->entries_.exists(message.get()))
+    {
+        const auto &entry = this->entries_.get(message.get());
+        if (!entry.message.expired())
+        {
+            return entry.sketch;
+        }
+    }
+
+    auto sketch = Sketch::of(message->messageText);
+    this->entries_.put(message.get(), {
+                                          .message = message,
+                                          .sketch = sketch,
+                                      });
+    return sketch;
+}
+
 template <std::ranges::bidirectional_range T>
-void setSimilarityFlags(const MessagePtr &message, const T &messages)
+void setSimilarityFlags(const MessagePtr &message, const T &messages,
+                        MessageSimilarityCache &cache)
 {
     if (getSettings()->similarityEnabled)
     {
@@ -102,7 +206,8 @@ void setSimilarityFlags(const MessagePtr &message, const T &messages)
             return;
         }
 
-        if (inMessages(message, messages) > getSettings()->similarityPercentage)
+        if (isSimilarToAny(message, messages, cache,
+                           getSettings()->similarityPercentage))
         {
             message->flags.set(MessageFlag::Similar);
             if (getSettings()->colorSimilarDisabled)
@@ -114,8 +219,10 @@ void setSimilarityFlags(const MessagePtr &message, const T &messages)
 }
 
 template void setSimilarityFlags<std::vector<MessagePtr>>(
-    const MessagePtr &msg, const std::vector<MessagePtr> &messages);
+    const MessagePtr &msg, const std::vector<MessagePtr> &messages,
+    MessageSimilarityCache &cache);
 template void setSimilarityFlags<LimitedQueueSnapshot<MessagePtr>>(
-    const MessagePtr &msg, const LimitedQueueSnapshot<MessagePtr> &messages);
+    const MessagePtr &msg, const LimitedQueueSnapshot<MessagePtr> &messages,
+    MessageSimilarityCache &cache);
 
 }  // namespace chatterino
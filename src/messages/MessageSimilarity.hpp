@@ -1,11 +1,61 @@
 #pragma once
 
-#include "messages/Message.hpp"
+#include <lrucache/lrucache.hpp>
+#include <QStringView>
 
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <ranges>
+
 namespace chatterino {
 
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/// MessageSimilarityCache keeps a summary of the text of recent messages so
+/// they aren't processed again each time a new message is compared to them.
+/// Each message sink owns one.
+class MessageSimilarityCache
+{
+public:
+    struct Sketch {
+        static constexpr size_t BUCKETS = 64;
+
+        /// Number of UTF-16 units of the text in each bucket
+        std::array<uint16_t, BUCKETS> histogram{};
+        qsizetype length = 0;
+        size_t hash = 0;
+
+        static Sketch of(QStringView text);
+
+        /// Returns an upper bound of the length of the longest common
+        /// substring of the texts of `a` and `b`
+        static qsizetype commonUpperBound(const Sketch &a, const Sketch &b);
+    };
+
+    MessageSimilarityCache();
+
+    /// Returns the sketch of the text of `message`
+    Sketch get(const MessagePtr &message);
+
+private:
+    struct Entry {
+        /// Makes sure the key isn't the address of a newer message
+        std::weak_ptr<const Message> message;
+        Sketch sketch;
+    };
+
+    std::mutex mutex_;
+    cache::lru_cache<const Message *, Entry> entries_;
+};
+
+/// Returns the length of the longest common substring of `str1` and `str2`
+qsizetype longestCommonSubstring(QStringView str1, QStringView str2);
+
 template <std::ranges::bidirectional_range T>
-void setSimilarityFlags(const MessagePtr &message, const T &messages);
+void setSimilarityFlags(const MessagePtr &message, const T &messages,
+                        MessageSimilarityCache &cache);
 
 }  // namespace chatterino
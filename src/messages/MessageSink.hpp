@@ -4,6 +4,7 @@
 #include "common/FlagsEnum.hpp"
 #include "messages/MessageFlag.hpp"
 
+#include <functional>
 #include <memory>
 #include <optional>
 
@@ -67,6 +68,13 @@ public:
 
     /// Behaviour to be exercised when parsing/building messages for this sink.
     virtual MessageSinkTraits sinkTraits() const = 0;
+
+    /// @brief Runs a side effect of building a message in the GUI thread
+    ///
+    /// Messages might be built outside of the GUI thread. Effects of building
+    /// them on the GUI (e.g. alerts) run after the messages added so far.
+    /// Sinks used in the GUI thread run `fn` right away.
+    virtual void runSideEffect(std::function<void()> fn) = 0;
 };
 
 }  // namespace chatterino
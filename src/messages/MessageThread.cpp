@@ -1,8 +1,10 @@
 #include "messages/MessageThread.hpp"
 
 #include "common/Literals.hpp"
+#include "debug/AssertInGuiThread.hpp"
 #include "messages/Message.hpp"
 #include "util/DebugCount.hpp"
+#include "util/PostToThread.hpp"
 #include "util/QMagicEnum.hpp"
 
 #include <QJsonArray>
@@ -29,16 +31,19 @@ MessageThread::~MessageThread()
 
 void MessageThread::addToThread(const std::shared_ptr<const Message> &message)
 {
+    std::lock_guard lock(this->repliesMutex_);
     this->replies_.emplace_back(message);
 }
 
 void MessageThread::addToThread(const std::weak_ptr<const Message> &message)
 {
+    std::lock_guard lock(this->repliesMutex_);
     this->replies_.push_back(message);
 }
 
 size_t MessageThread::liveCount() const
 {
+    std::lock_guard lock(this->repliesMutex_);
     size_t count = 0;
     for (const auto &reply : this->replies_)
     {
@@ -54,6 +59,7 @@ size_t MessageThread::liveCount() const
 size_t MessageThread::liveCount(
     const std::shared_ptr<const Message> &exclude) const
 {
+    std::lock_guard lock(this->repliesMutex_);
     size_t count = 0;
     for (const auto &reply : this->replies_)
     {
@@ -68,24 +74,47 @@ size_t MessageThread::liveCount(
 
 void MessageThread::markSubscribed()
 {
-    if (this->subscription_ == Subscription::Subscribed)
+    if (this->subscription_.exchange(Subscription::Subscribed) ==
+        Subscription::Subscribed)
     {
         return;
     }
 
-    this->subscription_ = Subscription::Subscribed;
-    this->subscriptionUpdated();
+    this->notifySubscriptionUpdated();
 }
 
 void MessageThread::markUnsubscribed()
 {
-    if (this->subscription_ == Subscription::Unsubscribed)
+    if (this->subscription_.exchange(Subscription::Unsubscribed) ==
+        Subscription::Unsubscribed)
     {
         return;
     }
 
-    this->subscription_ = Subscription::Unsubscribed;
-    this->subscriptionUpdated();
+    this->notifySubscriptionUpdated();
+}
+
+std::vector<std::weak_ptr<const Message>> MessageThread::replies() const
+{
+    std::lock_guard lock(this->repliesMutex_);
+    return this->replies_;
+}
+
+void MessageThread::notifySubscriptionUpdated()
+{
+    if (isGuiThread())
+    {
+        this->subscriptionUpdated();
+        return;
+    }
+
+    // Threads building messages subscribe too, but the listeners are widgets
+    postToThread([weak = this->weak_from_this()] {
+        if (auto self = weak.lock())
+        {
+            self->subscriptionUpdated();
+        }
+    });
 }
 
 QJsonObject MessageThread::toJson() const
@@ -96,7 +125,7 @@ QJsonObject MessageThread::toJson() const
     };
 
     QJsonArray replies;
-    for (const auto &msg : this->replies_)
+    for (const auto &msg : this->replies())
     {
         auto locked = msg.lock();
         if (locked)
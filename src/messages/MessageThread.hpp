@@ -3,7 +3,9 @@
 #include <boost/signals2.hpp>
 #include <QString>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class QJsonObject;
@@ -11,7 +13,9 @@ class QJsonObject;
 namespace chatterino {
 struct Message;
 
-class MessageThread
+/// Threads are shared between the GUI thread and the threads building
+/// messages, so they're safe to use from any thread.
+class MessageThread : public std::enable_shared_from_this<MessageThread>
 {
 public:
     enum class Subscription : uint8_t {
@@ -34,14 +38,14 @@ public:
 
     bool subscribed() const
     {
-        return this->subscription_ == Subscription::Subscribed;
+        return this->subscription_.load() == Subscription::Subscribed;
     }
 
     /// Returns true if and only if the user manually unsubscribed from the thread
     /// @see #markUnsubscribed()
     bool unsubscribed() const
     {
-        return this->subscription_ == Subscription::Unsubscribed;
+        return this->subscription_.load() == Subscription::Unsubscribed;
     }
 
     /// Subscribe to this thread.
@@ -59,21 +63,24 @@ public:
         return rootMessage_;
     }
 
-    const std::vector<std::weak_ptr<const Message>> &replies() const
-    {
-        return replies_;
-    }
+    /// Returns a copy of the replies, as they might be added to concurrently
+    std::vector<std::weak_ptr<const Message>> replies() const;
 
     QJsonObject toJson() const;
 
+    /// Always invoked in the GUI thread
     boost::signals2::signal<void()> subscriptionUpdated;
 
 private:
+    void notifySubscriptionUpdated();
+
     const QString rootMessageId_;
     const std::shared_ptr<const Message> rootMessage_;
+
+    mutable std::mutex repliesMutex_;
     std::vector<std::weak_ptr<const Message>> replies_;
 
-    Subscription subscription_ = Subscription::None;
+    std::atomic<Subscription> subscription_ = Subscription::None;
 };
 
 }  // namespace chatterino
@@ -0,0 +1,234 @@
+#include "messages/layouts/MessageBufferPool.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "singletons/Settings.hpp"
+#include "util/DebugCount.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+size_t byteSize(const QPixmap &pixmap)
+{
+    return static_cast<size_t>(pixmap.width()) *
+           static_cast<size_t>(pixmap.height()) *
+           static_cast<size_t>(pixmap.depth() / 8);
+}
+
+}  // namespace
+
+namespace chatterino {
+
+MessageBufferPool::MessageBufferPool(size_t budget)
+    : budget_(budget)
+{
+    DebugCount::configure("message buffer pool (used)",
+                          DebugCount::Flag::DataSize);
+    DebugCount::configure("message buffer pool (idle)",
+                          DebugCount::Flag::DataSize);
+    DebugCount::configure("message buffer pool (budget)",
+                          DebugCount::Flag::DataSize);
+    this->updateDebugCounts();
+}
+
+MessageBufferPool::~MessageBufferPool() = default;
+
+MessageBufferPool &MessageBufferPool::instance()
+{
+    static auto *instance = [] {
+        auto *pool = new MessageBufferPool(0);
+        // The pool lives until the application exits
+        getSettings()->messageBufferPoolSize.connect([pool](int megabytes) {
+            pool->setBudget(static_cast<size_t>(std::max(megabytes, 0)) *
+                            1024 * 1024);
+        });
+        return pool;
+    }();
+    return *instance;
+}
+
+std::unique_ptr<QPixmap> MessageBufferPool::acquire(
+    QSize size, qreal devicePixelRatio, std::function<void()> reclaim)
+{
+    assertInGuiThread();
+
+    std::unique_ptr<QPixmap> pixmap;
+    auto idle = this->idleIndex_.find({
+        .width = size.width(),
+        .height = size.height(),
+        .devicePixelRatio = devicePixelRatio,
+    });
+    if (idle != this->idleIndex_.end())
+    {
+        pixmap = std::move(idle->second->pixmap);
+        this->idle_.erase(idle->second);
+        this->idleIndex_.erase(idle);
+        this->idleBytes_ -= byteSize(*pixmap);
+        DebugCount::increase("message buffers reused");
+    }
+    else
+    {
+        pixmap = std::make_unique<QPixmap>(size);
+        pixmap->setDevicePixelRatio(devicePixelRatio);
+    }
+
+    auto bytes = byteSize(*pixmap);
+    this->usedBytes_ += bytes;
+    this->used_.push_front({
+        .pixmap = pixmap.get(),
+        .bytes = bytes,
+        .reclaim = std::move(reclaim),
+    });
+    this->usedIndex_[pixmap.get()] = this->used_.begin();
+
+    this->trim(pixmap.get());
+    return pixmap;
+}
+
+void MessageBufferPool::touch(const QPixmap *pixmap)
+{
+    auto it = this->usedIndex_.find(pixmap);
+    if (it != this->usedIndex_.end())
+    {
+        this->used_.splice(this->used_.begin(), this->used_, it->second);
+    }
+}
+
+void MessageBufferPool::release(std::unique_ptr<QPixmap> pixmap)
+{
+    assertInGuiThread();
+
+    if (!pixmap)
+    {
+        return;
+    }
+
+    auto used = this->usedIndex_.find(pixmap.get());
+    if (used == this->usedIndex_.end())
+    {
+        // Not from this pool
+        return;
+    }
+    auto bytes = used->second->bytes;
+    this->used_.erase(used->second);
+    this->usedIndex_.erase(used);
+    this->usedBytes_ -= bytes;
+
+    // Only keep the buffer if the buffers in use leave room for it. Older
+    // idle buffers are evicted to make room.
+    if (pixmap->isNull() || this->reclaiming_ ||
+        this->usedBytes_ + bytes > this->budget_)
+    {
+        this->updateDebugCounts();
+        return;
+    }
+
+    auto key = keyOf(*pixmap);
+    this->idle_.push_front({.pixmap = std::move(pixmap), .index = {}});
+    this->idle_.front().index =
+        this->idleIndex_.emplace(key, this->idle_.begin());
+    this->idleBytes_ += bytes;
+    this->trim();
+}
+
+void MessageBufferPool::setBudget(size_t budget)
+{
+    this->budget_ = budget;
+    this->trim();
+}
+
+size_t MessageBufferPool::budget() const
+{
+    return this->budget_;
+}
+
+size_t MessageBufferPool::usedBytes() const
+{
+    return this->usedBytes_;
+}
+
+size_t MessageBufferPool::idleBytes() const
+{
+    return this->idleBytes_;
+}
+
+void MessageBufferPool::clear()
+{
+    this->idle_.clear();
+    this->idleIndex_.clear();
+    this->idleBytes_ = 0;
+    this->updateDebugCounts();
+}
+
+MessageBufferPool::Key MessageBufferPool::keyOf(const QPixmap &pixmap)
+{
+    return {
+        .width = pixmap.width(),
+        .height = pixmap.height(),
+        .devicePixelRatio = pixmap.devicePixelRatio(),
+    };
+}
+
+void MessageBufferPool::trim(const QPixmap *keep)
+{
+    this->evictIdle();
+
+    if (this->reclaiming_ || this->usedBytes_ <= this->budget_)
+    {
+        this->updateDebugCounts();
+        return;
+    }
+
+    // Take buffers back from the messages that painted them least recently.
+    // Their owners release them, which modifies used_, so the callbacks are
+    // collected first.
+    std::vector<std::function<void()>> reclaims;
+    size_t excess = this->usedBytes_ - this->budget_;
+    size_t reclaimed = 0;
+    for (auto it = this->used_.rbegin();
+         it != this->used_.rend() && reclaimed < excess; ++it)
+    {
+        if (it->pixmap == keep || !it->reclaim)
+        {
+            continue;
+        }
+        reclaims.push_back(it->reclaim);
+        reclaimed += it->bytes;
+    }
+
+    this->reclaiming_ = true;
+    for (const auto &reclaim : reclaims)
+    {
+        reclaim();
+    }
+    this->reclaiming_ = false;
+
+    DebugCount::increase("message buffers reclaimed",
+                         static_cast<int64_t>(reclaims.size()));
+    this->updateDebugCounts();
+}
+
+void MessageBufferPool::evictIdle()
+{
+    while (!this->idle_.empty() &&
+           this->usedBytes_ + this->idleBytes_ > this->budget_)
+    {
+        auto &oldest = this->idle_.back();
+        this->idleBytes_ -= byteSize(*oldest.pixmap);
+        this->idleIndex_.erase(oldest.index);
+        this->idle_.pop_back();
+    }
+}
+
+void MessageBufferPool::updateDebugCounts() const
+{
+    DebugCount::set("message buffer pool (used)",
+                    static_cast<int64_t>(this->usedBytes_));
+    DebugCount::set("message buffer pool (idle)",
+                    static_cast<int64_t>(this->idleBytes_));
+    DebugCount::set("message buffer pool (budget)",
+                    static_cast<int64_t>(this->budget_));
+}
+
+}  // namespace chatterino
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <QPixmap>
+#include <QSize>
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace chatterino {
+
+/// MessageBufferPool recycles the pixmaps MessageLayouts paint into.
+///
+/// When a message scrolls out of view its buffer is returned to the pool
+/// instead of being freed, and handed out again to the next message of the
+/// same size. Most messages are a single line, so scrolling mostly reuses
+/// buffers instead of allocating new ones.
+///
+/// All buffers, idle or in use, count against the budget. Once they take up
+/// more than it, idle buffers are evicted (least recently released first).
+/// If that's not enough, buffers in use are taken back from the messages
+/// that painted them least recently, and buffers released while the pool is
+/// over its budget are freed.
+class MessageBufferPool
+{
+public:
+    explicit MessageBufferPool(size_t budget);
+    ~MessageBufferPool();
+
+    MessageBufferPool(const MessageBufferPool &) = delete;
+    MessageBufferPool(MessageBufferPool &&) = delete;
+    MessageBufferPool &operator=(const MessageBufferPool &) = delete;
+    MessageBufferPool &operator=(MessageBufferPool &&) = delete;
+
+    /// Returns the pool shared by all views. Its budget is the
+    /// messageBufferPoolSize setting.
+    static MessageBufferPool &instance();
+
+    /// Returns a pixmap of `size` device pixels and the given device pixel
+    /// ratio. Its contents are undefined.
+    ///
+    /// @param reclaim Called when the pool needs the buffer back. It must
+    ///                release() the buffer. Without it, the buffer is only
+    ///                given back when its owner releases it.
+    std::unique_ptr<QPixmap> acquire(QSize size, qreal devicePixelRatio,
+                                     std::function<void()> reclaim = {});
+
+    /// Marks `pixmap` (from acquire) as used, so it's reclaimed after the
+    /// buffers that weren't used since
+    void touch(const QPixmap *pixmap);
+
+    /// Gives `pixmap` (from acquire) back to the pool
+    void release(std::unique_ptr<QPixmap> pixmap);
+
+    void setBudget(size_t budget);
+    size_t budget() const;
+
+    /// Bytes of the buffers currently used by messages
+    size_t usedBytes() const;
+    /// Bytes of the buffers kept for reuse
+    size_t idleBytes() const;
+
+    /// Frees all idle buffers
+    void clear();
+
+private:
+    struct Key {
+        int width = 0;
+        int height = 0;
+        qreal devicePixelRatio = 1;
+
+        auto operator<=>(const Key &) const = default;
+    };
+
+    struct IdleBuffer;
+    /// Most recently released first
+    using IdleList = std::list<IdleBuffer>;
+    using IdleIndex = std::multimap<Key, IdleList::iterator>;
+
+    struct IdleBuffer {
+        std::unique_ptr<QPixmap> pixmap;
+        IdleIndex::iterator index;
+    };
+
+    struct UsedBuffer {
+        const QPixmap *pixmap = nullptr;
+        size_t bytes = 0;
+        std::function<void()> reclaim;
+    };
+    /// Most recently used first
+    using UsedList = std::list<UsedBuffer>;
+
+    static Key keyOf(const QPixmap &pixmap);
+
+    /// Evicts idle buffers and reclaims buffers in use (except `keep`) until
+    /// the pool is within its budget
+    void trim(const QPixmap *keep = nullptr);
+    void evictIdle();
+    void updateDebugCounts() const;
+
+    size_t budget_;
+    size_t usedBytes_ = 0;
+    size_t idleBytes_ = 0;
+    /// Set while buffers in use are reclaimed, their owners release them
+    /// from within trim()
+    bool reclaiming_ = false;
+
+    IdleList idle_;
+    IdleIndex idleIndex_;
+
+    UsedList used_;
+    std::unordered_map<const QPixmap *, UsedList::iterator> usedIndex_;
+};
+
+}  // namespace chatterino
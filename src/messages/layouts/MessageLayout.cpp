@@ -1,9 +1,12 @@
 #include "messages/layouts/MessageLayout.hpp"
 
 #include "Application.hpp"
+#include "messages/Image.hpp"
+#include "messages/layouts/MessageBufferPool.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/layouts/TextPreparation.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/Selection.hpp"
@@ -19,6 +22,8 @@
 #include <QtGlobal>
 #include <QThread>
 
+#include <algorithm>
+
 namespace chatterino {
 
 namespace {
@@ -42,6 +47,7 @@ MessageLayout::MessageLayout(MessagePtr message)
 
 MessageLayout::~MessageLayout()
 {
+    this->deleteBuffer();
     DebugCount::decrease("message layout");
 }
 
@@ -124,6 +130,27 @@ bool MessageLayout::layout(const MessageLayoutContext &ctx,
     return true;
 }
 
+bool MessageLayout::isWaitingForAny(
+    const std::unordered_set<const Image *> &images) const
+{
+    return std::ranges::any_of(this->pendingImages_, [&](const auto *image) {
+        return images.contains(image);
+    });
+}
+
+const std::shared_ptr<const PreparedText> &MessageLayout::getPreparedText()
+    const
+{
+    return this->preparedText_;
+}
+
+void MessageLayout::setPreparedText(
+    std::shared_ptr<const PreparedText> preparedText)
+{
+    this->preparedText_ = std::move(preparedText);
+    this->flags.unset(MessageLayoutFlag::PreparingText);
+}
+
 void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
 {
 #ifdef FOURTF
@@ -147,6 +174,16 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
     bool hideSimilar = getSettings()->hideSimilar;
     bool hideReplies = !ctx.flags.has(MessageElementFlag::RepliedMessage);
 
+    ImageLoadScope imageScope(ctx.imagePriority);
+
+    auto layoutCtx = ctx;
+    if (this->preparedText_ &&
+        getApp()->getWindows()->getTextPreparation().isCurrent(
+            *this->preparedText_, ctx.scale))
+    {
+        layoutCtx.preparedText = this->preparedText_.get();
+    }
+
     this->container_.beginLayout(ctx.width, this->scale_, this->imageScale_,
                                  messageFlags);
 
@@ -199,7 +236,7 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
             continue;
         }
 
-        element->addToContainer(this->container_, ctx);
+        element->addToContainer(this->container_, layoutCtx);
     }
 
     if (this->height_ != this->container_.getHeight())
@@ -209,6 +246,7 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
 
     this->container_.endLayout();
     this->height_ = this->container_.getHeight();
+    this->pendingImages_ = imageScope.pendingImages();
 
     // collapsed state
     this->flags.unset(MessageLayoutFlag::Collapsed);
@@ -222,6 +260,7 @@ void MessageLayout::actuallyLayout(const MessageLayoutContext &ctx)
 MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
 {
     MessagePaintResult result;
+    ImageLoadScope imageScope(ImageLoadScope::currentPriority());
 
     QPixmap *pixmap = this->ensureBuffer(ctx.painter, ctx.canvasWidth,
                                          ctx.messageColors.hasTransparency);
@@ -330,6 +369,16 @@ MessagePaintResult MessageLayout::paint(const MessagePaintContext &ctx)
             brush);
     }
 
+    // Images that started loading while painting (e.g. after they expired)
+    for (const auto *image : imageScope.pendingImages())
+    {
+        if (std::ranges::find(this->pendingImages_, image) ==
+            this->pendingImages_.end())
+        {
+            this->pendingImages_.push_back(image);
+        }
+    }
+
     this->bufferValid_ = true;
 
     return result;
@@ -339,15 +388,23 @@ QPixmap *MessageLayout::ensureBuffer(QPainter &painter, qreal width, bool clear)
 {
     if (this->buffer_ != nullptr)
     {
+        MessageBufferPool::instance().touch(this->buffer_.get());
         return this->buffer_.get();
     }
 
-    // Create new buffer
-    this->buffer_ = std::make_unique<QPixmap>(
-        static_cast<int>(width * painter.device()->devicePixelRatioF()),
-        static_cast<int>(this->container_.getHeight() *
-                         painter.device()->devicePixelRatioF()));
-    this->buffer_->setDevicePixelRatio(painter.device()->devicePixelRatioF());
+    // Create new buffer (or reuse one of a message that scrolled out of view)
+    auto devicePixelRatio = painter.device()->devicePixelRatioF();
+    this->buffer_ = MessageBufferPool::instance().acquire(
+        {
+            static_cast<int>(width * devicePixelRatio),
+            static_cast<int>(this->container_.getHeight() * devicePixelRatio),
+        },
+        devicePixelRatio,
+        // The pool is over its budget, this message is drawn again once
+        // it's painted next
+        [this] {
+            this->deleteBuffer();
+        });
 
     if (clear)
     {
@@ -479,7 +536,7 @@ void MessageLayout::deleteBuffer()
     {
         DebugCount::decrease("message drawing buffers");
 
-        this->buffer_ = nullptr;
+        MessageBufferPool::instance().release(std::move(this->buffer_));
     }
 }
 
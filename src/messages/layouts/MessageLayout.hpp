@@ -8,6 +8,8 @@
 
 #include <cinttypes>
 #include <memory>
+#include <unordered_set>
+#include <vector>
 
 namespace chatterino {
 
@@ -19,6 +21,8 @@ struct MessageLayoutContainer;
 class MessageLayoutElement;
 struct MessagePaintContext;
 struct MessageLayoutContext;
+class PreparedText;
+class Image;
 
 enum class MessageElementFlag : int64_t;
 using MessageElementFlags = FlagsEnum<MessageElementFlag>;
@@ -30,6 +34,8 @@ enum class MessageLayoutFlag : uint8_t {
     Collapsed = 1 << 4,
     Expanded = 1 << 5,
     IgnoreHighlights = 1 << 6,
+    /// The text of the message is being measured by TextPreparation
+    PreparingText = 1 << 7,
 };
 using MessageLayoutFlags = FlagsEnum<MessageLayoutFlag>;
 
@@ -61,6 +67,15 @@ public:
 
     bool layout(const MessageLayoutContext &ctx, bool shouldInvalidateBuffer);
 
+    /// Returns true if this layout contains placeholders for any of `images`
+    /// (i.e. it needs to be laid out again now that they're loaded)
+    bool isWaitingForAny(
+        const std::unordered_set<const Image *> &images) const;
+
+    /// Text measured ahead of time by TextPreparation
+    const std::shared_ptr<const PreparedText> &getPreparedText() const;
+    void setPreparedText(std::shared_ptr<const PreparedText> preparedText);
+
     // Painting
     MessagePaintResult paint(const MessagePaintContext &ctx);
     void invalidateBuffer();
@@ -122,6 +137,9 @@ private:
     // variables
     const MessagePtr message_;
     MessageLayoutContainer container_;
+    std::shared_ptr<const PreparedText> preparedText_;
+    /// Images that weren't loaded when this message was laid out or painted
+    std::vector<const Image *> pendingImages_;
     std::unique_ptr<QPixmap> buffer_;
     bool bufferValid_ = false;
 
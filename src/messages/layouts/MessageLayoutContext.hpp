@@ -1,5 +1,6 @@
 #pragma once
 
+#include "messages/ImagePriority.hpp"
 #include "messages/MessageElement.hpp"
 
 #include <QColor>
@@ -12,6 +13,7 @@ class SignalHolder;
 namespace chatterino {
 
 class ColorProvider;
+class PreparedText;
 class Theme;
 class Settings;
 struct Selection;
@@ -92,6 +94,12 @@ struct MessageLayoutContext {
     int width = 1;
     float scale = 1;
     float imageScale = 1;
+
+    /// Priority of the images that start loading during the layout
+    ImagePriority imagePriority = ImagePriority::Visible;
+
+    /// Widths of words measured ahead of time (may be null)
+    const PreparedText *preparedText = nullptr;
 };
 
 }  // namespace chatterino
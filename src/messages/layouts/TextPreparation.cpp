@@ -0,0 +1,199 @@
+#include "messages/layouts/TextPreparation.hpp"
+
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageElement.hpp"
+#include "util/DebugCount.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QFontMetricsF>
+#include <QThread>
+
+#include <algorithm>
+#include <optional>
+#include <typeinfo>
+
+namespace {
+
+using namespace chatterino;
+
+struct Job {
+    std::weak_ptr<MessageLayout> layout;
+    MessagePtr message;
+};
+
+}  // namespace
+
+namespace chatterino {
+
+const std::vector<qreal> *PreparedText::widths(const TextElement *element,
+                                               FontStyle style) const
+{
+    for (const auto &entry : this->entries_)
+    {
+        if (entry.element == element)
+        {
+            return entry.style == style ? &entry.widths : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+TextPreparation::TextPreparation(Fonts &fonts)
+    : fonts_(fonts)
+{
+    // Leave some room for the image decoders
+    this->pool_.setMaxThreadCount(
+        std::max(1, QThread::idealThreadCount() / 2));
+
+    this->signalHolder_.managedConnect(fonts.fontChanged, [this] {
+        this->generation_++;
+        this->cachedFonts_.reset();
+    });
+}
+
+TextPreparation::~TextPreparation()
+{
+    this->pool_.clear();
+    this->pool_.waitForDone();
+}
+
+void TextPreparation::prepare(
+    const LimitedQueueSnapshot<MessageLayoutPtr> &messages, float scale)
+{
+    assertInGuiThread();
+
+    std::vector<Job> jobs;
+    auto submit = [&] {
+        if (jobs.empty())
+        {
+            return;
+        }
+
+        DebugCount::increase("text preparation jobs");
+        this->pool_.start([jobs = std::move(jobs),
+                           fonts = this->fontsFor(scale), scale,
+                           generation = this->generation_] {
+            std::array<std::optional<QFontMetricsF>, size_t(FontStyle::EndType)>
+                metrics;
+            std::vector<
+                std::pair<std::weak_ptr<MessageLayout>, PreparedText>>
+                results;
+            results.reserve(jobs.size());
+
+            for (const auto &job : jobs)
+            {
+                PreparedText prepared;
+                prepared.scale = scale;
+                prepared.generation = generation;
+
+                for (const auto &element : job.message->elements)
+                {
+                    // Subclasses of TextElement modify their text or style
+                    // when they're laid out
+                    if (typeid(*element) != typeid(TextElement))
+                    {
+                        continue;
+                    }
+                    const auto *text =
+                        static_cast<const TextElement *>(element.get());
+                    auto style = text->fontStyle();
+
+                    auto &fontMetrics = metrics[size_t(style)];
+                    if (!fontMetrics)
+                    {
+                        // QFont copies share their cache of font engines, so
+                        // each job creates its own fonts
+                        QFont font;
+                        font.fromString((*fonts)[size_t(style)]);
+                        fontMetrics.emplace(font);
+                    }
+
+                    std::vector<qreal> widths;
+                    widths.reserve(size_t(text->words().size()));
+                    for (const auto &word : text->words())
+                    {
+                        widths.push_back(fontMetrics->horizontalAdvance(word));
+                    }
+                    prepared.entries_.push_back({
+                        .element = text,
+                        .style = style,
+                        .widths = std::move(widths),
+                    });
+                }
+
+                results.emplace_back(job.layout, std::move(prepared));
+            }
+
+            postToThread([results = std::move(results)]() mutable {
+                for (auto &[weak, prepared] : results)
+                {
+                    if (auto layout = weak.lock())
+                    {
+                        layout->setPreparedText(
+                            std::make_shared<const PreparedText>(
+                                std::move(prepared)));
+                    }
+                }
+                DebugCount::decrease("text preparation jobs");
+            });
+        });
+        jobs.clear();
+    };
+
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        const auto &layout = messages[i];
+        if (layout->flags.has(MessageLayoutFlag::PreparingText))
+        {
+            continue;
+        }
+        const auto &prepared = layout->getPreparedText();
+        if (prepared && this->isCurrent(*prepared, scale))
+        {
+            continue;
+        }
+
+        layout->flags.set(MessageLayoutFlag::PreparingText);
+        jobs.push_back({
+            .layout = layout,
+            .message = layout->getMessagePtr(),
+        });
+        if (jobs.size() >= BATCH_SIZE)
+        {
+            submit();
+        }
+    }
+    submit();
+}
+
+bool TextPreparation::isCurrent(const PreparedText &text, float scale) const
+{
+    return text.generation == this->generation_ && text.scale == scale;
+}
+
+void TextPreparation::waitForDone()
+{
+    this->pool_.waitForDone();
+}
+
+std::shared_ptr<const TextPreparation::FontSet> TextPreparation::fontsFor(
+    float scale)
+{
+    if (this->cachedFonts_ && this->cachedScale_ == scale)
+    {
+        return this->cachedFonts_;
+    }
+
+    auto fonts = std::make_shared<FontSet>();
+    for (size_t i = 0; i < fonts->size(); i++)
+    {
+        (*fonts)[i] = this->fonts_.getFont(FontStyle(i), scale).toString();
+    }
+    this->cachedScale_ = scale;
+    this->cachedFonts_ = std::move(fonts);
+    return this->cachedFonts_;
+}
+
+}  // namespace chatterino
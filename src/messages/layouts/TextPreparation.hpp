@@ -0,0 +1,100 @@
+#pragma once
+
+#include "messages/LimitedQueueSnapshot.hpp"
+#include "singletons/Fonts.hpp"
+
+#include <pajlada/signals/signalholder.hpp>
+#include <QString>
+#include <QThreadPool>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+class MessageLayout;
+class TextElement;
+using MessageLayoutPtr = std::shared_ptr<MessageLayout>;
+
+/// PreparedText contains the widths of the words of a message's text
+/// elements in one font scale.
+///
+/// Measuring text is the most expensive part of laying out a message, but
+/// unlike the layout itself it doesn't depend on the width of the view or on
+/// the images in the message. It's done ahead of time on TextPreparation's
+/// worker threads, so relayouts (e.g. when resizing the window or when an
+/// emote finished loading) only have to place the words.
+class PreparedText
+{
+public:
+    /// Returns the widths of the words of `element` in `style` or nullptr if
+    /// they weren't measured
+    const std::vector<qreal> *widths(const TextElement *element,
+                                     FontStyle style) const;
+
+    float scale = 0;
+    int generation = 0;
+
+private:
+    struct Entry {
+        const TextElement *element;
+        FontStyle style;
+        std::vector<qreal> widths;
+    };
+    std::vector<Entry> entries_;
+
+    friend class TextPreparation;
+};
+
+/// TextPreparation measures the text of messages on a small pool of worker
+/// threads and hands the results to their MessageLayouts on the GUI thread.
+///
+/// Only plain TextElements are measured, since other elements (links,
+/// mentions, timestamps, emotes) change their text or style while being laid
+/// out. Their text is still measured synchronously.
+class TextPreparation
+{
+public:
+    /// Number of layouts measured in one job
+    static constexpr size_t BATCH_SIZE = 128;
+
+    explicit TextPreparation(Fonts &fonts);
+    ~TextPreparation();
+
+    TextPreparation(const TextPreparation &) = delete;
+    TextPreparation(TextPreparation &&) = delete;
+    TextPreparation &operator=(const TextPreparation &) = delete;
+    TextPreparation &operator=(TextPreparation &&) = delete;
+
+    /// Queues the layouts in `messages` whose text isn't measured for
+    /// `scale` yet. Must be called from the GUI thread.
+    void prepare(const LimitedQueueSnapshot<MessageLayoutPtr> &messages,
+                 float scale);
+
+    /// Returns true if `text` was measured with the current fonts in `scale`
+    bool isCurrent(const PreparedText &text, float scale) const;
+
+    /// Blocks until all queued jobs finished (only used in tests)
+    void waitForDone();
+
+private:
+    /// Descriptions (QFont::toString) of the fonts of all styles in a scale
+    using FontSet = std::array<QString, size_t(FontStyle::EndType)>;
+
+    std::shared_ptr<const FontSet> fontsFor(float scale);
+
+    Fonts &fonts_;
+    /// Incremented whenever the fonts change, which invalidates all
+    /// measurements
+    int generation_ = 0;
+
+    float cachedScale_ = 0;
+    std::shared_ptr<const FontSet> cachedFonts_;
+
+    QThreadPool pool_;
+
+    pajlada::Signals::SignalHolder signalHolder_;
+};
+
+}  // namespace chatterino
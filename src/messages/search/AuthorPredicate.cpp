@@ -21,4 +21,15 @@ bool AuthorPredicate::appliesToImpl(const Message &message)
            authors_.contains(message.loginName, Qt::CaseInsensitive);
 }
 
+std::optional<SearchIndex::Positions> AuthorPredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    SearchIndex::Positions positions;
+    for (const auto &author : this->authors_)
+    {
+        positions = SearchIndex::unite(positions, index.byAuthor(author));
+    }
+    return positions;
+}
+
 }  // namespace chatterino
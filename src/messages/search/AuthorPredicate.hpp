@@ -35,6 +35,16 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Finds the messages sent by any of the users passed in
+     *        the constructor.
+     *
+     * @param index the index of the messages to search
+     * @return the positions of the messages sent by one of the specified users
+     */
+    std::optional<SearchIndex::Positions> candidatesImpl(
+        const SearchIndex &index) const override;
+
 private:
     /// Holds the user names that will be searched for
     QStringList authors_;
@@ -44,4 +44,15 @@ bool BadgePredicate::appliesToImpl(const Message &message)
     return false;
 }
 
+std::optional<SearchIndex::Positions> BadgePredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    SearchIndex::Positions positions;
+    for (const auto &badge : this->badges_)
+    {
+        positions = SearchIndex::unite(positions, index.withBadge(badge));
+    }
+    return positions;
+}
+
 }  // namespace chatterino
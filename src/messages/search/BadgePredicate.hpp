@@ -35,6 +35,16 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Finds the messages with any of the badges passed in
+     *        the constructor.
+     *
+     * @param index the index of the messages to search
+     * @return the positions of the messages with one of the specified badges
+     */
+    std::optional<SearchIndex::Positions> candidatesImpl(
+        const SearchIndex &index) const override;
+
 private:
     /// Holds the badges that will be searched for
     QStringList badges_;
@@ -20,4 +20,15 @@ bool ChannelPredicate::appliesToImpl(const Message &message)
     return channels_.contains(message.channelName, Qt::CaseInsensitive);
 }
 
+std::optional<SearchIndex::Positions> ChannelPredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    SearchIndex::Positions positions;
+    for (const auto &channel : this->channels_)
+    {
+        positions = SearchIndex::unite(positions, index.inChannel(channel));
+    }
+    return positions;
+}
+
 }  // namespace chatterino
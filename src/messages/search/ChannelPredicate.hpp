@@ -35,6 +35,17 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Finds the messages sent in any of the channels passed in
+     *        the constructor.
+     *
+     * @param index the index of the messages to search
+     * @return the positions of the messages sent in one of the specified
+     *         channels
+     */
+    std::optional<SearchIndex::Positions> candidatesImpl(
+        const SearchIndex &index) const override;
+
 private:
     /// Holds the channel names that will be searched for
     QStringList channels_;
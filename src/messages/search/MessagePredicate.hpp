@@ -1,6 +1,9 @@
 #pragma once
 
+#include "messages/search/SearchIndex.hpp"
+
 #include <memory>
+#include <optional>
 
 namespace chatterino {
 
@@ -38,6 +41,27 @@ public:
         return result;
     }
 
+    /**
+     * @brief Finds the messages in an index this predicate might apply to
+     *
+     * Calls the derived classes `candidatesImpl` implementation. Negated
+     * predicates can't narrow down the messages, so all of them have to be
+     * checked.
+     *
+     * @param index the index of the messages to search
+     * @return the positions of the messages this predicate might apply to, or
+     *         std::nullopt if all messages have to be checked
+     **/
+    std::optional<SearchIndex::Positions> candidates(
+        const SearchIndex &index) const
+    {
+        if (this->isNegated_)
+        {
+            return std::nullopt;
+        }
+        return this->candidatesImpl(index);
+    }
+
 protected:
     explicit MessagePredicate(bool negate)
         : isNegated_(negate)
@@ -55,6 +79,23 @@ protected:
      */
     virtual bool appliesToImpl(const Message &message) = 0;
 
+    /**
+     * @brief Finds the messages in an index this predicate might apply to.
+     *
+     * The returned messages must include all messages `appliesToImpl` returns
+     * true for. By default, all messages have to be checked.
+     *
+     * @param index the index of the messages to search
+     * @return the positions of the messages this predicate might apply to, or
+     *         std::nullopt if all messages have to be checked
+     */
+    virtual std::optional<SearchIndex::Positions> candidatesImpl(
+        const SearchIndex &index) const
+    {
+        (void)index;
+        return std::nullopt;
+    }
+
 private:
     const bool isNegated_ = false;
 };
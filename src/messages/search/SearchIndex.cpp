@@ -0,0 +1,286 @@
+#include "messages/search/SearchIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr qsizetype GRAM_LENGTH = 3;
+
+/// Stale keys are removed once there are more of them than this or than
+/// indexed messages
+constexpr size_t MIN_STALE_KEYS = 1024;
+
+uint64_t trigramAt(QStringView text, qsizetype pos)
+{
+    return (uint64_t{text[pos].unicode()} << 32) |
+           (uint64_t{text[pos + 1].unicode()} << 16) |
+           uint64_t{text[pos + 2].unicode()};
+}
+
+/// Inserts `key` into the sorted `keys` unless it's there already
+void insertKey(std::vector<int64_t> &keys, int64_t key)
+{
+    // Messages are mostly appended
+    if (keys.empty() || keys.back() < key)
+    {
+        keys.push_back(key);
+        return;
+    }
+
+    auto it = std::ranges::lower_bound(keys, key);
+    if (it == keys.end() || *it != key)
+    {
+        keys.insert(it, key);
+    }
+}
+
+void eraseKey(std::vector<int64_t> &keys, int64_t key)
+{
+    auto it = std::ranges::lower_bound(keys, key);
+    if (it != keys.end() && *it == key)
+    {
+        keys.erase(it);
+    }
+}
+
+/// Calls `fn` with the list of `key` in `map`, creating it if `create` is
+/// set. Empty lists are removed after `fn` returns.
+template <typename Map, typename Fn>
+void withList(Map &map, const typename Map::key_type &key, bool create,
+              Fn &&fn)
+{
+    auto it = map.find(key);
+    if (it == map.end())
+    {
+        if (!create)
+        {
+            return;
+        }
+        it = map.try_emplace(key).first;
+    }
+
+    fn(it->second);
+    if (it->second.empty())
+    {
+        map.erase(it);
+    }
+}
+
+/// Removes all keys before `firstKey` from the lists of `map`
+template <typename Map>
+void compactMap(Map &map, int64_t firstKey)
+{
+    for (auto it = map.begin(); it != map.end();)
+    {
+        auto &keys = it->second;
+        keys.erase(keys.begin(), std::ranges::lower_bound(keys, firstKey));
+        if (keys.empty())
+        {
+            it = map.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+SearchIndex::SearchIndex(const LimitedQueueSnapshot<MessagePtr> &snapshot)
+{
+    for (const auto &message : snapshot)
+    {
+        this->add(*message, this->firstKey_ + static_cast<Key>(this->size_));
+        this->size_++;
+    }
+}
+
+size_t SearchIndex::size() const
+{
+    return this->size_;
+}
+
+void SearchIndex::append(std::span<const MessagePtr> messages)
+{
+    for (const auto &message : messages)
+    {
+        this->add(*message, this->firstKey_ + static_cast<Key>(this->size_));
+        this->size_++;
+    }
+}
+
+void SearchIndex::prepend(std::span<const MessagePtr> messages)
+{
+    // The keys of the new messages would collide with stale keys
+    this->compact();
+
+    this->firstKey_ -= static_cast<Key>(messages.size());
+    this->size_ += messages.size();
+    for (size_t i = 0; i < messages.size(); i++)
+    {
+        this->add(*messages[i], this->firstKey_ + static_cast<Key>(i));
+    }
+}
+
+void SearchIndex::removeFront(size_t count)
+{
+    count = std::min(count, this->size_);
+    this->firstKey_ += static_cast<Key>(count);
+    this->size_ -= count;
+    this->staleKeys_ += count;
+
+    if (this->staleKeys_ > std::max(this->size_, MIN_STALE_KEYS))
+    {
+        this->compact();
+    }
+}
+
+void SearchIndex::replace(size_t position, const MessagePtr &previous,
+                          const MessagePtr &replacement)
+{
+    if (position >= this->size_)
+    {
+        return;
+    }
+
+    auto key = this->firstKey_ + static_cast<Key>(position);
+    this->remove(*previous, key);
+    this->add(*replacement, key);
+}
+
+std::optional<SearchIndex::Positions> SearchIndex::withText(
+    QStringView text) const
+{
+    if (text.size() < GRAM_LENGTH)
+    {
+        return std::nullopt;
+    }
+
+    // Only the messages with the rarest trigram of the text can contain it
+    auto folded = text.toString().toCaseFolded();
+    const Keys *rarest = nullptr;
+    for (qsizetype pos = 0; pos + GRAM_LENGTH <= folded.size(); pos++)
+    {
+        auto it = this->trigrams_.find(trigramAt(folded, pos));
+        if (it == this->trigrams_.end())
+        {
+            return Positions{};
+        }
+        if (!rarest || it->second.size() < rarest->size())
+        {
+            rarest = &it->second;
+        }
+    }
+    return this->toPositions(*rarest);
+}
+
+SearchIndex::Positions SearchIndex::byAuthor(const QString &name) const
+{
+    return this->find(this->authors_, name);
+}
+
+SearchIndex::Positions SearchIndex::inChannel(const QString &channelName) const
+{
+    return this->find(this->channels_, channelName);
+}
+
+SearchIndex::Positions SearchIndex::withBadge(const QString &badge) const
+{
+    return this->find(this->badges_, badge);
+}
+
+SearchIndex::Positions SearchIndex::intersect(const Positions &a,
+                                              const Positions &b)
+{
+    Positions result;
+    std::ranges::set_intersection(a, b, std::back_inserter(result));
+    return result;
+}
+
+SearchIndex::Positions SearchIndex::unite(const Positions &a,
+                                          const Positions &b)
+{
+    Positions result;
+    result.reserve(a.size() + b.size());
+    std::ranges::set_union(a, b, std::back_inserter(result));
+    return result;
+}
+
+template <typename Fn>
+void SearchIndex::forEachList(const Message &message, bool create, Fn &&fn)
+{
+    auto text = message.searchText.toCaseFolded();
+    for (qsizetype pos = 0; pos + GRAM_LENGTH <= text.size(); pos++)
+    {
+        withList(this->trigrams_, trigramAt(text, pos), create, fn);
+    }
+
+    withList(this->authors_, message.loginName.toCaseFolded(), create, fn);
+    withList(this->authors_, message.displayName.toCaseFolded(), create, fn);
+    withList(this->channels_, message.channelName.toCaseFolded(), create, fn);
+    for (const auto &badge : message.badges)
+    {
+        withList(this->badges_, badge.key_.toCaseFolded(), create, fn);
+    }
+}
+
+void SearchIndex::add(const Message &message, Key key)
+{
+    this->forEachList(message, true, [key](Keys &keys) {
+        insertKey(keys, key);
+    });
+}
+
+void SearchIndex::remove(const Message &message, Key key)
+{
+    this->forEachList(message, false, [key](Keys &keys) {
+        eraseKey(keys, key);
+    });
+}
+
+void SearchIndex::compact()
+{
+    if (this->staleKeys_ == 0)
+    {
+        return;
+    }
+
+    compactMap(this->trigrams_, this->firstKey_);
+    compactMap(this->authors_, this->firstKey_);
+    compactMap(this->channels_, this->firstKey_);
+    compactMap(this->badges_, this->firstKey_);
+    this->staleKeys_ = 0;
+}
+
+SearchIndex::Positions SearchIndex::toPositions(const Keys &keys) const
+{
+    Positions positions;
+    auto it = std::ranges::lower_bound(keys, this->firstKey_);
+    positions.reserve(static_cast<size_t>(std::distance(it, keys.end())));
+    for (; it != keys.end(); ++it)
+    {
+        positions.push_back(static_cast<uint32_t>(*it - this->firstKey_));
+    }
+    return positions;
+}
+
+SearchIndex::Positions SearchIndex::find(const Lookup &lookup,
+                                         const QString &key) const
+{
+    auto it = lookup.find(key.toCaseFolded());
+    if (it == lookup.end())
+    {
+        return {};
+    }
+    return this->toPositions(it->second);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "messages/LimitedQueueSnapshot.hpp"
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/**
+ * @brief Index of the messages of a channel, used to find the messages a
+ *        search might match without checking all of them.
+ *
+ * The index mirrors the message queue of its channel: it's updated as
+ * messages are appended, prepended, replaced and removed from the start.
+ * Lookups return positions of messages in the current queue in ascending
+ * order. The returned messages are candidates; predicates still have to be
+ * checked on them. All lookups ignore case.
+ *
+ * Only parts of messages that don't change after they're added are indexed
+ * (e.g. not the flags).
+ */
+class SearchIndex
+{
+public:
+    using Positions = std::vector<uint32_t>;
+
+    SearchIndex() = default;
+    explicit SearchIndex(const LimitedQueueSnapshot<MessagePtr> &snapshot);
+
+    /// Returns the number of indexed messages
+    size_t size() const;
+
+    /// Adds `messages` after the last message
+    void append(std::span<const MessagePtr> messages);
+    /// Adds `messages` (in order) before the first message
+    void prepend(std::span<const MessagePtr> messages);
+    /// Removes the first `count` messages
+    void removeFront(size_t count);
+    /// Replaces `previous` at `position` with `replacement`
+    void replace(size_t position, const MessagePtr &previous,
+                 const MessagePtr &replacement);
+
+    /**
+     * @brief Returns the messages whose `searchText` might contain `text`.
+     *
+     * @return std::nullopt if the text is too short to be looked up
+     */
+    std::optional<Positions> withText(QStringView text) const;
+
+    /// Returns the messages sent by `name` (login or display name)
+    Positions byAuthor(const QString &name) const;
+
+    /// Returns the messages sent in `channelName`
+    Positions inChannel(const QString &channelName) const;
+
+    /// Returns the messages with a badge with the key `badge`
+    Positions withBadge(const QString &badge) const;
+
+    /// Returns the positions contained in both `a` and `b`
+    static Positions intersect(const Positions &a, const Positions &b);
+
+    /// Returns the positions contained in `a` or `b`
+    static Positions unite(const Positions &a, const Positions &b);
+
+private:
+    /// Messages are identified by keys, which increase from the first to the
+    /// last message. Keys stay the same when messages are removed from the
+    /// start, so the position of a message is its key minus firstKey_.
+    using Key = int64_t;
+    using Keys = std::vector<Key>;
+    using Lookup = std::unordered_map<QString, Keys>;
+
+    /// Calls `fn` with the lists of keys of all terms of `message`, creating
+    /// them if `create` is set. Lists that don't exist are skipped otherwise.
+    template <typename Fn>
+    void forEachList(const Message &message, bool create, Fn &&fn);
+
+    void add(const Message &message, Key key);
+    void remove(const Message &message, Key key);
+    /// Removes the keys of messages that were removed from the start
+    void compact();
+
+    Positions toPositions(const Keys &keys) const;
+    Positions find(const Lookup &lookup, const QString &key) const;
+
+    Key firstKey_ = 0;
+    size_t size_ = 0;
+    /// Number of keys before firstKey_ that weren't removed from the lists
+    /// yet
+    size_t staleKeys_ = 0;
+
+    /// Messages containing each trigram of case-folded search texts
+    std::unordered_map<uint64_t, Keys> trigrams_;
+    Lookup authors_;
+    Lookup channels_;
+    Lookup badges_;
+};
+
+}  // namespace chatterino
@@ -15,4 +15,10 @@ bool SubstringPredicate::appliesToImpl(const Message &message)
     return message.searchText.contains(this->search_, Qt::CaseInsensitive);
 }
 
+std::optional<SearchIndex::Positions> SubstringPredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    return index.withText(this->search_);
+}
+
 }  // namespace chatterino
@@ -36,6 +36,16 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Finds the messages whose `searchText` might contain the
+     *        substring passed in the constructor.
+     *
+     * @param index the index of the messages to search
+     * @return the positions of the messages that might contain the substring
+     */
+    std::optional<SearchIndex::Positions> candidatesImpl(
+        const SearchIndex &index) const override;
+
 private:
     /// Holds the substring to search for in a message's `messageText`
     const QString search_;
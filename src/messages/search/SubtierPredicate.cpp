@@ -31,4 +31,10 @@ bool SubtierPredicate::appliesToImpl(const Message &message)
     return false;
 }
 
+std::optional<SearchIndex::Positions> SubtierPredicate::candidatesImpl(
+    const SearchIndex &index) const
+{
+    return index.withBadge("subscriber");
+}
+
 }  // namespace chatterino
@@ -35,6 +35,15 @@ protected:
      */
     bool appliesToImpl(const Message &message) override;
 
+    /**
+     * @brief Finds the messages with a subscriber badge.
+     *
+     * @param index the index of the messages to search
+     * @return the positions of the messages with a subscriber badge
+     */
+    std::optional<SearchIndex::Positions> candidatesImpl(
+        const SearchIndex &index) const override;
+
 private:
     /// Holds the subtiers that will be searched for
     QStringList subtiers_;
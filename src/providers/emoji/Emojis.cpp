@@ -14,8 +14,10 @@
 #include <rapidjson/error/error.h>
 #include <rapidjson/rapidjson.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <span>
 
 namespace {
 
@@ -149,6 +151,19 @@ QString getToneNames(const QString &tones)
     return toneNameResults.join('-');
 }
 
+/// Returns true if `text` only contains ASCII characters. Every emoji
+/// contains at least one non-ASCII character, so these can't contain emojis.
+bool isAscii(QStringView text)
+{
+    // No early exit, so the loop can be vectorized
+    char16_t bits = 0;
+    for (auto unit : text)
+    {
+        bits |= unit.unicode();
+    }
+    return bits < 0x80;
+}
+
 }  // namespace
 
 namespace chatterino {
@@ -165,6 +180,8 @@ void Emojis::load()
 
     this->sortEmojis();
 
+    this->buildTrie();
+
     this->loadEmojiSet();
 }
 
@@ -197,8 +214,6 @@ void Emojis::loadEmojis()
             this->shortCodes.emplace_back(shortCode);
         }
 
-        this->emojiFirstByte_[emojiData->value.at(0)].append(emojiData);
-
         this->emojis.push_back(emojiData);
 
         if (unparsedEmoji.HasMember("skin_variations"))
@@ -218,9 +233,6 @@ void Emojis::loadEmojis()
                     variationEmojiData->shortCodes[0], variationEmojiData);
                 this->shortCodes.push_back(variationEmojiData->shortCodes[0]);
 
-                this->emojiFirstByte_[variationEmojiData->value.at(0)].append(
-                    variationEmojiData);
-
                 this->emojis.push_back(variationEmojiData);
             }
         }
@@ -229,20 +241,89 @@ void Emojis::loadEmojis()
 
 void Emojis::sortEmojis()
 {
-    for (auto &p : this->emojiFirstByte_)
-    {
-        std::stable_sort(p.begin(), p.end(),
-                         [](const auto &lhs, const auto &rhs) {
-                             return lhs->value.length() > rhs->value.length();
-                         });
-    }
-
     auto &p = this->shortCodes;
     std::stable_sort(p.begin(), p.end(), [](const auto &lhs, const auto &rhs) {
         return lhs < rhs;
     });
 }
 
+void Emojis::buildTrie()
+{
+    // Longer emojis are preferred. Of emojis with the same length, the first
+    // one in emoji.json wins, and the qualified version of an emoji is
+    // preferred over the non-qualified one.
+    std::vector<uint32_t> order(this->emojis.size());
+    for (uint32_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::ranges::stable_sort(order, [&](uint32_t lhs, uint32_t rhs) {
+        return this->emojis[lhs]->value.length() >
+               this->emojis[rhs]->value.length();
+    });
+
+    struct BuildNode {
+        std::map<char16_t, uint32_t> children;
+        uint32_t emoji = NO_EMOJI;
+        uint32_t rank = UINT32_MAX;
+    };
+    std::vector<BuildNode> nodes(1);
+
+    auto insert = [&](const QString &text, uint32_t emoji, uint32_t rank) {
+        assert(!isAscii(text));
+
+        uint32_t node = 0;
+        for (auto unit : text)
+        {
+            auto next = static_cast<uint32_t>(nodes.size());
+            auto [it, inserted] =
+                nodes[node].children.try_emplace(unit.unicode(), next);
+            next = it->second;
+            if (inserted)
+            {
+                nodes.emplace_back();
+            }
+            node = next;
+        }
+        if (rank < nodes[node].rank)
+        {
+            nodes[node].emoji = emoji;
+            nodes[node].rank = rank;
+        }
+    };
+
+    for (uint32_t i = 0; i < order.size(); i++)
+    {
+        const auto &emoji = this->emojis[order[i]];
+        if (!emoji->value.isEmpty())
+        {
+            insert(emoji->value, order[i], 2 * i);
+        }
+        if (!emoji->nonQualified.isEmpty())
+        {
+            insert(emoji->nonQualified, order[i], 2 * i + 1);
+        }
+    }
+
+    this->trieNodes_.clear();
+    this->trieEdges_.clear();
+    this->trieNodes_.reserve(nodes.size());
+    this->trieEdges_.reserve(nodes.size() - 1);
+    for (const auto &node : nodes)
+    {
+        this->trieNodes_.push_back({
+            .firstEdge = static_cast<uint32_t>(this->trieEdges_.size()),
+            .edgeCount = static_cast<uint32_t>(node.children.size()),
+            .emoji = node.emoji,
+            .rank = node.rank,
+        });
+        for (const auto &[unit, child] : node.children)
+        {
+            this->trieEdges_.push_back({.unit = unit, .node = child});
+        }
+    }
+}
+
 void Emojis::loadEmojiSet()
 {
     getSettings()->emojiSet.connect([this](const auto &emojiSet) {
@@ -302,104 +383,102 @@ void Emojis::loadEmojiSet()
 std::vector<boost::variant<EmotePtr, QString>> Emojis::parse(
     const QString &text) const
 {
-    auto result = std::vector<boost::variant<EmotePtr, QString>>();
-    QString::size_type lastParsedEmojiEndIndex = 0;
-
-    for (qsizetype i = 0; i < text.length(); ++i)
+    std::vector<boost::variant<EmotePtr, QString>> result;
+    for (auto &span : this->parseSpans(text))
     {
-        const QChar character = text.at(i);
-
-        if (character.isLowSurrogate())
+        if (span.emote)
         {
-            continue;
+            result.emplace_back(std::move(span.emote));
         }
-
-        auto it = this->emojiFirstByte_.find(character);
-        if (it == this->emojiFirstByte_.end())
+        else
         {
-            // No emoji starts with this character
-            continue;
+            result.emplace_back(text.mid(span.start, span.length));
         }
+    }
+    return result;
+}
 
-        const auto &possibleEmojis = it.value();
-
-        auto remainingCharacters = text.length() - i - 1;
-
-        std::shared_ptr<EmojiData> matchedEmoji;
-
-        QString::size_type matchedEmojiLength = 0;
-
-        for (const std::shared_ptr<EmojiData> &emoji : possibleEmojis)
+std::vector<EmojiSpan> Emojis::parseSpans(QStringView text) const
+{
+    std::vector<EmojiSpan> result;
+    if (isAscii(text))
+    {
+        if (!text.isEmpty())
         {
-            auto emojiNonQualifiedExtraCharacters =
-                emoji->nonQualified.length() - 1;
-            auto emojiExtraCharacters = emoji->value.length() - 1;
-            if (remainingCharacters >= emojiExtraCharacters)
-            {
-                // look in emoji->value
-                bool match = QStringView{emoji->value}.mid(1) ==
-                             QStringView{text}.mid(i + 1, emojiExtraCharacters);
-
-                if (match)
-                {
-                    matchedEmoji = emoji;
-                    matchedEmojiLength = emoji->value.length();
-
-                    break;
-                }
-            }
-            if (!emoji->nonQualified.isNull() &&
-                remainingCharacters >= emojiNonQualifiedExtraCharacters)
-            {
-                // This checking here relies on the fact that the nonQualified string
-                // always starts with the same byte as value (the unified string)
-                bool match = QStringView{emoji->nonQualified}.mid(1) ==
-                             QStringView{text}.mid(
-                                 i + 1, emojiNonQualifiedExtraCharacters);
-
-                if (match)
-                {
-                    matchedEmoji = emoji;
-                    matchedEmojiLength = emoji->nonQualified.length();
-
-                    break;
-                }
-            }
+            result.push_back({.start = 0, .length = text.size()});
         }
+        return result;
+    }
 
-        if (matchedEmojiLength == 0)
+    qsizetype lastEnd = 0;
+    qsizetype i = 0;
+    while (i < text.size())
+    {
+        auto [emoji, length] = this->matchAt(text, i);
+        if (emoji == NO_EMOJI)
         {
+            i++;
             continue;
         }
 
-        auto currentParsedEmojiFirstIndex = i;
-        auto currentParsedEmojiEndIndex = i + (matchedEmojiLength);
-
-        auto charactersFromLastParsedEmoji =
-            currentParsedEmojiFirstIndex - lastParsedEmojiEndIndex;
-
-        if (charactersFromLastParsedEmoji > 0)
+        if (i > lastEnd)
         {
             // Add characters inbetween emojis
-            result.emplace_back(text.mid(lastParsedEmojiEndIndex,
-                                         charactersFromLastParsedEmoji));
+            result.push_back({.start = lastEnd, .length = i - lastEnd});
         }
+        result.push_back({
+            .start = i,
+            .length = length,
+            .emote = this->emojis[emoji]->emote,
+        });
+
+        i += length;
+        lastEnd = i;
+    }
 
-        // Push the emoji as a word to parsedWords
-        result.emplace_back(matchedEmoji->emote);
+    if (lastEnd < text.size())
+    {
+        // Add remaining characters
+        result.push_back({.start = lastEnd, .length = text.size() - lastEnd});
+    }
 
-        lastParsedEmojiEndIndex = currentParsedEmojiEndIndex;
+    return result;
+}
 
-        i += matchedEmojiLength - 1;
+std::pair<uint32_t, qsizetype> Emojis::matchAt(QStringView text,
+                                               qsizetype start) const
+{
+    if (this->trieNodes_.empty())
+    {
+        return {NO_EMOJI, 0};
     }
 
-    if (lastParsedEmojiEndIndex < text.length())
+    uint32_t bestEmoji = NO_EMOJI;
+    uint32_t bestRank = UINT32_MAX;
+    qsizetype bestLength = 0;
+
+    const auto *node = &this->trieNodes_[0];
+    for (auto i = start; i < text.size(); i++)
     {
-        // Add remaining characters
-        result.emplace_back(text.mid(lastParsedEmojiEndIndex));
+        auto edges = std::span(this->trieEdges_)
+                         .subspan(node->firstEdge, node->edgeCount);
+        char16_t unit = text[i].unicode();
+        auto it = std::ranges::lower_bound(edges, unit, {}, &TrieEdge::unit);
+        if (it == edges.end() || it->unit != unit)
+        {
+            break;
+        }
+
+        node = &this->trieNodes_[it->node];
+        if (node->rank < bestRank)
+        {
+            bestEmoji = node->emoji;
+            bestRank = node->rank;
+            bestLength = i - start + 1;
+        }
     }
 
-    return result;
+    return {bestEmoji, bestLength};
 }
 
 QString Emojis::replaceShortCodes(const QString &text) const
@@ -6,8 +6,9 @@
 #include <boost/variant.hpp>
 #include <QMap>
 #include <QRegularExpression>
-#include <QVector>
+#include <QStringView>
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -43,6 +44,14 @@ struct EmojiData {
 
 using EmojiPtr = std::shared_ptr<EmojiData>;
 
+/// A part of a text parsed by IEmojis::parseSpans
+struct EmojiSpan {
+    qsizetype start = 0;
+    qsizetype length = 0;
+    /// The emote of the emoji or nullptr if this is text between emojis
+    EmotePtr emote;
+};
+
 class IEmojis
 {
 public:
@@ -50,6 +59,9 @@ public:
 
     virtual std::vector<boost::variant<EmotePtr, QString>> parse(
         const QString &text) const = 0;
+    /// Splits `text` into emojis and the text between them without copying
+    /// the text
+    virtual std::vector<EmojiSpan> parseSpans(QStringView text) const = 0;
     virtual const std::vector<EmojiPtr> &getEmojis() const = 0;
     virtual const std::vector<QString> &getShortCodes() const = 0;
     virtual QString replaceShortCodes(const QString &text) const = 0;
@@ -62,6 +74,7 @@ public:
     void load();
     std::vector<boost::variant<EmotePtr, QString>> parse(
         const QString &text) const override;
+    std::vector<EmojiSpan> parseSpans(QStringView text) const override;
 
     std::vector<QString> shortCodes;
     QString replaceShortCodes(const QString &text) const override;
@@ -70,10 +83,34 @@ public:
     const std::vector<QString> &getShortCodes() const override;
 
 private:
+    /// A node of the trie of the UTF-16 code units of all emojis
+    struct TrieNode {
+        /// The children of this node are
+        /// trieEdges_[firstEdge..firstEdge + edgeCount] (sorted by code unit)
+        uint32_t firstEdge = 0;
+        uint32_t edgeCount = 0;
+        /// Index of the emoji (in `emojis`) ending at this node or NO_EMOJI
+        uint32_t emoji = NO_EMOJI;
+        /// If multiple emojis could match at a position, the one with the
+        /// lowest rank wins
+        uint32_t rank = UINT32_MAX;
+    };
+    struct TrieEdge {
+        char16_t unit;
+        uint32_t node;
+    };
+    static constexpr uint32_t NO_EMOJI = UINT32_MAX;
+
     void loadEmojis();
     void sortEmojis();
+    void buildTrie();
     void loadEmojiSet();
 
+    /// Returns the index of the emoji starting at `text[start]` (or NO_EMOJI)
+    /// and its length
+    std::pair<uint32_t, qsizetype> matchAt(QStringView text,
+                                           qsizetype start) const;
+
     std::vector<EmojiPtr> emojis;
 
     /// Emojis
@@ -82,9 +119,9 @@ private:
     // shortCodeToEmoji maps strings like "sunglasses" to its emoji
     QMap<QString, std::shared_ptr<EmojiData>> emojiShortCodeToEmoji_;
 
-    // Maps the first character of the emoji unicode string to a vector of
-    // possible emojis
-    QMap<QChar, QVector<std::shared_ptr<EmojiData>>> emojiFirstByte_;
+    /// The root is trieNodes_[0]
+    std::vector<TrieNode> trieNodes_;
+    std::vector<TrieEdge> trieEdges_;
 
     bool loaded_ = false;
 };
@@ -12,6 +12,12 @@ LinkInfo::LinkInfo(QString url)
     , url_(std::move(url))
     , tooltip_(this->url_)
 {
+    // Messages might be built on worker threads without an event loop, but
+    // the info is updated from the GUI thread
+    if (!isGuiThread())
+    {
+        this->moveToThread(QCoreApplication::instance()->thread());
+    }
 }
 
 LinkInfo::~LinkInfo() = default;
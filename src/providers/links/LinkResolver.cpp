@@ -5,7 +5,9 @@
 #include "common/network/NetworkResult.hpp"
 #include "providers/links/LinkInfo.hpp"
 #include "singletons/Settings.hpp"
+#include "util/PostToThread.hpp"
 
+#include <QPointer>
 #include <QStringBuilder>
 
 namespace chatterino {
@@ -16,6 +18,18 @@ void LinkResolver::resolve(LinkInfo *info)
 
     assert(info);
 
+    if (!isGuiThread())
+    {
+        // The message is being built on a worker thread
+        postToThread([this, info = QPointer(info)] {
+            if (info)
+            {
+                this->resolve(info);
+            }
+        });
+        return;
+    }
+
     if (info->state() != State::Created)
     {
         // The link is already resolved or is currently loading
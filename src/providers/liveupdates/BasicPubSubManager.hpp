@@ -2,6 +2,7 @@
 
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
+#include "common/websockets/IoRuntime.hpp"
 #include "providers/liveupdates/BasicPubSubClient.hpp"
 #include "providers/liveupdates/BasicPubSubWebsocket.hpp"
 #include "providers/NetworkConfigurationProvider.hpp"
@@ -9,13 +10,10 @@
 #include "util/DebugCount.hpp"
 #include "util/ExponentialBackoff.hpp"
 #include "util/OnceFlag.hpp"
-#include "util/RenameThread.hpp"
 
 #include <pajlada/signals/signal.hpp>
 #include <QJsonObject>
-#include <QScopeGuard>
 #include <QString>
-#include <QStringBuilder>
 #include <websocketpp/client.hpp>
 
 #include <algorithm>
@@ -24,7 +22,6 @@
 #include <exception>
 #include <map>
 #include <memory>
-#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -64,35 +61,50 @@ class BasicPubSubManager
 {
 public:
     BasicPubSubManager(QString host, QString shortName)
-        : host_(std::move(host))
+        : websocketClient_(std::make_unique<liveupdates::WebsocketClient>())
+        , host_(std::move(host))
         , shortName_(std::move(shortName))
+        , io_(IoRuntime::instance().registerClient(this->shortName_))
     {
-        this->websocketClient_.set_access_channels(
+        this->websocketClient_->set_access_channels(
             websocketpp::log::alevel::all);
-        this->websocketClient_.clear_access_channels(
+        this->websocketClient_->clear_access_channels(
             websocketpp::log::alevel::frame_payload |
             websocketpp::log::alevel::frame_header);
 
-        this->websocketClient_.init_asio();
-
         // SSL Handshake
-        this->websocketClient_.set_tls_init_handler([this](auto hdl) {
-            return this->onTLSInit(hdl);
-        });
+        this->websocketClient_->set_tls_init_handler(
+            [io{this->io_}](auto /*hdl*/) {
+                return WebsocketContextPtr(io->runtime().unverifiedTls());
+            });
 
-        this->websocketClient_.set_message_handler([this](auto hdl, auto msg) {
-            this->onMessage(hdl, msg);
-        });
-        this->websocketClient_.set_open_handler([this](auto hdl) {
-            this->onConnectionOpen(hdl);
-        });
-        this->websocketClient_.set_close_handler([this](auto hdl) {
-            this->onConnectionClose(hdl);
-        });
-        this->websocketClient_.set_fail_handler([this](auto hdl) {
-            this->onConnectionFail(hdl);
-        });
-        this->websocketClient_.set_user_agent(
+        // The handlers are called on the strands of the connections, so
+        // they're moved to our strand. Once we're stopped, they're dropped.
+        this->websocketClient_->set_message_handler(
+            [io{this->io_}, this](auto hdl, auto msg) {
+                io->post([this, hdl, msg] {
+                    this->onMessage(hdl, msg);
+                });
+            });
+        this->websocketClient_->set_open_handler(
+            [io{this->io_}, this](auto hdl) {
+                io->post([this, hdl] {
+                    this->onConnectionOpen(hdl);
+                });
+            });
+        this->websocketClient_->set_close_handler(
+            [io{this->io_}, this](auto hdl) {
+                io->post([this, hdl] {
+                    this->onConnectionClose(hdl);
+                });
+            });
+        this->websocketClient_->set_fail_handler(
+            [io{this->io_}, this](auto hdl) {
+                io->post([this, hdl] {
+                    this->onConnectionFail(hdl);
+                });
+            });
+        this->websocketClient_->set_user_agent(
             QStringLiteral("Chatterino/%1 (%2)")
                 .arg(Version::instance().version(),
                      Version::instance().commitHash())
@@ -119,63 +131,35 @@ public:
 
     void start()
     {
-        this->work_ = std::make_shared<boost::asio::executor_work_guard<
-            boost::asio::io_context::executor_type>>(
-            this->websocketClient_.get_io_service().get_executor());
-        this->mainThread_.reset(new std::thread([this] {
-            // make sure we set in any case, even exceptions
-            auto guard = qScopeGuard([&] {
-                this->stoppedFlag_.set();
-            });
-
-            runThread();
-        }));
-
-        renameThread(*this->mainThread_.get(), "BPSM-" % this->shortName_);
+        this->websocketClient_->init_asio(&this->io_->context());
     }
 
     void stop()
     {
-        if (this->stopping_)
+        if (this->stopping_.exchange(true))
         {
             return;
         }
 
-        this->stopping_ = true;
-
-        for (const auto &client : this->clients_)
-        {
-            client.second->close("Shutting down");
-        }
-
-        this->work_.reset();
-
-        if (!this->mainThread_->joinable())
-        {
-            return;
-        }
-
-        // NOTE:
-        // There is a case where a new client was initiated but not added to the clients list.
-        // We just don't join the thread & let the operating system nuke the thread if joining fails
-        // within 1s.
-        if (this->stoppedFlag_.waitFor(std::chrono::milliseconds{100}))
-        {
-            this->mainThread_->join();
-            return;
-        }
+        this->io_->post([this] {
+            for (const auto &client : this->clients_)
+            {
+                client.second->close("Shutting down");
+            }
+            this->checkStopped();
+        });
 
-        qCWarning(chatterinoLiveupdates)
-            << "Thread didn't finish within 100ms, force-stop the client";
-        this->websocketClient_.stop();
-        if (this->stoppedFlag_.waitFor(std::chrono::milliseconds{20}))
+        if (!this->stoppedFlag_.waitFor(std::chrono::milliseconds{120}))
         {
-            this->mainThread_->join();
-            return;
+            qCWarning(chatterinoLiveupdates)
+                << "Connections didn't close within 120ms, leaving them to "
+                   "the IO runtime";
+            // The pending handlers of the connections still reference the
+            // client
+            this->io_->runtime().retain(std::move(this->websocketClient_));
         }
 
-        qCWarning(chatterinoLiveupdates)
-            << "Thread didn't finish after stopping";
+        this->io_->close();
     }
 
 protected:
@@ -242,7 +226,7 @@ private:
 
         this->connectBackoff_.reset();
 
-        auto client = this->createClient(this->websocketClient_, hdl);
+        auto client = this->createClient(*this->websocketClient_, hdl);
 
         // We separate the starting from the constructor because we will want to use
         // shared_from_this
@@ -250,6 +234,13 @@ private:
 
         this->clients_.emplace(hdl, client);
 
+        if (this->stopping_)
+        {
+            // This connection was started before we stopped
+            client->close("Shutting down");
+            return;
+        }
+
         auto pendingSubsToTake = std::min(this->pendingSubscriptions_.size(),
                                           client->maxSubscriptions);
 
@@ -283,7 +274,8 @@ private:
         DebugCount::increase("LiveUpdates failed connections");
         this->diag.connectionsFailed.fetch_add(1, std::memory_order_acq_rel);
 
-        if (auto conn = this->websocketClient_.get_con_from_hdl(std::move(hdl)))
+        if (auto conn =
+                this->websocketClient_->get_con_from_hdl(std::move(hdl)))
         {
             qCDebug(chatterinoLiveupdates)
                 << "LiveUpdates connection attempt failed (error: "
@@ -296,10 +288,15 @@ private:
                    "connection from a handle.";
         }
         this->addingClient_ = false;
+        if (this->stopping_)
+        {
+            this->checkStopped();
+            return;
+        }
         if (!this->pendingSubscriptions_.empty())
         {
-            runAfter(this->websocketClient_.get_io_service(),
-                     this->connectBackoff_.next(), [this](auto /*timer*/) {
+            runAfter(this->io_->strand(), this->connectBackoff_.next(),
+                     [this](auto /*timer*/) {
                          this->addClient();
                      });
         }
@@ -330,35 +327,17 @@ private:
                 this->subscribe(sub);
             }
         }
+
+        this->checkStopped();
     }
 
-    WebsocketContextPtr onTLSInit(const websocketpp::connection_hdl & /*hdl*/)
+    /// Sets the stopped flag if all connections are closed after stop()
+    void checkStopped()
     {
-        WebsocketContextPtr ctx(new boost::asio::ssl::context(
-            boost::asio::ssl::context::tls_client));
-
-        try
+        if (this->stopping_ && this->clients_.empty() && !this->addingClient_)
         {
-            ctx->set_options(boost::asio::ssl::context::default_workarounds |
-                             boost::asio::ssl::context::no_tlsv1 |
-                             boost::asio::ssl::context::no_tlsv1_1 |
-                             boost::asio::ssl::context::single_dh_use);
+            this->stoppedFlag_.set();
         }
-        catch (const std::exception &e)
-        {
-            qCDebug(chatterinoLiveupdates)
-                << "Exception caught in OnTLSInit:" << e.what();
-        }
-
-        return ctx;
-    }
-
-    void runThread()
-    {
-        qCDebug(chatterinoLiveupdates) << "Start LiveUpdates manager thread";
-        this->websocketClient_.run();
-        qCDebug(chatterinoLiveupdates)
-            << "Done with LiveUpdates manager thread";
     }
 
     void addClient()
@@ -373,7 +352,7 @@ private:
         this->addingClient_ = true;
 
         websocketpp::lib::error_code ec;
-        auto con = this->websocketClient_.get_connection(
+        auto con = this->websocketClient_->get_connection(
             this->host_.toStdString(), ec);
 
         if (ec)
@@ -385,7 +364,7 @@ private:
 
         NetworkConfigurationProvider::applyToWebSocket(con);
 
-        this->websocketClient_.connect(con);
+        this->websocketClient_->connect(con);
     }
 
     bool trySubscribe(const Subscription &subscription)
@@ -404,8 +383,9 @@ private:
     std::atomic<bool> addingClient_{false};
     ExponentialBackoff<5> connectBackoff_{std::chrono::milliseconds(1000)};
 
-    liveupdates::WebsocketClient websocketClient_;
-    std::unique_ptr<std::thread> mainThread_;
+    // This is a pointer, because it's handed to the IO runtime if its
+    // connections don't close in time
+    std::unique_ptr<liveupdates::WebsocketClient> websocketClient_;
     OnceFlag stoppedFlag_;
 
     std::map<liveupdates::WebsocketHandle,
@@ -413,16 +393,15 @@ private:
              std::owner_less<liveupdates::WebsocketHandle>>
         clients_;
 
-    std::shared_ptr<boost::asio::executor_work_guard<
-        boost::asio::io_context::executor_type>>
-        work_{nullptr};
-
     const QString host_;
 
     /// Short name of the service (e.g. "7TV" or "BTTV")
     const QString shortName_;
 
-    bool stopping_{false};
+    /// The handlers of all connections run on the strand of this client
+    std::shared_ptr<IoClient> io_;
+
+    std::atomic<bool> stopping_{false};
 };
 
 }  // namespace chatterino
@@ -39,9 +39,23 @@ void load(
             return;
         }
 
+        // The channel's date is only touched on the GUI thread, the messages
+        // are built with a copy of it
+        QDate lastDate;
+        if (auto shared = channelPtr.lock())
+        {
+            lastDate = shared->lastDate_;
+        }
+
+        // Building runs on the thread pool, so the backlogs of several
+        // channels are built at the same time
         NetworkRequest(url)
-            .onSuccess([channelPtr, onLoaded](const auto &result) {
-                assert(!isAppAboutToQuit());
+            .concurrent()
+            .onSuccess([channelPtr, onLoaded, lastDate](const auto &result) {
+                if (isAppAboutToQuit())
+                {
+                    return;
+                }
 
                 auto shared = channelPtr.lock();
                 if (!shared)
@@ -56,14 +70,18 @@ void load(
                 auto parsedMessages = parseRecentMessages(root);
 
                 // build the Communi messages into chatterino messages
-                auto builtMessages =
-                    buildRecentMessages(parsedMessages, shared.get());
+                auto builtLastDate = lastDate;
+                auto builtMessages = buildRecentMessages(
+                    parsedMessages, shared.get(), builtLastDate);
 
                 postToThread(
                     [shared = std::move(shared), root = std::move(root),
-                     messages = std::move(builtMessages), onLoaded]() mutable {
+                     messages = std::move(builtMessages), onLoaded,
+                     builtLastDate]() mutable {
                         assert(!isAppAboutToQuit());
 
+                        shared->lastDate_ = builtLastDate;
+
                         // Notify user about a possible gap in logs if it returned some messages
                         // but isn't currently joined to a channel
                         const auto errorCode =
@@ -88,22 +106,25 @@ void load(
                     });
             })
             .onError([channelPtr, onError](const NetworkResult &result) {
-                auto shared = channelPtr.lock();
-                if (!shared)
-                {
-                    return;
-                }
-                assert(!isAppAboutToQuit());
-
-                qCDebug(LOG) << "Failed to load recent messages for"
-                             << shared->getName();
-
-                shared->addSystemMessage(
-                    QStringLiteral(
-                        "Message history service unavailable (Error: %1)")
-                        .arg(result.formatError()));
-
-                onError();
+                postToThread([channelPtr, onError,
+                              error = result.formatError()] {
+                    auto shared = channelPtr.lock();
+                    if (!shared)
+                    {
+                        return;
+                    }
+                    assert(!isAppAboutToQuit());
+
+                    qCDebug(LOG) << "Failed to load recent messages for"
+                                 << shared->getName();
+
+                    shared->addSystemMessage(
+                        QStringLiteral(
+                            "Message history service unavailable (Error: %1)")
+                            .arg(error));
+
+                    onError();
+                });
             })
             .execute();
     });
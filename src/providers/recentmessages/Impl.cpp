@@ -8,31 +8,53 @@
 #include "util/VectorMessageSink.hpp"
 
 #include <QJsonArray>
+#include <QtConcurrent>
 #include <QUrlQuery>
 
+#include <algorithm>
+
+namespace {
+
+/// Number of messages parsed by one task of the thread pool
+constexpr qsizetype PARSE_CHUNK_SIZE = 100;
+
+}  // namespace
+
 namespace chatterino::recentmessages::detail {
 
 // Parse the IRC messages returned in JSON form into Communi messages
-std::vector<Communi::IrcMessage *> parseRecentMessages(
+std::vector<std::unique_ptr<Communi::IrcMessage>> parseRecentMessages(
     const QJsonObject &jsonRoot)
 {
     const auto jsonMessages = jsonRoot.value("messages").toArray();
-    std::vector<Communi::IrcMessage *> messages;
+    std::vector<std::unique_ptr<Communi::IrcMessage>> messages(
+        static_cast<size_t>(jsonMessages.size()));
 
     if (jsonMessages.empty())
     {
         return messages;
     }
 
-    for (const auto &jsonMessage : jsonMessages)
+    std::vector<qsizetype> chunks;
+    for (qsizetype start = 0; start < jsonMessages.size();
+         start += PARSE_CHUNK_SIZE)
     {
-        auto content = unescapeZeroWidthJoiner(jsonMessage.toString());
+        chunks.push_back(start);
+    }
 
-        auto *message =
-            Communi::IrcMessage::fromData(content.toUtf8(), nullptr);
+    // Every chunk fills its own slots, so the order doesn't depend on which
+    // chunk finishes first
+    QtConcurrent::blockingMap(chunks, [&](qsizetype start) {
+        auto end = std::min(start + PARSE_CHUNK_SIZE, jsonMessages.size());
+        for (auto i = start; i < end; i++)
+        {
+            auto content =
+                unescapeZeroWidthJoiner(jsonMessages.at(i).toString());
 
-        messages.emplace_back(message);
-    }
+            messages[static_cast<size_t>(i)].reset(
+                Communi::IrcMessage::fromData(content.toUtf8(), nullptr));
+        }
+    });
 
     return messages;
 }
@@ -40,7 +62,15 @@ std::vector<Communi::IrcMessage *> parseRecentMessages(
 // Build Communi messages retrieved from the recent messages API into
 // proper chatterino messages.
 std::vector<MessagePtr> buildRecentMessages(
-    std::vector<Communi::IrcMessage *> &messages, Channel *channel)
+    const std::vector<std::unique_ptr<Communi::IrcMessage>> &messages,
+    Channel *channel)
+{
+    return buildRecentMessages(messages, channel, channel->lastDate_);
+}
+
+std::vector<MessagePtr> buildRecentMessages(
+    const std::vector<std::unique_ptr<Communi::IrcMessage>> &messages,
+    Channel *channel, QDate &lastDate)
 {
     VectorMessageSink sink({}, MessageFlag::RecentMessage);
 
@@ -50,7 +80,9 @@ std::vector<MessagePtr> buildRecentMessages(
         return {};
     }
 
-    for (auto *message : messages)
+    // Messages reply to and delete earlier messages, so they're built in
+    // order
+    for (const auto &message : messages)
     {
         if (message->tags().contains("rm-received-ts"))
         {
@@ -60,9 +92,9 @@ std::vector<MessagePtr> buildRecentMessages(
                     .date();
 
             // Check if we need to insert a message stating that a new day began
-            if (msgDate != channel->lastDate_)
+            if (msgDate != lastDate)
             {
-                channel->lastDate_ = msgDate;
+                lastDate = msgDate;
                 auto msg = makeSystemMessage(
                     QLocale().toString(msgDate, QLocale::LongFormat),
                     QTime(0, 0));
@@ -70,9 +102,8 @@ std::vector<MessagePtr> buildRecentMessages(
             }
         }
 
-        IrcMessageHandler::parseMessageInto(message, sink, twitchChannel);
-
-        message->deleteLater();
+        IrcMessageHandler::parseMessageInto(message.get(), sink,
+                                            twitchChannel);
     }
 
     return std::move(sink).takeMessages();
@@ -4,6 +4,7 @@
 #include "messages/Message.hpp"
 
 #include <IrcMessage>
+#include <QDate>
 #include <QJsonObject>
 #include <QString>
 #include <QUrl>
@@ -15,14 +16,24 @@
 
 namespace chatterino::recentmessages::detail {
 
-// Parse the IRC messages returned in JSON form into Communi messages
-std::vector<Communi::IrcMessage *> parseRecentMessages(
+// Parse the IRC messages returned in JSON form into Communi messages.
+// Messages are parsed in chunks on the global thread pool, the returned
+// messages are in the order of the response.
+std::vector<std::unique_ptr<Communi::IrcMessage>> parseRecentMessages(
     const QJsonObject &jsonRoot);
 
 // Build Communi messages retrieved from the recent messages API into
 // proper chatterino messages.
 std::vector<MessagePtr> buildRecentMessages(
-    std::vector<Communi::IrcMessage *> &messages, Channel *channel);
+    const std::vector<std::unique_ptr<Communi::IrcMessage>> &messages,
+    Channel *channel);
+
+// Like buildRecentMessages above, but `lastDate` is used instead of the
+// channel's last date to insert day change messages. This doesn't touch the
+// channel's date, so it can be used outside of the GUI thread.
+std::vector<MessagePtr> buildRecentMessages(
+    const std::vector<std::unique_ptr<Communi::IrcMessage>> &messages,
+    Channel *channel, QDate &lastDate);
 
 // Returns the URL to be used for querying the Recent Messages API for the
 // given channel.
@@ -28,6 +28,7 @@
 #include "util/IrcHelpers.hpp"
 
 #include <IrcMessage>
+#include <QCoreApplication>
 #include <QLocale>
 #include <QStringBuilder>
 
@@ -380,7 +381,15 @@ void IrcMessageHandler::handlePrivMessage(Communi::IrcPrivateMessage *message,
         return;
     }
 
-    parsePrivMessageInto(message, *twitchChannel, twitchChannel);
+    // Communi deletes the message once this returns
+    std::shared_ptr<Communi::IrcPrivateMessage> cloned(
+        static_cast<Communi::IrcPrivateMessage *>(message->clone()),
+        DeleteLater{});
+    twitchChannel->postMessageBuild(
+        [message = std::move(cloned)](MessageSink &sink,
+                                      TwitchChannel &channel) {
+            parsePrivMessageInto(message.get(), sink, &channel);
+        });
 }
 
 void IrcMessageHandler::parsePrivMessageInto(
@@ -394,9 +403,20 @@ void IrcMessageHandler::parsePrivMessageInto(
         if (badgesTag.isValid())
         {
             auto parsedBadges = parseBadges(badgesTag.toString());
-            channel->setMod(parsedBadges.contains("moderator"));
-            channel->setVIP(parsedBadges.contains("vip"));
-            channel->setStaff(parsedBadges.contains("staff"));
+            sink.runSideEffect([weak = channel->weak_from_this(),
+                                isMod = parsedBadges.contains("moderator"),
+                                isVip = parsedBadges.contains("vip"),
+                                isStaff = parsedBadges.contains("staff")] {
+                auto shared = weak.lock();
+                if (!shared)
+                {
+                    return;
+                }
+                auto *channel = static_cast<TwitchChannel *>(shared.get());
+                channel->setMod(isMod);
+                channel->setVIP(isVip);
+                channel->setStaff(isStaff);
+            });
         }
     }
 
@@ -1055,7 +1075,19 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
         qCDebug(chatterinoTwitch) << "TwitchChannel reward added ADD "
                                      "callback since reward is not known:"
                                   << rewardId;
-        chan->addQueuedRedemption(rewardId, originalContent, message);
+        // The message might be gone once the side effect runs
+        std::shared_ptr<Communi::IrcMessage> queued(message->clone(),
+                                                    DeleteLater{});
+        queued->moveToThread(QCoreApplication::instance()->thread());
+        sink.runSideEffect([weak = chan->weak_from_this(), rewardId,
+                            originalContent, queued] {
+            if (auto shared = weak.lock())
+            {
+                static_cast<TwitchChannel *>(shared.get())
+                    ->addQueuedRedemption(rewardId, originalContent,
+                                          queued.get());
+            }
+        });
     }
     args.channelPointRewardId = rewardId;
 
@@ -1068,12 +1100,10 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
         it != tags.end())
     {
         const QString replyID = it.value().toString();
-        auto threadIt = chan->threads().find(replyID);
         std::shared_ptr<MessageThread> rootThread;
-        if (threadIt != chan->threads().end() && !threadIt->second.expired())
+        if (auto thread = chan->findThread(replyID))
         {
             // Thread already exists (has a reply)
-            auto thread = threadIt->second.lock();
             checkThreadSubscription(tags, message->nick(), thread);
             replyCtx.thread = thread;
             rootThread = thread;
@@ -1108,14 +1138,9 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
             }
             else
             {
-                auto parentThreadIt = chan->threads().find(parentID);
-                if (parentThreadIt != chan->threads().end())
+                if (auto thread = chan->findThread(parentID))
                 {
-                    auto thread = parentThreadIt->second.lock();
-                    if (thread)
-                    {
-                        replyCtx.parent = thread->root();
-                    }
+                    replyCtx.parent = thread->root();
                 }
                 else
                 {
@@ -1154,7 +1179,12 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
             (!getSettings()->hideSimilar &&
              getSettings()->shownSimilarTriggerHighlights))
         {
-            MessageBuilder::triggerHighlights(chan, alert);
+            sink.runSideEffect([weak = chan->weak_from_this(), alert] {
+                if (auto shared = weak.lock())
+                {
+                    MessageBuilder::triggerHighlights(shared.get(), alert);
+                }
+            });
         }
 
         const auto highlighted = msg->flags.has(MessageFlag::Highlighted);
@@ -1163,8 +1193,9 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *message,
         if (highlighted && showInMentions &&
             sink.sinkTraits().has(MessageSinkTrait::AddMentionsToGlobalChannel))
         {
-            twitch.getMentionsChannel()->addMessage(msg,
-                                                    MessageContext::Original);
+            sink.runSideEffect([mentions = twitch.getMentionsChannel(), msg] {
+                mentions->addMessage(msg, MessageContext::Original);
+            });
         }
 
         sink.addMessage(msg, MessageContext::Original);
@@ -12,11 +12,12 @@ namespace chatterino {
 class TwitchAccount;
 struct ActionUser;
 
-// Create timer using given ioService
+// Create timer using given executor
 template <typename Duration, typename Callback>
-void runAfter(boost::asio::io_context &ioc, Duration duration, Callback cb)
+void runAfter(const boost::asio::any_io_executor &executor, Duration duration,
+              Callback cb)
 {
-    auto timer = std::make_shared<boost::asio::steady_timer>(ioc);
+    auto timer = std::make_shared<boost::asio::steady_timer>(executor);
     timer->expires_after(duration);
 
     timer->async_wait([timer, cb](const boost::system::error_code &ec) {
@@ -2,53 +2,69 @@
 
 #include "Application.hpp"
 #include "common/QLogging.hpp"
+#include "common/websockets/IoRuntime.hpp"
 #include "providers/NetworkConfigurationProvider.hpp"
 #include "providers/twitch/PubSubClient.hpp"
 #include "providers/twitch/PubSubHelpers.hpp"
 #include "providers/twitch/PubSubMessages.hpp"
 #include "util/DebugCount.hpp"
-#include "util/RenameThread.hpp"
 
 #include <QJsonArray>
-#include <QScopeGuard>
 
 #include <algorithm>
 #include <exception>
 #include <memory>
-#include <thread>
 
-using websocketpp::lib::bind;
-using websocketpp::lib::placeholders::_1;
-using websocketpp::lib::placeholders::_2;
 using namespace std::chrono_literals;
 
 namespace chatterino {
 
 PubSub::PubSub(const QString &host, std::chrono::seconds pingInterval)
-    : host_(host)
+    : websocketClient(std::make_unique<WebsocketClient>())
+    , host_(host)
     , clientOptions_({
           pingInterval,
       })
+    , io_(IoRuntime::instance().registerClient("PubSub"))
 {
-    this->websocketClient.set_access_channels(websocketpp::log::alevel::all);
-    this->websocketClient.clear_access_channels(
+    this->websocketClient->set_access_channels(websocketpp::log::alevel::all);
+    this->websocketClient->clear_access_channels(
         websocketpp::log::alevel::frame_payload |
         websocketpp::log::alevel::frame_header);
 
-    this->websocketClient.init_asio();
-
     // SSL Handshake
-    this->websocketClient.set_tls_init_handler(
-        bind(&PubSub::onTLSInit, this, ::_1));
-
-    this->websocketClient.set_message_handler(
-        bind(&PubSub::onMessage, this, ::_1, ::_2));
-    this->websocketClient.set_open_handler(
-        bind(&PubSub::onConnectionOpen, this, ::_1));
-    this->websocketClient.set_close_handler(
-        bind(&PubSub::onConnectionClose, this, ::_1));
-    this->websocketClient.set_fail_handler(
-        bind(&PubSub::onConnectionFail, this, ::_1));
+    this->websocketClient->set_tls_init_handler(
+        [io{this->io_}](websocketpp::connection_hdl /*hdl*/) {
+            return WebsocketContextPtr(io->runtime().unverifiedTls());
+        });
+
+    // The handlers are called on the strands of the connections, so they're
+    // moved to our strand. Once we're stopped, they're dropped.
+    this->websocketClient->set_message_handler(
+        [io{this->io_}, this](websocketpp::connection_hdl hdl,
+                              WebsocketMessagePtr msg) {
+            io->post([this, hdl, msg] {
+                this->onMessage(hdl, msg);
+            });
+        });
+    this->websocketClient->set_open_handler(
+        [io{this->io_}, this](websocketpp::connection_hdl hdl) {
+            io->post([this, hdl] {
+                this->onConnectionOpen(hdl);
+            });
+        });
+    this->websocketClient->set_close_handler(
+        [io{this->io_}, this](websocketpp::connection_hdl hdl) {
+            io->post([this, hdl] {
+                this->onConnectionClose(hdl);
+            });
+        });
+    this->websocketClient->set_fail_handler(
+        [io{this->io_}, this](websocketpp::connection_hdl hdl) {
+            io->post([this, hdl] {
+                this->onConnectionFail(hdl);
+            });
+        });
 }
 
 PubSub::~PubSub()
@@ -74,7 +90,7 @@ void PubSub::addClient()
 
     websocketpp::lib::error_code ec;
     auto con =
-        this->websocketClient.get_connection(this->host_.toStdString(), ec);
+        this->websocketClient->get_connection(this->host_.toStdString(), ec);
 
     if (ec)
     {
@@ -85,65 +101,49 @@ void PubSub::addClient()
 
     NetworkConfigurationProvider::applyToWebSocket(con);
 
-    this->websocketClient.connect(con);
+    this->websocketClient->connect(con);
 }
 
 void PubSub::start()
 {
-    this->work = std::make_shared<boost::asio::executor_work_guard<
-        boost::asio::io_context::executor_type>>(
-        this->websocketClient.get_io_service().get_executor());
-    this->thread = std::make_unique<std::thread>([this] {
-        // make sure we set in any case, even exceptions
-        auto guard = qScopeGuard([&] {
-            this->stoppedFlag_.set();
-        });
-
-        runThread();
-    });
-    renameThread(*this->thread, "PubSub");
+    this->websocketClient->init_asio(&this->io_->context());
 }
 
 void PubSub::stop()
 {
-    this->stopping_ = true;
-
-    for (const auto &[hdl, client] : this->clients)
+    if (this->stopping_.exchange(true))
     {
-        (void)hdl;
-
-        client->close("Shutting down");
+        return;
     }
 
-    this->work.reset();
+    this->io_->post([this] {
+        for (const auto &[hdl, client] : this->clients)
+        {
+            (void)hdl;
 
-    if (!this->thread->joinable())
-    {
-        return;
-    }
+            client->close("Shutting down");
+        }
+        this->checkStopped();
+    });
 
-    // NOTE:
-    // There is a case where a new client was initiated but not added to the clients list.
-    // We just don't join the thread & let the operating system nuke the thread if joining fails
-    // within 1s.
-    // We could fix the underlying bug, but this is easier & we realistically won't use this exact code
-    // for super much longer.
-    if (this->stoppedFlag_.waitFor(std::chrono::milliseconds{100}))
+    if (!this->stoppedFlag_.waitFor(std::chrono::milliseconds{120}))
     {
-        this->thread->join();
-        return;
+        qCWarning(chatterinoLiveupdates)
+            << "Connections didn't close within 120ms, leaving them to the "
+               "IO runtime";
+        // The pending handlers of the connections still reference the client
+        this->io_->runtime().retain(std::move(this->websocketClient));
     }
 
-    qCWarning(chatterinoLiveupdates)
-        << "Thread didn't finish within 100ms, force-stop the client";
-    this->websocketClient.stop();
-    if (this->stoppedFlag_.waitFor(std::chrono::milliseconds{20}))
+    this->io_->close();
+}
+
+void PubSub::checkStopped()
+{
+    if (this->stopping_ && this->clients.empty() && !this->addingClient)
     {
-        this->thread->join();
-        return;
+        this->stoppedFlag_.set();
     }
-
-    qCWarning(chatterinoLiveupdates) << "Thread didn't finish after stopping";
 }
 
 void PubSub::listenToChannelPointRewards(const QString &channelID)
@@ -323,7 +323,7 @@ void PubSub::onConnectionOpen(WebsocketHandle hdl)
 
     this->connectBackoff.reset();
 
-    auto client = std::make_shared<PubSubClient>(this->websocketClient, hdl,
+    auto client = std::make_shared<PubSubClient>(*this->websocketClient, hdl,
                                                  this->clientOptions_);
 
     // We separate the starting from the constructor because we will want to use
@@ -332,6 +332,13 @@ void PubSub::onConnectionOpen(WebsocketHandle hdl)
 
     this->clients.emplace(hdl, client);
 
+    if (this->stopping_)
+    {
+        // This connection was started before we stopped
+        client->close("Shutting down");
+        return;
+    }
+
     qCDebug(chatterinoPubSub) << "PubSub connection opened!";
 
     const auto topicsToTake =
@@ -372,7 +379,7 @@ void PubSub::onConnectionFail(WebsocketHandle hdl)
     this->diag.connectionsFailed += 1;
 
     DebugCount::increase("PubSub failed connections");
-    if (auto conn = this->websocketClient.get_con_from_hdl(std::move(hdl)))
+    if (auto conn = this->websocketClient->get_con_from_hdl(std::move(hdl)))
     {
         qCDebug(chatterinoPubSub) << "PubSub connection attempt failed (error: "
                                   << conn->get_ec().message().c_str() << ")";
@@ -385,10 +392,15 @@ void PubSub::onConnectionFail(WebsocketHandle hdl)
     }
 
     this->addingClient = false;
+    if (this->stopping_)
+    {
+        this->checkStopped();
+        return;
+    }
     if (!this->requests.empty())
     {
-        runAfter(this->websocketClient.get_io_service(),
-                 this->connectBackoff.next(), [this](auto timer) {
+        runAfter(this->io_->strand(), this->connectBackoff.next(),
+                 [this](auto timer) {
                      this->addClient();  //
                  });
     }
@@ -420,26 +432,8 @@ void PubSub::onConnectionClose(WebsocketHandle hdl)
             this->listenToTopic(listener.topic);
         }
     }
-}
 
-PubSub::WebsocketContextPtr PubSub::onTLSInit(websocketpp::connection_hdl hdl)
-{
-    WebsocketContextPtr ctx(
-        new boost::asio::ssl::context(boost::asio::ssl::context::tlsv12));
-
-    try
-    {
-        ctx->set_options(boost::asio::ssl::context::default_workarounds |
-                         boost::asio::ssl::context::no_sslv2 |
-                         boost::asio::ssl::context::single_dh_use);
-    }
-    catch (const std::exception &e)
-    {
-        qCDebug(chatterinoPubSub)
-            << "Exception caught in OnTLSInit:" << e.what();
-    }
-
-    return ctx;
+    this->checkStopped();
 }
 
 void PubSub::handleResponse(const PubSubMessage &message)
@@ -563,13 +557,6 @@ void PubSub::handleMessageResponse(const PubSubMessageMessage &message)
     }
 }
 
-void PubSub::runThread()
-{
-    qCDebug(chatterinoPubSub) << "Start pubsub manager thread";
-    this->websocketClient.run();
-    qCDebug(chatterinoPubSub) << "Done with pubsub manager thread";
-}
-
 void PubSub::listenToTopic(const QString &topic)
 {
     this->listen(PubSubListenMessage({topic}));
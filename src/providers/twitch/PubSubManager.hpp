@@ -5,7 +5,6 @@
 #include "util/ExponentialBackoff.hpp"
 #include "util/OnceFlag.hpp"
 
-#include <boost/asio/io_context.hpp>
 #include <boost/asio/ssl/context.hpp>
 #include <pajlada/signals/signal.hpp>
 #include <QJsonObject>
@@ -21,7 +20,6 @@
 #include <map>
 #include <memory>
 #include <optional>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -31,6 +29,7 @@
 
 namespace chatterino {
 
+class IoClient;
 class TwitchAccount;
 class PubSubClient;
 
@@ -63,8 +62,9 @@ class PubSub
         std::vector<QString>::size_type topicCount;
     };
 
-    WebsocketClient websocketClient;
-    std::unique_ptr<std::thread> thread;
+    // This is a pointer, because it's handed to the IO runtime if its
+    // connections don't close in time
+    std::unique_ptr<WebsocketClient> websocketClient;
 
 public:
     PubSub(const QString &host,
@@ -134,7 +134,6 @@ private:
     void onConnectionOpen(websocketpp::connection_hdl hdl);
     void onConnectionFail(websocketpp::connection_hdl hdl);
     void onConnectionClose(websocketpp::connection_hdl hdl);
-    WebsocketContextPtr onTLSInit(websocketpp::connection_hdl hdl);
 
     void handleResponse(const PubSubMessage &message);
     void handleListenResponse(const NonceInfo &info, bool failed);
@@ -149,18 +148,18 @@ private:
 
     std::unordered_map<QString, NonceInfo> nonces_;
 
-    void runThread();
-
-    std::shared_ptr<boost::asio::executor_work_guard<
-        boost::asio::io_context::executor_type>>
-        work{nullptr};
+    /// Sets the stopped flag if all connections are closed after stop()
+    void checkStopped();
 
     const QString host_;
     const PubSubClientOptions clientOptions_;
 
+    /// The handlers of all connections run on the strand of this client
+    std::shared_ptr<IoClient> io_;
+
     OnceFlag stoppedFlag_;
 
-    bool stopping_{false};
+    std::atomic<bool> stopping_{false};
 
 #ifdef FRIEND_TEST
     friend class FTest;
@@ -19,6 +19,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <shared_mutex>
 #include <unordered_set>
 
 namespace chatterino {
@@ -73,9 +74,13 @@ public:
 
     void blockUserLocally(const QString &userID, const QString &userLogin);
 
-    [[nodiscard]] const std::unordered_set<TwitchUser> &blocks() const;
-    [[nodiscard]] const std::unordered_set<QString> &blockedUserIds() const;
-    [[nodiscard]] const std::unordered_set<QString> &blockedUserLogins() const;
+    /// Returns a copy of the blocked users
+    [[nodiscard]] std::unordered_set<TwitchUser> blocks() const;
+
+    /// Returns true if the user with the ID `userID` is blocked
+    [[nodiscard]] bool isBlockedUserId(const QString &userID) const;
+    /// Returns true if the user `login` is blocked
+    [[nodiscard]] bool isBlockedUserLogin(const QString &login) const;
 
     // Automod actions
     void autoModAllow(const QString &msgID, ChannelPtr channel) const;
@@ -119,6 +124,8 @@ private:
     QStringList userstateEmoteSets_;
 
     ScopedCancellationToken blockToken_;
+    /// Guards the blocks, which are only modified in the GUI thread
+    mutable std::shared_mutex blocksMutex_;
     std::unordered_set<TwitchUser> ignores_;
     std::unordered_set<QString> ignoresUserIds_;
     std::unordered_set<QString> ignoresUserLogins_;
@@ -218,6 +218,7 @@ TwitchAccountManager::TwitchAccountManager()
 
 std::shared_ptr<TwitchAccount> TwitchAccountManager::getCurrent()
 {
+    std::lock_guard guard(this->currentUserMutex_);
     if (!this->currentUser_)
     {
         return this->anonymousUser_;
@@ -343,28 +344,38 @@ void TwitchAccountManager::load()
     this->currentUsername.connect([this](const QString &newUsername) {
         auto user = this->findUserByUsername(newUsername);
 
-        this->currentUserAboutToChange.invoke(this->currentUser_, user);
+        std::shared_ptr<TwitchAccount> previous;
+        {
+            std::lock_guard guard(this->currentUserMutex_);
+            previous = this->currentUser_;
+        }
+        this->currentUserAboutToChange.invoke(previous, user);
 
         if (user)
         {
             qCDebug(chatterinoTwitch)
                 << "Twitch user updated to" << newUsername;
             getHelix()->update(user->getOAuthClient(), user->getOAuthToken());
-            this->currentUser_ = user;
         }
         else
         {
             qCDebug(chatterinoTwitch) << "Twitch user updated to anonymous";
-            this->currentUser_ = this->anonymousUser_;
+            user = this->anonymousUser_;
+        }
+
+        {
+            std::lock_guard guard(this->currentUserMutex_);
+            this->currentUser_ = user;
         }
 
         this->currentUserChanged();
-        this->currentUser_->reloadEmotes();
+        user->reloadEmotes();
     });
 }
 
 bool TwitchAccountManager::isLoggedIn() const
 {
+    std::lock_guard guard(this->currentUserMutex_);
     if (!this->currentUser_)
     {
         return false;
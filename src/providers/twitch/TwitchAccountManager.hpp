@@ -82,6 +82,9 @@ private:
     AddUserResponse addUser(const UserData &data);
     bool removeUser(TwitchAccount *account);
 
+    /// Messages are built on the thread pool, so the current user can be
+    /// read from any thread
+    mutable std::mutex currentUserMutex_;
     std::shared_ptr<TwitchAccount> currentUser_;
 
     std::shared_ptr<TwitchAccount> anonymousUser_;
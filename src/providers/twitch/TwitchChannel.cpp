@@ -11,11 +11,13 @@
 #include "controllers/notifications/NotificationController.hpp"
 #include "controllers/twitch/LiveController.hpp"
 #include "messages/Emote.hpp"
+#include "messages/EmoteLookup.hpp"
 #include "messages/Image.hpp"
 #include "messages/Link.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
+#include "messages/MessageIngest.hpp"
 #include "messages/MessageThread.hpp"
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/bttv/BttvLiveUpdates.hpp"
@@ -41,6 +43,7 @@
 #include "singletons/StreamerMode.hpp"
 #include "singletons/Toasts.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/ChannelIngestSink.hpp"
 #include "util/Helpers.hpp"
 #include "util/PostToThread.hpp"
 #include "util/QStringHash.hpp"
@@ -122,9 +125,16 @@ TwitchChannel::TwitchChannel(const QString &name)
     , bttvEmotes_(std::make_shared<EmoteMap>())
     , ffzEmotes_(std::make_shared<EmoteMap>())
     , seventvEmotes_(std::make_shared<EmoteMap>())
+    , ingest_(MessageIngest::create())
+    , ingestSink_(std::make_unique<ChannelIngestSink>(*this))
 {
     qCDebug(chatterinoTwitch) << "[TwitchChannel" << name << "] Opened";
 
+    // Messages built in one frame are added to the channel together
+    this->ingest_->setAfterFlush([this] {
+        this->ingestSink_->commit();
+    });
+
     this->signalHolder_.managedConnect(
         getApp()->getAccounts()->twitch.currentUserAboutToChange,
         [this](const auto & /*oldAccount*/, const auto & /*newAccount*/) {
@@ -221,6 +231,9 @@ TwitchChannel::TwitchChannel(const QString &name)
 
 TwitchChannel::~TwitchChannel()
 {
+    // The ingest might outlive the channel while it's flushing
+    this->ingest_->setAfterFlush({});
+
     if (isAppAboutToQuit())
     {
         return;
@@ -1080,6 +1093,23 @@ std::shared_ptr<const EmoteMap> TwitchChannel::seventvEmotes() const
     return this->seventvEmotes_.get();
 }
 
+std::shared_ptr<const EmoteLookup> TwitchChannel::emoteLookup() const
+{
+    auto sources = EmoteLookup::Sources::globals();
+    sources.ffzChannel = this->ffzEmotes_.get();
+    sources.bttvChannel = this->bttvEmotes_.get();
+    sources.seventvChannel = this->seventvEmotes_.get();
+
+    auto lookup = this->emoteLookup_.get();
+    if (!lookup || !lookup->isBuiltFrom(sources))
+    {
+        // Concurrent builds might both rebuild it, either result is fine
+        lookup = EmoteLookup::build(sources);
+        this->emoteLookup_.set(lookup);
+    }
+    return lookup;
+}
+
 const QString &TwitchChannel::seventvUserID() const
 {
     return this->seventvUserID_;
@@ -1352,7 +1382,7 @@ void TwitchChannel::messageRemovedFromStart(const MessagePtr &msg)
     {
         if (msg->replyThread->liveCount(msg) == 0)
         {
-            this->threads_.erase(msg->replyThread->rootId());
+            this->threads_.access()->erase(msg->replyThread->rootId());
         }
     }
 }
@@ -1741,13 +1771,19 @@ void TwitchChannel::refreshChatters()
 
 void TwitchChannel::addReplyThread(const std::shared_ptr<MessageThread> &thread)
 {
-    this->threads_[thread->rootId()] = thread;
+    (*this->threads_.access())[thread->rootId()] = thread;
 }
 
-const std::unordered_map<QString, std::weak_ptr<MessageThread>> &
-    TwitchChannel::threads() const
+std::shared_ptr<MessageThread> TwitchChannel::findThread(
+    const QString &rootId) const
 {
-    return this->threads_;
+    auto threads = this->threads_.accessConst();
+    auto it = threads->find(rootId);
+    if (it == threads->end())
+    {
+        return nullptr;
+    }
+    return it->second.lock();
 }
 
 std::shared_ptr<MessageThread> TwitchChannel::getOrCreateThread(
@@ -1755,21 +1791,60 @@ std::shared_ptr<MessageThread> TwitchChannel::getOrCreateThread(
 {
     assert(message != nullptr);
 
-    auto threadIt = this->threads_.find(message->id);
-    if (threadIt != this->threads_.end() && !threadIt->second.expired())
+    auto threads = this->threads_.access();
+    auto &entry = (*threads)[message->id];
+    if (auto thread = entry.lock())
     {
-        return threadIt->second.lock();
+        return thread;
     }
 
     auto thread = std::make_shared<MessageThread>(message);
-    this->addReplyThread(thread);
+    entry = thread;
     return thread;
 }
 
+void TwitchChannel::postMessageBuild(
+    std::function<void(MessageSink &, TwitchChannel &)> build)
+{
+    this->ingest_->post([weak = weakOf<Channel>(this),
+                         build = std::move(build)]() -> MessageIngest::Apply {
+        auto shared = weak.lock();
+        if (!shared)
+        {
+            return {};
+        }
+
+        auto &self = static_cast<TwitchChannel &>(*shared);
+        build(*self.ingestSink_, self);
+
+        // The channel has to be released in the GUI thread
+        return [shared = std::move(shared),
+                changes = self.ingestSink_->takeChanges()] {
+            if (changes)
+            {
+                changes();
+            }
+        };
+    });
+}
+
+void TwitchChannel::runAfterMessageBuilds(std::function<void()> fn)
+{
+    this->ingest_->runInOrder(
+        [weak = this->weak_from_this(), fn = std::move(fn)] {
+            // Previously built messages have to be in the channel
+            if (auto shared = weak.lock())
+            {
+                static_cast<TwitchChannel &>(*shared).ingestSink_->commit();
+            }
+            fn();
+        });
+}
+
 void TwitchChannel::cleanUpReplyThreads()
 {
-    for (auto it = this->threads_.begin(), last = this->threads_.end();
-         it != last;)
+    auto threads = this->threads_.access();
+    for (auto it = threads->begin(), last = threads->end(); it != last;)
     {
         bool doErase = true;
         if (auto thread = it->second.lock())
@@ -1779,7 +1854,7 @@ void TwitchChannel::cleanUpReplyThreads()
 
         if (doErase)
         {
-            it = this->threads_.erase(it);
+            it = threads->erase(it);
         }
         else
         {
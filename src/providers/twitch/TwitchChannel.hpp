@@ -22,6 +22,8 @@
 #include <QRegularExpression>
 
 #include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <unordered_map>
@@ -36,6 +38,7 @@ enum class HighlightState;
 struct Emote;
 using EmotePtr = std::shared_ptr<const Emote>;
 class EmoteMap;
+class EmoteLookup;
 
 class TwitchBadges;
 class FfzEmotes;
@@ -61,6 +64,9 @@ using HelixChannelBadges = HelixGlobalBadges;
 
 class TwitchIrcServer;
 class TwitchAccount;
+class MessageIngest;
+class MessageSink;
+class ChannelIngestSink;
 
 const int MAX_QUEUED_REDEMPTIONS = 16;
 
@@ -222,6 +228,13 @@ public:
     std::shared_ptr<const EmoteMap> ffzEmotes() const;
     std::shared_ptr<const EmoteMap> seventvEmotes() const;
 
+    /**
+     * Returns the third party emotes of this channel merged with the global
+     * ones. The lookup is rebuilt when it's requested after one of the emote
+     * maps was replaced.
+     */
+    std::shared_ptr<const EmoteLookup> emoteLookup() const;
+
     void refreshTwitchChannelEmotes(bool manualRefresh);
     void refreshBTTVChannelEmotes(bool manualRefresh);
     void refreshFFZChannelEmotes(bool manualRefresh);
@@ -284,8 +297,13 @@ public:
      * TwitchChannel instance will store a weak_ptr to the thread.
      */
     void addReplyThread(const std::shared_ptr<MessageThread> &thread);
-    const std::unordered_map<QString, std::weak_ptr<MessageThread>> &threads()
-        const;
+
+    /**
+     * Returns the thread with the root message `rootId` if it's still alive.
+     *
+     * Threads can be looked up from any thread.
+     */
+    std::shared_ptr<MessageThread> findThread(const QString &rootId) const;
 
     /**
      * Get the thread for the given message
@@ -293,6 +311,22 @@ public:
      */
     std::shared_ptr<MessageThread> getOrCreateThread(const MessagePtr &message);
 
+    /**
+     * Builds messages with `build` on a worker thread and adds them to this
+     * channel in the GUI thread. Builds run in the order they were posted.
+     *
+     * The sink passed to `build` defers all changes to the channel, so
+     * `build` may only read the parts of the channel that are thread-safe.
+     */
+    void postMessageBuild(
+        std::function<void(MessageSink &, TwitchChannel &)> build);
+
+    /**
+     * Runs `fn` in the GUI thread once the messages of all builds posted so
+     * far were added. Runs `fn` right away if there are no pending builds.
+     */
+    void runAfterMessageBuilds(std::function<void()> fn);
+
     /**
      * This signal fires when the local user has joined the channel
      **/
@@ -453,7 +487,8 @@ private:
     std::optional<std::chrono::time_point<std::chrono::system_clock>>
         lastConnectedAt_{};
     std::atomic_flag loadingRecentMessages_ = ATOMIC_FLAG_INIT;
-    std::unordered_map<QString, std::weak_ptr<MessageThread>> threads_;
+    UniqueAccess<std::unordered_map<QString, std::weak_ptr<MessageThread>>>
+        threads_;
 
 protected:
     void messageRemovedFromStart(const MessagePtr &msg) override;
@@ -463,6 +498,7 @@ protected:
     Atomic<std::shared_ptr<const EmoteMap>> bttvEmotes_;
     Atomic<std::shared_ptr<const EmoteMap>> ffzEmotes_;
     Atomic<std::shared_ptr<const EmoteMap>> seventvEmotes_;
+    mutable Atomic<std::shared_ptr<const EmoteLookup>> emoteLookup_;
     Atomic<std::optional<EmotePtr>> ffzCustomModBadge_;
     Atomic<std::optional<EmotePtr>> ffzCustomVipBadge_;
 
@@ -478,11 +514,15 @@ private:
     boost::circular_buffer_space_optimized<QueuedRedemption>
         waitingRedemptions_{MAX_QUEUED_REDEMPTIONS};
 
-    bool mod_ = false;
-    bool vip_ = false;
-    bool staff_ = false;
+    // Read when building messages on the thread pool
+    std::atomic<bool> mod_ = false;
+    std::atomic<bool> vip_ = false;
+    std::atomic<bool> staff_ = false;
     UniqueAccess<QString> roomID_;
 
+    std::shared_ptr<MessageIngest> ingest_;
+    std::unique_ptr<ChannelIngestSink> ingestSink_;
+
     // --
     QString lastSentMessage_;
     QObject lifetimeGuard_;
@@ -0,0 +1,75 @@
+#include "providers/twitch/TwitchIrcCommand.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+
+using CommandName = std::pair<std::string_view, TwitchIrcCommand>;
+
+// Sorted by name, so names can be found with a binary search
+constexpr std::array COMMANDS{
+    CommandName{"CAP", TwitchIrcCommand::Cap},
+    CommandName{"CLEARCHAT", TwitchIrcCommand::ClearChat},
+    CommandName{"CLEARMSG", TwitchIrcCommand::ClearMsg},
+    CommandName{"GLOBALUSERSTATE", TwitchIrcCommand::GlobalUserState},
+    CommandName{"JOIN", TwitchIrcCommand::Join},
+    CommandName{"NOTICE", TwitchIrcCommand::Notice},
+    CommandName{"PART", TwitchIrcCommand::Part},
+    CommandName{"PING", TwitchIrcCommand::Ping},
+    CommandName{"PONG", TwitchIrcCommand::Pong},
+    CommandName{"PRIVMSG", TwitchIrcCommand::Privmsg},
+    CommandName{"RECONNECT", TwitchIrcCommand::Reconnect},
+    CommandName{"ROOMSTATE", TwitchIrcCommand::RoomState},
+    CommandName{"USERNOTICE", TwitchIrcCommand::UserNotice},
+    CommandName{"USERSTATE", TwitchIrcCommand::UserState},
+    CommandName{"WHISPER", TwitchIrcCommand::Whisper},
+};
+
+constexpr auto byName = [](const CommandName &entry) {
+    return entry.first;
+};
+
+static_assert(std::ranges::is_sorted(COMMANDS, {}, byName));
+
+}  // namespace
+
+namespace chatterino {
+
+TwitchIrcCommand parseTwitchIrcCommand(std::string_view command)
+{
+    auto it = std::ranges::lower_bound(COMMANDS, command, {}, byName);
+    if (it == COMMANDS.end() || it->first != command)
+    {
+        return TwitchIrcCommand::Unknown;
+    }
+    return it->second;
+}
+
+TwitchIrcCommand parseTwitchIrcCommand(QStringView command)
+{
+    // Commands are short and ASCII, so they're converted on the stack
+    std::array<char, 16> buffer{};
+    if (command.size() > static_cast<qsizetype>(buffer.size()))
+    {
+        return TwitchIrcCommand::Unknown;
+    }
+
+    for (qsizetype i = 0; i < command.size(); i++)
+    {
+        auto c = command[i].unicode();
+        if (c > 0x7f)
+        {
+            return TwitchIrcCommand::Unknown;
+        }
+        buffer[static_cast<size_t>(i)] = static_cast<char>(c);
+    }
+
+    return parseTwitchIrcCommand(
+        std::string_view(buffer.data(), static_cast<size_t>(command.size())));
+}
+
+}  // namespace chatterino
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QStringView>
+
+#include <cstdint>
+#include <string_view>
+
+namespace chatterino {
+
+/// Commands sent by Twitch's IRC servers
+enum class TwitchIrcCommand : uint8_t {
+    Unknown,
+    Cap,
+    ClearChat,
+    ClearMsg,
+    GlobalUserState,
+    Join,
+    Notice,
+    Part,
+    Ping,
+    Pong,
+    Privmsg,
+    Reconnect,
+    RoomState,
+    UserNotice,
+    UserState,
+    Whisper,
+};
+
+/// Returns the command named `command` or TwitchIrcCommand::Unknown
+TwitchIrcCommand parseTwitchIrcCommand(std::string_view command);
+TwitchIrcCommand parseTwitchIrcCommand(QStringView command);
+
+}  // namespace chatterino
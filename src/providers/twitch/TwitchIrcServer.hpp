@@ -170,6 +170,7 @@ protected:
 
     void privateMessageReceived(Communi::IrcPrivateMessage *message);
     void readConnectionMessageReceived(Communi::IrcMessage *message);
+    void handleReadConnectionMessage(Communi::IrcMessage *message);
     void writeConnectionMessageReceived(Communi::IrcMessage *message);
 
     void onReadConnected(IrcConnection *connection);
@@ -3,11 +3,14 @@
 #include "common/QLogging.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/TwitchUser.hpp"
+#include "util/PostToThread.hpp"
 
 #include <boost/unordered/unordered_flat_map.hpp>
 #include <QStringList>
 #include <QTimer>
 
+#include <mutex>
+
 namespace {
 
 auto withSelf(auto *ptr, auto cb)
@@ -33,12 +36,19 @@ public:
     TwitchUsersPrivate();
 
 private:
+    /// Guards `cache`, `unresolved` and the updates of cached users, as
+    /// messages are built (and users resolved) outside of the GUI thread
+    std::mutex mutex;
     boost::unordered_flat_map<UserId, std::shared_ptr<TwitchUser>> cache;
     QStringList unresolved;
+
+    // Only used in the GUI thread
     QTimer nextBatchTimer;
     bool isResolving = false;
 
-    std::shared_ptr<TwitchUser> makeUnresolved(const UserId &id);
+    /// Looks up or creates the cache entry. `mutex` must be locked.
+    std::shared_ptr<TwitchUser> findOrMakeUnresolved(const UserId &id);
+    void scheduleNextBatch();
     void makeNextRequest();
     void updateUsers(const std::vector<HelixUser> &users);
 
@@ -54,12 +64,14 @@ TwitchUsers::~TwitchUsers() = default;
 
 std::shared_ptr<TwitchUser> TwitchUsers::resolveID(const UserId &id)
 {
-    auto cached = this->private_->cache.find(id);
-    if (cached != this->private_->cache.end())
-    {
-        return cached->second;
-    }
-    return this->private_->makeUnresolved(id);
+    std::lock_guard lock(this->private_->mutex);
+    return this->private_->findOrMakeUnresolved(id);
+}
+
+TwitchUser TwitchUsers::resolveIDCopy(const UserId &id)
+{
+    std::lock_guard lock(this->private_->mutex);
+    return *this->private_->findOrMakeUnresolved(id);
 }
 
 TwitchUsersPrivate::TwitchUsersPrivate()
@@ -73,10 +85,15 @@ TwitchUsersPrivate::TwitchUsersPrivate()
     });
 }
 
-std::shared_ptr<TwitchUser> TwitchUsersPrivate::makeUnresolved(const UserId &id)
+std::shared_ptr<TwitchUser> TwitchUsersPrivate::findOrMakeUnresolved(
+    const UserId &id)
 {
-    // assumption: Cache entry is empty so neither a shared pointer was created
-    //             nor an entry in the unresolved list was added.
+    auto cached = this->cache.find(id);
+    if (cached != this->cache.end())
+    {
+        return cached->second;
+    }
+
     auto ptr = this->cache
                    .emplace(id, std::make_shared<TwitchUser>(TwitchUser{
                                     .id = id.string,
@@ -91,30 +108,48 @@ std::shared_ptr<TwitchUser> TwitchUsersPrivate::makeUnresolved(const UserId &id)
     }
 
     this->unresolved.append(id.string);
-    if (!this->isResolving && !this->nextBatchTimer.isActive())
-    {
-        this->nextBatchTimer.start();
-    }
+    this->scheduleNextBatch();
     return ptr;
 }
 
+void TwitchUsersPrivate::scheduleNextBatch()
+{
+    // The timer lives in the GUI thread and can't be started from others
+    runInGuiThread([weak = this->weak_from_this()] {
+        auto self = weak.lock();
+        if (!self)
+        {
+            return;
+        }
+        if (!self->isResolving && !self->nextBatchTimer.isActive())
+        {
+            self->nextBatchTimer.start();
+        }
+    });
+}
+
 void TwitchUsersPrivate::makeNextRequest()
 {
-    if (this->unresolved.empty())
+    if (this->isResolving)
     {
+        qCWarning(chatterinoTwitch) << "Tried to start request while resolving";
         return;
     }
 
-    if (this->isResolving)
+    QStringList ids;
     {
-        qCWarning(chatterinoTwitch) << "Tried to start request while resolving";
-        return;
+        std::lock_guard lock(this->mutex);
+        if (this->unresolved.empty())
+        {
+            return;
+        }
+
+        ids = this->unresolved.mid(
+            0, std::min<qsizetype>(this->unresolved.size(), 100));
+        this->unresolved = this->unresolved.mid(ids.length());
     }
     this->isResolving = true;
 
-    auto ids = this->unresolved.mid(
-        0, std::min<qsizetype>(this->unresolved.size(), 100));
-    this->unresolved = this->unresolved.mid(ids.length());
     getHelix()->fetchUsers(ids, {},
                            withSelf(this,
                                     [](auto self, const auto &users) {
@@ -132,6 +167,7 @@ void TwitchUsersPrivate::makeNextRequest()
 
 void TwitchUsersPrivate::updateUsers(const std::vector<HelixUser> &users)
 {
+    std::lock_guard lock(this->mutex);
     for (const auto &user : users)
     {
         auto cached = this->cache.find(UserId{user.id});
@@ -22,13 +22,20 @@ public:
     /// @brief Resolve a TwitchUser by their ID
     ///
     /// Users are cached. If the user wasn't resolved yet, a request will be
-    /// scheduled. The returned shared pointer must only be used on the GUI
-    /// thread as it will be updated from there.
+    /// scheduled. This can be called from any thread, but the returned shared
+    /// pointer must only be used on the GUI thread as it will be updated from
+    /// there.
     ///
     /// @returns A shared reference to the TwitchUser. The `name` and
     ///          `displayName` might be empty if the user wasn't resolved yet or
     ///          they don't exist.
     virtual std::shared_ptr<TwitchUser> resolveID(const UserId &id) = 0;
+
+    /// @brief Resolve a TwitchUser by their ID and return a copy of it
+    ///
+    /// Like resolveID(), but the user is copied while it can't be updated, so
+    /// this can be used from threads building messages.
+    virtual TwitchUser resolveIDCopy(const UserId &id) = 0;
 };
 
 class TwitchUsersPrivate;
@@ -45,6 +52,9 @@ public:
     /// @see ITwitchUsers::resolveID()
     std::shared_ptr<TwitchUser> resolveID(const UserId &id) override;
 
+    /// @see ITwitchUsers::resolveIDCopy()
+    TwitchUser resolveIDCopy(const UserId &id) override;
+
 private:
     // Using a shared_ptr to pass to network callbacks
     std::shared_ptr<TwitchUsersPrivate> private_;
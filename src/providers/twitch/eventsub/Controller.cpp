@@ -4,15 +4,12 @@
 #include "common/Args.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
+#include "common/websockets/IoRuntime.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "providers/twitch/eventsub/Connection.hpp"
 #include "util/QMagicEnum.hpp"
-#include "util/RenameThread.hpp"
 
-#include <boost/asio/io_context.hpp>
-#include <boost/asio/ssl.hpp>
-#include <boost/asio/ssl/verify_mode.hpp>
-#include <boost/certify/https_verification.hpp>
+#include <boost/asio/system_timer.hpp>
 #include <twitch-eventsub-ws/session.hpp>
 
 #include <memory>
@@ -76,22 +73,10 @@ Controller::Controller()
                          Version::instance().commitHash())
                     .toUtf8()
                     .toStdString())
-    , ioContext(1)
-    , work(boost::asio::make_work_guard(this->ioContext))
+    , io(IoRuntime::instance().registerClient("EventSub"))
 {
     std::tie(this->eventSubHost, this->eventSubPort, this->eventSubPath) =
         getEventSubHost();
-    this->thread = std::make_unique<std::thread>([this] {
-        // make sure we set in any case, even exceptions
-        auto guard = qScopeGuard([&] {
-            this->stoppedFlag.set();
-        });
-
-        this->ioContext.run();
-    });
-    renameThread(*this->thread, "C2EventSub");
-
-    this->threadGuard = std::make_unique<ThreadGuard>(this->thread->get_id());
 }
 
 Controller::~Controller()
@@ -101,38 +86,27 @@ Controller::~Controller()
 
     qCInfo(LOG) << "Controller dtor start";
 
-    for (const auto &weakConnection : this->connections)
-    {
-        auto connection = weakConnection.lock();
-        if (!connection)
+    this->io->post([this] {
+        for (const auto &weakConnection : this->connections)
         {
-            continue;
-        }
+            auto connection = weakConnection.lock();
+            if (!connection)
+            {
+                continue;
+            }
 
-        connection->close();
-    }
+            connection->close();
+        }
 
-    {
+        // This cancels the retry timers, which run on our strand
         std::lock_guard lock(this->subscriptionsMutex);
         this->subscriptions.clear();
-    }
-
-    this->work.reset();
-
-    if (!this->thread->joinable())
-    {
-        qCInfo(LOG) << "Controller dtor end (not joinable)";
-        return;
-    }
+    });
 
-    if (this->stoppedFlag.waitFor(250ms))
-    {
-        this->thread->join();
-        qCInfo(LOG) << "Controller dtor end (joined)";
-        return;
-    }
+    // Waits for the connections to be closed
+    this->io->close();
 
-    qCWarning(LOG) << "Controller dtor end (stopped flag didn't stop)";
+    qCInfo(LOG) << "Controller dtor end";
 }
 
 void Controller::removeRef(const SubscriptionRequest &request)
@@ -262,7 +236,7 @@ SubscriptionHandle Controller::subscribe(const SubscriptionRequest &request)
 
     if (needToSubscribe)
     {
-        boost::asio::post(this->ioContext, [this, request] {
+        this->io->post([this, request] {
             this->subscribe(request, false);
         });
     }
@@ -275,6 +249,17 @@ void Controller::reconnectConnection(
     const std::optional<std::string> &reconnectURL,
     const std::unordered_set<SubscriptionRequest> &subs)
 {
+    if (!this->io->strand().running_in_this_thread())
+    {
+        // This is called from the strand of the closed connection
+        this->io->post([this, connection{std::move(connection)}, reconnectURL,
+                        subs]() mutable {
+            this->reconnectConnection(std::move(connection), reconnectURL,
+                                      subs);
+        });
+        return;
+    }
+
     this->clearConnections();
     if (subs.empty())
     {
@@ -348,7 +333,7 @@ void Controller::debug()
             << ") -> " << sessionID;
     }
 
-    boost::asio::post(this->ioContext, [this] {
+    this->io->post([this] {
         for (const auto &weakConnection : this->connections)
         {
             auto connection = weakConnection.lock();
@@ -464,7 +449,7 @@ void Controller::subscribe(const SubscriptionRequest &request, bool isRetry)
 
                 if (retry)
                 {
-                    boost::asio::post(this->ioContext, [this, request] {
+                    this->io->post([this, request] {
                         this->retrySubscription(request);
                     });
                 }
@@ -545,23 +530,11 @@ void Controller::createConnection(std::string host, std::string port,
 
     try
     {
-        boost::asio::ssl::context sslContext{
-            boost::asio::ssl::context::tlsv12_client};
-
-#ifndef NDEBUG
-        if (!getApp()->getArgs().useLocalEventsub)
-#endif
-        {
-            sslContext.set_verify_mode(
-                boost::asio::ssl::verify_peer |
-                boost::asio::ssl::verify_fail_if_no_peer_cert);
-            sslContext.set_default_verify_paths();
-
-            boost::certify::enable_native_https_server_verification(sslContext);
-        }
-
+        // The TLS context verifies peers unless the local EventSub server is
+        // used
         auto connection = std::make_shared<lib::Session>(
-            this->ioContext, sslContext, std::move(listener), this->logProxy);
+            this->io->context(), this->io->runtime().tls(),
+            std::move(listener), this->logProxy);
 
         this->registerConnection(connection);
 
@@ -576,7 +549,7 @@ void Controller::createConnection(std::string host, std::string port,
 
 void Controller::registerConnection(std::weak_ptr<lib::Session> &&connection)
 {
-    this->threadGuard->guard();
+    assert(this->io->strand().running_in_this_thread());
 
     this->connections.emplace_back(std::move(connection));
 }
@@ -618,7 +591,7 @@ void Controller::retrySubscription(const SubscriptionRequest &request)
     std::chrono::milliseconds jitter{std::rand() % 256};
 
     auto retryTimer =
-        std::make_unique<boost::asio::system_timer>(this->ioContext);
+        std::make_unique<boost::asio::system_timer>(this->io->strand());
     retryTimer->expires_after(subscription.backoff.next() + jitter);
     retryTimer->async_wait([this, request](const auto &ec) {
         if (isAppAboutToQuit())
@@ -750,7 +723,7 @@ void Controller::markRequestUnsubscribed(const SubscriptionRequest &request)
 
     // someone subscribed in the meantime
     subscription.state = Subscription::State::Subscribing;
-    boost::asio::post(this->ioContext, [this, request] {
+    this->io->post([this, request] {
         this->subscribe(request, false);
     });
 }
@@ -5,11 +5,7 @@
 #include "twitch-eventsub-ws/logger.hpp"
 #include "twitch-eventsub-ws/session.hpp"
 #include "util/ExponentialBackoff.hpp"
-#include "util/OnceFlag.hpp"
-#include "util/ThreadGuard.hpp"
 
-#include <boost/asio/executor_work_guard.hpp>
-#include <boost/asio/io_context.hpp>
 #include <boost/functional/hash.hpp>
 #include <QJsonObject>
 #include <QString>
@@ -19,9 +15,14 @@
 #include <memory>
 #include <optional>
 #include <string>
-#include <thread>
 #include <unordered_set>
 
+namespace chatterino {
+
+class IoClient;
+
+}  // namespace chatterino
+
 namespace chatterino::eventsub {
 
 class IController
@@ -105,11 +106,8 @@ private:
     std::string eventSubPort;
     std::string eventSubPath;
 
-    std::unique_ptr<std::thread> thread;
-    std::unique_ptr<ThreadGuard> threadGuard;
-    boost::asio::io_context ioContext;
-    boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
-        work;
+    /// Connections and retries run on the strand of this client
+    std::shared_ptr<IoClient> io;
 
     std::vector<std::weak_ptr<lib::Session>> connections;
 
@@ -155,7 +153,6 @@ private:
     std::unordered_map<SubscriptionRequest, Subscription> subscriptions;
 
     std::atomic<bool> quitting = false;
-    OnceFlag stoppedFlag;
 };
 
 class DummyController : public IController
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "messages/ImageDecodeQueue.hpp"
 #include "providers/emoji/Emojis.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
 #include "singletons/helper/GifTimer.hpp"
@@ -14,6 +15,7 @@ public:
     virtual ITwitchEmotes *getTwitchEmotes() = 0;
     virtual IEmojis *getEmojis() = 0;
     virtual GIFTimer &getGIFTimer() = 0;
+    virtual ImageDecodeQueue &getImageDecodeQueue() = 0;
 };
 
 class Emotes final : public IEmotes
@@ -36,10 +38,16 @@ public:
         return this->gifTimer;
     }
 
+    ImageDecodeQueue &getImageDecodeQueue() final
+    {
+        return this->imageDecodeQueue;
+    }
+
     TwitchEmotes twitch;
     Emojis emojis;
 
     GIFTimer gifTimer;
+    ImageDecodeQueue imageDecodeQueue;
 };
 
 }  // namespace chatterino
@@ -178,6 +178,30 @@ QString fontFamily(FontStyle style)
 
 namespace chatterino {
 
+Fonts::WordWidths::WordWidths(const QFontMetricsF &metrics, size_t capacity)
+    : metrics_(metrics)
+    , enabled_(capacity > 0)
+    , widths_(capacity)
+{
+}
+
+qreal Fonts::WordWidths::width(const QString &word)
+{
+    if (!this->enabled_)
+    {
+        return this->metrics_.horizontalAdvance(word);
+    }
+
+    if (this->widths_.exists(word))
+    {
+        return this->widths_.get(word);
+    }
+
+    auto width = this->metrics_.horizontalAdvance(word);
+    this->widths_.put(word, width);
+    return width;
+}
+
 Fonts::Fonts(Settings &settings)
 {
     this->fontsByType_.resize(size_t(FontStyle::EndType));
@@ -207,6 +231,23 @@ QFontMetricsF Fonts::getFontMetrics(FontStyle type, float scale)
     return this->getOrCreateFontData(type, scale).metrics;
 }
 
+Fonts::WordWidths &Fonts::getWordWidths(FontStyle type, float scale)
+{
+    return this->getOrCreateFontData(type, scale).wordWidths;
+}
+
+void Fonts::setWordWidthCacheSize(size_t size)
+{
+    assertInGuiThread();
+
+    this->wordWidthCacheSize_ = size;
+    // The caches are recreated with the font data
+    for (auto &map : this->fontsByType_)
+    {
+        map.clear();
+    }
+}
+
 Fonts::FontData &Fonts::getOrCreateFontData(FontStyle type, float scale)
 {
     assertInGuiThread();
@@ -225,13 +266,15 @@ Fonts::FontData &Fonts::getOrCreateFontData(FontStyle type, float scale)
     }
 
     // emplace new element
-    auto result = map.emplace(scale, Fonts::createFontData(type, scale));
+    auto result = map.emplace(
+        scale, Fonts::createFontData(type, scale, this->wordWidthCacheSize_));
     assert(result.second);
 
     return result.first->second;
 }
 
-Fonts::FontData Fonts::createFontData(FontStyle type, float scale)
+Fonts::FontData Fonts::createFontData(FontStyle type, float scale,
+                                      size_t wordWidthCacheSize)
 {
     QFont font{
         fontFamily(type),
@@ -253,7 +296,7 @@ Fonts::FontData Fonts::createFontData(FontStyle type, float scale)
         break;
     }
 
-    return font;
+    return {font, wordWidthCacheSize};
 }
 
 }  // namespace chatterino
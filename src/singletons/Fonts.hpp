@@ -2,6 +2,7 @@
 
 #include "pajlada/settings/settinglistener.hpp"
 
+#include <lrucache/lrucache.hpp>
 #include <pajlada/signals/signal.hpp>
 #include <QFont>
 #include <QFontMetrics>
@@ -42,6 +43,27 @@ enum class FontStyle : uint8_t {
 class Fonts final
 {
 public:
+    /// Number of words whose widths are remembered per font style and scale
+    static constexpr size_t DEFAULT_WORD_WIDTH_CACHE_SIZE = 4096;
+
+    /// WordWidths measures words in one font and remembers the widths of the
+    /// most recently measured words.
+    ///
+    /// The same words (emote names, usernames, common words) appear in many
+    /// messages and every message is measured again whenever it's laid out.
+    class WordWidths
+    {
+    public:
+        WordWidths(const QFontMetricsF &metrics, size_t capacity);
+
+        qreal width(const QString &word);
+
+    private:
+        QFontMetricsF metrics_;
+        bool enabled_;
+        cache::lru_cache<QString, qreal> widths_;
+    };
+
     explicit Fonts(Settings &settings);
 
     // font data gets set in createFontData(...)
@@ -49,18 +71,28 @@ public:
     QFont getFont(FontStyle type, float scale);
     QFontMetricsF getFontMetrics(FontStyle type, float scale);
 
+    /// Returns the (cached) word widths of the font. The reference is valid
+    /// until the fonts change.
+    WordWidths &getWordWidths(FontStyle type, float scale);
+
+    /// Sets how many word widths are cached per font style and scale. 0
+    /// disables the cache.
+    void setWordWidthCacheSize(size_t size);
+
     pajlada::Signals::NoArgSignal fontChanged;
 
 private:
     struct FontData {
-        FontData(const QFont &_font)
+        FontData(const QFont &_font, size_t wordWidthCacheSize)
             : font(_font)
             , metrics(_font)
+            , wordWidths(this->metrics, wordWidthCacheSize)
         {
         }
 
         const QFont font;
         const QFontMetricsF metrics;
+        WordWidths wordWidths;
     };
 
     struct ChatFontData {
@@ -76,9 +108,11 @@ private:
     };
 
     FontData &getOrCreateFontData(FontStyle type, float scale);
-    static FontData createFontData(FontStyle type, float scale);
+    static FontData createFontData(FontStyle type, float scale,
+                                   size_t wordWidthCacheSize);
 
     std::vector<std::unordered_map<float, FontData>> fontsByType_;
+    size_t wordWidthCacheSize_ = DEFAULT_WORD_WIDTH_CACHE_SIZE;
 
     pajlada::SettingListener fontChangedListener;
 };
@@ -2,6 +2,7 @@
 
 #include "messages/Message.hpp"
 #include "singletons/helper/LoggingChannel.hpp"
+#include "singletons/helper/LogWriter.hpp"
 #include "singletons/Settings.hpp"
 
 #include <QDir>
@@ -13,6 +14,7 @@
 namespace chatterino {
 
 Logging::Logging(Settings &settings)
+    : writer_(std::make_unique<LogWriter>())
 {
     // We can safely ignore this signal connection since settings are only-ever destroyed
     // on application exit
@@ -22,15 +24,32 @@ Logging::Logging(Settings &settings)
             this->threadGuard.guard();
 
             this->onlyLogListedChannels.clear();
+            this->compressedChannels_.clear();
 
             for (const auto &loggedChannel :
                  *settings.loggedChannels.readOnly())
             {
                 this->onlyLogListedChannels.insert(loggedChannel.channelName());
+                if (loggedChannel.isCompressed())
+                {
+                    this->compressedChannels_.insert(
+                        loggedChannel.channelName());
+                }
+            }
+
+            // Reopen channels whose format changed
+            for (auto &platform : this->loggingChannels_)
+            {
+                std::erase_if(platform.second, [this](const auto &it) {
+                    return it.second->compressed !=
+                           this->compressedChannels_.contains(it.first);
+                });
             }
         });
 }
 
+Logging::~Logging() = default;
+
 void Logging::addMessage(const QString &channelName, MessagePtr message,
                          const QString &platformName, const QString &streamID)
 {
@@ -57,7 +76,9 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
     auto platIt = this->loggingChannels_.find(platformName);
     if (platIt == this->loggingChannels_.end())
     {
-        auto *channel = new LoggingChannel(channelName, platformName);
+        auto *channel = new LoggingChannel(
+            channelName, platformName,
+            this->compressedChannels_.contains(channelName), *this->writer_);
         channel->addMessage(message, streamID);
         auto map = std::map<QString, std::unique_ptr<LoggingChannel>>();
         this->loggingChannels_[platformName] = std::move(map);
@@ -68,7 +89,9 @@ void Logging::addMessage(const QString &channelName, MessagePtr message,
     auto chanIt = platIt->second.find(channelName);
     if (chanIt == platIt->second.end())
     {
-        auto *channel = new LoggingChannel(channelName, platformName);
+        auto *channel = new LoggingChannel(
+            channelName, platformName,
+            this->compressedChannels_.contains(channelName), *this->writer_);
         channel->addMessage(message, streamID);
         platIt->second.emplace(channelName, channel);
     }
@@ -15,6 +15,7 @@ class Settings;
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 class LoggingChannel;
+class LogWriter;
 
 class ILogging
 {
@@ -33,6 +34,7 @@ class Logging : public ILogging
 {
 public:
     Logging(Settings &settings);
+    ~Logging() override;
 
     void addMessage(const QString &channelName, MessagePtr message,
                     const QString &platformName,
@@ -44,12 +46,18 @@ public:
 private:
     using PlatformName = QString;
     using ChannelName = QString;
+
+    // Declared before the channels, so it outlives them and writes their
+    // closing lines when the application shuts down
+    std::unique_ptr<LogWriter> writer_;
     std::map<PlatformName,
              std::map<ChannelName, std::unique_ptr<LoggingChannel>>>
         loggingChannels_;
 
     // Keeps the value of the `loggedChannels` settings
     std::unordered_set<ChannelName> onlyLogListedChannels;
+    // Channels of `loggedChannels` that are logged in the compressed format
+    std::unordered_set<ChannelName> compressedChannels_;
     ThreadGuard threadGuard;
 };
 
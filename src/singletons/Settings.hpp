@@ -150,6 +150,11 @@ public:
     BoolSetting showTimestamps = {"/appearance/messages/showTimestamps", true};
     BoolSetting animationsWhenFocused = {
         "/appearance/enableAnimationsWhenFocused", false};
+    /// Maximum number of times per second chats are laid out and drawn
+    IntSetting frameRateLimit = {"/appearance/frameRateLimit", 60};
+    /// Like #frameRateLimit for chats in windows that aren't focused
+    IntSetting backgroundFrameRateLimit = {
+        "/appearance/backgroundFrameRateLimit", 30};
     QStringSetting timestampFormat = {"/appearance/messages/timestampFormat",
                                       "h:mm"};
     BoolSetting showLastMessageIndicator = {
@@ -661,6 +666,16 @@ public:
         "/misc/scrollback/usercardLimit",
         1000,
     };
+    /// Memory budget of the pixmaps messages are drawn into, in MiB
+    IntSetting messageBufferPoolSize = {
+        "/misc/messageBufferPoolSize",
+        64,
+    };
+    /// Number of threads running the event loop of the websocket clients
+    IntSetting ioThreadCount = {
+        "/misc/ioThreadCount",
+        1,
+    };
 
     EnumStringSetting<ChatSendProtocol> chatSendProtocol = {
         "/misc/chatSendProtocol", ChatSendProtocol::Default};
@@ -672,6 +687,8 @@ public:
         ThumbnailPreviewMode::AlwaysShow,
     };
     QStringSetting cachePath = {"/cache/path", ""};
+    /// Size limit of the HTTP cache in MiB
+    IntSetting cacheSizeLimit = {"/cache/sizeLimit", 1024};
     BoolSetting attachExtensionToAnyProcess = {
         "/misc/attachExtensionToAnyProcess", false};
     BoolSetting askOnImageUpload = {"/misc/askOnImageUpload", true};
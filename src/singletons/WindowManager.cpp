@@ -4,8 +4,10 @@
 #include "common/Args.hpp"
 #include "common/QLogging.hpp"
 #include "debug/AssertInGuiThread.hpp"
+#include "messages/layouts/TextPreparation.hpp"
 #include "messages/MessageElement.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "singletons/helper/FrameScheduler.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
@@ -109,6 +111,8 @@ WindowManager::WindowManager(const Args &appArgs_, const Paths &paths,
     , appArgs(appArgs_)
     , windowLayoutFilePath(combinePath(paths.settingsDirectory,
                                        WindowManager::WINDOW_LAYOUT_FILENAME))
+    , textPreparation_(std::make_unique<TextPreparation>(fonts))
+    , frameScheduler_(std::make_unique<FrameScheduler>())
     , updateWordTypeMaskListener([this] {
         this->updateWordTypeMask();
     })
@@ -811,6 +815,16 @@ void WindowManager::incGeneration()
     this->generation_++;
 }
 
+TextPreparation &WindowManager::getTextPreparation()
+{
+    return *this->textPreparation_;
+}
+
+FrameScheduler &WindowManager::getFrameScheduler()
+{
+    return *this->frameScheduler_;
+}
+
 WindowLayout WindowManager::loadWindowLayoutFromFile() const
 {
     return WindowLayout::loadFromFile(this->windowLayoutFilePath);
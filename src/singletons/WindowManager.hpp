@@ -11,6 +11,7 @@
 
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 namespace chatterino {
 
@@ -29,6 +30,9 @@ using MessagePtr = std::shared_ptr<const Message>;
 class WindowLayout;
 class Theme;
 class Fonts;
+class TextPreparation;
+class FrameScheduler;
+class Image;
 
 enum class MessageElementFlag : int64_t;
 using MessageElementFlags = FlagsEnum<MessageElementFlag>;
@@ -121,6 +125,12 @@ public:
     int getGeneration() const;
     void incGeneration();
 
+    /// Measures the text of messages on worker threads
+    TextPreparation &getTextPreparation();
+
+    /// Lays out and repaints channel views once per frame
+    FrameScheduler &getFrameScheduler();
+
     MessageElementFlags getWordFlags();
     void updateWordTypeMask();
 
@@ -148,6 +158,10 @@ public:
     // This signal fires whenever views rendering a channel, or all views if the
     // channel is a nullptr, need to invalidate their paint buffers
     pajlada::Signals::Signal<Channel *> invalidateBuffersRequested;
+    // This signal fires (at most once per event-loop iteration) when images
+    // finished loading. Views lay out the messages that waited for them.
+    pajlada::Signals::Signal<const std::unordered_set<const Image *> &>
+        imagesLoaded;
 
     pajlada::Signals::NoArgSignal wordFlagsChanged;
 
@@ -174,6 +188,9 @@ private:
 
     std::atomic<int> generation_{0};
 
+    std::unique_ptr<TextPreparation> textPreparation_;
+    std::unique_ptr<FrameScheduler> frameScheduler_;
+
     std::vector<Window *> windows_;
 
     std::unique_ptr<FramelessEmbedWindow> framelessEmbedWindow_;
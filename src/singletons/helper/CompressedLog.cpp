@@ -0,0 +1,409 @@
+#include "singletons/helper/CompressedLog.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+using namespace chatterino;
+
+constexpr quint32 BLOCK_MAGIC = 0x434C4231;  // "CLB1"
+/// BLOCK_MAGIC as it's written (big endian)
+const QByteArray BLOCK_MAGIC_BYTES = QByteArrayLiteral("CLB1");
+constexpr auto STREAM_VERSION = QDataStream::Qt_5_15;
+constexpr std::size_t FILTER_BITS = LogUserFilter::SIZE * 8;
+constexpr std::size_t FILTER_HASHES = 4;
+
+struct BlockHeader {
+    quint32 entryCount = 0;
+    qint64 minTimestamp = 0;
+    qint64 maxTimestamp = 0;
+    quint32 payloadSize = 0;
+    LogUserFilter users;
+};
+
+/// 64-bit FNV-1a over the UTF-16 code units of `user` with ASCII letters
+/// lowercased. Qt's case folding depends on its Unicode version, so it's not
+/// used here. User IDs and login names are ASCII anyway.
+std::uint64_t hashUser(const QString &user)
+{
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto c : user)
+    {
+        auto unit = c.unicode();
+        if (unit >= u'A' && unit <= u'Z')
+        {
+            unit += u'a' - u'A';
+        }
+        for (auto byte : {unit & 0xff, unit >> 8})
+        {
+            hash ^= static_cast<std::uint64_t>(byte);
+            hash *= 0x100000001b3;
+        }
+    }
+    return hash;
+}
+
+/// Calls `fn(bitIndex)` for every bit `user` maps to
+template <typename Fn>
+void forEachBit(const QString &user, Fn &&fn)
+{
+    auto hash = hashUser(user);
+    auto h1 = hash & 0xffffffff;
+    auto h2 = (hash >> 32) | 1;
+    for (std::size_t i = 0; i < FILTER_HASHES; i++)
+    {
+        fn(static_cast<std::size_t>((h1 + i * h2) % FILTER_BITS));
+    }
+}
+
+void writeHeader(QDataStream &stream, const BlockHeader &header)
+{
+    stream << BLOCK_MAGIC << header.entryCount << header.minTimestamp
+           << header.maxTimestamp << header.payloadSize;
+    stream.writeRawData(
+        reinterpret_cast<const char *>(header.users.bits.data()),
+        static_cast<int>(header.users.bits.size()));
+}
+
+bool readHeader(QDataStream &stream, BlockHeader &header)
+{
+    quint32 magic = 0;
+    stream >> magic;
+    if (magic != BLOCK_MAGIC)
+    {
+        return false;
+    }
+
+    stream >> header.entryCount >> header.minTimestamp >>
+        header.maxTimestamp >> header.payloadSize;
+    auto size = static_cast<int>(header.users.bits.size());
+    return stream.readRawData(
+               reinterpret_cast<char *>(header.users.bits.data()), size) ==
+               size &&
+           stream.status() == QDataStream::Ok;
+}
+
+bool mightMatch(const BlockHeader &header, const CompressedLogQuery &query)
+{
+    if (query.from.isValid() &&
+        header.maxTimestamp < query.from.toMSecsSinceEpoch())
+    {
+        return false;
+    }
+    if (query.to.isValid() &&
+        header.minTimestamp > query.to.toMSecsSinceEpoch())
+    {
+        return false;
+    }
+    return query.user.isEmpty() || header.users.mightContain(query.user);
+}
+
+void readEntries(const QByteArray &payload, const CompressedLogQuery &query,
+                 quint32 count, std::vector<CompressedLogEntry> &out)
+{
+    QDataStream stream(payload);
+    stream.setVersion(STREAM_VERSION);
+
+    for (quint32 i = 0; i < count; i++)
+    {
+        qint64 timestamp = 0;
+        CompressedLogEntry entry;
+        stream >> timestamp >> entry.userID >> entry.loginName >> entry.text;
+        if (stream.status() != QDataStream::Ok)
+        {
+            return;
+        }
+
+        entry.timestamp = QDateTime::fromMSecsSinceEpoch(timestamp);
+        if (query.matches(entry))
+        {
+            out.push_back(std::move(entry));
+        }
+    }
+}
+
+/// Seeks to the next block magic at or after `from`. Returns false (and
+/// seeks to the end) if there is none.
+bool seekToMagic(QFile &file, qint64 from)
+{
+    constexpr qint64 CHUNK_SIZE = 64 * 1024;
+
+    for (auto pos = from; pos < file.size(); pos += CHUNK_SIZE)
+    {
+        file.seek(pos);
+        // Overlap the chunks, so a magic on a boundary is found
+        auto chunk = file.read(CHUNK_SIZE + BLOCK_MAGIC_BYTES.size() - 1);
+        auto index = chunk.indexOf(BLOCK_MAGIC_BYTES);
+        if (index >= 0)
+        {
+            file.seek(pos + index);
+            return true;
+        }
+    }
+
+    file.seek(file.size());
+    return false;
+}
+
+/// Returns true if `end` is the end of `file` or the start of a block
+bool isBlockBoundary(QFile &file, qint64 end)
+{
+    if (end == file.size())
+    {
+        return true;
+    }
+
+    auto pos = file.pos();
+    file.seek(end);
+    auto magic = file.read(BLOCK_MAGIC_BYTES.size());
+    file.seek(pos);
+    return magic == BLOCK_MAGIC_BYTES;
+}
+
+/// Reads the header of the next complete block, skipping damaged data.
+///
+/// A session that crashed leaves an incomplete block behind, and the next
+/// session appends its blocks after it. So instead of stopping at an invalid
+/// block, the next block magic is searched. A block only counts as complete
+/// if it's followed by another block or the end of the file.
+///
+/// @return false if there are no more complete blocks
+bool readNextBlock(QFile &file, QDataStream &stream, BlockHeader &header)
+{
+    while (!stream.atEnd())
+    {
+        auto start = file.pos();
+        if (readHeader(stream, header) &&
+            header.payloadSize <= file.size() - file.pos() &&
+            header.minTimestamp <= header.maxTimestamp &&
+            isBlockBoundary(file, file.pos() + header.payloadSize))
+        {
+            return true;
+        }
+
+        qCDebug(chatterinoHelper)
+            << "Invalid block in log" << file.fileName() << "at" << start;
+        stream.resetStatus();
+        if (!seekToMagic(file, start + 1))
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+void searchFile(const QString &path, const CompressedLogQuery &query,
+                std::vector<CompressedLogEntry> &out)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qCDebug(chatterinoHelper) << "Unable to open log" << path;
+        return;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(STREAM_VERSION);
+
+    BlockHeader header;
+    while (readNextBlock(file, stream, header))
+    {
+        if (!mightMatch(header, query))
+        {
+            file.seek(file.pos() + header.payloadSize);
+            continue;
+        }
+
+        auto payload = qUncompress(file.read(header.payloadSize));
+        readEntries(payload, query, header.entryCount, out);
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+void LogUserFilter::add(const QString &user)
+{
+    forEachBit(user, [this](std::size_t bit) {
+        this->bits[bit / 8] |= static_cast<std::uint8_t>(1U << (bit % 8));
+    });
+}
+
+bool LogUserFilter::mightContain(const QString &user) const
+{
+    bool result = true;
+    forEachBit(user, [&](std::size_t bit) {
+        result = result && (this->bits[bit / 8] & (1U << (bit % 8))) != 0;
+    });
+    return result;
+}
+
+void CompressedLogBlock::add(CompressedLogEntry entry)
+{
+    if (this->entries_.empty())
+    {
+        this->createdAt_ = QDateTime::currentDateTime();
+    }
+    this->textBytes_ += static_cast<std::size_t>(entry.text.size()) * 2;
+    this->entries_.push_back(std::move(entry));
+}
+
+bool CompressedLogBlock::empty() const
+{
+    return this->entries_.empty();
+}
+
+std::size_t CompressedLogBlock::size() const
+{
+    return this->entries_.size();
+}
+
+bool CompressedLogBlock::isFull(std::chrono::milliseconds maxAge) const
+{
+    if (this->entries_.empty())
+    {
+        return false;
+    }
+
+    return this->entries_.size() >= MAX_ENTRIES ||
+           this->textBytes_ >= MAX_TEXT_BYTES ||
+           this->createdAt_.msecsTo(QDateTime::currentDateTime()) >=
+               maxAge.count();
+}
+
+QByteArray CompressedLogBlock::finish()
+{
+    BlockHeader header;
+    header.entryCount = static_cast<quint32>(this->entries_.size());
+    header.minTimestamp = std::numeric_limits<qint64>::max();
+    header.maxTimestamp = std::numeric_limits<qint64>::min();
+
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setVersion(STREAM_VERSION);
+        for (const auto &entry : this->entries_)
+        {
+            auto timestamp = entry.timestamp.toMSecsSinceEpoch();
+            header.minTimestamp = std::min(header.minTimestamp, timestamp);
+            header.maxTimestamp = std::max(header.maxTimestamp, timestamp);
+            if (!entry.userID.isEmpty())
+            {
+                header.users.add(entry.userID);
+            }
+            if (!entry.loginName.isEmpty())
+            {
+                header.users.add(entry.loginName);
+            }
+
+            stream << timestamp << entry.userID << entry.loginName
+                   << entry.text;
+        }
+    }
+    payload = qCompress(payload);
+    header.payloadSize = static_cast<quint32>(payload.size());
+
+    this->entries_.clear();
+    this->textBytes_ = 0;
+
+    QByteArray block;
+    {
+        QDataStream stream(&block, QIODevice::WriteOnly);
+        stream.setVersion(STREAM_VERSION);
+        writeHeader(stream, header);
+    }
+    block.append(payload);
+    return block;
+}
+
+bool CompressedLogQuery::matches(const CompressedLogEntry &entry) const
+{
+    if (this->from.isValid() && entry.timestamp < this->from)
+    {
+        return false;
+    }
+    if (this->to.isValid() && entry.timestamp > this->to)
+    {
+        return false;
+    }
+    return this->user.isEmpty() || entry.userID == this->user ||
+           entry.loginName.compare(this->user, Qt::CaseInsensitive) == 0;
+}
+
+std::vector<CompressedLogEntry> CompressedLogReader::search(
+    const QString &path, const CompressedLogQuery &query)
+{
+    std::vector<CompressedLogEntry> entries;
+    searchFile(path, query, entries);
+    return entries;
+}
+
+qint64 CompressedLogReader::completeSize(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return 0;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(STREAM_VERSION);
+
+    qint64 size = 0;
+    BlockHeader header;
+    while (readNextBlock(file, stream, header))
+    {
+        size = file.pos() + header.payloadSize;
+        file.seek(size);
+    }
+    return size;
+}
+
+std::vector<CompressedLogEntry> CompressedLogReader::searchChannel(
+    const QString &directory, const QString &channelName,
+    const CompressedLogQuery &query)
+{
+    auto prefix = channelName + '-';
+    auto pattern = prefix + '*' + COMPRESSED_LOG_SUFFIX.toString();
+    auto files =
+        QDir(directory).entryInfoList({pattern}, QDir::Files, QDir::Name);
+
+    std::vector<CompressedLogEntry> entries;
+    for (const auto &info : files)
+    {
+        // Daily logs are named after the local date, so allow a day of
+        // slack for the time zone. Stream logs are named after the stream ID
+        // and always searched.
+        auto date = QDate::fromString(
+            info.fileName().mid(prefix.size()).chopped(
+                COMPRESSED_LOG_SUFFIX.size()),
+            QStringLiteral("yyyy-MM-dd"));
+        if (date.isValid() &&
+            ((query.from.isValid() &&
+              date.addDays(1) < query.from.toLocalTime().date()) ||
+             (query.to.isValid() &&
+              date.addDays(-1) > query.to.toLocalTime().date())))
+        {
+            continue;
+        }
+
+        searchFile(info.filePath(), query, entries);
+    }
+
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const auto &a, const auto &b) {
+                         return a.timestamp < b.timestamp;
+                     });
+    return entries;
+}
+
+}  // namespace chatterino
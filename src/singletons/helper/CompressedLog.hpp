@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+#include <QStringView>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chatterino {
+
+/// File name suffix of compressed logs (plain text logs use ".log")
+inline constexpr QStringView COMPRESSED_LOG_SUFFIX = u".clog";
+
+/// A compressed log is a sequence of independently compressed blocks of
+/// messages. Each block starts with an uncompressed header containing the
+/// range of timestamps in the block and a bloom filter of the users that sent
+/// a message in it, so a search can skip blocks without decompressing them.
+///
+/// Blocks are only ever appended, so a log that was cut off while writing
+/// loses at most its last block. The incomplete block is cut off before the
+/// next session appends to the log, and readers skip over it if it's still
+/// there.
+struct CompressedLogEntry {
+    QDateTime timestamp;
+    QString userID;
+    QString loginName;
+    /// The line as it would be written to a plain text log, without the
+    /// trailing newline
+    QString text;
+};
+
+/// A bloom filter over user IDs and login names.
+///
+/// The hash is part of the file format, so it must not depend on the Qt
+/// version or the platform.
+class LogUserFilter
+{
+public:
+    static constexpr std::size_t SIZE = 256;
+
+    void add(const QString &user);
+    bool mightContain(const QString &user) const;
+
+    std::array<std::uint8_t, SIZE> bits{};
+};
+
+/// Collects entries of a block and encodes them
+class CompressedLogBlock
+{
+public:
+    static constexpr std::size_t MAX_ENTRIES = 256;
+    static constexpr std::size_t MAX_TEXT_BYTES = 64 * 1024;
+    /// Blocks are written at least this often, so a crash doesn't lose
+    /// more than a few minutes of logs
+    static constexpr std::chrono::minutes MAX_AGE{1};
+
+    void add(CompressedLogEntry entry);
+
+    bool empty() const;
+    /// Returns the number of entries in the block
+    std::size_t size() const;
+    /// Returns true if the block should be written before adding more
+    /// entries (or it's older than `maxAge`)
+    bool isFull(std::chrono::milliseconds maxAge = MAX_AGE) const;
+
+    /// Encodes the block (header and compressed entries) and clears it
+    QByteArray finish();
+
+private:
+    std::vector<CompressedLogEntry> entries_;
+    std::size_t textBytes_ = 0;
+    QDateTime createdAt_;
+};
+
+struct CompressedLogQuery {
+    /// Login name or user ID of the sender. Empty matches all messages.
+    QString user;
+    /// Only messages in [from, to] match. Null timestamps are unbounded.
+    QDateTime from;
+    QDateTime to;
+
+    bool matches(const CompressedLogEntry &entry) const;
+};
+
+class CompressedLogReader
+{
+public:
+    /// Returns all entries of the compressed log at `path` matching `query`.
+    ///
+    /// Blocks whose header rules out a match are skipped without
+    /// decompressing them.
+    static std::vector<CompressedLogEntry> search(
+        const QString &path, const CompressedLogQuery &query);
+
+    /// Returns the size of the compressed log at `path` up to the end of
+    /// its last complete block. Anything after it is a block that was cut
+    /// off.
+    static qint64 completeSize(const QString &path);
+
+    /// Searches all compressed logs of `channelName` in `directory` (e.g.
+    /// "<log path>/Twitch/Channels/forsen") in chronological order.
+    ///
+    /// Daily logs that end before `query.from` are not opened.
+    static std::vector<CompressedLogEntry> searchChannel(
+        const QString &directory, const QString &channelName,
+        const CompressedLogQuery &query);
+};
+
+}  // namespace chatterino
@@ -0,0 +1,281 @@
+#include "singletons/helper/FrameScheduler.hpp"
+
+#include "common/Literals.hpp"
+#include "singletons/Settings.hpp"
+#include "widgets/helper/ChannelView.hpp"
+
+#include <QApplication>
+#include <QStringBuilder>
+#include <QVarLengthArray>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using namespace chatterino::literals;
+using namespace std::chrono_literals;
+
+/// Upper bounds of all but the last bucket
+constexpr std::array BUCKET_BOUNDS{1ms, 2ms, 4ms, 8ms, 16ms, 32ms};
+
+}  // namespace
+
+namespace chatterino {
+
+void FrameTimeHistogram::record(std::chrono::nanoseconds duration)
+{
+    auto it =
+        std::upper_bound(BUCKET_BOUNDS.begin(), BUCKET_BOUNDS.end(), duration);
+    auto bucket = static_cast<size_t>(it - BUCKET_BOUNDS.begin());
+    this->buckets_[bucket]++;
+    this->total_++;
+}
+
+QString FrameTimeHistogram::toString(const QString &title) const
+{
+    QString text = title % u": " % QString::number(this->total_) % '\n';
+    for (size_t i = 0; i < this->buckets_.size(); i++)
+    {
+        QString range;
+        if (i < BUCKET_BOUNDS.size())
+        {
+            range = u"< " % QString::number(BUCKET_BOUNDS[i].count()) % u"ms";
+        }
+        else
+        {
+            range = u">= " % QString::number(BUCKET_BOUNDS.back().count()) %
+                    u"ms";
+        }
+        text += u"  " % range % u": " % QString::number(this->buckets_[i]) %
+                '\n';
+    }
+    return text;
+}
+
+FrameScheduler::FrameScheduler()
+{
+    this->timer_.setSingleShot(true);
+    this->timer_.setTimerType(Qt::PreciseTimer);
+    QObject::connect(&this->timer_, &QTimer::timeout, [this] {
+        this->runFrame();
+    });
+}
+
+void FrameScheduler::requestLayout(ChannelView *view)
+{
+    if (!view->isVisible())
+    {
+        // The view lays out its messages once it's shown
+        return;
+    }
+
+    this->markDirty(view);
+    this->schedule();
+}
+
+void FrameScheduler::requestUpdate(ChannelView *view)
+{
+    if (!view->isVisible())
+    {
+        return;
+    }
+
+    this->markDirty(view).fullUpdate = true;
+    this->schedule();
+}
+
+void FrameScheduler::requestUpdate(ChannelView *view, const QRect &area)
+{
+    if (!view->isVisible())
+    {
+        return;
+    }
+
+    auto &dirty = this->markDirty(view);
+    if (!dirty.fullUpdate)
+    {
+        dirty.region += area;
+    }
+    this->schedule();
+}
+
+void FrameScheduler::recordPaint(std::chrono::nanoseconds duration)
+{
+    this->paintTimes_.record(duration);
+}
+
+QString FrameScheduler::getDebugText() const
+{
+    return this->frameTimes_.toString(u"Frames"_s) %
+           this->paintTimes_.toString(u"Paints"_s);
+}
+
+FrameScheduler::Dirty &FrameScheduler::markDirty(ChannelView *view)
+{
+    auto &dirty = this->dirty_[view];
+    if (dirty.view != view)
+    {
+        // A new view (possibly allocated where a destroyed one was)
+        dirty = {.view = view};
+    }
+    return dirty;
+}
+
+void FrameScheduler::schedule()
+{
+    if (this->inFrame_)
+    {
+        return;
+    }
+
+    std::erase_if(this->dirty_, [](const auto &entry) {
+        return entry.second.view.isNull();
+    });
+    if (this->dirty_.empty())
+    {
+        return;
+    }
+
+    QVarLengthArray<ViewTiming, 16> views;
+    for (const auto &[key, dirty] : this->dirty_)
+    {
+        views.push_back({
+            .lastFrame = dirty.view->lastFrameTime_,
+            .interval = this->interval(*dirty.view),
+        });
+    }
+    auto due = nextFrameDue({views.data(), static_cast<size_t>(views.size())},
+                            this->lastFrame_, this->foregroundInterval());
+
+    auto delay = std::max(std::chrono::ceil<std::chrono::milliseconds>(
+                              due - std::chrono::steady_clock::now()),
+                          0ms);
+    // A view in the background might have armed the timer for its longer
+    // interval, a foreground view mustn't wait for it
+    if (this->timer_.isActive() &&
+        this->timer_.remainingTimeAsDuration() <= delay)
+    {
+        return;
+    }
+    this->timer_.start(delay);
+}
+
+void FrameScheduler::runFrame()
+{
+    auto now = std::chrono::steady_clock::now();
+    this->lastFrame_ = now;
+    this->inFrame_ = true;
+
+    std::vector<Dirty> frame;
+    for (auto it = this->dirty_.begin(); it != this->dirty_.end();)
+    {
+        const auto &view = it->second.view;
+        if (!view)
+        {
+            it = this->dirty_.erase(it);
+            continue;
+        }
+        if (now < view->lastFrameTime_ + this->interval(*view))
+        {
+            it++;
+            continue;
+        }
+
+        frame.push_back(std::move(it->second));
+        it = this->dirty_.erase(it);
+    }
+
+    for (const auto &dirty : frame)
+    {
+        dirty.view->lastFrameTime_ = now;
+        if (dirty.view->layoutQueued_ && dirty.view->isVisible())
+        {
+            dirty.view->performLayout();
+        }
+    }
+
+    for (auto &dirty : frame)
+    {
+        if (!dirty.view)
+        {
+            continue;
+        }
+
+        // The layout might have requested a repaint
+        auto it = this->dirty_.find(dirty.view.data());
+        if (it != this->dirty_.end() && it->second.view == dirty.view &&
+            !dirty.view->layoutQueued_)
+        {
+            dirty.fullUpdate |= it->second.fullUpdate;
+            dirty.region += it->second.region;
+            this->dirty_.erase(it);
+        }
+
+        if (dirty.fullUpdate)
+        {
+            dirty.view->update();
+        }
+        else if (!dirty.region.isEmpty())
+        {
+            dirty.view->update(dirty.region);
+        }
+    }
+
+    this->inFrame_ = false;
+    if (!frame.empty())
+    {
+        this->frameTimes_.record(std::chrono::steady_clock::now() - now);
+    }
+    this->schedule();
+}
+
+std::chrono::milliseconds FrameScheduler::frameInterval(
+    bool isBackground, int frameRateLimit, int backgroundFrameRateLimit)
+{
+    auto foreground =
+        std::chrono::milliseconds(1000 / std::clamp(frameRateLimit, 1, 1000));
+    if (!isBackground)
+    {
+        return foreground;
+    }
+
+    // The background is never redrawn more often than the foreground
+    auto background = std::chrono::milliseconds(
+        1000 / std::clamp(backgroundFrameRateLimit, 1, 1000));
+    return std::max(background, foreground);
+}
+
+std::chrono::steady_clock::time_point FrameScheduler::nextFrameDue(
+    std::span<const ViewTiming> views,
+    std::chrono::steady_clock::time_point lastFrame,
+    std::chrono::milliseconds minInterval)
+{
+    // Frames are at least one interval apart, views in the background wait
+    // for their own (longer) interval
+    auto due = std::chrono::steady_clock::time_point::max();
+    for (const auto &view : views)
+    {
+        due = std::min(due, view.lastFrame + view.interval);
+    }
+    return std::max(due, lastFrame + minInterval);
+}
+
+std::chrono::milliseconds FrameScheduler::foregroundInterval() const
+{
+    return frameInterval(false, getSettings()->frameRateLimit.getValue(), 0);
+}
+
+std::chrono::milliseconds FrameScheduler::interval(
+    const ChannelView &view) const
+{
+    const auto *window = view.window();
+    // Overlays are drawn over other applications, they're never focused
+    bool isBackground = !view.isOverlay_ &&
+                        (window != QApplication::activeWindow() ||
+                         window->isMinimized());
+    return frameInterval(isBackground, getSettings()->frameRateLimit.getValue(),
+                         getSettings()->backgroundFrameRateLimit.getValue());
+}
+
+}  // namespace chatterino
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <QPointer>
+#include <QRegion>
+#include <QString>
+#include <QTimer>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+
+namespace chatterino {
+
+class ChannelView;
+
+/// Counts durations in buckets (below 1ms, 2ms, 4ms, ..., 32ms and above)
+class FrameTimeHistogram
+{
+public:
+    void record(std::chrono::nanoseconds duration);
+
+    /// Returns one line for each bucket prefixed by `title`
+    QString toString(const QString &title) const;
+
+private:
+    std::array<uint64_t, 7> buckets_{};
+    uint64_t total_ = 0;
+};
+
+/**
+ * @brief Lays out and repaints all channel views at most once per frame.
+ *
+ * Views request a layout or a repaint of a region instead of doing it right
+ * away. The requests are collected until the next frame, when every dirty
+ * view is laid out once and repainted once with the union of its dirty
+ * regions. This way, a burst of messages, GIF frames and loaded images in
+ * many splits only costs one layout and one paint per view.
+ *
+ * Frames are capped at the `frameRateLimit` setting. Views in windows that
+ * aren't focused (or are minimized) use `backgroundFrameRateLimit`. Hidden
+ * views aren't scheduled at all, they lay out once they're shown.
+ */
+class FrameScheduler
+{
+public:
+    FrameScheduler();
+
+    void requestLayout(ChannelView *view);
+    void requestUpdate(ChannelView *view);
+    void requestUpdate(ChannelView *view, const QRect &area);
+
+    /// Records the time a view took to paint
+    void recordPaint(std::chrono::nanoseconds duration);
+
+    /// Returns histograms of the frame and paint times for the debug popup
+    QString getDebugText() const;
+
+    /// The last frame of a dirty view and the minimum time until its next one
+    struct ViewTiming {
+        std::chrono::steady_clock::time_point lastFrame;
+        std::chrono::milliseconds interval;
+    };
+
+    /// Returns the minimum time between two frames of a view in the
+    /// foreground or background with the given limits (in frames per second)
+    static std::chrono::milliseconds frameInterval(
+        bool isBackground, int frameRateLimit, int backgroundFrameRateLimit);
+
+    /**
+     * @brief Returns when the next frame is due.
+     *
+     * That's when the first of `views` is due, but at least `minInterval`
+     * after the last frame (`lastFrame`).
+     */
+    static std::chrono::steady_clock::time_point nextFrameDue(
+        std::span<const ViewTiming> views,
+        std::chrono::steady_clock::time_point lastFrame,
+        std::chrono::milliseconds minInterval);
+
+private:
+    struct Dirty {
+        QPointer<ChannelView> view;
+        bool fullUpdate = false;
+        QRegion region;
+    };
+
+    Dirty &markDirty(ChannelView *view);
+    void schedule();
+    void runFrame();
+
+    std::chrono::milliseconds foregroundInterval() const;
+    /// Returns the minimum time between two frames of `view`
+    std::chrono::milliseconds interval(const ChannelView &view) const;
+
+    std::unordered_map<const ChannelView *, Dirty> dirty_;
+    QTimer timer_;
+    std::chrono::steady_clock::time_point lastFrame_;
+    /// Requests made while a frame runs are handled by it or scheduled after
+    bool inFrame_ = false;
+
+    FrameTimeHistogram frameTimes_;
+    FrameTimeHistogram paintTimes_;
+};
+
+}  // namespace chatterino
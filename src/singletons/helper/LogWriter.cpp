@@ -0,0 +1,285 @@
+#include "singletons/helper/LogWriter.hpp"
+
+#include "common/QLogging.hpp"
+#include "util/DebugCount.hpp"
+#include "util/RenameThread.hpp"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+
+#include <utility>
+
+namespace {
+
+using namespace chatterino;
+
+/// Cuts off a block that a previous session didn't finish writing (e.g.
+/// because it crashed), so the blocks appended now stay readable
+void dropIncompleteBlock(const QString &path)
+{
+    QFileInfo info(path);
+    if (!info.exists())
+    {
+        return;
+    }
+
+    auto size = CompressedLogReader::completeSize(path);
+    if (size < info.size())
+    {
+        qCWarning(chatterinoHelper)
+            << "Dropping" << info.size() - size
+            << "bytes of an incomplete block from" << path;
+        QFile::resize(path, size);
+    }
+}
+
+}  // namespace
+
+namespace chatterino {
+
+class LogWriter::File
+{
+public:
+    File(QString directory_, QString fileName_)
+        : directory(std::move(directory_))
+        , fileName(std::move(fileName_))
+    {
+    }
+
+    const QString directory;
+    const QString fileName;
+
+    // Guarded by LogWriter::mutex_
+    QByteArray pending;
+    std::size_t pendingLines = 0;
+    bool closing = false;
+    bool dirty = false;
+    CompressedLogBlock block;
+    bool hasBlock = false;
+
+    // Only used on the writer thread
+    QFile handle;
+    bool openFailed = false;
+};
+
+struct LogWriter::Batch {
+    FilePtr file;
+    QByteArray data;
+    std::size_t lines;
+    bool close;
+};
+
+LogWriter::LogWriter(std::chrono::milliseconds maxBlockAge)
+    : maxBlockAge_(maxBlockAge)
+{
+    this->thread_ = std::make_unique<std::thread>([this] {
+        this->run();
+    });
+    renameThread(*this->thread_, "LogWriter");
+}
+
+LogWriter::~LogWriter()
+{
+    {
+        std::lock_guard lock(this->mutex_);
+        this->stopping_ = true;
+    }
+    this->wake_.notify_one();
+    this->thread_->join();
+}
+
+LogWriter::FilePtr LogWriter::open(const QString &directory,
+                                   const QString &fileName)
+{
+    return std::make_shared<File>(directory, fileName);
+}
+
+void LogWriter::append(const FilePtr &file, const QString &line)
+{
+    this->appendRaw(file, line.toUtf8());
+}
+
+void LogWriter::appendRaw(const FilePtr &file, const QByteArray &data)
+{
+    std::unique_lock lock(this->mutex_);
+    auto wake = this->queue(file, data);
+    lock.unlock();
+
+    if (wake)
+    {
+        this->wake_.notify_one();
+    }
+}
+
+void LogWriter::appendCompressed(const FilePtr &file, CompressedLogEntry entry)
+{
+    std::unique_lock lock(this->mutex_);
+    file->block.add(std::move(entry));
+    if (!file->hasBlock)
+    {
+        file->hasBlock = true;
+        this->blocks_.push_back(file);
+    }
+    if (!file->block.isFull(this->maxBlockAge_))
+    {
+        return;
+    }
+
+    auto wake = this->queueBlock(file);
+    lock.unlock();
+
+    if (wake)
+    {
+        this->wake_.notify_one();
+    }
+}
+
+void LogWriter::close(const FilePtr &file)
+{
+    std::lock_guard lock(this->mutex_);
+    if (!file->block.empty())
+    {
+        this->queueBlock(file);
+    }
+    file->closing = true;
+    this->markDirty(file);
+}
+
+bool LogWriter::queue(const FilePtr &file, const QByteArray &data,
+                      std::size_t lines)
+{
+    auto size = static_cast<std::size_t>(data.size());
+    if (this->pendingBytes_ + size > MAX_PENDING_BYTES)
+    {
+        DebugCount::increase("dropped log lines",
+                             static_cast<int64_t>(lines));
+        return false;
+    }
+
+    file->pending.append(data);
+    file->pendingLines += lines;
+    this->pendingBytes_ += size;
+    this->markDirty(file);
+    DebugCount::increase("queued log lines", static_cast<int64_t>(lines));
+    return this->pendingBytes_ >= FLUSH_THRESHOLD;
+}
+
+bool LogWriter::queueBlock(const FilePtr &file)
+{
+    // A dropped block loses all of its entries
+    auto lines = file->block.size();
+    return this->queue(file, file->block.finish(), lines);
+}
+
+void LogWriter::finishBlocks(bool all)
+{
+    std::erase_if(this->blocks_, [&](const FilePtr &file) {
+        if (!file->block.empty())
+        {
+            if (!all && !file->block.isFull(this->maxBlockAge_))
+            {
+                return false;
+            }
+            this->queueBlock(file);
+        }
+        file->hasBlock = false;
+        return true;
+    });
+}
+
+void LogWriter::markDirty(const FilePtr &file)
+{
+    if (!file->dirty)
+    {
+        file->dirty = true;
+        this->dirty_.push_back(file);
+    }
+}
+
+void LogWriter::run()
+{
+    std::vector<Batch> batches;
+
+    std::unique_lock lock(this->mutex_);
+    while (true)
+    {
+        this->wake_.wait_for(lock, FLUSH_INTERVAL, [this] {
+            return this->stopping_ || this->pendingBytes_ >= FLUSH_THRESHOLD;
+        });
+        this->finishBlocks(this->stopping_);
+
+        if (this->dirty_.empty())
+        {
+            if (this->stopping_)
+            {
+                break;
+            }
+            continue;
+        }
+
+        for (auto &file : this->dirty_)
+        {
+            batches.push_back({
+                .file = file,
+                .data = std::exchange(file->pending, {}),
+                .lines = std::exchange(file->pendingLines, 0),
+                .close = file->closing,
+            });
+            file->dirty = false;
+        }
+        this->dirty_.clear();
+        this->pendingBytes_ = 0;
+        lock.unlock();
+
+        for (auto &batch : batches)
+        {
+            auto &file = *batch.file;
+            if (!file.handle.isOpen() && !file.openFailed &&
+                !batch.data.isEmpty())
+            {
+                if (QDir().mkpath(file.directory))
+                {
+                    auto path = file.directory + QDir::separator() +
+                                file.fileName;
+                    if (file.fileName.endsWith(COMPRESSED_LOG_SUFFIX))
+                    {
+                        dropIncompleteBlock(path);
+                    }
+                    file.handle.setFileName(path);
+                    file.openFailed = !file.handle.open(QIODevice::Append);
+                }
+                else
+                {
+                    file.openFailed = true;
+                }
+
+                if (file.openFailed)
+                {
+                    qCWarning(chatterinoHelper)
+                        << "Unable to open log file" << file.fileName << "in"
+                        << file.directory;
+                }
+            }
+
+            if (file.handle.isOpen())
+            {
+                file.handle.write(batch.data);
+                file.handle.flush();
+            }
+            if (batch.close)
+            {
+                file.handle.close();
+            }
+
+            DebugCount::decrease("queued log lines",
+                                 static_cast<int64_t>(batch.lines));
+        }
+        batches.clear();
+
+        lock.lock();
+    }
+}
+
+}  // namespace chatterino
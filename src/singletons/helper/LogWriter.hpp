@@ -0,0 +1,99 @@
+#pragma once
+
+#include "singletons/helper/CompressedLog.hpp"
+
+#include <QByteArray>
+#include <QString>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chatterino {
+
+/// LogWriter writes chat logs to disk on a dedicated thread.
+///
+/// Lines are buffered per file and written in batches (group commit): each
+/// file is written to and flushed at most once per FLUSH_INTERVAL, or earlier
+/// if more than FLUSH_THRESHOLD bytes are waiting. If the writer falls behind
+/// by more than MAX_PENDING_BYTES, new lines are dropped.
+///
+/// Compressed logs are collected in blocks per file (see CompressedLog.hpp).
+/// A block is written once it's full, or by the writer thread once it's
+/// older than the maximum block age, so a quiet channel doesn't keep its
+/// last messages in memory.
+///
+/// Destroying the writer writes all lines that are still queued.
+class LogWriter
+{
+public:
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{500};
+    static constexpr std::size_t FLUSH_THRESHOLD = 64 * 1024;
+    static constexpr std::size_t MAX_PENDING_BYTES = 16 * 1024 * 1024;
+
+    /// A log file lines can be appended to
+    class File;
+    using FilePtr = std::shared_ptr<File>;
+
+    /// @param maxBlockAge The age after which compressed blocks are written
+    ///                    even if they aren't full
+    explicit LogWriter(
+        std::chrono::milliseconds maxBlockAge = CompressedLogBlock::MAX_AGE);
+    ~LogWriter();
+
+    LogWriter(const LogWriter &) = delete;
+    LogWriter &operator=(const LogWriter &) = delete;
+    LogWriter(LogWriter &&) = delete;
+    LogWriter &operator=(LogWriter &&) = delete;
+
+    /// Returns a handle to the file `fileName` in `directory`.
+    ///
+    /// The directory is created and the file is opened for appending on the
+    /// writer thread once the first line is written.
+    FilePtr open(const QString &directory, const QString &fileName);
+
+    /// Queues `line` to be appended to `file`
+    void append(const FilePtr &file, const QString &line);
+    /// Queues `data` to be appended to `file` as is
+    void appendRaw(const FilePtr &file, const QByteArray &data);
+    /// Adds `entry` to the compressed block of `file`
+    void appendCompressed(const FilePtr &file, CompressedLogEntry entry);
+
+    /// Closes `file` once all lines appended to it have been written
+    void close(const FilePtr &file);
+
+private:
+    struct Batch;
+
+    void run();
+    void markDirty(const FilePtr &file);
+    /// Queues `data` holding `lines` lines (the mutex must be held).
+    /// Returns true if the writer should be woken up.
+    bool queue(const FilePtr &file, const QByteArray &data,
+               std::size_t lines = 1);
+    /// Queues the compressed block of `file` and clears it (the mutex must
+    /// be held). Returns true if the writer should be woken up.
+    bool queueBlock(const FilePtr &file);
+    /// Queues the blocks that are full or too old, or all blocks if
+    /// `all` is set (the mutex must be held)
+    void finishBlocks(bool all);
+
+    const std::chrono::milliseconds maxBlockAge_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    /// Files with queued lines or waiting to be closed
+    std::vector<FilePtr> dirty_;
+    /// Files that might have entries in their compressed block
+    std::vector<FilePtr> blocks_;
+    std::size_t pendingBytes_ = 0;
+    bool stopping_ = false;
+
+    std::unique_ptr<std::thread> thread_;
+};
+
+}  // namespace chatterino
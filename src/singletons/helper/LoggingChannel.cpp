@@ -14,15 +14,6 @@ namespace {
 
 const QByteArray ENDLINE("\n");
 
-void appendLine(QFile &fileHandle, const QString &line)
-{
-    assert(fileHandle.isOpen());
-    assert(fileHandle.isWritable());
-
-    fileHandle.write(line.toUtf8());
-    fileHandle.flush();
-}
-
 QString generateOpeningString(
     const QDateTime &now = QDateTime::currentDateTime())
 {
@@ -56,9 +47,12 @@ QString generateDateString(const QDateTime &now)
 
 namespace chatterino {
 
-LoggingChannel::LoggingChannel(QString _channelName, QString _platform)
+LoggingChannel::LoggingChannel(QString _channelName, QString _platform,
+                               bool _compressed, LogWriter &writer)
     : channelName(std::move(_channelName))
     , platform(std::move(_platform))
+    , compressed(_compressed)
+    , writer(writer)
 {
     if (this->channelName.startsWith("/whispers"))
     {
@@ -96,9 +90,18 @@ LoggingChannel::LoggingChannel(QString _channelName, QString _platform)
 
 LoggingChannel::~LoggingChannel()
 {
-    appendLine(this->fileHandle, generateClosingString());
-    this->fileHandle.close();
-    this->currentStreamFileHandle.close();
+    if (this->file)
+    {
+        if (!this->compressed)
+        {
+            this->writer.append(this->file, generateClosingString());
+        }
+        this->writer.close(this->file);
+    }
+    if (this->currentStreamFile)
+    {
+        this->writer.close(this->currentStreamFile);
+    }
 }
 
 void LoggingChannel::openLogFile()
@@ -106,31 +109,27 @@ void LoggingChannel::openLogFile()
     QDateTime now = QDateTime::currentDateTime();
     this->dateString = generateDateString(now);
 
-    if (this->fileHandle.isOpen())
+    if (this->file)
     {
-        this->fileHandle.flush();
-        this->fileHandle.close();
+        this->writer.close(this->file);
     }
 
-    QString baseFileName = this->channelName + "-" + this->dateString + ".log";
+    QString baseFileName = this->channelName + "-" + this->dateString +
+                           (this->compressed ? COMPRESSED_LOG_SUFFIX.toString()
+                                             : QStringLiteral(".log"));
 
     QString directory =
         this->baseDirectory + QDir::separator() + this->subDirectory;
 
-    if (!QDir().mkpath(directory))
+    // The writer creates the directory and opens the file on its own thread
+    qCDebug(chatterinoHelper)
+        << "Logging to" << directory + QDir::separator() + baseFileName;
+    this->file = this->writer.open(directory, baseFileName);
+
+    if (!this->compressed)
     {
-        qCDebug(chatterinoHelper) << "Unable to create logging path";
-        return;
+        this->writer.append(this->file, generateOpeningString(now));
     }
-
-    // Open file handle to log file of current date
-    QString fileName = directory + QDir::separator() + baseFileName;
-    qCDebug(chatterinoHelper) << "Logging to" << fileName;
-    this->fileHandle.setFileName(fileName);
-
-    this->fileHandle.open(QIODevice::Append);
-
-    appendLine(this->fileHandle, generateOpeningString(now));
 }
 
 void LoggingChannel::openStreamLogFile(const QString &streamID)
@@ -138,29 +137,27 @@ void LoggingChannel::openStreamLogFile(const QString &streamID)
     QDateTime now = QDateTime::currentDateTime();
     this->currentStreamID = streamID;
 
-    if (this->currentStreamFileHandle.isOpen())
+    if (this->currentStreamFile)
     {
-        this->currentStreamFileHandle.flush();
-        this->currentStreamFileHandle.close();
+        this->writer.close(this->currentStreamFile);
     }
 
-    QString baseFileName = this->channelName + "-" + streamID + ".log";
+    QString baseFileName = this->channelName + "-" + streamID +
+                           (this->compressed ? COMPRESSED_LOG_SUFFIX.toString()
+                                             : QStringLiteral(".log"));
 
     QString directory =
         this->baseDirectory + QDir::separator() + this->subDirectory;
 
-    if (!QDir().mkpath(directory))
+    qCDebug(chatterinoHelper)
+        << "Logging stream to" << directory + QDir::separator() + baseFileName;
+    this->currentStreamFile = this->writer.open(directory, baseFileName);
+
+    if (!this->compressed)
     {
-        qCDebug(chatterinoHelper) << "Unable to create logging path";
-        return;
+        this->writer.append(this->currentStreamFile,
+                            generateOpeningString(now));
     }
-
-    QString fileName = directory + QDir::separator() + baseFileName;
-    qCDebug(chatterinoHelper) << "Logging stream to" << fileName;
-    this->currentStreamFileHandle.setFileName(fileName);
-
-    this->currentStreamFileHandle.open(QIODevice::Append);
-    appendLine(this->currentStreamFileHandle, generateOpeningString(now));
 }
 
 void LoggingChannel::addMessage(const MessagePtr &message,
@@ -243,7 +240,7 @@ void LoggingChannel::addMessage(const MessagePtr &message,
     str.append(messageText);
     str.append(ENDLINE);
 
-    appendLine(this->fileHandle, str);
+    this->write(this->file, str, message, messageTimestamp);
 
     if (!streamID.isEmpty() && getSettings()->separatelyStoreStreamLogs)
     {
@@ -252,8 +249,27 @@ void LoggingChannel::addMessage(const MessagePtr &message,
             this->openStreamLogFile(streamID);
         }
 
-        appendLine(this->currentStreamFileHandle, str);
+        this->write(this->currentStreamFile, str, message, messageTimestamp);
     }
 }
 
+void LoggingChannel::write(const LogWriter::FilePtr &target,
+                           const QString &line, const MessagePtr &message,
+                           const QDateTime &timestamp)
+{
+    if (!this->compressed)
+    {
+        this->writer.append(target, line);
+        return;
+    }
+
+    this->writer.appendCompressed(target,
+                                  {
+                                      .timestamp = timestamp,
+                                      .userID = message->userID,
+                                      .loginName = message->loginName,
+                                      .text = line.chopped(ENDLINE.size()),
+                                  });
+}
+
 }  // namespace chatterino
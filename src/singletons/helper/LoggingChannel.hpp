@@ -1,6 +1,7 @@
 #pragma once
 
-#include <QFile>
+#include "singletons/helper/LogWriter.hpp"
+
 #include <QString>
 
 #include <memory>
@@ -13,7 +14,8 @@ using MessagePtr = std::shared_ptr<const Message>;
 
 class LoggingChannel
 {
-    explicit LoggingChannel(QString _channelName, QString _platform);
+    explicit LoggingChannel(QString _channelName, QString _platform,
+                            bool _compressed, LogWriter &writer);
 
 public:
     ~LoggingChannel();
@@ -30,13 +32,22 @@ private:
     void openLogFile();
     void openStreamLogFile(const QString &streamID);
 
+    /// Writes `line` to `target`. Compressed logs are collected in blocks by
+    /// the writer.
+    void write(const LogWriter::FilePtr &target, const QString &line,
+               const MessagePtr &message, const QDateTime &timestamp);
+
     const QString channelName;
     const QString platform;
+    /// Whether this channel is logged in the compressed format (see
+    /// CompressedLog.hpp) instead of plain text
+    const bool compressed;
+    LogWriter &writer;
     QString baseDirectory;
     QString subDirectory;
 
-    QFile fileHandle;
-    QFile currentStreamFileHandle;
+    LogWriter::FilePtr file;
+    LogWriter::FilePtr currentStreamFile;
     QString currentStreamID;
 
     QString dateString;
@@ -0,0 +1,141 @@
+#include "util/AhoCorasick.hpp"
+
+#include <algorithm>
+#include <queue>
+
+namespace chatterino {
+
+void AhoCorasick::addPattern(QStringView pattern, std::size_t id)
+{
+    if (pattern.isEmpty())
+    {
+        return;
+    }
+
+    std::uint32_t node = 0;
+    for (auto qc : pattern)
+    {
+        auto c = qc.unicode();
+        auto &next = this->nodes_[node].next;
+        auto it = std::find_if(next.begin(), next.end(), [c](const auto &kv) {
+            return kv.first == c;
+        });
+        if (it != next.end())
+        {
+            node = it->second;
+            continue;
+        }
+
+        auto created = static_cast<std::uint32_t>(this->nodes_.size());
+        // `next` is invalidated by the push_back below
+        this->nodes_[node].next.emplace_back(c, created);
+        this->nodes_.emplace_back();
+        node = created;
+    }
+
+    this->nodes_[node].outputs.push_back(
+        static_cast<std::uint32_t>(this->patterns_.size()));
+    this->patterns_.push_back({id, pattern.size()});
+}
+
+void AhoCorasick::build()
+{
+    for (auto &node : this->nodes_)
+    {
+        std::sort(node.next.begin(), node.next.end());
+    }
+
+    // Breadth-first, so the failure target of a node is always processed
+    // before the node itself
+    std::queue<std::uint32_t> queue;
+    for (const auto &[c, child] : this->nodes_[0].next)
+    {
+        this->nodes_[child].fail = 0;
+        queue.push(child);
+    }
+
+    while (!queue.empty())
+    {
+        auto parent = queue.front();
+        queue.pop();
+
+        for (const auto &[c, child] : this->nodes_[parent].next)
+        {
+            auto fail = this->nodes_[parent].fail;
+            while (fail != 0 && this->child(fail, c) == NONE)
+            {
+                fail = this->nodes_[fail].fail;
+            }
+            auto target = this->child(fail, c);
+            if (target == NONE || target == child)
+            {
+                target = 0;
+            }
+
+            auto &node = this->nodes_[child];
+            node.fail = target;
+            node.outputLink = this->nodes_[target].outputs.empty()
+                                  ? this->nodes_[target].outputLink
+                                  : target;
+            queue.push(child);
+        }
+    }
+}
+
+bool AhoCorasick::empty() const
+{
+    return this->patterns_.empty();
+}
+
+bool AhoCorasick::containsAny(QStringView text) const
+{
+    if (this->empty())
+    {
+        return false;
+    }
+
+    std::uint32_t state = 0;
+    for (auto c : text)
+    {
+        state = this->step(state, c.unicode());
+        const auto &node = this->nodes_[state];
+        if (!node.outputs.empty() || node.outputLink != NONE)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint32_t AhoCorasick::child(std::uint32_t node, char16_t c) const
+{
+    const auto &next = this->nodes_[node].next;
+    auto it = std::lower_bound(next.begin(), next.end(), c,
+                               [](const auto &kv, char16_t value) {
+                                   return kv.first < value;
+                               });
+    if (it == next.end() || it->first != c)
+    {
+        return NONE;
+    }
+    return it->second;
+}
+
+std::uint32_t AhoCorasick::step(std::uint32_t state, char16_t c) const
+{
+    while (true)
+    {
+        auto next = this->child(state, c);
+        if (next != NONE)
+        {
+            return next;
+        }
+        if (state == 0)
+        {
+            return 0;
+        }
+        state = this->nodes_[state].fail;
+    }
+}
+
+}  // namespace chatterino
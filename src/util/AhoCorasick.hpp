@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QString>
+#include <QStringView>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/// AhoCorasick finds all occurrences of a set of literal patterns in a single
+/// pass over a text.
+///
+/// Patterns and text are compared code unit by code unit. For
+/// case-insensitive matching, both should be folded first
+/// (QString::toCaseFolded).
+///
+/// Usage:
+///   AhoCorasick matcher;
+///   matcher.addPattern(u"foo", 0);
+///   matcher.addPattern(u"bar", 1);
+///   matcher.build();
+///   matcher.findAll(text, [](const AhoCorasick::Match &match) { ... });
+class AhoCorasick
+{
+public:
+    struct Match {
+        /// The id the pattern was added with
+        std::size_t id;
+        /// Start of the match in the text
+        qsizetype start;
+        /// Length of the match (equal to the length of the pattern)
+        qsizetype length;
+    };
+
+    /// Adds a pattern that's reported as `id` when found.
+    ///
+    /// Empty patterns are ignored. Must not be called after build().
+    void addPattern(QStringView pattern, std::size_t id);
+
+    /// Computes the failure links. Must be called after all patterns were
+    /// added and before searching.
+    void build();
+
+    /// Returns true if no pattern was added
+    bool empty() const;
+
+    /// Calls `callback(match)` for every occurrence of every pattern in
+    /// `text`, including overlapping ones. Matches are reported in order of
+    /// their end position.
+    template <typename Callback>
+    void findAll(QStringView text, Callback &&callback) const
+    {
+        if (this->empty())
+        {
+            return;
+        }
+
+        std::uint32_t state = 0;
+        for (qsizetype i = 0; i < text.size(); i++)
+        {
+            state = this->step(state, text[i].unicode());
+
+            auto output = this->nodes_[state].outputs.empty()
+                              ? this->nodes_[state].outputLink
+                              : state;
+            while (output != NONE)
+            {
+                const auto &node = this->nodes_[output];
+                for (auto patternIdx : node.outputs)
+                {
+                    const auto &pattern = this->patterns_[patternIdx];
+                    callback(Match{
+                        .id = pattern.id,
+                        .start = i + 1 - pattern.length,
+                        .length = pattern.length,
+                    });
+                }
+                output = node.outputLink;
+            }
+        }
+    }
+
+    /// Returns true if any pattern occurs in `text`
+    bool containsAny(QStringView text) const;
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    struct Node {
+        /// Transitions, sorted by code unit after build()
+        std::vector<std::pair<char16_t, std::uint32_t>> next;
+        std::uint32_t fail = 0;
+        /// Closest node on the failure chain that has outputs
+        std::uint32_t outputLink = NONE;
+        /// Indices into patterns_ of the patterns ending in this node
+        std::vector<std::uint32_t> outputs;
+    };
+
+    struct Pattern {
+        std::size_t id;
+        qsizetype length;
+    };
+
+    std::uint32_t child(std::uint32_t node, char16_t c) const;
+    std::uint32_t step(std::uint32_t state, char16_t c) const;
+
+    std::vector<Node> nodes_{Node{}};
+    std::vector<Pattern> patterns_;
+};
+
+}  // namespace chatterino
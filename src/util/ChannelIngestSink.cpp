@@ -0,0 +1,179 @@
+#include "util/ChannelIngestSink.hpp"
+
+#include "common/Channel.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "messages/Message.hpp"
+#include "singletons/Settings.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace chatterino {
+
+ChannelIngestSink::ChannelIngestSink(Channel &channel)
+    : channel_(channel)
+{
+}
+
+ChannelIngestSink::~ChannelIngestSink() = default;
+
+void ChannelIngestSink::addMessage(MessagePtr message, MessageContext ctx,
+                                   std::optional<MessageFlags> overridingFlags)
+{
+    {
+        std::lock_guard lock(this->pendingMutex_);
+        this->pending_.push_back(message);
+    }
+
+    this->changes_.emplace_back([this, message = std::move(message), ctx,
+                                 overridingFlags]() mutable {
+        this->batch_.push_back({
+            .message = std::move(message),
+            .ctx = ctx,
+            .overridingFlags = overridingFlags,
+        });
+    });
+}
+
+void ChannelIngestSink::addOrReplaceTimeout(MessagePtr clearchatMessage,
+                                            const QDateTime &now)
+{
+    this->changes_.emplace_back(
+        [this, message = std::move(clearchatMessage), now]() mutable {
+            this->commit();
+            this->channel_.addOrReplaceTimeout(std::move(message), now);
+        });
+}
+
+void ChannelIngestSink::addOrReplaceClearChat(MessagePtr clearchatMessage,
+                                              const QDateTime &now)
+{
+    this->changes_.emplace_back(
+        [this, message = std::move(clearchatMessage), now]() mutable {
+            this->commit();
+            this->channel_.addOrReplaceClearChat(std::move(message), now);
+        });
+}
+
+void ChannelIngestSink::disableAllMessages()
+{
+    this->changes_.emplace_back([this] {
+        this->commit();
+        this->channel_.disableAllMessages();
+    });
+}
+
+void ChannelIngestSink::applySimilarityFilters(const MessagePtr &message) const
+{
+    std::vector<MessagePtr> pending;
+    {
+        std::lock_guard lock(this->pendingMutex_);
+        pending.assign(this->pending_.begin(), this->pending_.end());
+    }
+
+    if (pending.empty())
+    {
+        this->channel_.applySimilarityFilters(message);
+        return;
+    }
+
+    // The pending messages come after the ones in the channel
+    auto snapshot = this->channel_.getMessageSnapshot();
+    auto fromChannel = std::min<size_t>(
+        snapshot.size(),
+        static_cast<size_t>(std::max(
+            0, getSettings()->hideSimilarMaxMessagesToCheck.getValue())));
+
+    std::vector<MessagePtr> recent;
+    recent.reserve(fromChannel + pending.size());
+    for (size_t i = snapshot.size() - fromChannel; i < snapshot.size(); i++)
+    {
+        recent.push_back(snapshot[i]);
+    }
+    std::ranges::move(pending, std::back_inserter(recent));
+
+    setSimilarityFlags(message, recent, this->similarityCache_);
+}
+
+MessagePtr ChannelIngestSink::findMessageByID(QStringView id)
+{
+    {
+        std::lock_guard lock(this->pendingMutex_);
+        auto it = std::find_if(this->pending_.rbegin(), this->pending_.rend(),
+                               [&](const MessagePtr &message) {
+                                   return message->id == id;
+                               });
+        if (it != this->pending_.rend())
+        {
+            return *it;
+        }
+    }
+
+    return this->channel_.findMessageByID(id);
+}
+
+MessageSinkTraits ChannelIngestSink::sinkTraits() const
+{
+    return this->channel_.sinkTraits();
+}
+
+void ChannelIngestSink::runSideEffect(std::function<void()> fn)
+{
+    // Side effects may look at the channel's messages
+    this->changes_.emplace_back([this, fn = std::move(fn)] {
+        this->commit();
+        fn();
+    });
+}
+
+MessageIngest::Apply ChannelIngestSink::takeChanges()
+{
+    if (this->changes_.empty())
+    {
+        return {};
+    }
+
+    return [changes = std::exchange(this->changes_, {})] {
+        for (const auto &change : changes)
+        {
+            change();
+        }
+    };
+}
+
+void ChannelIngestSink::commit()
+{
+    assertInGuiThread();
+
+    auto batch = std::exchange(this->batch_, {});
+    auto it = batch.begin();
+    while (it != batch.end())
+    {
+        // Messages with the same context and flags are added together
+        auto last = std::find_if(it, batch.end(), [&](const Batched &entry) {
+            return entry.ctx != it->ctx ||
+                   entry.overridingFlags != it->overridingFlags;
+        });
+
+        std::vector<MessagePtr> messages;
+        messages.reserve(static_cast<size_t>(std::distance(it, last)));
+        for (auto entry = it; entry != last; entry++)
+        {
+            messages.push_back(std::move(entry->message));
+        }
+        this->channel_.addMessages(messages, it->ctx, it->overridingFlags);
+        it = last;
+    }
+
+    if (!batch.empty())
+    {
+        std::lock_guard lock(this->pendingMutex_);
+        // Changes are applied in order, so these are the oldest messages
+        this->pending_.erase(
+            this->pending_.begin(),
+            this->pending_.begin() + static_cast<ptrdiff_t>(batch.size()));
+    }
+}
+
+}  // namespace chatterino
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "messages/MessageIngest.hpp"
+#include "messages/MessageSimilarity.hpp"
+#include "messages/MessageSink.hpp"
+
+#include <QDateTime>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+class Channel;
+
+/// @brief Sink used to build the messages of a channel on a worker thread
+///
+/// Changes to the channel are recorded and applied in the GUI thread by the
+/// function returned from takeChanges(). Until then, added messages can
+/// still be found and compared to (findMessageByID and
+/// applySimilarityFilters).
+///
+/// Messages are added to the channel in batches: the owner calls commit()
+/// once all results of a MessageIngest::flush are applied (see
+/// MessageIngest::setAfterFlush), so the messages are added with one
+/// Channel::addMessages and views only update once for them. Other changes
+/// (timeouts, clears and side effects) commit the messages before them
+/// first.
+///
+/// Owned by the channel. Only one thread may build messages with it at a
+/// time (jobs of a MessageIngest run one after another).
+class ChannelIngestSink final : public MessageSink
+{
+public:
+    explicit ChannelIngestSink(Channel &channel);
+    ~ChannelIngestSink() override;
+
+    ChannelIngestSink(const ChannelIngestSink &) = delete;
+    ChannelIngestSink(ChannelIngestSink &&) = delete;
+    ChannelIngestSink &operator=(const ChannelIngestSink &) = delete;
+    ChannelIngestSink &operator=(ChannelIngestSink &&) = delete;
+
+    void addMessage(
+        MessagePtr message, MessageContext ctx,
+        std::optional<MessageFlags> overridingFlags = std::nullopt) override;
+    void addOrReplaceTimeout(MessagePtr clearchatMessage,
+                             const QDateTime &now) override;
+    void addOrReplaceClearChat(MessagePtr clearchatMessage,
+                               const QDateTime &now) override;
+
+    void disableAllMessages() override;
+
+    void applySimilarityFilters(const MessagePtr &message) const override;
+
+    MessagePtr findMessageByID(QStringView id) override;
+
+    MessageSinkTraits sinkTraits() const override;
+
+    void runSideEffect(std::function<void()> fn) override;
+
+    /// @brief Returns the changes recorded since the last call
+    ///
+    /// The returned function has to run in the GUI thread while the channel
+    /// is alive.
+    MessageIngest::Apply takeChanges();
+
+    /// Adds the batched messages to the channel (only in the GUI thread)
+    void commit();
+
+private:
+    struct Batched {
+        MessagePtr message;
+        MessageContext ctx;
+        std::optional<MessageFlags> overridingFlags;
+    };
+
+    Channel &channel_;
+    std::vector<std::function<void()>> changes_;
+
+    /// Messages of applied changes waiting for commit() (GUI thread only)
+    std::vector<Batched> batch_;
+
+    /// Added messages that are not in the channel yet
+    mutable std::mutex pendingMutex_;
+    std::deque<MessagePtr> pending_;
+
+    mutable MessageSimilarityCache similarityCache_;
+};
+
+}  // namespace chatterino
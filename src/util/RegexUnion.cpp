@@ -0,0 +1,120 @@
+#include "util/RegexUnion.hpp"
+
+#include "common/QLogging.hpp"
+
+namespace {
+
+/// Constructs whose meaning depends on the rest of the pattern or on group
+/// numbering:
+///  - backreferences and subroutine calls (\1, \g, \k, (?P=, (?P>, (?&, (?R,
+///    (?1)
+///  - named groups, which could collide between expressions
+///  - branch resets (?|
+///  - verbs like (*SKIP) or (*UTF)
+///  - \Q without a matching \E and \G
+///  - extended mode (?x, where a comment would swallow the closing group
+const QRegularExpression &uncombinableConstruct()
+{
+    static const QRegularExpression regex(
+        R"(\\[1-9gkKGQ]|\(\*|\(\?(?:P?<[A-Za-z_]|'|P[=>]|&|R|[+-]?\d|\||)"
+        R"([A-Za-z^-]*x))");
+    return regex;
+}
+
+}  // namespace
+
+namespace chatterino {
+
+RegexUnion::RegexUnion(QRegularExpression::PatternOptions options)
+    : options_(options)
+{
+}
+
+bool RegexUnion::canCombine(const QString &pattern)
+{
+    return !uncombinableConstruct().match(pattern).hasMatch();
+}
+
+bool RegexUnion::add(const QRegularExpression &regex, std::size_t id)
+{
+    if (!regex.isValid() || regex.pattern().isEmpty())
+    {
+        return false;
+    }
+
+    auto otherOptions = regex.patternOptions();
+    auto caseInsensitive =
+        otherOptions.testFlag(QRegularExpression::CaseInsensitiveOption);
+    otherOptions.setFlag(QRegularExpression::CaseInsensitiveOption, false);
+    if (otherOptions != this->options_ || !canCombine(regex.pattern()))
+    {
+        return false;
+    }
+
+    if (!this->pattern_.isEmpty())
+    {
+        this->pattern_ += u'|';
+    }
+    this->pattern_ += caseInsensitive ? QStringLiteral("((?i:")
+                                      : QStringLiteral("((?-i:");
+    this->pattern_ += regex.pattern();
+    this->pattern_ += QStringLiteral("))");
+
+    this->alternatives_.push_back({id, this->groupCount_ + 1});
+    this->groupCount_ += 1 + regex.captureCount();
+    return true;
+}
+
+void RegexUnion::build(std::vector<std::size_t> *rejected)
+{
+    this->regex_ = QRegularExpression(this->pattern_, this->options_);
+    if (this->alternatives_.empty() || this->regex_.isValid())
+    {
+        this->regex_.optimize();
+        return;
+    }
+
+    qCWarning(chatterinoApp)
+        << "Failed to combine" << this->alternatives_.size()
+        << "regular expressions:" << this->regex_.errorString();
+    if (rejected != nullptr)
+    {
+        for (const auto &alternative : this->alternatives_)
+        {
+            rejected->push_back(alternative.id);
+        }
+    }
+    this->alternatives_.clear();
+    this->pattern_.clear();
+}
+
+bool RegexUnion::empty() const
+{
+    return this->alternatives_.empty();
+}
+
+std::optional<std::size_t> RegexUnion::firstMatch(
+    const QString &subject) const
+{
+    if (this->empty())
+    {
+        return std::nullopt;
+    }
+
+    auto match = this->regex_.match(subject);
+    if (!match.hasMatch())
+    {
+        return std::nullopt;
+    }
+
+    for (const auto &alternative : this->alternatives_)
+    {
+        if (match.capturedStart(alternative.group) != -1)
+        {
+            return alternative.id;
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace chatterino
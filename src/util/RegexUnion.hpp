@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QRegularExpression>
+#include <QString>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace chatterino {
+
+/// RegexUnion combines many regular expressions into a single alternation, so
+/// a subject can be searched for all of them in one scan.
+///
+/// Every alternative is wrapped in its own capture group. The group that
+/// participated in a match tells which expression matched.
+///
+/// Not every expression can be combined without changing its meaning (e.g.
+/// ones using backreferences or named groups). add() rejects those, and the
+/// caller has to match them on their own.
+class RegexUnion
+{
+public:
+    /// @param options The options all combined expressions must share. Case
+    ///                sensitivity may differ per expression.
+    explicit RegexUnion(QRegularExpression::PatternOptions options =
+                            QRegularExpression::UseUnicodePropertiesOption);
+
+    /// Returns true if `pattern` can be part of an alternation without
+    /// changing what it matches
+    static bool canCombine(const QString &pattern);
+
+    /// Adds `regex` as an alternative that's reported as `id`.
+    ///
+    /// Returns false if the expression is invalid, can't be combined, or uses
+    /// options other than the ones of this union. Must not be called after
+    /// build().
+    bool add(const QRegularExpression &regex, std::size_t id);
+
+    /// Compiles the union. Must be called after all expressions were added.
+    ///
+    /// If the combined expression fails to compile, all alternatives are
+    /// dropped (empty() returns true) and `rejected` is filled with their ids.
+    void build(std::vector<std::size_t> *rejected = nullptr);
+
+    /// Returns true if no expression was combined
+    bool empty() const;
+
+    /// Returns the id of the expression with the leftmost match in `subject`,
+    /// or std::nullopt if none of the combined expressions match
+    std::optional<std::size_t> firstMatch(const QString &subject) const;
+
+    /// Calls `callback(id, match, group)` for each leftmost, non-overlapping
+    /// match in `subject`, where `group` is the capture group of the
+    /// alternative in `match`.
+    ///
+    /// Each match is reported for the first alternative that matched at its
+    /// position, so an expression whose matches are all shadowed by earlier
+    /// alternatives is not reported even though it would match on its own.
+    template <typename Callback>
+    void forEachMatch(const QString &subject, Callback &&callback) const
+    {
+        if (this->empty())
+        {
+            return;
+        }
+
+        auto it = this->regex_.globalMatch(subject);
+        while (it.hasNext())
+        {
+            auto match = it.next();
+            for (const auto &alternative : this->alternatives_)
+            {
+                if (match.capturedStart(alternative.group) != -1)
+                {
+                    callback(alternative.id, match, alternative.group);
+                    break;
+                }
+            }
+        }
+    }
+
+private:
+    struct Alternative {
+        std::size_t id;
+        /// The capture group wrapping the alternative in regex_
+        int group;
+    };
+
+    QRegularExpression::PatternOptions options_;
+    QString pattern_;
+    int groupCount_ = 0;
+    std::vector<Alternative> alternatives_;
+    QRegularExpression regex_;
+};
+
+}  // namespace chatterino
@@ -1,7 +1,9 @@
 #include "util/VectorMessageSink.hpp"
 
+#include "messages/Message.hpp"
 #include "messages/MessageSimilarity.hpp"
 #include "util/ChannelHelpers.hpp"
+#include "util/PostToThread.hpp"
 
 #include <cassert>
 
@@ -70,7 +72,7 @@ void VectorMessageSink::disableAllMessages()
 
 void VectorMessageSink::applySimilarityFilters(const MessagePtr &message) const
 {
-    setSimilarityFlags(message, this->messages_);
+    setSimilarityFlags(message, this->messages_, this->similarityCache_);
 }
 
 MessagePtr VectorMessageSink::findMessageByID(QStringView id)
@@ -100,4 +102,9 @@ MessageSinkTraits VectorMessageSink::sinkTraits() const
     return this->traits;
 }
 
+void VectorMessageSink::runSideEffect(std::function<void()> fn)
+{
+    runInGuiThread(std::move(fn));
+}
+
 }  // namespace chatterino
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "messages/MessageSimilarity.hpp"
 #include "messages/MessageSink.hpp"
 
 namespace chatterino {
@@ -27,11 +28,14 @@ public:
 
     MessageSinkTraits sinkTraits() const override;
 
+    void runSideEffect(std::function<void()> fn) override;
+
     const std::vector<MessagePtr> &messages() const;
     std::vector<MessagePtr> takeMessages() &&;
 
 private:
     std::vector<MessagePtr> messages_;
+    mutable MessageSimilarityCache similarityCache_;
     MessageFlags additionalFlags;
     MessageSinkTraits traits;
 };
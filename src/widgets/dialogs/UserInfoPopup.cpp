@@ -1007,7 +1007,7 @@ void UserInfoPopup::updateUserData()
             []() {});
 
         // get ignore state
-        bool isIgnoring = currentUser->blockedUserIds().contains(user.id);
+        bool isIgnoring = currentUser->isBlockedUserId(user.id);
 
         // get ignoreHighlights state
         bool isIgnoringHighlights = false;
@@ -13,6 +13,7 @@
 #include "messages/layouts/MessageLayout.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "messages/layouts/TextPreparation.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -24,6 +25,7 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
+#include "singletons/helper/FrameScheduler.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/StreamerMode.hpp"
@@ -425,7 +427,7 @@ void ChannelView::initializeSignals()
     this->signalHolder_.managedConnect(getApp()->getWindows()->wordFlagsChanged,
                                        [this] {
                                            this->queueLayout();
-                                           this->update();
+                                           this->queueUpdate();
                                        });
 
     getSettings()->showLastMessageIndicator.connect(
@@ -463,6 +465,27 @@ void ChannelView::initializeSignals()
             }
         });
 
+    this->signalHolder_.managedConnect(
+        getApp()->getWindows()->imagesLoaded,
+        [this](const std::unordered_set<const Image *> &images) {
+            auto &messages = this->getMessagesSnapshot();
+            bool anyWaiting = false;
+            for (size_t i = 0; i < messages.size(); i++)
+            {
+                if (messages[i]->isWaitingForAny(images))
+                {
+                    messages[i]->flags.set(MessageLayoutFlag::RequiresLayout);
+                    anyWaiting = true;
+                }
+            }
+
+            // Hidden views lay the messages out when they're shown
+            if (anyWaiting && this->isVisible())
+            {
+                this->queueLayout();
+            }
+        });
+
     this->signalHolder_.managedConnect(getApp()->getFonts()->fontChanged,
                                        [this] {
                                            this->queueLayout();
@@ -647,31 +670,26 @@ void ChannelView::scaleChangedEvent(float scale)
 
 void ChannelView::queueUpdate()
 {
-    this->update();
+    getApp()->getWindows()->getFrameScheduler().requestUpdate(this);
 }
 
 void ChannelView::queueUpdate(const QRect &area)
 {
-    this->update(area);
+    getApp()->getWindows()->getFrameScheduler().requestUpdate(this, area);
 }
 
 void ChannelView::invalidateBuffers()
 {
     this->bufferInvalidationQueued_ = true;
     this->queueLayout();
-    this->update();
+    this->queueUpdate();
 }
 
 void ChannelView::queueLayout()
 {
-    if (this->isVisible())
-    {
-        this->performLayout();
-    }
-    else
-    {
-        this->layoutQueued_ = true;
-    }
+    // Hidden views lay out their messages once they're shown
+    this->layoutQueued_ = true;
+    getApp()->getWindows()->getFrameScheduler().requestLayout(this);
 }
 
 void ChannelView::showEvent(QShowEvent * /*event*/)
@@ -701,6 +719,11 @@ void ChannelView::performLayout(bool causedByScrollbar, bool causedByShow)
     /// Update scrollbar
     this->updateScrollbar(messages, causedByScrollbar, causedByShow);
 
+    /// Measure the text of the other messages in the background, so the next
+    /// relayout (e.g. when resizing) is cheaper
+    getApp()->getWindows()->getTextPreparation().prepare(messages,
+                                                         this->scale());
+
     this->goToBottom_->setVisible(this->enableScrollingToBottom_ &&
                                   this->scrollBar_->isVisible() &&
                                   !this->scrollBar_->isAtBottom());
@@ -731,6 +754,7 @@ void ChannelView::layoutVisibleMessages(
                     .scale = this->scale(),
                     .imageScale = this->scale() *
                                   static_cast<float>(this->devicePixelRatio()),
+                    .imagePriority = this->imagePriority_,
                 },
                 this->bufferInvalidationQueued_);
 
@@ -774,6 +798,8 @@ void ChannelView::updateScrollbar(
                 .scale = this->scale(),
                 .imageScale = this->scale() *
                               static_cast<float>(this->devicePixelRatio()),
+                // These messages might be above the visible ones
+                .imagePriority = ImagePriority::Prefetch,
             },
             false);
 
@@ -906,6 +932,11 @@ void ChannelView::setOverrideFlags(std::optional<MessageElementFlags> value)
     this->overrideFlags_ = value;
 }
 
+void ChannelView::setImagePriority(ImagePriority priority)
+{
+    this->imagePriority_ = priority;
+}
+
 const std::optional<MessageElementFlags> &ChannelView::getOverrideFlags() const
 {
     return this->overrideFlags_;
@@ -957,25 +988,32 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
     //
 
     this->channelConnections_.managedConnect(
-        underlyingChannel->messageAppended,
-        [this](MessagePtr &message,
+        underlyingChannel->messagesAppended,
+        [this](std::span<const MessagePtr> messages,
                std::optional<MessageFlags> overridingFlags) {
-            if (this->shouldIncludeMessage(message))
+            std::vector<MessagePtr> filtered;
+            std::copy_if(messages.begin(), messages.end(),
+                         std::back_inserter(filtered), [this](const auto &msg) {
+                             return this->shouldIncludeMessage(msg);
+                         });
+            if (filtered.empty())
             {
-                if (this->channel_->lastDate_ != QDate::currentDate())
-                {
-                    // Day change message
-                    this->channel_->lastDate_ = QDate::currentDate();
-                    auto msg = makeSystemMessage(
-                        QLocale().toString(QDate::currentDate(),
-                                           QLocale::LongFormat),
-                        QTime(0, 0));
-                    msg->flags.set(MessageFlag::DoNotLog);
-                    this->channel_->addMessage(msg, MessageContext::Original);
-                }
-                this->channel_->addMessage(message, MessageContext::Repost,
-                                           overridingFlags);
+                return;
+            }
+
+            if (this->channel_->lastDate_ != QDate::currentDate())
+            {
+                // Day change message
+                this->channel_->lastDate_ = QDate::currentDate();
+                auto msg = makeSystemMessage(
+                    QLocale().toString(QDate::currentDate(),
+                                       QLocale::LongFormat),
+                    QTime(0, 0));
+                msg->flags.set(MessageFlag::DoNotLog);
+                this->channel_->addMessage(msg, MessageContext::Original);
             }
+            this->channel_->addMessages(filtered, MessageContext::Repost,
+                                        overridingFlags);
         });
 
     this->channelConnections_.managedConnect(
@@ -1064,10 +1102,10 @@ void ChannelView::setChannel(const ChannelPtr &underlyingChannel)
 
     // on new message
     this->channelConnections_.managedConnect(
-        this->channel_->messageAppended,
-        [this](MessagePtr &message,
+        this->channel_->messagesAppended,
+        [this](std::span<const MessagePtr> messages,
                std::optional<MessageFlags> overridingFlags) {
-            this->messageAppended(message, overridingFlags);
+            this->messagesAppended(messages, overridingFlags);
         });
 
     this->channelConnections_.managedConnect(
@@ -1170,77 +1208,98 @@ bool ChannelView::hasSourceChannel() const
     return this->sourceChannel_ != nullptr;
 }
 
-void ChannelView::messageAppended(MessagePtr &message,
-                                  std::optional<MessageFlags> overridingFlags)
+void ChannelView::messagesAppended(std::span<const MessagePtr> messages,
+                                   std::optional<MessageFlags> overridingFlags)
 {
-    auto *messageFlags = &message->flags;
-    if (overridingFlags)
+    if (messages.empty())
     {
-        messageFlags = &*overridingFlags;
+        return;
     }
 
-    auto messageRef = std::make_shared<MessageLayout>(message);
-
-    if (this->lastMessageHasAlternateBackground_)
+    std::vector<MessageLayoutPtr> layouts;
+    layouts.reserve(messages.size());
+    for (const auto &message : messages)
     {
-        messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
-    }
-    if (this->channel_->shouldIgnoreHighlights())
-    {
-        messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        auto layout = std::make_shared<MessageLayout>(message);
+
+        if (this->lastMessageHasAlternateBackground_)
+        {
+            layout->flags.set(MessageLayoutFlag::AlternateBackground);
+        }
+        if (this->channel_->shouldIgnoreHighlights())
+        {
+            layout->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        }
+        this->lastMessageHasAlternateBackground_ =
+            !this->lastMessageHasAlternateBackground_;
+
+        layouts.push_back(std::move(layout));
     }
-    this->lastMessageHasAlternateBackground_ =
-        !this->lastMessageHasAlternateBackground_;
 
     if (this->paused())
     {
-        this->pauseScrollMaximumOffset_++;
+        this->pauseScrollMaximumOffset_ += static_cast<int>(layouts.size());
     }
     else
     {
-        this->scrollBar_->offsetMaximum(1);
+        this->scrollBar_->offsetMaximum(qreal(layouts.size()));
     }
 
-    if (this->messages_.pushBack(messageRef))
+    auto removed = this->messages_.pushBack(layouts);
+    if (removed > 0)
     {
         if (this->paused())
         {
-            this->pauseScrollMinimumOffset_++;
-            this->pauseSelectionOffset_++;
+            this->pauseScrollMinimumOffset_ += static_cast<int>(removed);
+            this->pauseSelectionOffset_ += static_cast<uint32_t>(removed);
         }
         else
         {
-            this->scrollBar_->offsetMinimum(1);
+            this->scrollBar_->offsetMinimum(qreal(removed));
             if (this->showingLatestMessages_ && !this->isVisible())
             {
                 this->scrollBar_->scrollToBottom(false);
             }
-            this->selection_.shiftMessageIndex(1);
-            this->doubleClickSelection_.shiftMessageIndex(1);
+            this->selection_.shiftMessageIndex(removed);
+            this->doubleClickSelection_.shiftMessageIndex(removed);
         }
     }
 
-    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
+    // Request the tab highlight once for the whole batch
+    std::optional<HighlightState> tabHighlight;
+    for (const auto &message : messages)
     {
-        if ((messageFlags->has(MessageFlag::Highlighted) &&
-             messageFlags->has(MessageFlag::ShowInMentions) &&
-             !messageFlags->has(MessageFlag::Subscription) &&
+        const auto &messageFlags =
+            overridingFlags ? *overridingFlags : message->flags;
+        if (messageFlags.has(MessageFlag::DoNotTriggerNotification))
+        {
+            continue;
+        }
+
+        if ((messageFlags.has(MessageFlag::Highlighted) &&
+             messageFlags.has(MessageFlag::ShowInMentions) &&
+             !messageFlags.has(MessageFlag::Subscription) &&
              (getSettings()->highlightMentions ||
               this->channel_->getType() != Channel::Type::TwitchMentions)) ||
             (this->channel_->getType() == Channel::Type::TwitchAutomod &&
              getSettings()->enableAutomodHighlight))
         {
-            this->tabHighlightRequested.invoke(HighlightState::Highlighted);
-        }
-        else
-        {
-            this->tabHighlightRequested.invoke(HighlightState::NewMessage);
+            tabHighlight = HighlightState::Highlighted;
+            break;
         }
+        tabHighlight = HighlightState::NewMessage;
+    }
+    if (tabHighlight)
+    {
+        this->tabHighlightRequested.invoke(*tabHighlight);
     }
 
     if (this->showScrollbarHighlights())
     {
-        this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        for (const auto &message : messages)
+        {
+            this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        }
     }
 
     this->queueLayout();
@@ -1555,8 +1614,17 @@ void ChannelView::scrollToMessageLayout(MessageLayout *layout,
 void ChannelView::paintEvent(QPaintEvent *event)
 {
     //    BenchmarkGuard benchmark("paint");
+    auto start = std::chrono::steady_clock::now();
+
+    // Something other than the frame scheduler (e.g. a resize) caused this
+    // paint before a queued layout ran
+    if (this->layoutQueued_)
+    {
+        this->performLayout();
+    }
 
     QPainter painter(this);
+    ImageLoadScope imageScope(this->imagePriority_);
 
     painter.fillRect(rect(), this->messageColors_.channelBackground);
 
@@ -1598,6 +1666,9 @@ void ChannelView::paintEvent(QPaintEvent *event)
         painter.drawText(QRectF(textX, pausedY, textWidth, indicatorSize),
                          Qt::AlignLeft | Qt::AlignVCenter, text);
     }
+
+    getApp()->getWindows()->getFrameScheduler().recordPaint(
+        std::chrono::steady_clock::now() - start);
 }
 
 // if overlays is false then it draws the message, if true then it draws things
@@ -1823,6 +1894,7 @@ void ChannelView::wheelEvent(QWheelEvent *event)
                             .imageScale =
                                 this->scale() *
                                 static_cast<float>(this->devicePixelRatio()),
+                            .imagePriority = ImagePriority::Prefetch,
                         },
                         false);
                     scrollFactor = 1;
@@ -1866,6 +1938,7 @@ void ChannelView::wheelEvent(QWheelEvent *event)
                             .imageScale =
                                 this->scale() *
                                 static_cast<float>(this->devicePixelRatio()),
+                            .imagePriority = ImagePriority::Prefetch,
                         },
                         false);
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/FlagsEnum.hpp"
+#include "messages/ImagePriority.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
@@ -21,6 +22,8 @@
 #include <QWheelEvent>
 #include <QWidget>
 
+#include <chrono>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -45,6 +48,7 @@ struct Link;
 class MessageLayoutElement;
 class Split;
 class FilterSet;
+class FrameScheduler;
 using FilterSetPtr = std::shared_ptr<FilterSet>;
 
 class LinkInfo;
@@ -97,6 +101,7 @@ public:
                          Context context = Context::None,
                          size_t messagesLimit = 1000);
 
+    /// Repaints the view in the next frame (see FrameScheduler)
     void queueUpdate();
     void queueUpdate(const QRect &area);
     Scrollbar &getScrollBar();
@@ -115,6 +120,9 @@ public:
     bool getEnableScrollingToBottom() const;
     void setOverrideFlags(std::optional<MessageElementFlags> value);
     const std::optional<MessageElementFlags> &getOverrideFlags() const;
+    /// Sets the priority of the images shown in this view (defaults to
+    /// Visible)
+    void setImagePriority(ImagePriority priority);
     void updateLastReadMessage();
 
     /**
@@ -179,6 +187,7 @@ public:
 
     LimitedQueueSnapshot<MessageLayoutPtr> &getMessagesSnapshot();
 
+    /// Lays out the view in the next frame (see FrameScheduler)
     void queueLayout();
     void invalidateBuffers();
 
@@ -272,8 +281,8 @@ private:
     void initializeScrollbar();
     void initializeSignals();
 
-    void messageAppended(MessagePtr &message,
-                         std::optional<MessageFlags> overridingFlags);
+    void messagesAppended(std::span<const MessagePtr> messages,
+                          std::optional<MessageFlags> overridingFlags);
     void messageAddedAtStart(std::vector<MessagePtr> &messages);
     void messageRemoveFromStart(MessagePtr &message);
     void messageReplaced(size_t hint, const MessagePtr &prev,
@@ -327,6 +336,8 @@ private:
     ChannelViewID id_{};
 
     bool layoutQueued_ = false;
+    /// When the FrameScheduler last laid out and repainted this view
+    std::chrono::steady_clock::time_point lastFrameTime_;
     bool bufferInvalidationQueued_ = false;
 
     bool lastMessageHasAlternateBackground_ = false;
@@ -396,6 +407,7 @@ private:
     // "Show latest messages" button
     bool showingLatestMessages_ = true;
     bool enableScrollingToBottom_ = true;
+    ImagePriority imagePriority_ = ImagePriority::Visible;
 
     bool onlyUpdateEmotes_ = false;
 
@@ -458,6 +470,8 @@ private:
 
     /// Slot for the LinkInfo::stateChanged signal.
     void pendingLinkInfoStateChanged();
+
+    friend class FrameScheduler;
 };
 
 }  // namespace chatterino
@@ -1,12 +1,16 @@
 #include "widgets/helper/DebugPopup.hpp"
 
+#include "Application.hpp"
 #include "common/Literals.hpp"
+#include "singletons/helper/FrameScheduler.hpp"
+#include "singletons/WindowManager.hpp"
 #include "util/Clipboard.hpp"
 #include "util/DebugCount.hpp"
 
 #include <QFontDatabase>
 #include <QLabel>
 #include <QPushButton>
+#include <QStringBuilder>
 #include <QTimer>
 #include <QVBoxLayout>
 
@@ -21,11 +25,14 @@ DebugPopup::DebugPopup()
     auto *timer = new QTimer(this);
     auto *copyButton = new QPushButton(u"&Copy"_s);
 
-    QObject::connect(timer, &QTimer::timeout, [text] {
-        text->setText(DebugCount::getDebugText());
-    });
+    auto refresh = [text] {
+        text->setText(
+            DebugCount::getDebugText() % '\n' %
+            getApp()->getWindows()->getFrameScheduler().getDebugText());
+    };
+    QObject::connect(timer, &QTimer::timeout, refresh);
     timer->start(300);
-    text->setText(DebugCount::getDebugText());
+    refresh();
 
     text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
 
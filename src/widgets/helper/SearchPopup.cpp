@@ -11,6 +11,7 @@
 #include "messages/search/LinkPredicate.hpp"
 #include "messages/search/MessageFlagsPredicate.hpp"
 #include "messages/search/RegexPredicate.hpp"
+#include "messages/search/SearchIndex.hpp"
 #include "messages/search/SubstringPredicate.hpp"
 #include "messages/search/SubtierPredicate.hpp"
 #include "singletons/Settings.hpp"
@@ -25,42 +26,70 @@
 
 namespace chatterino {
 
-ChannelPtr SearchPopup::filter(const QString &text, const QString &channelName,
-                               const LimitedQueueSnapshot<MessagePtr> &snapshot)
+std::optional<SearchIndex::Positions> SearchPopup::findCandidates(
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+    const SearchIndex &index)
 {
-    ChannelPtr channel(new Channel(channelName, Channel::Type::None));
+    // Predicates that can't be looked up (e.g. regexes) are only checked in
+    // filter
+    std::optional<SearchIndex::Positions> candidates;
+    for (const auto &pred : predicates)
+    {
+        auto positions = pred->candidates(index);
+        if (!positions)
+        {
+            continue;
+        }
 
-    // Parse predicates from tags in "text"
-    auto predicates = parsePredicates(text);
+        if (candidates)
+        {
+            candidates = SearchIndex::intersect(*candidates, *positions);
+        }
+        else
+        {
+            candidates = std::move(positions);
+        }
+    }
+    return candidates;
+}
 
-    // Check for every message whether it fulfills all predicates that have
+void SearchPopup::filter(
+    const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+    const LimitedQueueSnapshot<MessagePtr> &snapshot,
+    const std::optional<SearchIndex::Positions> &candidates,
+    std::vector<MessagePtr> &matches)
+{
+    // Check for every candidate whether it fulfills all predicates that have
     // been registered
-    for (size_t i = 0; i < snapshot.size(); ++i)
-    {
-        MessagePtr message = snapshot[i];
+    auto checkMessage = [&](size_t i) {
+        const MessagePtr &message = snapshot[i];
 
-        bool accept = true;
         for (const auto &pred : predicates)
         {
             // Discard the message as soon as one predicate fails
             if (!pred->appliesTo(*message))
             {
-                accept = false;
-                break;
+                return;
             }
         }
 
-        // If all predicates match, add the message to the channel
-        if (accept)
-        {
-            auto overrideFlags = std::optional<MessageFlags>(message->flags);
-            overrideFlags->set(MessageFlag::DoNotLog);
+        matches.push_back(message);
+    };
 
-            channel->addMessage(message, MessageContext::Repost, overrideFlags);
+    if (candidates)
+    {
+        for (auto i : *candidates)
+        {
+            checkMessage(i);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < snapshot.size(); ++i)
+        {
+            checkMessage(i);
         }
     }
-
-    return channel;
 }
 
 SearchPopup::SearchPopup(QWidget *parent, Split *split)
@@ -224,69 +253,74 @@ void SearchPopup::themeChangedEvent()
 
 void SearchPopup::search()
 {
-    if (this->snapshot_.size() == 0)
-    {
-        this->snapshot_ = this->buildSnapshot();
-    }
+    // Parse predicates from tags in the search query
+    auto predicates = parsePredicates(this->searchInput_->text());
 
-    this->channelView_->setChannel(filter(this->searchInput_->text(),
-                                          this->channelName_, this->snapshot_));
-}
-
-LimitedQueueSnapshot<MessagePtr> SearchPopup::buildSnapshot()
-{
-    // no point in filtering/sorting if it's a single channel search
-    if (this->searchChannels_.length() == 1)
-    {
-        const auto channelPtr = this->searchChannels_.at(0);
-        return channelPtr.get().channel()->getMessageSnapshot();
-    }
-
-    auto combinedSnapshot = std::vector<std::shared_ptr<const Message>>{};
+    std::vector<MessagePtr> matches;
     for (auto &channel : this->searchChannels_)
     {
         ChannelView &sharedView = channel.get();
-
+        auto begin = matches.size();
+
+        // Only the lookup runs while the index is locked, the predicates are
+        // checked afterwards
+        std::optional<SearchIndex::Positions> candidates;
+        auto snapshot = sharedView.channel()->lookUpMessages(
+            [&](const SearchIndex &index) {
+                candidates = findCandidates(predicates, index);
+            });
+        filter(predicates, snapshot, candidates, matches);
+
+        // no point in filtering if it's a single channel search
         const FilterSetPtr filterSet = sharedView.getFilterSet();
-        const LimitedQueueSnapshot<MessagePtr> &snapshot =
-            sharedView.channel()->getMessageSnapshot();
-
-        for (const auto &message : snapshot)
+        if (this->searchChannels_.length() == 1 || !filterSet)
         {
-            if (filterSet && !filterSet->filter(message, sharedView.channel()))
-            {
-                continue;
-            }
-
-            combinedSnapshot.push_back(message);
+            continue;
         }
-    }
-
-    // remove any duplicate messages from splits containing the same channel
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
-              [](MessagePtr &a, MessagePtr &b) {
-                  return a->id > b->id;
-              });
 
-    auto uniqueIterator =
-        std::unique(combinedSnapshot.begin(), combinedSnapshot.end(),
-                    [](MessagePtr &a, MessagePtr &b) {
-                        // nullptr check prevents system messages from being dropped
-                        return (a->id != nullptr) && a->id == b->id;
-                    });
+        auto removed = std::remove_if(
+            matches.begin() + static_cast<std::ptrdiff_t>(begin), matches.end(),
+            [&](const MessagePtr &message) {
+                return !filterSet->filter(message, sharedView.channel());
+            });
+        matches.erase(removed, matches.end());
+    }
 
-    combinedSnapshot.erase(uniqueIterator, combinedSnapshot.end());
+    if (this->searchChannels_.length() > 1)
+    {
+        // remove any duplicate messages from splits containing the same channel
+        std::sort(matches.begin(), matches.end(),
+                  [](MessagePtr &a, MessagePtr &b) {
+                      return a->id > b->id;
+                  });
+
+        auto uniqueIterator =
+            std::unique(matches.begin(), matches.end(),
+                        [](MessagePtr &a, MessagePtr &b) {
+                            // nullptr check prevents system messages from
+                            // being dropped
+                            return (a->id != nullptr) && a->id == b->id;
+                        });
+
+        matches.erase(uniqueIterator, matches.end());
+
+        // resort by time for presentation
+        std::sort(matches.begin(), matches.end(),
+                  [](MessagePtr &a, MessagePtr &b) {
+                      return a->serverReceivedTime < b->serverReceivedTime;
+                  });
+    }
 
-    // resort by time for presentation
-    std::sort(combinedSnapshot.begin(), combinedSnapshot.end(),
-              [](MessagePtr &a, MessagePtr &b) {
-                  return a->serverReceivedTime < b->serverReceivedTime;
-              });
+    ChannelPtr channel(new Channel(this->channelName_, Channel::Type::None));
+    for (const auto &message : matches)
+    {
+        auto overrideFlags = std::optional<MessageFlags>(message->flags);
+        overrideFlags->set(MessageFlag::DoNotLog);
 
-    auto queue = LimitedQueue<MessagePtr>(combinedSnapshot.size());
-    queue.pushFront(combinedSnapshot);
+        channel->addMessage(message, MessageContext::Repost, overrideFlags);
+    }
 
-    return queue.getSnapshot();
+    this->channelView_->setChannel(channel);
 }
 
 void SearchPopup::initLayout()
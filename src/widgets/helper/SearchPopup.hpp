@@ -2,6 +2,7 @@
 
 #include "ForwardDecl.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
+#include "messages/search/SearchIndex.hpp"
 #include "widgets/BasePopup.hpp"
 
 #include <memory>
@@ -38,22 +39,36 @@ private:
     void initLayout();
     void search();
     void addShortcuts() override;
-    LimitedQueueSnapshot<MessagePtr> buildSnapshot();
 
     /**
-     * @brief Only retains those message from a list of messages that satisfy a
-     *        search query.
+     * @brief Looks up the messages in an index that might satisfy all
+     *        predicates.
      *
-     * @param text          the search query -- will be parsed for MessagePredicates
-     * @param channelName   name of the channel to be returned
-     * @param snapshot      list of messages to filter
-     * @param filterSet     channel filter to apply
+     * @param predicates    the predicates parsed from the search query
+     * @param index         the index to look the messages up in
      *
-     * @return a ChannelPtr with "channelName" and the filtered messages from
-     *         "snapshot"
+     * @return the positions of the candidates, or std::nullopt if all
+     *         messages have to be checked
+     */
+    static std::optional<SearchIndex::Positions> findCandidates(
+        const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+        const SearchIndex &index);
+
+    /**
+     * @brief Appends the messages from a list of messages that satisfy all
+     *        predicates to "matches".
+     *
+     * @param predicates    the predicates parsed from the search query
+     * @param snapshot      list of messages to filter
+     * @param candidates    positions of the messages in "snapshot" to check,
+     *                      or std::nullopt to check all of them
+     * @param matches       the list to append the matching messages to
      */
-    static ChannelPtr filter(const QString &text, const QString &channelName,
-                             const LimitedQueueSnapshot<MessagePtr> &snapshot);
+    static void filter(
+        const std::vector<std::unique_ptr<MessagePredicate>> &predicates,
+        const LimitedQueueSnapshot<MessagePtr> &snapshot,
+        const std::optional<SearchIndex::Positions> &candidates,
+        std::vector<MessagePtr> &matches);
 
     /**
      * @brief Checks the input for tags and registers their corresponding
@@ -65,7 +80,6 @@ private:
     static std::vector<std::unique_ptr<MessagePredicate>> parsePredicates(
         const QString &input);
 
-    LimitedQueueSnapshot<MessagePtr> snapshot_;
     QLineEdit *searchInput_{};
     ChannelView *channelView_{};
     QString channelName_{};
@@ -2,6 +2,7 @@
 
 #include "Application.hpp"
 #include "common/Literals.hpp"  // IWYU pragma: keep
+#include "common/network/NetworkCache.hpp"
 #include "common/Version.hpp"
 #include "controllers/hotkeys/HotkeyCategory.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
@@ -966,9 +967,7 @@ void GeneralPage::initLayout(GeneralPageView &layout)
 
             if (reply == QMessageBox::Yes)
             {
-                auto cacheDir = QDir(getApp()->getPaths().cacheDirectory());
-                cacheDir.removeRecursively();
-                cacheDir.mkdir(getApp()->getPaths().cacheDirectory());
+                NetworkCache::current()->clear();
             }
         }));
         box->addStretch(1);
@@ -976,6 +975,16 @@ void GeneralPage::initLayout(GeneralPageView &layout)
         layout.addLayout(box);
     }
 
+    SettingWidget::intInput("Cache size limit (MiB)", s.cacheSizeLimit,
+                            {
+                                .min = 16,
+                                .max = 64 * 1024,
+                                .singleStep = 256,
+                            })
+        ->setTooltip("When the cached responses (e.g. emotes) take up more "
+                     "than this, the least recently used ones are removed.")
+        ->addTo(layout);
+
     layout.addTitle("Advanced");
 
     layout.addSubtitle("Chat title");
@@ -1420,6 +1429,50 @@ void GeneralPage::initLayout(GeneralPageView &layout)
                             })
         ->addTo(layout);
 
+    SettingWidget::intInput("Memory for drawn messages (MiB)",
+                            s.messageBufferPoolSize,
+                            {
+                                .min = 8,
+                                .max = 1024,
+                                .singleStep = 8,
+                            })
+        ->setTooltip("Limits the memory of the buffers messages are drawn "
+                     "into. Messages that scrolled out of view keep their "
+                     "buffers within this limit, so they can be reused.")
+        ->addTo(layout);
+
+    layout.addDropdown<int>(
+        "Frame rate limit", {"120", "60", "30", "15"}, s.frameRateLimit,
+        [](auto val) {
+            return QString::number(val);
+        },
+        [](auto args) {
+            return fuzzyToInt(args.value, 60);
+        },
+        true, "How often chats are redrawn at most per second.");
+    layout.addDropdown<int>(
+        "Frame rate limit in unfocused windows", {"60", "30", "15", "5"},
+        s.backgroundFrameRateLimit,
+        [](auto val) {
+            return QString::number(val);
+        },
+        [](auto args) {
+            return fuzzyToInt(args.value, 30);
+        },
+        true,
+        "How often chats in windows that aren't focused or are minimized are "
+        "redrawn at most per second.");
+
+    SettingWidget::intInput("Network threads (requires restart)",
+                            s.ioThreadCount,
+                            {
+                                .min = 1,
+                                .max = 8,
+                            })
+        ->setTooltip("Number of threads handling the connections to PubSub, "
+                     "EventSub and the live emote updates.")
+        ->addTo(layout);
+
     SettingWidget::dropdown("Show blocked term automod messages",
                             s.showBlockedTermAutomodMessages)
         ->setTooltip("Show messages that are blocked by AutoMod for containing "
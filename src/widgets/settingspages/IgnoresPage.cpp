@@ -132,10 +132,11 @@ void IgnoresPage::onShow()
         return;
     }
 
+    auto blocks = user->blocks();
     QStringList users;
-    users.reserve(user->blocks().size());
+    users.reserve(blocks.size());
 
-    for (const auto &blockedUser : user->blocks())
+    for (const auto &blockedUser : blocks)
     {
         users << blockedUser.name;
     }
@@ -208,7 +208,7 @@ ModerationPage::ModerationPage()
                         ->initialized(&getSettings()->loggedChannels))
                 .getElement();
 
-        view->setTitles({"Twitch channels"});
+        view->setTitles({"Twitch channels", "Compressed"});
         view->getTableView()->horizontalHeader()->setSectionResizeMode(
             QHeaderView::Fixed);
         view->getTableView()->horizontalHeader()->setSectionResizeMode(
@@ -0,0 +1,90 @@
+#include "util/AhoCorasick.hpp"
+
+#include "Test.hpp"
+
+#include <QString>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+using MatchTuple = std::tuple<std::size_t, qsizetype, qsizetype>;
+
+std::vector<MatchTuple> findAll(const AhoCorasick &matcher, QStringView text)
+{
+    std::vector<MatchTuple> matches;
+    matcher.findAll(text, [&](const AhoCorasick::Match &match) {
+        matches.emplace_back(match.id, match.start, match.length);
+    });
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+}  // namespace
+
+TEST(AhoCorasick, Empty)
+{
+    AhoCorasick matcher;
+    matcher.addPattern(u"", 0);
+    matcher.build();
+
+    ASSERT_TRUE(matcher.empty());
+    ASSERT_FALSE(matcher.containsAny(u"foo"));
+    ASSERT_TRUE(findAll(matcher, u"foo").empty());
+}
+
+TEST(AhoCorasick, Overlapping)
+{
+    AhoCorasick matcher;
+    matcher.addPattern(u"he", 0);
+    matcher.addPattern(u"she", 1);
+    matcher.addPattern(u"his", 2);
+    matcher.addPattern(u"hers", 3);
+    matcher.build();
+
+    std::vector<MatchTuple> expected{
+        {0, 1, 2},
+        {0, 5, 2},
+        {1, 0, 3},
+        {3, 5, 4},
+    };
+    ASSERT_EQ(findAll(matcher, u"she ahers"), expected);
+
+    ASSERT_TRUE(matcher.containsAny(u"ushers"));
+    ASSERT_TRUE(matcher.containsAny(u"this"));
+    ASSERT_FALSE(matcher.containsAny(u"hi sh"));
+    ASSERT_FALSE(matcher.containsAny(u""));
+}
+
+TEST(AhoCorasick, DuplicatePatterns)
+{
+    AhoCorasick matcher;
+    matcher.addPattern(u"a", 0);
+    matcher.addPattern(u"a", 1);
+    matcher.addPattern(u"aa", 2);
+    matcher.build();
+
+    std::vector<MatchTuple> expected{
+        {0, 0, 1}, {0, 1, 1}, {1, 0, 1}, {1, 1, 1}, {2, 0, 2},
+    };
+    ASSERT_EQ(findAll(matcher, u"aa"), expected);
+}
+
+TEST(AhoCorasick, CaseFolded)
+{
+    AhoCorasick matcher;
+    matcher.addPattern(QString("ForsEn").toCaseFolded(), 0);
+    matcher.addPattern(QString("ÄÖÜ").toCaseFolded(), 1);
+    matcher.build();
+
+    auto text = QString("hello FORSEN and äöü").toCaseFolded();
+    std::vector<MatchTuple> expected{
+        {0, 6, 6},
+        {1, 17, 3},
+    };
+    ASSERT_EQ(findAll(matcher, text), expected);
+}
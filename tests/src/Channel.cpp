@@ -0,0 +1,80 @@
+#include "common/Channel.hpp"
+
+#include "lib/ChannelFixture.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "mocks/Channel.hpp"
+#include "Test.hpp"
+
+#include <QStringList>
+
+#include <vector>
+
+using namespace chatterino;
+using chatterino::mock::MockChannel;
+using chatterino::testlib::LoggingApplication;
+using chatterino::testlib::texts;
+
+TEST(Channel, addMessagesAppendsInOrder)
+{
+    LoggingApplication app;
+    MockChannel channel("test");
+
+    std::vector<MessagePtr> messages{
+        makeSystemMessage("a"),
+        makeSystemMessage("b"),
+        makeSystemMessage("c"),
+    };
+
+    QStringList appended;
+    std::vector<size_t> batches;
+    std::ignore = channel.messageAppended.connect([&](auto &message, auto) {
+        appended.append(message->messageText);
+    });
+    std::ignore =
+        channel.messagesAppended.connect([&](auto batch, auto flags) {
+            ASSERT_FALSE(flags.has_value());
+            batches.push_back(batch.size());
+        });
+
+    channel.addMessages(messages, MessageContext::Original);
+
+    ASSERT_EQ(texts(channel.getMessageSnapshot()),
+              QStringList({"a", "b", "c"}));
+    // Every message is announced, but the batch only once
+    ASSERT_EQ(appended, QStringList({"a", "b", "c"}));
+    ASSERT_EQ(batches, std::vector<size_t>{3});
+}
+
+TEST(Channel, addMessagesIgnoresEmptyBatches)
+{
+    LoggingApplication app;
+    MockChannel channel("test");
+
+    bool invoked = false;
+    std::ignore = channel.messagesAppended.connect([&](auto, auto) {
+        invoked = true;
+    });
+
+    channel.addMessages({}, MessageContext::Original);
+
+    ASSERT_FALSE(invoked);
+    ASSERT_EQ(channel.getMessageSnapshot().size(), 0U);
+}
+
+TEST(Channel, addMessageIsABatchOfOne)
+{
+    LoggingApplication app;
+    MockChannel channel("test");
+
+    std::vector<size_t> batches;
+    std::ignore = channel.messagesAppended.connect([&](auto batch, auto) {
+        batches.push_back(batch.size());
+    });
+
+    channel.addMessage(makeSystemMessage("a"), MessageContext::Original);
+    channel.addMessage(makeSystemMessage("b"), MessageContext::Original);
+
+    ASSERT_EQ(batches, (std::vector<size_t>{1, 1}));
+    ASSERT_EQ(texts(channel.getMessageSnapshot()), QStringList({"a", "b"}));
+}
@@ -0,0 +1,119 @@
+#include "util/ChannelIngestSink.hpp"
+
+#include "lib/ChannelFixture.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "mocks/Channel.hpp"
+#include "Test.hpp"
+
+#include <QDateTime>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+using chatterino::mock::MockChannel;
+using chatterino::testlib::LoggingApplication;
+
+namespace {
+
+QStringList texts(Channel &channel)
+{
+    return testlib::texts(channel.getMessageSnapshot());
+}
+
+class ChannelIngestSinkTest : public ::testing::Test
+{
+protected:
+    void apply()
+    {
+        auto changes = this->sink.takeChanges();
+        ASSERT_TRUE(changes);
+        changes();
+    }
+
+    LoggingApplication app;
+    MockChannel channel{"test"};
+    ChannelIngestSink sink{channel};
+};
+
+}  // namespace
+
+TEST_F(ChannelIngestSinkTest, batchesMessagesUntilCommit)
+{
+    std::vector<size_t> batches;
+    std::ignore = this->channel.messagesAppended.connect([&](auto batch, auto) {
+        batches.push_back(batch.size());
+    });
+
+    this->sink.addMessage(makeSystemMessage("a"), MessageContext::Original);
+    this->apply();
+    this->sink.addMessage(makeSystemMessage("b"), MessageContext::Original);
+    this->apply();
+
+    // Applied messages wait for the commit
+    ASSERT_TRUE(texts(this->channel).isEmpty());
+
+    this->sink.commit();
+    ASSERT_EQ(texts(this->channel), QStringList({"a", "b"}));
+    ASSERT_EQ(batches, std::vector<size_t>{2});
+
+    // Nothing left to commit
+    this->sink.commit();
+    ASSERT_EQ(batches, std::vector<size_t>{2});
+}
+
+TEST_F(ChannelIngestSinkTest, findsPendingMessages)
+{
+    auto message = std::make_shared<Message>();
+    message->id = "pending-id";
+    message->messageText = "pending";
+    this->sink.addMessage(message, MessageContext::Original);
+
+    ASSERT_EQ(this->sink.findMessageByID(u"pending-id"), message);
+
+    this->apply();
+    this->sink.commit();
+    ASSERT_EQ(this->sink.findMessageByID(u"pending-id"), message);
+    ASSERT_EQ(texts(this->channel), QStringList({"pending"}));
+}
+
+TEST_F(ChannelIngestSinkTest, commitsBeforeTimeout)
+{
+    this->sink.addMessage(makeSystemMessage("a"), MessageContext::Original);
+    this->sink.addOrReplaceTimeout(makeSystemMessage("timeout"),
+                                   QDateTime::currentDateTime());
+    this->apply();
+
+    ASSERT_EQ(texts(this->channel), QStringList({"a", "timeout"}));
+}
+
+TEST_F(ChannelIngestSinkTest, commitsBeforeClearChat)
+{
+    this->sink.addMessage(makeSystemMessage("a"), MessageContext::Original);
+    this->sink.addMessage(makeSystemMessage("b"), MessageContext::Original);
+    this->sink.addOrReplaceClearChat(makeSystemMessage("clear"),
+                                     QDateTime::currentDateTime());
+    this->apply();
+
+    ASSERT_EQ(texts(this->channel), QStringList({"a", "b", "clear"}));
+}
+
+TEST_F(ChannelIngestSinkTest, commitsBeforeSideEffects)
+{
+    QStringList seen;
+    this->sink.addMessage(makeSystemMessage("a"), MessageContext::Original);
+    this->sink.runSideEffect([&] {
+        seen = texts(this->channel);
+    });
+    this->sink.addMessage(makeSystemMessage("b"), MessageContext::Original);
+    this->apply();
+
+    // Side effects may look at the channel's messages
+    ASSERT_EQ(seen, QStringList({"a"}));
+    ASSERT_EQ(texts(this->channel), QStringList({"a"}));
+
+    this->sink.commit();
+    ASSERT_EQ(texts(this->channel), QStringList({"a", "b"}));
+}
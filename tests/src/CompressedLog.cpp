@@ -0,0 +1,239 @@
+#include "singletons/helper/CompressedLog.hpp"
+
+#include "common/Literals.hpp"
+#include "lib/ChannelFixture.hpp"
+#include "Test.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+using namespace literals;
+using chatterino::testlib::texts;
+
+namespace {
+
+const QDateTime START = QDateTime::fromMSecsSinceEpoch(1700000000000);
+
+CompressedLogEntry entry(int minutes, const QString &user)
+{
+    return {
+        .timestamp = START.addSecs(minutes * 60LL),
+        .userID = user + "-id",
+        .loginName = user,
+        .text = u"%1: message %2"_s.arg(user).arg(minutes),
+    };
+}
+
+/// Writes blocks of `perBlock` entries, one entry per minute alternating
+/// between the users
+void writeLog(const QString &path, int count, int perBlock,
+              const QStringList &users)
+{
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+    CompressedLogBlock block;
+    for (int i = 0; i < count; i++)
+    {
+        block.add(entry(i, users[i % users.size()]));
+        if ((i + 1) % perBlock == 0)
+        {
+            file.write(block.finish());
+        }
+    }
+    if (!block.empty())
+    {
+        file.write(block.finish());
+    }
+}
+
+}  // namespace
+
+TEST(CompressedLog, userFilter)
+{
+    LogUserFilter filter;
+    filter.add("forsen");
+    filter.add("12345");
+
+    ASSERT_TRUE(filter.mightContain("forsen"));
+    ASSERT_TRUE(filter.mightContain("FORSEN"));
+    ASSERT_TRUE(filter.mightContain("12345"));
+
+    int falsePositives = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        falsePositives += filter.mightContain(u"user%1"_s.arg(i)) ? 1 : 0;
+    }
+    ASSERT_LT(falsePositives, 10);
+}
+
+TEST(CompressedLog, userFilterBits)
+{
+    // The bits are part of the file format
+    LogUserFilter filter;
+    filter.add("Forsen");
+
+    std::vector<std::size_t> bits;
+    for (std::size_t i = 0; i < LogUserFilter::SIZE * 8; i++)
+    {
+        if ((filter.bits[i / 8] & (1U << (i % 8))) != 0)
+        {
+            bits.push_back(i);
+        }
+    }
+    ASSERT_EQ(bits, std::vector<std::size_t>({630, 695, 1356, 2017}));
+}
+
+TEST(CompressedLog, roundTrip)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    auto path = tmp.filePath("forsen-2023-11-14.clog");
+    writeLog(path, 100, 16, {"forsen", "nymn"});
+
+    auto all = CompressedLogReader::search(path, {});
+    ASSERT_EQ(all.size(), 100U);
+    ASSERT_EQ(all[0].text, "forsen: message 0");
+    ASSERT_EQ(all[0].timestamp, START);
+    ASSERT_EQ(all[99].text, "nymn: message 99");
+    ASSERT_EQ(all[99].userID, "nymn-id");
+
+    auto byName = CompressedLogReader::search(path, {.user = "NymN"});
+    ASSERT_EQ(byName.size(), 50U);
+    auto byID = CompressedLogReader::search(path, {.user = "nymn-id"});
+    ASSERT_EQ(texts(byID), texts(byName));
+
+    ASSERT_TRUE(CompressedLogReader::search(path, {.user = "pajlada"}).empty());
+}
+
+TEST(CompressedLog, timeRange)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    auto path = tmp.filePath("forsen-2023-11-14.clog");
+    writeLog(path, 100, 16, {"forsen", "nymn"});
+
+    auto entries = CompressedLogReader::search(
+        path, {
+                  .user = "forsen",
+                  .from = START.addSecs(20 * 60),
+                  .to = START.addSecs(30 * 60),
+              });
+    ASSERT_EQ(texts(entries),
+              QStringList({
+                  "forsen: message 20",
+                  "forsen: message 22",
+                  "forsen: message 24",
+                  "forsen: message 26",
+                  "forsen: message 28",
+                  "forsen: message 30",
+              }));
+}
+
+TEST(CompressedLog, truncatedBlock)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    auto path = tmp.filePath("forsen-2023-11-14.clog");
+    writeLog(path, 32, 16, {"forsen"});
+
+    QFile file(path);
+    ASSERT_TRUE(file.resize(file.size() - 10));
+
+    // The first block is still readable
+    ASSERT_EQ(CompressedLogReader::search(path, {}).size(), 16U);
+}
+
+TEST(CompressedLog, appendAfterTruncatedBlock)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    auto path = tmp.filePath("forsen-2023-11-14.clog");
+    writeLog(path, 32, 16, {"forsen"});
+
+    // The session crashed while writing its second block
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.resize(file.size() - 10));
+    }
+
+    // The next session appends its blocks after the cut off one
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::Append));
+        CompressedLogBlock block;
+        for (int i = 100; i < 110; i++)
+        {
+            block.add(entry(i, "nymn"));
+        }
+        ASSERT_EQ(block.size(), 10U);
+        file.write(block.finish());
+        ASSERT_EQ(block.size(), 0U);
+        block.add(entry(110, "nymn"));
+        file.write(block.finish());
+    }
+
+    auto entries = CompressedLogReader::search(path, {});
+    ASSERT_EQ(entries.size(), 16U + 11U);
+    ASSERT_EQ(entries[15].text, "forsen: message 15");
+    ASSERT_EQ(entries[16].text, "nymn: message 100");
+    ASSERT_EQ(entries[26].text, "nymn: message 110");
+
+    auto byUser = CompressedLogReader::search(path, {.user = "nymn"});
+    ASSERT_EQ(byUser.size(), 11U);
+}
+
+TEST(CompressedLog, completeSize)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    auto path = tmp.filePath("forsen-2023-11-14.clog");
+    writeLog(path, 32, 16, {"forsen"});
+    // The first block of both logs is the same
+    writeLog(tmp.filePath("first.clog"), 16, 16, {"forsen"});
+    auto firstBlock = QFileInfo(tmp.filePath("first.clog")).size();
+    auto complete = QFileInfo(path).size();
+
+    ASSERT_EQ(CompressedLogReader::completeSize(path), complete);
+
+    // Cut off in the payload and in the header of the second block
+    for (auto cut : {complete - 10, firstBlock + 3})
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.resize(cut));
+        ASSERT_EQ(CompressedLogReader::completeSize(path), firstBlock);
+    }
+
+    ASSERT_EQ(CompressedLogReader::completeSize(tmp.filePath("missing.clog")),
+              0);
+}
+
+TEST(CompressedLog, searchChannel)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    writeLog(tmp.filePath("forsen-2023-11-14.clog"), 10, 4, {"forsen"});
+    writeLog(tmp.filePath("forsen-123456.clog"), 10, 4, {"nymn"});
+    writeLog(tmp.filePath("forsen-2020-01-01.clog"), 10, 4, {"forsen"});
+    writeLog(tmp.filePath("nymn-2023-11-14.clog"), 10, 4, {"forsen"});
+
+    auto entries = CompressedLogReader::searchChannel(
+        tmp.path(), "forsen",
+        {
+            .from = START.addDays(-2),
+        });
+    // The daily log from 2020 is skipped
+    ASSERT_EQ(entries.size(), 20U);
+    for (std::size_t i = 0; i < entries.size(); i++)
+    {
+        auto minutes = static_cast<qint64>(i / 2);
+        ASSERT_EQ(entries[i].timestamp, START.addSecs(minutes * 60));
+    }
+
+    auto byUser = CompressedLogReader::searchChannel(tmp.path(), "forsen",
+                                                     {.user = "forsen"});
+    // Includes the daily log from 2020
+    ASSERT_EQ(byUser.size(), 20U);
+}
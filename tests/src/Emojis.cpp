@@ -169,3 +169,40 @@ TEST(Emojis, Parse)
         }
     }
 }
+
+TEST(Emojis, ParseSpans)
+{
+    Emojis emojis;
+
+    emojis.load();
+
+    ASSERT_TRUE(emojis.parseSpans(u"").empty());
+
+    // ASCII only
+    auto spans = emojis.parseSpans(u"#1 abc");
+    ASSERT_EQ(spans.size(), 1U);
+    ASSERT_EQ(spans[0].start, 0);
+    ASSERT_EQ(spans[0].length, 6);
+    ASSERT_TRUE(spans[0].emote == nullptr);
+
+    // penguin, keycap 1 and penguin
+    auto text = u"a\U0001F427b1\uFE0F\u20E3\U0001F427"_s;
+    spans = emojis.parseSpans(text);
+    ASSERT_EQ(spans.size(), 5U);
+
+    ASSERT_EQ(text.mid(spans[0].start, spans[0].length), u"a"_s);
+    ASSERT_TRUE(spans[0].emote == nullptr);
+
+    ASSERT_EQ(spans[1].start, 1);
+    ASSERT_EQ(spans[1].length, 2);
+    ASSERT_TRUE(spans[1].emote != nullptr);
+
+    ASSERT_EQ(text.mid(spans[2].start, spans[2].length), u"b"_s);
+    ASSERT_TRUE(spans[2].emote == nullptr);
+
+    ASSERT_EQ(spans[3].start, 4);
+    ASSERT_EQ(spans[3].length, 3);
+    ASSERT_TRUE(spans[3].emote != nullptr);
+
+    ASSERT_TRUE(spans[4].emote == spans[1].emote);
+}
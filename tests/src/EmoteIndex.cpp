@@ -0,0 +1,105 @@
+#include "controllers/completion/sources/EmoteIndex.hpp"
+
+#include "Test.hpp"
+
+#include <QStringList>
+
+#include <vector>
+
+using namespace chatterino;
+using namespace chatterino::completion;
+
+namespace {
+
+EmoteIndex makeIndex(const QStringList &names)
+{
+    std::vector<EmoteItem> items;
+    for (const auto &name : names)
+    {
+        items.push_back({.searchName = name});
+    }
+    return EmoteIndex(std::move(items));
+}
+
+QStringList namesOf(const EmoteIndex &index,
+                    const std::vector<uint32_t> &found)
+{
+    QStringList names;
+    for (auto i : found)
+    {
+        names.append(index.items()[i].searchName);
+    }
+    return names;
+}
+
+std::shared_ptr<const EmoteMap> makeMap(const QStringList &names)
+{
+    auto map = std::make_shared<EmoteMap>();
+    for (const auto &name : names)
+    {
+        EmoteName emoteName{.string = name};
+        map->emplace(emoteName, std::make_shared<const Emote>(Emote{
+                                    .name = emoteName,
+                                }));
+    }
+    return map;
+}
+
+}  // namespace
+
+TEST(EmoteIndex, Prefix)
+{
+    auto index = makeIndex({"pajaW", "Clap", "PAJAW", "clapper", "Clap2",
+                            "FeelsGoodMan", "xdd"});
+
+    ASSERT_EQ(namesOf(index, index.find(u"cla", true)),
+              QStringList({"Clap", "clapper", "Clap2"}));
+    ASSERT_EQ(namesOf(index, index.find(u"paja", true)),
+              QStringList({"pajaW", "PAJAW"}));
+    ASSERT_EQ(namesOf(index, index.find(u"lap", true)), QStringList());
+    ASSERT_EQ(namesOf(index, index.find(u"", true)).size(), 7);
+    ASSERT_EQ(namesOf(index, index.find(u"xddd", true)), QStringList());
+}
+
+TEST(EmoteIndex, Contains)
+{
+    auto index = makeIndex({"pajaW", "Clap", "PAJAW", "clapper", "Clap2",
+                            "FeelsGoodMan", "FeelsBadMan", ":)", "B-)"});
+
+    // queries of up to two characters are scanned
+    ASSERT_EQ(namesOf(index, index.find(u")", false)),
+              QStringList({":)", "B-)"}));
+    ASSERT_EQ(namesOf(index, index.find(u"ap", false)),
+              QStringList({"Clap", "clapper", "Clap2"}));
+
+    // longer queries use the trigrams
+    ASSERT_EQ(namesOf(index, index.find(u"lap", false)),
+              QStringList({"Clap", "clapper", "Clap2"}));
+    ASSERT_EQ(namesOf(index, index.find(u"sbadm", false)),
+              QStringList({"FeelsBadMan"}));
+    ASSERT_EQ(namesOf(index, index.find(u"feelsman", false)), QStringList());
+    ASSERT_EQ(namesOf(index, index.find(u"ajaw", false)),
+              QStringList({"pajaW", "PAJAW"}));
+    // all trigrams are present, but not in order
+    ASSERT_EQ(namesOf(index, index.find(u"ppercla", false)), QStringList());
+}
+
+TEST(EmoteIndex, CachedPerMap)
+{
+    auto bttv = makeMap({"Clap", "FeelsGoodMan"});
+    auto seventv = makeMap({"Clap2"});
+
+    auto bttvIndex = EmoteIndex::forMap(bttv, "Global BetterTTV");
+    ASSERT_EQ(bttvIndex->items().size(), 2);
+    ASSERT_EQ(bttvIndex->items()[0].providerName, "Global BetterTTV");
+    ASSERT_EQ(EmoteIndex::forMap(bttv, "Global BetterTTV"), bttvIndex);
+
+    auto seventvIndex = EmoteIndex::forMap(seventv, "Global 7TV");
+    ASSERT_NE(seventvIndex, bttvIndex);
+
+    // a changed map gets a new index, the other ones are kept
+    seventv = makeMap({"Clap2", "pajaW"});
+    auto newSeventvIndex = EmoteIndex::forMap(seventv, "Global 7TV");
+    ASSERT_EQ(newSeventvIndex->items().size(), 2);
+    ASSERT_EQ(EmoteIndex::forMap(bttv, "Global BetterTTV"), bttvIndex);
+}
@@ -0,0 +1,120 @@
+#include "messages/EmoteLookup.hpp"
+
+#include "messages/Emote.hpp"
+#include "messages/MessageElement.hpp"
+#include "Test.hpp"
+
+#include <memory>
+
+using namespace chatterino;
+
+namespace {
+
+EmotePtr makeEmote(const QString &name, bool zeroWidth = false)
+{
+    return std::make_shared<const Emote>(Emote{
+        .name = {name},
+        .zeroWidth = zeroWidth,
+    });
+}
+
+/// A map with one emote for each name
+std::shared_ptr<const EmoteMap> makeMap(
+    std::initializer_list<std::pair<QString, EmotePtr>> emotes)
+{
+    EmoteMap map;
+    for (const auto &[name, emote] : emotes)
+    {
+        map[{name}] = emote;
+    }
+    return std::make_shared<const EmoteMap>(std::move(map));
+}
+
+}  // namespace
+
+TEST(EmoteLookup, Precedence)
+{
+    auto ffzChannel = makeEmote("a");
+    auto bttvChannel = makeEmote("a");
+    auto seventvChannel = makeEmote("b");
+    auto ffzGlobal = makeEmote("b");
+    auto bttvGlobal = makeEmote("c");
+    auto seventvGlobal = makeEmote("c");
+    auto onlyGlobal = makeEmote("d");
+
+    auto lookup = EmoteLookup::build({
+        .ffzChannel = makeMap({{"a", ffzChannel}}),
+        .bttvChannel = makeMap({{"a", bttvChannel}}),
+        .seventvChannel = makeMap({{"b", seventvChannel}}),
+        .ffzGlobal = makeMap({{"b", ffzGlobal}}),
+        .bttvGlobal = makeMap({{"c", bttvGlobal}}),
+        .seventvGlobal = makeMap({{"c", seventvGlobal}, {"d", onlyGlobal}}),
+    });
+
+    ASSERT_EQ(lookup->size(), 4U);
+
+    const auto *a = lookup->find({"a"});
+    ASSERT_NE(a, nullptr);
+    ASSERT_EQ(a->emote, ffzChannel);
+    ASSERT_EQ(a->flags, MessageElementFlags{MessageElementFlag::FfzEmote});
+
+    const auto *b = lookup->find({"b"});
+    ASSERT_NE(b, nullptr);
+    ASSERT_EQ(b->emote, seventvChannel);
+    ASSERT_EQ(b->flags, MessageElementFlags{MessageElementFlag::SevenTVEmote});
+
+    const auto *c = lookup->find({"c"});
+    ASSERT_NE(c, nullptr);
+    ASSERT_EQ(c->emote, bttvGlobal);
+    ASSERT_EQ(c->flags, MessageElementFlags{MessageElementFlag::BttvEmote});
+
+    const auto *d = lookup->find({"d"});
+    ASSERT_NE(d, nullptr);
+    ASSERT_EQ(d->emote, onlyGlobal);
+
+    ASSERT_EQ(lookup->find({"e"}), nullptr);
+    // names are case-sensitive
+    ASSERT_EQ(lookup->find({"A"}), nullptr);
+}
+
+TEST(EmoteLookup, ZeroWidth)
+{
+    auto lookup = EmoteLookup::build({
+        .ffzChannel = makeMap({{"ffz", makeEmote("ffz", true)}}),
+        .bttvChannel = makeMap({{"TopHat", makeEmote("TopHat")}}),
+        .seventvChannel = makeMap({{"7tv", makeEmote("7tv", true)}}),
+        .bttvGlobal = makeMap({
+            {"SantaHat", makeEmote("SantaHat")},
+            {"bttv", makeEmote("bttv")},
+        }),
+        .seventvGlobal = makeMap({{"7tvGlobal", makeEmote("7tvGlobal", true)}}),
+    });
+
+    // FFZ has no zero-width emotes
+    ASSERT_FALSE(lookup->find({"ffz"})->zeroWidth);
+    // only the global BTTV emotes in the list are zero-width
+    ASSERT_FALSE(lookup->find({"TopHat"})->zeroWidth);
+    ASSERT_TRUE(lookup->find({"SantaHat"})->zeroWidth);
+    ASSERT_FALSE(lookup->find({"bttv"})->zeroWidth);
+    ASSERT_TRUE(lookup->find({"7tv"})->zeroWidth);
+    ASSERT_TRUE(lookup->find({"7tvGlobal"})->zeroWidth);
+}
+
+TEST(EmoteLookup, IsBuiltFrom)
+{
+    EmoteLookup::Sources sources{
+        .seventvChannel = makeMap({{"a", makeEmote("a")}}),
+        .ffzGlobal = makeMap({{"b", makeEmote("b")}}),
+    };
+    auto lookup = EmoteLookup::build(sources);
+    ASSERT_TRUE(lookup->isBuiltFrom(sources));
+
+    // maps are replaced when they change
+    auto changed = sources;
+    changed.seventvChannel = makeMap({{"a", makeEmote("a")}});
+    ASSERT_FALSE(lookup->isBuiltFrom(changed));
+
+    auto rebuilt = EmoteLookup::build(changed);
+    ASSERT_TRUE(rebuilt->isBuiltFrom(changed));
+    ASSERT_NE(rebuilt->find({"b"}), nullptr);
+}
@@ -1,6 +1,8 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/filters/lang/expressions/UnaryOperation.hpp"
 #include "controllers/filters/lang/Filter.hpp"
+#include "controllers/filters/lang/Identifier.hpp"
+#include "controllers/filters/lang/Program.hpp"
 #include "controllers/filters/lang/Types.hpp"
 #include "controllers/highlights/HighlightController.hpp"
 #include "messages/MessageBuilder.hpp"
@@ -90,6 +92,25 @@ public:
     HighlightController highlights;
 };
 
+/// Supplies identifier values from a ContextMap to a compiled filter
+class ContextMapSource : public IdentifierSource
+{
+public:
+    explicit ContextMapSource(const ContextMap &context)
+        : context_(context)
+    {
+    }
+
+    Value value(Identifier identifier) override
+    {
+        return valueFromVariant(
+            this->context_.value(identifierToString(identifier)));
+    }
+
+private:
+    const ContextMap &context_;
+};
+
 class FiltersF : public ::testing::Test
 {
 protected:
@@ -265,6 +286,99 @@ TEST(Filters, Evaluation)
             << "Filter{ " << input << " } evaluated to " << result.toString()
             << " instead of " << expected.toString()
             << ".\nDebug: " << filter.debugString(MESSAGE_TYPING_CONTEXT);
+
+        ContextMapSource source(contextMap);
+        auto compiledResult = valueToVariant(filter.execute(source));
+
+        EXPECT_EQ(compiledResult, expected)
+            << "Compiled Filter{ " << input << " } evaluated to "
+            << compiledResult.toString() << " instead of "
+            << expected.toString();
+    }
+}
+
+TEST(Filters, NegationOfNonBoolValues)
+{
+    // Boolean identifiers may be missing or hold other values at runtime,
+    // the compiled filter must negate them like the expression tree does
+    std::vector<QVariant> operands{
+        QVariant(),
+        QVariant(true),
+        QVariant(false),
+        QVariant(0),
+        QVariant(1),
+        QVariant(""),
+        QVariant("abc"),
+        QVariant("false"),
+        QVariant(QStringList({"a", "b"})),
+        QVariant(QColor("#ff0000")),
+    };
+
+    auto filterResult = Filter::fromString(R".(!author.subbed).");
+    ASSERT_TRUE(std::holds_alternative<Filter>(filterResult));
+    const auto &filter = std::get<Filter>(filterResult);
+
+    for (const auto &operand : operands)
+    {
+        ContextMap contextMap;
+        if (operand.isValid())
+        {
+            contextMap.insert("author.subbed", operand);
+        }
+
+        auto expected = filter.execute(contextMap);
+        ContextMapSource source(contextMap);
+        auto compiledResult = valueToVariant(filter.execute(source));
+
+        EXPECT_EQ(compiledResult, expected)
+            << "Compiled !author.subbed with " << operand.toString()
+            << " evaluated to " << compiledResult.toString() << " instead of "
+            << expected.toString();
+    }
+}
+
+TEST(Filters, Compilation)
+{
+    struct TestCase {
+        QString input;
+        std::vector<OpCode> instructions;
+    };
+
+    // clang-format off
+    std::vector<TestCase> tests{
+        // constant sub-expressions are evaluated at compile time
+        {R".(1 + 2 * 3).", {OpCode::PushConstant}},
+        {R".({"a", "b"} contains "A").", {OpCode::PushConstant}},
+        {R".(author.sub_length > (1 + 1)).", {OpCode::PushIdentifier, OpCode::PushConstant, OpCode::GtInt}},
+        // logical operators short-circuit
+        {R".(flags.reply && flags.automod).", {OpCode::PushIdentifier, OpCode::JumpIfFalseOrPop, OpCode::PushIdentifier}},
+        {R".(flags.reply || flags.automod).", {OpCode::PushIdentifier, OpCode::JumpIfTrueOrPop, OpCode::PushIdentifier}},
+        {R".(!author.subbed).", {OpCode::PushIdentifier, OpCode::Not}},
+        {R".(author.name == "icelys").", {OpCode::PushIdentifier, OpCode::PushConstant, OpCode::EqString}},
+        {R".(author.badges contains "moderator").", {OpCode::PushIdentifier, OpCode::PushConstant, OpCode::ContainsStringList}},
+        {R".(message.content match r"abc").", {OpCode::PushIdentifier, OpCode::MatchRegex}},
+        {R".(message.content match {r"(a)bc", 1}).", {OpCode::PushIdentifier, OpCode::CaptureRegex}},
+        // operand types without a specialized instruction
+        {R".(author.color == "#ff0000").", {OpCode::PushIdentifier, OpCode::PushConstant, OpCode::Generic}},
+    };
+    // clang-format on
+
+    for (const auto &[input, expected] : tests)
+    {
+        auto filterResult = Filter::fromString(input);
+        ASSERT_TRUE(std::holds_alternative<Filter>(filterResult))
+            << "Filter::fromString( " << input << " ) is invalid";
+
+        const auto &program = std::get<Filter>(filterResult).program();
+
+        std::vector<OpCode> actual;
+        for (const auto &instruction : program.instructions())
+        {
+            actual.push_back(instruction.op);
+        }
+
+        EXPECT_EQ(actual, expected)
+            << "Filter{ " << input << " } compiled to unexpected instructions";
     }
 }
 
@@ -294,6 +408,58 @@ TEST_F(FiltersF, TypingContextChecks)
 
     EXPECT_EQ(contextMap.size(), MESSAGE_TYPING_CONTEXT.size());
 
+    // Every identifier must evaluate to the type it's declared with
+    MessageIdentifierSource identifiers(*msg, &channel);
+    for (std::size_t i = 0; i < IDENTIFIER_COUNT; ++i)
+    {
+        auto identifier = static_cast<Identifier>(i);
+        auto value = identifiers.value(identifier);
+        bool typeMatches = [&] {
+            switch (identifierInfo(identifier).type)
+            {
+                case Type::Bool:
+                    return std::holds_alternative<bool>(value);
+                case Type::Int:
+                    return std::holds_alternative<int>(value);
+                case Type::String:
+                    return std::holds_alternative<QString>(value);
+                case Type::StringList:
+                    return std::holds_alternative<QStringList>(value);
+                case Type::Color:
+                    return std::holds_alternative<QColor>(value);
+                default:
+                    return false;
+            }
+        }();
+        EXPECT_TRUE(typeMatches)
+            << identifierToString(identifier)
+            << " doesn't evaluate to its declared type";
+    }
+
+    // The compiled filters must agree with the expression tree
+    std::vector<QString> filters{
+        R".(author.subbed && author.sub_length == 80).",
+        R".(author.badges contains "broadcaster").",
+        R".(author.name == "PAJLADA" && channel.name == "pajlada").",
+        R".(author.color == "#CC44FF").",
+        R".(flags.action || message.length > 100).",
+        R".(message.content match {r"(\w+)", 1}).",
+        R".(reward.cost < 0 && reward.title == "").",
+    };
+    for (const auto &input : filters)
+    {
+        auto filterResult = Filter::fromString(input);
+        ASSERT_TRUE(std::holds_alternative<Filter>(filterResult))
+            << "Filter::fromString( " << input << " ) is invalid";
+        const auto &filter = std::get<Filter>(filterResult);
+
+        MessageIdentifierSource source(*msg, &channel);
+        EXPECT_EQ(valueToVariant(filter.execute(source)),
+                  filter.execute(contextMap))
+            << "Compiled Filter{ " << input
+            << " } disagrees with the expression tree";
+    }
+
     delete privmsg;
 }
 
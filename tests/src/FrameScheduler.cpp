@@ -0,0 +1,106 @@
+#include "singletons/helper/FrameScheduler.hpp"
+
+#include "Test.hpp"
+
+#include <vector>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Returns the lines of the buckets of `histogram`, without the title
+std::vector<QString> bucketLines(const FrameTimeHistogram &histogram)
+{
+    auto lines = histogram.toString("Frames").split('\n', Qt::SkipEmptyParts);
+    return {lines.begin() + 1, lines.end()};
+}
+
+}  // namespace
+
+TEST(FrameTimeHistogram, bucketBounds)
+{
+    FrameTimeHistogram histogram;
+    ASSERT_EQ(histogram.toString("Frames"), "Frames: 0\n"
+                                            "  < 1ms: 0\n"
+                                            "  < 2ms: 0\n"
+                                            "  < 4ms: 0\n"
+                                            "  < 8ms: 0\n"
+                                            "  < 16ms: 0\n"
+                                            "  < 32ms: 0\n"
+                                            "  >= 32ms: 0\n");
+
+    // upper bounds are exclusive
+    histogram.record(0ns);
+    histogram.record(999us);
+    histogram.record(1ms);
+    histogram.record(3999us);
+    histogram.record(4ms);
+    histogram.record(31ms);
+    histogram.record(32ms);
+    histogram.record(10s);
+
+    auto lines = bucketLines(histogram);
+    ASSERT_EQ(lines, std::vector<QString>({
+                         "  < 1ms: 2",
+                         "  < 2ms: 1",
+                         "  < 4ms: 1",
+                         "  < 8ms: 1",
+                         "  < 16ms: 0",
+                         "  < 32ms: 1",
+                         "  >= 32ms: 2",
+                     }));
+    ASSERT_TRUE(histogram.toString("Paints").startsWith("Paints: 8\n"));
+}
+
+TEST(FrameScheduler, frameInterval)
+{
+    ASSERT_EQ(FrameScheduler::frameInterval(false, 60, 30), 16ms);
+    ASSERT_EQ(FrameScheduler::frameInterval(true, 60, 30), 33ms);
+
+    // the background is never faster than the foreground
+    ASSERT_EQ(FrameScheduler::frameInterval(true, 15, 60), 66ms);
+
+    // limits are clamped to 1-1000 frames per second
+    ASSERT_EQ(FrameScheduler::frameInterval(false, 0, 0), 1000ms);
+    ASSERT_EQ(FrameScheduler::frameInterval(false, 5000, 0), 1ms);
+    ASSERT_EQ(FrameScheduler::frameInterval(true, 120, -1), 1000ms);
+}
+
+TEST(FrameScheduler, nextFrameDue)
+{
+    auto start = std::chrono::steady_clock::time_point{} + 1h;
+    auto foreground = FrameScheduler::frameInterval(false, 60, 15);
+    auto background = FrameScheduler::frameInterval(true, 60, 15);
+
+    // the earliest view wins, even if it was listed after a later one
+    std::vector<FrameScheduler::ViewTiming> views{
+        {.lastFrame = start, .interval = background},
+        {.lastFrame = start + 10ms, .interval = foreground},
+    };
+    ASSERT_EQ(FrameScheduler::nextFrameDue(views, start, foreground),
+              start + 10ms + foreground);
+
+    // a background view due earlier than a foreground view
+    views = {
+        {.lastFrame = start + 100ms, .interval = foreground},
+        {.lastFrame = start, .interval = background},
+    };
+    ASSERT_EQ(FrameScheduler::nextFrameDue(views, start, foreground),
+              start + background);
+
+    // frames are at least one foreground interval apart
+    views = {
+        {.lastFrame = start, .interval = foreground},
+    };
+    ASSERT_EQ(FrameScheduler::nextFrameDue(views, start + 50ms, foreground),
+              start + 50ms + foreground);
+
+    // views that are overdue are drawn right after the last frame
+    views = {
+        {.lastFrame = start - 1s, .interval = background},
+        {.lastFrame = start - 2s, .interval = foreground},
+    };
+    ASSERT_EQ(FrameScheduler::nextFrameDue(views, start, foreground),
+              start + foreground);
+}
@@ -1,6 +1,8 @@
 #include "controllers/ignores/IgnoreController.hpp"
 
 #include "controllers/accounts/AccountController.hpp"
+#include "controllers/ignores/IgnorePhrase.hpp"
+#include "controllers/ignores/IgnorePhraseSet.hpp"
 #include "mocks/BaseApplication.hpp"
 #include "mocks/Emotes.hpp"
 #include "providers/twitch/TwitchIrc.hpp"
@@ -135,6 +137,13 @@ TEST_F(TestIgnoreController, processIgnorePhrases)
             "Kappa",
             {emoteAt(127, "Kappa")},
         },
+        {
+            {regularReplace("foo", "longer")},
+            "foo Kappa foo Keepo foo",
+            {emoteAt(4, "Kappa"), emoteAt(14, "Keepo")},
+            "longer Kappa longer Keepo longer",
+            {emoteAt(7, "Kappa"), emoteAt(20, "Keepo")},
+        },
         {
             {regexReplace("abc", "def", false)},
             "AbC Kappa",
@@ -184,3 +193,29 @@ TEST_F(TestIgnoreController, processIgnorePhrases)
             << "' and output '" << message << "'";
     }
 }
+
+TEST_F(TestIgnoreController, IgnorePhraseSet)
+{
+    auto phrases = std::make_shared<const std::vector<IgnorePhrase>>(
+        std::vector<IgnorePhrase>{
+            IgnorePhrase("spam", false, true, "", false),
+            IgnorePhrase("f(o+)", true, false, "***", true),
+            IgnorePhrase("(x)\\1", true, true, "", true),
+            IgnorePhrase("bar", false, false, "***", true),
+            IgnorePhrase("", false, true, "", true),
+            IgnorePhrase("Baz", false, false, "***", true),
+        });
+    IgnorePhraseSet set(phrases);
+
+    ASSERT_EQ(set.findBlock("no match here"), nullptr);
+    ASSERT_EQ(set.findBlock("SPAM"), &(*phrases)[0]);
+    ASSERT_EQ(set.findBlock("xx"), &(*phrases)[2]);
+    ASSERT_EQ(set.findBlock("xy spam xx"), &(*phrases)[0]);
+
+    using Indices = std::vector<std::size_t>;
+    ASSERT_EQ(set.findReplacements("spam"), Indices{});
+    ASSERT_EQ(set.findReplacements("foo bar baz"), (Indices{1, 3}));
+    ASSERT_EQ(set.findReplacements("foo bar Baz"), (Indices{1, 3, 5}));
+    ASSERT_EQ(set.findReplacements("foo bar Baz", 2), (Indices{3, 5}));
+    ASSERT_EQ(set.findReplacements("FOO BAR"), Indices{});
+}
@@ -0,0 +1,119 @@
+#include "messages/ImageDecodeQueue.hpp"
+
+#include "Test.hpp"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+/// Occupies the only thread of a queue until `release` is called
+class Blocker
+{
+public:
+    explicit Blocker(ImageDecodeQueue &queue)
+    {
+        queue.push(ImagePriority::Visible, this->owner_, [this] {
+            this->started_.set_value();
+            this->release_.get_future().wait();
+        });
+        this->started_.get_future().wait();
+    }
+
+    void release()
+    {
+        this->release_.set_value();
+    }
+
+private:
+    std::shared_ptr<int> owner_ = std::make_shared<int>();
+    std::promise<void> started_;
+    std::promise<void> release_;
+};
+
+class Recorder
+{
+public:
+    std::function<void()> record(int id)
+    {
+        return [this, id] {
+            std::lock_guard lock(this->mutex_);
+            this->order_.push_back(id);
+        };
+    }
+
+    std::vector<int> order()
+    {
+        std::lock_guard lock(this->mutex_);
+        return this->order_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<int> order_;
+};
+
+}  // namespace
+
+TEST(ImageDecodeQueue, RunsByPriority)
+{
+    ImageDecodeQueue queue(1);
+    Recorder recorder;
+    auto owner = std::make_shared<int>();
+
+    Blocker blocker(queue);
+    queue.push(ImagePriority::Prefetch, owner, recorder.record(1));
+    queue.push(ImagePriority::Popup, owner, recorder.record(2));
+    queue.push(ImagePriority::Visible, owner, recorder.record(3));
+    queue.push(ImagePriority::Prefetch, owner, recorder.record(4));
+    queue.push(ImagePriority::Visible, owner, recorder.record(5));
+    blocker.release();
+    queue.waitForDone();
+
+    ASSERT_EQ(recorder.order(), (std::vector{3, 5, 2, 1, 4}));
+}
+
+TEST(ImageDecodeQueue, Raise)
+{
+    ImageDecodeQueue queue(1);
+    Recorder recorder;
+    auto owner = std::make_shared<int>();
+
+    Blocker blocker(queue);
+    auto first = queue.push(ImagePriority::Prefetch, owner, recorder.record(1));
+    queue.push(ImagePriority::Visible, owner, recorder.record(2));
+    auto third = queue.push(ImagePriority::Prefetch, owner, recorder.record(3));
+    queue.raise(third, ImagePriority::Visible);
+    // not lower
+    queue.raise(third, ImagePriority::Popup);
+    blocker.release();
+    queue.waitForDone();
+
+    ASSERT_EQ(recorder.order(), (std::vector{2, 3, 1}));
+
+    // raising a job that already ran does nothing
+    queue.raise(first, ImagePriority::Visible);
+    queue.waitForDone();
+    ASSERT_EQ(recorder.order(), (std::vector{2, 3, 1}));
+}
+
+TEST(ImageDecodeQueue, SkipsExpiredOwners)
+{
+    ImageDecodeQueue queue(1);
+    Recorder recorder;
+    auto owner = std::make_shared<int>();
+    auto expired = std::make_shared<int>();
+
+    Blocker blocker(queue);
+    queue.push(ImagePriority::Visible, expired, recorder.record(1));
+    queue.push(ImagePriority::Visible, owner, recorder.record(2));
+    expired.reset();
+    blocker.release();
+    queue.waitForDone();
+
+    ASSERT_EQ(recorder.order(), (std::vector{2}));
+}
@@ -0,0 +1,119 @@
+#include "common/websockets/IoRuntime.hpp"
+
+#include "Test.hpp"
+#include "util/OnceFlag.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+TEST(IoRuntime, PostRunsOnStrand)
+{
+    auto runtime = std::make_shared<IoRuntime>(4);
+    auto client = runtime->registerClient("test");
+
+    // Not atomic - the strand serializes the handlers
+    int counter = 0;
+    bool onStrand = true;
+    OnceFlag done;
+    for (int i = 0; i < 1000; i++)
+    {
+        client->post([&] {
+            onStrand = onStrand && client->strand().running_in_this_thread();
+            counter++;
+        });
+    }
+    client->post([&] {
+        done.set();
+    });
+
+    ASSERT_TRUE(done.waitFor(1s));
+    ASSERT_EQ(counter, 1000);
+    ASSERT_TRUE(onStrand);
+
+    client->close();
+    runtime->stop();
+}
+
+TEST(IoRuntime, ClosedClientDropsHandlers)
+{
+    auto runtime = std::make_shared<IoRuntime>(2);
+    auto client = runtime->registerClient("test");
+    auto other = runtime->registerClient("other");
+
+    OnceFlag ran;
+    client->close();
+    ASSERT_TRUE(client->isClosed());
+    client->post([&] {
+        ran.set();
+    });
+
+    // Other clients aren't affected
+    OnceFlag otherRan;
+    other->post([&] {
+        otherRan.set();
+    });
+    ASSERT_TRUE(otherRan.waitFor(1s));
+    ASSERT_FALSE(ran.waitFor(50ms));
+
+    other->close();
+    runtime->stop();
+}
+
+TEST(IoRuntime, CloseWaitsForRunningHandler)
+{
+    auto runtime = std::make_shared<IoRuntime>(2);
+    auto client = runtime->registerClient("test");
+
+    OnceFlag started;
+    std::atomic<bool> finished = false;
+    client->post([&] {
+        started.set();
+        std::this_thread::sleep_for(50ms);
+        finished = true;
+    });
+    ASSERT_TRUE(started.waitFor(1s));
+
+    client->close();
+    ASSERT_TRUE(finished);
+
+    runtime->stop();
+}
+
+TEST(IoRuntime, StopDropsPendingHandlers)
+{
+    auto runtime = std::make_shared<IoRuntime>(1);
+    std::weak_ptr<IoRuntime> weakRuntime = runtime;
+    auto client = runtime->registerClient("test");
+
+    OnceFlag started;
+    OnceFlag release;
+    client->post([&] {
+        started.set();
+        release.wait();
+    });
+    ASSERT_TRUE(started.waitFor(1s));
+
+    // These are queued behind the running handler and never run. They own
+    // the client, which owns the runtime.
+    std::atomic<bool> ran = false;
+    client->post([client, &ran] {
+        ran = true;
+    });
+    client->post(client->strand(), [client, &ran] {
+        ran = true;
+    });
+
+    runtime->context().stop();
+    release.set();
+    runtime->stop();
+    ASSERT_FALSE(ran);
+    ASSERT_TRUE(client->isClosed());
+
+    client.reset();
+    runtime.reset();
+    ASSERT_TRUE(weakRuntime.expired());
+}
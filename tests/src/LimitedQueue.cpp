@@ -2,10 +2,13 @@
 
 #include "Test.hpp"
 
+#include <ranges>
 #include <vector>
 
 using namespace chatterino;
 
+static_assert(std::ranges::random_access_range<LimitedQueueSnapshot<int>>);
+
 namespace chatterino {
 
 template <typename T>
@@ -95,6 +98,36 @@ TEST(LimitedQueue, PushBack)
     SNAPSHOT_EQUALS(snapshot1, {1, 2}, "first snapshot same 3");
 }
 
+TEST(LimitedQueue, PushBackMany)
+{
+    LimitedQueue<int> queue(5);
+    std::vector<int> deleted;
+
+    std::vector<int> first{1, 2, 3};
+    EXPECT_EQ(queue.pushBack(std::span<const int>(first), &deleted), 0);
+    EXPECT_TRUE(deleted.empty());
+
+    auto snapshot1 = queue.getSnapshot();
+    SNAPSHOT_EQUALS(snapshot1, {1, 2, 3}, "first snapshot");
+
+    std::vector<int> second{4, 5, 6, 7};
+    EXPECT_EQ(queue.pushBack(std::span<const int>(second), &deleted), 2);
+    EXPECT_EQ(deleted, (std::vector{1, 2}));
+
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {3, 4, 5, 6, 7}, "second snapshot");
+    SNAPSHOT_EQUALS(snapshot1, {1, 2, 3}, "first snapshot same");
+
+    // more items than the limit evict the first pushed ones as well
+    deleted.clear();
+    std::vector<int> third{10, 11, 12, 13, 14, 15, 16};
+    EXPECT_EQ(queue.pushBack(std::span<const int>(third), &deleted), 7);
+    EXPECT_EQ(deleted, (std::vector{3, 4, 5, 6, 7, 10, 11}));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {12, 13, 14, 15, 16},
+                    "third snapshot");
+
+    EXPECT_EQ(queue.pushBack(std::span<const int>()), 0);
+}
+
 TEST(LimitedQueue, PushFront)
 {
     LimitedQueue<int> queue(5);
@@ -264,3 +297,62 @@ TEST(LimitedQueue, Find)
                            })
                      .has_value());
 }
+
+TEST(LimitedQueue, SnapshotIsolation)
+{
+    // Spans several chunks
+    LimitedQueue<int> queue(150);
+    std::vector<int> expected;
+    for (int i = 0; i < 150; ++i)
+    {
+        queue.pushBack(i);
+        expected.push_back(i);
+    }
+
+    auto snapshot = queue.getSnapshot();
+    auto same = queue.getSnapshot();
+    SNAPSHOT_EQUALS(same, expected, "unchanged queue");
+
+    queue.replaceItem(std::size_t(0), -1);
+    queue.replaceItem(std::size_t(100), -2);
+    for (int i = 150; i < 220; ++i)
+    {
+        queue.pushBack(i);
+    }
+    SNAPSHOT_EQUALS(snapshot, expected, "after replace and evict");
+
+    auto evicted = queue.getSnapshot();
+    ASSERT_EQ(evicted.size(), 150);
+    EXPECT_EQ(evicted[0], 70);
+    EXPECT_EQ(evicted[30], -2);
+    EXPECT_EQ(evicted[149], 219);
+
+    queue.clear();
+    EXPECT_EQ(queue.pushFront({1, 2, 3}).size(), 3);
+    queue.pushBack(4);
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {1, 2, 3, 4}, "after clear");
+    SNAPSHOT_EQUALS(snapshot, expected, "after clear");
+    EXPECT_EQ(evicted[0], 70);
+
+    auto reversed = std::vector<int>(evicted.rbegin(), evicted.rend());
+    EXPECT_EQ(reversed.front(), 219);
+    EXPECT_EQ(reversed.back(), 70);
+}
+
+TEST(LimitedQueue, Insert)
+{
+    LimitedQueue<int> queue(4);
+    queue.pushBack(1);
+    queue.pushBack(3);
+    auto snapshot = queue.getSnapshot();
+
+    EXPECT_TRUE(queue.insertBefore(3, 2));
+    EXPECT_TRUE(queue.insertAfter(3, 4));
+    EXPECT_FALSE(queue.insertAfter(5, 6));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {1, 2, 3, 4}, "inserted");
+    SNAPSHOT_EQUALS(snapshot, {1, 3}, "old snapshot");
+
+    // A full queue evicts the front
+    EXPECT_TRUE(queue.insertAfter(4, 5));
+    SNAPSHOT_EQUALS(queue.getSnapshot(), {2, 3, 4, 5}, "evicted");
+}
@@ -0,0 +1,177 @@
+#include "singletons/helper/LogWriter.hpp"
+
+#include "singletons/helper/CompressedLog.hpp"
+#include "Test.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <chrono>
+#include <thread>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+QString readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return {};
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+}  // namespace
+
+TEST(LogWriter, drainsOnDestruction)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    auto directory = tmp.filePath("Twitch/Channels/forsen");
+
+    {
+        LogWriter writer;
+        auto file = writer.open(directory, "forsen.log");
+        auto other = writer.open(directory, "forsen-other.log");
+        for (int i = 0; i < 1000; i++)
+        {
+            writer.append(file, QString("line %1\n").arg(i));
+        }
+        writer.append(other, "first\n");
+        writer.close(other);
+    }
+
+    QString expected;
+    for (int i = 0; i < 1000; i++)
+    {
+        expected += QString("line %1\n").arg(i);
+    }
+    ASSERT_EQ(readFile(directory + "/forsen.log"), expected);
+    ASSERT_EQ(readFile(directory + "/forsen-other.log"), "first\n");
+}
+
+TEST(LogWriter, appendsToExistingFile)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    for (const auto *line : {"a\n", "b\n"})
+    {
+        LogWriter writer;
+        auto file = writer.open(tmp.path(), "test.log");
+        writer.append(file, line);
+        writer.close(file);
+    }
+
+    ASSERT_EQ(readFile(tmp.filePath("test.log")), "a\nb\n");
+}
+
+TEST(LogWriter, emptyFileIsNotCreated)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    {
+        LogWriter writer;
+        auto file = writer.open(tmp.path(), "empty.log");
+        writer.close(file);
+    }
+
+    ASSERT_FALSE(QFile::exists(tmp.filePath("empty.log")));
+}
+
+TEST(LogWriter, writesCompressedBlocksOnClose)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    {
+        LogWriter writer;
+        auto file = writer.open(tmp.path(), "test.clog");
+        writer.appendCompressed(file,
+                                {
+                                    .timestamp = QDateTime::currentDateTime(),
+                                    .userID = "11148817",
+                                    .loginName = "pajlada",
+                                    .text = "pajlada: hello",
+                                });
+        writer.close(file);
+    }
+
+    auto entries = CompressedLogReader::search(tmp.filePath("test.clog"), {});
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_EQ(entries[0].text, "pajlada: hello");
+}
+
+TEST(LogWriter, dropsIncompleteCompressedBlock)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+    auto path = tmp.filePath("test.clog");
+
+    auto write = [&](const QString &text) {
+        LogWriter writer;
+        auto file = writer.open(tmp.path(), "test.clog");
+        writer.appendCompressed(file,
+                                {
+                                    .timestamp = QDateTime::currentDateTime(),
+                                    .userID = "11148817",
+                                    .loginName = "pajlada",
+                                    .text = text,
+                                });
+        writer.close(file);
+    };
+
+    write("pajlada: first");
+    auto firstBlock = QFileInfo(path).size();
+    write("pajlada: crashed");
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.resize(file.size() - 10));
+    }
+    write("pajlada: after");
+
+    auto entries = CompressedLogReader::search(path, {});
+    ASSERT_EQ(entries.size(), 2);
+    ASSERT_EQ(entries[0].text, "pajlada: first");
+    ASSERT_EQ(entries[1].text, "pajlada: after");
+
+    // The incomplete block was cut off before appending, so the new block
+    // starts right after the first one
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    auto data = file.readAll();
+    ASSERT_EQ(data.indexOf("CLB1", 1), firstBlock);
+    ASSERT_EQ(data.indexOf("CLB1", firstBlock + 1), -1);
+}
+
+TEST(LogWriter, writesOldCompressedBlocks)
+{
+    QTemporaryDir tmp;
+    ASSERT_TRUE(tmp.isValid());
+
+    // The file is never closed, a quiet channel must still get its block
+    // written once it's too old
+    LogWriter writer(100ms);
+    auto file = writer.open(tmp.path(), "quiet.clog");
+    writer.appendCompressed(file, {
+                                      .timestamp = QDateTime::currentDateTime(),
+                                      .userID = "11148817",
+                                      .loginName = "pajlada",
+                                      .text = "pajlada: hello",
+                                  });
+
+    std::vector<CompressedLogEntry> entries;
+    for (int i = 0; i < 100 && entries.empty(); i++)
+    {
+        std::this_thread::sleep_for(50ms);
+        entries = CompressedLogReader::search(tmp.filePath("quiet.clog"), {});
+    }
+    ASSERT_EQ(entries.size(), 1);
+    ASSERT_EQ(entries[0].loginName, "pajlada");
+}
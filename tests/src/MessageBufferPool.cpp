@@ -0,0 +1,115 @@
+#include "messages/layouts/MessageBufferPool.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+namespace {
+
+constexpr size_t BYTES_PER_PIXEL = 4;
+
+size_t bytes(QSize size)
+{
+    return static_cast<size_t>(size.width()) *
+           static_cast<size_t>(size.height()) * BYTES_PER_PIXEL;
+}
+
+}  // namespace
+
+TEST(MessageBufferPool, reusesBuffersOfTheSameSize)
+{
+    MessageBufferPool pool(1024 * 1024);
+
+    auto first = pool.acquire({100, 20}, 1.0);
+    const auto *firstPtr = first.get();
+    ASSERT_EQ(first->size(), QSize(100, 20));
+    ASSERT_EQ(pool.usedBytes(), bytes({100, 20}));
+
+    pool.release(std::move(first));
+    ASSERT_EQ(pool.usedBytes(), 0U);
+    ASSERT_EQ(pool.idleBytes(), bytes({100, 20}));
+
+    // Different size or device pixel ratio
+    auto other = pool.acquire({100, 40}, 1.0);
+    ASSERT_NE(other.get(), firstPtr);
+    auto scaled = pool.acquire({100, 20}, 2.0);
+    ASSERT_NE(scaled.get(), firstPtr);
+    ASSERT_EQ(scaled->devicePixelRatio(), 2.0);
+
+    auto reused = pool.acquire({100, 20}, 1.0);
+    ASSERT_EQ(reused.get(), firstPtr);
+    ASSERT_EQ(pool.idleBytes(), 0U);
+}
+
+TEST(MessageBufferPool, evictsLeastRecentlyReleased)
+{
+    // Room for three buffers
+    MessageBufferPool pool(3 * bytes({100, 20}));
+
+    auto a = pool.acquire({100, 20}, 1.0);
+    auto b = pool.acquire({100, 20}, 1.0);
+    auto c = pool.acquire({100, 20}, 1.0);
+    const auto *cPtr = c.get();
+    pool.release(std::move(a));
+    pool.release(std::move(b));
+    pool.release(std::move(c));
+    ASSERT_EQ(pool.idleBytes(), 3 * bytes({100, 20}));
+
+    // Doesn't fit, so the oldest idle buffers are freed
+    auto large = pool.acquire({100, 40}, 1.0);
+    ASSERT_EQ(pool.usedBytes(), bytes({100, 40}));
+    ASSERT_EQ(pool.idleBytes(), bytes({100, 20}));
+
+    auto reused = pool.acquire({100, 20}, 1.0);
+    ASSERT_EQ(reused.get(), cPtr);
+
+    pool.release(std::move(large));
+    pool.release(std::move(reused));
+    pool.setBudget(bytes({100, 20}));
+    ASSERT_EQ(pool.idleBytes(), bytes({100, 20}));
+
+    pool.clear();
+    ASSERT_EQ(pool.idleBytes(), 0U);
+}
+
+TEST(MessageBufferPool, reclaimsLeastRecentlyUsedBuffers)
+{
+    // Room for two buffers
+    MessageBufferPool pool(2 * bytes({100, 20}));
+
+    std::unique_ptr<QPixmap> a;
+    std::unique_ptr<QPixmap> b;
+    auto owner = [&](std::unique_ptr<QPixmap> &buffer) {
+        return [&pool, &buffer] {
+            pool.release(std::move(buffer));
+        };
+    };
+
+    a = pool.acquire({100, 20}, 1.0, owner(a));
+    b = pool.acquire({100, 20}, 1.0, owner(b));
+    ASSERT_EQ(pool.usedBytes(), 2 * bytes({100, 20}));
+
+    // `a` was painted more recently than `b`, so `b` is taken back
+    pool.touch(a.get());
+    auto c = pool.acquire({100, 20}, 1.0);
+    ASSERT_TRUE(a != nullptr);
+    ASSERT_TRUE(b == nullptr);
+    ASSERT_EQ(pool.usedBytes(), 2 * bytes({100, 20}));
+    // Reclaimed buffers are freed, not kept for reuse
+    ASSERT_EQ(pool.idleBytes(), 0U);
+
+    // Buffers without an owner to reclaim them stay, even over the budget
+    auto d = pool.acquire({100, 20}, 1.0);
+    ASSERT_TRUE(a == nullptr);
+    ASSERT_EQ(pool.usedBytes(), 2 * bytes({100, 20}));
+    auto e = pool.acquire({100, 20}, 1.0);
+    ASSERT_EQ(pool.usedBytes(), 3 * bytes({100, 20}));
+
+    // Released while over the budget, so it's freed
+    pool.release(std::move(e));
+    ASSERT_EQ(pool.usedBytes(), 2 * bytes({100, 20}));
+    ASSERT_EQ(pool.idleBytes(), 0U);
+
+    pool.release(std::move(d));
+    ASSERT_EQ(pool.idleBytes(), bytes({100, 20}));
+}
@@ -0,0 +1,160 @@
+#include "messages/MessageIngest.hpp"
+
+#include "Test.hpp"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+/// Records the order results are applied in (only in the GUI thread)
+class Recorder
+{
+public:
+    MessageIngest::Apply record(int id)
+    {
+        return [this, id] {
+            this->order.push_back(id);
+        };
+    }
+
+    std::vector<int> order;
+};
+
+}  // namespace
+
+TEST(MessageIngest, AppliesInOrder)
+{
+    auto ingest = MessageIngest::create();
+    Recorder recorder;
+
+    for (int i = 0; i < 20; i++)
+    {
+        ingest->post([&recorder, i] {
+            return recorder.record(i);
+        });
+    }
+    ingest->waitForDone();
+
+    std::vector<int> expected;
+    for (int i = 0; i < 20; i++)
+    {
+        expected.push_back(i);
+    }
+    ASSERT_EQ(recorder.order, expected);
+    ASSERT_TRUE(ingest->isIdle());
+}
+
+TEST(MessageIngest, RunsJobsOneAfterAnother)
+{
+    auto ingest = MessageIngest::create();
+    std::atomic<int> running = 0;
+    std::atomic<bool> overlapped = false;
+
+    for (int i = 0; i < 50; i++)
+    {
+        ingest->post([&] {
+            if (running.fetch_add(1) != 0)
+            {
+                overlapped = true;
+            }
+            running.fetch_sub(1);
+            return MessageIngest::Apply{};
+        });
+    }
+    ingest->waitForDone();
+
+    ASSERT_FALSE(overlapped);
+}
+
+TEST(MessageIngest, RunInOrder)
+{
+    auto ingest = MessageIngest::create();
+    Recorder recorder;
+
+    // nothing pending
+    ingest->runInOrder(recorder.record(1));
+    ASSERT_EQ(recorder.order, (std::vector{1}));
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    ingest->post([&recorder, released] {
+        released.wait();
+        return recorder.record(2);
+    });
+    ingest->runInOrder(recorder.record(3));
+    ingest->post([&recorder] {
+        return recorder.record(4);
+    });
+
+    ASSERT_EQ(recorder.order, (std::vector{1}));
+    ASSERT_FALSE(ingest->isIdle());
+
+    release.set_value();
+    ingest->waitForDone();
+
+    ASSERT_EQ(recorder.order, (std::vector{1, 2, 3, 4}));
+    ASSERT_TRUE(ingest->isIdle());
+}
+
+TEST(MessageIngest, Independent)
+{
+    auto first = MessageIngest::create();
+    auto second = MessageIngest::create();
+    Recorder recorder;
+
+    // the second ingest isn't held up by the first one
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    first->post([&recorder, released] {
+        released.wait();
+        return recorder.record(1);
+    });
+    second->post([&recorder] {
+        return recorder.record(2);
+    });
+    second->runInOrder(recorder.record(3));
+
+    while (!second->isIdle())
+    {
+        second->flush();
+    }
+    ASSERT_EQ(recorder.order, (std::vector{2, 3}));
+
+    release.set_value();
+    first->waitForDone();
+    ASSERT_EQ(recorder.order, (std::vector{2, 3, 1}));
+}
+
+TEST(MessageIngest, AfterFlush)
+{
+    auto ingest = MessageIngest::create();
+    Recorder recorder;
+    ingest->setAfterFlush(recorder.record(-1));
+
+    // nothing applied
+    ingest->flush();
+    ASSERT_TRUE(recorder.order.empty());
+
+    for (int i = 0; i < 3; i++)
+    {
+        ingest->post([&recorder, i] {
+            return recorder.record(i);
+        });
+    }
+    ingest->waitForDone();
+
+    // runs once after all results of the flush
+    ASSERT_EQ(recorder.order, (std::vector{0, 1, 2, -1}));
+
+    ingest->setAfterFlush({});
+    ingest->post([&recorder] {
+        return recorder.record(3);
+    });
+    ingest->waitForDone();
+    ASSERT_EQ(recorder.order, (std::vector{0, 1, 2, -1, 3}));
+}
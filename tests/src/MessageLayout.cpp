@@ -3,6 +3,8 @@
 #include "Application.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "messages/layouts/MessageLayoutContext.hpp"
+#include "messages/layouts/TextPreparation.hpp"
+#include "messages/LimitedQueue.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
 #include "mocks/BaseApplication.hpp"
@@ -13,6 +15,7 @@
 #include "singletons/WindowManager.hpp"
 #include "Test.hpp"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QString>
 
@@ -91,3 +94,75 @@ TEST(TextElement, BasicCase)
     EXPECT_EQ(wordStart, 0);
     EXPECT_EQ(wordEnd, 3);
 }
+
+TEST(TextPreparation, MatchesSynchronousMeasurement)
+{
+    MockApplication app;
+
+    MessageBuilder builder;
+    builder.append(std::make_unique<TextElement>(
+        "Kappa 123 forsenE   the quick brown fox", MessageElementFlag::Text));
+    builder.append(std::make_unique<TextElement>(
+        "bold", MessageElementFlag::Text, MessageColor::Text,
+        FontStyle::ChatMediumBold));
+    auto message = builder.release();
+
+    LimitedQueue<MessageLayoutPtr> queue;
+    queue.pushBack(std::make_shared<MessageLayout>(message));
+    auto snapshot = queue.getSnapshot();
+
+    auto &preparation = app.windowManager.getTextPreparation();
+    preparation.prepare(snapshot, 1.5F);
+    ASSERT_TRUE(snapshot[0]->flags.has(MessageLayoutFlag::PreparingText));
+
+    // Queueing it again while it's being measured does nothing
+    preparation.prepare(snapshot, 1.5F);
+
+    preparation.waitForDone();
+    QCoreApplication::sendPostedEvents();
+
+    ASSERT_FALSE(snapshot[0]->flags.has(MessageLayoutFlag::PreparingText));
+    const auto &prepared = snapshot[0]->getPreparedText();
+    ASSERT_NE(prepared, nullptr);
+    ASSERT_TRUE(preparation.isCurrent(*prepared, 1.5F));
+    ASSERT_FALSE(preparation.isCurrent(*prepared, 1.0F));
+
+    for (const auto &element : message->elements)
+    {
+        const auto *text = dynamic_cast<const TextElement *>(element.get());
+        ASSERT_NE(text, nullptr);
+
+        const auto *widths = prepared->widths(text, text->fontStyle());
+        ASSERT_NE(widths, nullptr);
+        ASSERT_EQ(widths->size(), size_t(text->words().size()));
+
+        auto metrics = app.fonts.getFontMetrics(text->fontStyle(), 1.5F);
+        for (qsizetype i = 0; i < text->words().size(); i++)
+        {
+            EXPECT_DOUBLE_EQ((*widths)[size_t(i)],
+                             metrics.horizontalAdvance(text->words()[i]));
+        }
+
+        // Measured in a different style
+        ASSERT_EQ(prepared->widths(text, FontStyle::ChatLarge), nullptr);
+    }
+}
+
+TEST(Fonts, WordWidthsMatchMetrics)
+{
+    MockApplication app;
+
+    auto metrics = app.fonts.getFontMetrics(FontStyle::ChatMedium, 1.0F);
+    for (size_t cacheSize : {size_t(0), size_t(2)})
+    {
+        app.fonts.setWordWidthCacheSize(cacheSize);
+        auto &widths = app.fonts.getWordWidths(FontStyle::ChatMedium, 1.0F);
+
+        // Repeats and more words than fit into the cache
+        for (const auto *word : {"Kappa", "LUL", "Kappa", "forsenE", "LUL"})
+        {
+            EXPECT_DOUBLE_EQ(widths.width(word),
+                             metrics.horizontalAdvance(word));
+        }
+    }
+}
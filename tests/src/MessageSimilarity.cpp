@@ -0,0 +1,137 @@
+#include "messages/MessageSimilarity.hpp"
+
+#include "common/Literals.hpp"
+#include "Test.hpp"
+
+#include <QString>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace chatterino;
+using namespace literals;
+
+using Sketch = MessageSimilarityCache::Sketch;
+
+namespace {
+
+/// The implementation before the table was reduced to a single row
+qsizetype referenceLongestCommonSubstring(QStringView str1, QStringView str2)
+{
+    std::vector<std::vector<qsizetype>> tree(
+        str1.size(), std::vector<qsizetype>(str2.size(), 0));
+    qsizetype z = 0;
+
+    for (qsizetype i = 0; i < str1.size(); ++i)
+    {
+        for (qsizetype j = 0; j < str2.size(); ++j)
+        {
+            if (str1[i] == str2[j])
+            {
+                if (i == 0 || j == 0)
+                {
+                    tree[i][j] = 1;
+                }
+                else
+                {
+                    tree[i][j] = tree[i - 1][j - 1] + 1;
+                }
+                z = std::max(tree[i][j], z);
+            }
+            else
+            {
+                tree[i][j] = 0;
+            }
+        }
+    }
+
+    return z;
+}
+
+/// Random text from a small alphabet, so texts share substrings
+QString randomText(std::mt19937 &rng, qsizetype maxLength)
+{
+    std::uniform_int_distribution<qsizetype> length(0, maxLength);
+    std::uniform_int_distribution<int> letter('a', 'e');
+    QString text;
+    for (auto i = length(rng); i > 0; i--)
+    {
+        text.append(QChar(letter(rng)));
+    }
+    return text;
+}
+
+}  // namespace
+
+TEST(MessageSimilarity, longestCommonSubstring)
+{
+    struct TestCase {
+        QString a;
+        QString b;
+        qsizetype expected;
+    };
+
+    std::vector<TestCase> tests{
+        {"", "", 0},
+        {"", "forsen", 0},
+        {"forsen", "", 0},
+        {"forsen", "forsen", 6},
+        {"forsen", "nymn", 1},
+        {"abc", "xyz", 0},
+        {"hello world", "world hello", 5},
+        {"xxabcdyy", "abcd", 4},
+        {"abcd", "xxabcdyy", 4},
+        {"aaaa", "aa", 2},
+        {u"🙂 hi 🙂"_s, u"hi 🙂"_s, 5},
+    };
+
+    for (const auto &test : tests)
+    {
+        EXPECT_EQ(longestCommonSubstring(test.a, test.b), test.expected)
+            << test.a << " and " << test.b;
+    }
+}
+
+TEST(MessageSimilarity, longestCommonSubstringMatchesReference)
+{
+    std::mt19937 rng(42);
+    for (int i = 0; i < 1000; i++)
+    {
+        auto a = randomText(rng, 40);
+        auto b = randomText(rng, 40);
+        ASSERT_EQ(longestCommonSubstring(a, b),
+                  referenceLongestCommonSubstring(a, b))
+            << a << " and " << b;
+        ASSERT_EQ(longestCommonSubstring(b, a),
+                  referenceLongestCommonSubstring(a, b))
+            << b << " and " << a;
+    }
+}
+
+TEST(MessageSimilarity, commonUpperBound)
+{
+    auto bound = [](const QString &a, const QString &b) {
+        return Sketch::commonUpperBound(Sketch::of(a), Sketch::of(b));
+    };
+
+    EXPECT_EQ(bound("", ""), 0);
+    EXPECT_EQ(bound("", "forsen"), 0);
+    EXPECT_EQ(bound("forsen", "forsen"), 6);
+    EXPECT_EQ(bound("abc", "cba"), 3);
+
+    // Saturated buckets fall back to the shorter length
+    QString many(70000, QChar('a'));
+    EXPECT_EQ(bound(many, many), 70000);
+    EXPECT_EQ(bound(many, QString(65535, QChar('a')) + "b"), 65536);
+
+    // The bound never underestimates the longest common substring
+    std::mt19937 rng(42);
+    for (int i = 0; i < 1000; i++)
+    {
+        auto a = randomText(rng, 40);
+        auto b = randomText(rng, 40);
+        ASSERT_GE(bound(a, b), referenceLongestCommonSubstring(a, b))
+            << a << " and " << b;
+    }
+}
@@ -0,0 +1,241 @@
+#include "common/network/NetworkCache.hpp"
+
+#include "Test.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+using namespace chatterino;
+
+namespace {
+
+const QString KEY_A = QStringLiteral("aa");
+const QString KEY_B = QStringLiteral("bb");
+const QString KEY_C = QStringLiteral("cc");
+
+}  // namespace
+
+TEST(NetworkCache, storesAndReadsBodies)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 1024);
+    ASSERT_FALSE(cache.find(KEY_A).has_value());
+
+    cache.store(KEY_A, "body", "\"etag\"", {});
+    cache.flush();
+
+    auto entry = cache.find(KEY_A);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(entry->size, 4);
+    ASSERT_EQ(entry->etag, QByteArray("\"etag\""));
+    ASSERT_TRUE(entry->canRevalidate());
+    ASSERT_EQ(cache.read(KEY_A, *entry), QByteArray("body"));
+}
+
+TEST(NetworkCache, deduplicatesBodies)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 1024);
+    cache.store(KEY_A, "same", {}, {});
+    cache.store(KEY_B, "same", {}, {});
+    cache.flush();
+
+    ASSERT_EQ(cache.entryCount(), 2U);
+    ASSERT_EQ(cache.totalBytes(), 4);
+    ASSERT_EQ(cache.find(KEY_A)->blob, cache.find(KEY_B)->blob);
+}
+
+TEST(NetworkCache, evictsLeastRecentlyUsed)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 8);
+    cache.store(KEY_A, "aaaa", {}, {});
+    cache.store(KEY_B, "bbbb", {}, {});
+    cache.flush();
+
+    auto b = cache.find(KEY_B);
+    ASSERT_TRUE(b.has_value());
+    // Using A makes B the least recently used entry
+    ASSERT_TRUE(cache.find(KEY_A).has_value());
+
+    cache.store(KEY_C, "cccc", {}, {});
+    cache.flush();
+
+    ASSERT_EQ(cache.entryCount(), 2U);
+    ASSERT_EQ(cache.totalBytes(), 8);
+    ASSERT_TRUE(cache.find(KEY_A).has_value());
+    ASSERT_FALSE(cache.find(KEY_B).has_value());
+    ASSERT_TRUE(cache.find(KEY_C).has_value());
+
+    // The evicted body is deleted
+    ASSERT_FALSE(cache.read(KEY_B, *b).has_value());
+}
+
+TEST(NetworkCache, persistsIndex)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        NetworkCache cache(dir.path(), 1024);
+        cache.store(KEY_A, "body", {}, "Mon, 01 Jan 2024 00:00:00 GMT");
+    }
+
+    NetworkCache cache(dir.path(), 1024);
+    auto entry = cache.find(KEY_A);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(entry->lastModified,
+              QByteArray("Mon, 01 Jan 2024 00:00:00 GMT"));
+    ASSERT_EQ(cache.read(KEY_A, *entry), QByteArray("body"));
+}
+
+TEST(NetworkCache, persistsUsageOrder)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        NetworkCache cache(dir.path(), 8);
+        cache.store(KEY_A, "aaaa", {}, {});
+        cache.store(KEY_B, "bbbb", {}, {});
+        cache.flush();
+
+        // Only the order changes, it's saved when the cache is destroyed
+        ASSERT_TRUE(cache.find(KEY_A).has_value());
+    }
+
+    NetworkCache cache(dir.path(), 8);
+    cache.store(KEY_C, "cccc", {}, {});
+    cache.flush();
+
+    ASSERT_TRUE(cache.find(KEY_A).has_value());
+    ASSERT_FALSE(cache.find(KEY_B).has_value());
+    ASSERT_TRUE(cache.find(KEY_C).has_value());
+}
+
+TEST(NetworkCache, revalidatesStaleEntries)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 1024);
+    cache.store(KEY_A, "body", "\"etag\"", {});
+    cache.flush();
+
+    auto entry = cache.find(KEY_A);
+    ASSERT_TRUE(entry.has_value());
+    auto later =
+        entry->storedAt +
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            NetworkCache::MAX_AGE + std::chrono::hours(1))
+            .count();
+    ASSERT_FALSE(entry->isStale(entry->storedAt));
+    ASSERT_TRUE(entry->isStale(later));
+
+    cache.markRevalidated(KEY_A);
+    ASSERT_GE(cache.find(KEY_A)->storedAt, entry->storedAt);
+}
+
+TEST(NetworkCache, clearRemovesEverything)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 1024);
+    cache.store(KEY_A, "body", {}, {});
+    cache.flush();
+    auto entry = cache.find(KEY_A);
+    ASSERT_TRUE(entry.has_value());
+
+    cache.clear();
+    ASSERT_EQ(cache.entryCount(), 0U);
+    ASSERT_EQ(cache.totalBytes(), 0);
+    ASSERT_FALSE(cache.read(KEY_A, *entry).has_value());
+}
+
+TEST(NetworkCache, mapsBodies)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    NetworkCache cache(dir.path(), 1024);
+    cache.store(KEY_A, "body", {}, {});
+    cache.flush();
+
+    auto entry = cache.find(KEY_A);
+    ASSERT_TRUE(entry.has_value());
+    auto mapping = cache.map(KEY_A, *entry);
+    ASSERT_NE(mapping, nullptr);
+    ASSERT_EQ(mapping->data(), QByteArray("body"));
+
+    mapping.reset();
+    cache.clear();
+    ASSERT_EQ(cache.map(KEY_A, *entry), nullptr);
+}
+
+TEST(NetworkCache, deletesOrphanedBodies)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+
+    {
+        NetworkCache cache(dir.path(), 1024);
+        cache.store(KEY_A, "body", {}, {});
+        cache.flush();
+    }
+
+    // A body that was stored after the index was saved for the last time
+    auto orphan = QString(64, 'f');
+    QDir().mkpath(dir.filePath("ff"));
+    QFile file(dir.filePath("ff/" + orphan));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("orphan");
+    file.close();
+
+    // A file left behind by an interrupted save of the index
+    QFile stray(dir.filePath("index.Ab1234"));
+    ASSERT_TRUE(stray.open(QIODevice::WriteOnly));
+    stray.write("stray");
+    stray.close();
+
+    NetworkCache cache(dir.path(), 1024);
+    cache.flush();
+
+    ASSERT_FALSE(QFile::exists(file.fileName()));
+    ASSERT_FALSE(QFile::exists(stray.fileName()));
+    ASSERT_TRUE(QFile::exists(dir.filePath("index")));
+    auto entry = cache.find(KEY_A);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_EQ(cache.read(KEY_A, *entry), QByteArray("body"));
+}
+
+TEST(NetworkCache, removesLegacyFiles)
+{
+    QTemporaryDir root;
+    ASSERT_TRUE(root.isValid());
+
+    auto legacy = root.filePath(QString(64, 'a'));
+    auto emotes = root.filePath("11148817.7tv");
+    for (const auto &path : {legacy, emotes})
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write("response");
+    }
+
+    NetworkCache cache(root.filePath("http"), 1024);
+    cache.store(KEY_A, "body", {}, {});
+    cache.removeLegacyFiles(root.path());
+    cache.flush();
+
+    ASSERT_FALSE(QFile::exists(legacy));
+    ASSERT_TRUE(QFile::exists(emotes));
+    ASSERT_TRUE(cache.find(KEY_A).has_value());
+}
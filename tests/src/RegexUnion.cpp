@@ -0,0 +1,92 @@
+#include "util/RegexUnion.hpp"
+
+#include "Test.hpp"
+
+#include <QRegularExpression>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+QRegularExpression regex(const QString &pattern, bool caseSensitive = false)
+{
+    auto options = QRegularExpression::UseUnicodePropertiesOption |
+                   (caseSensitive ? QRegularExpression::NoPatternOption
+                                  : QRegularExpression::CaseInsensitiveOption);
+    return QRegularExpression(pattern, options);
+}
+
+/// Returns the id of the first match or -1 if nothing matched
+int firstMatch(const RegexUnion &regexes, const QString &subject)
+{
+    auto id = regexes.firstMatch(subject);
+    if (!id)
+    {
+        return -1;
+    }
+    return static_cast<int>(*id);
+}
+
+}  // namespace
+
+TEST(RegexUnion, CanCombine)
+{
+    EXPECT_TRUE(RegexUnion::canCombine(R"(^foo|bar$)"));
+    EXPECT_TRUE(RegexUnion::canCombine(R"((a+)(?:b)(?=c)(?<!d)(?i)e)"));
+    EXPECT_TRUE(RegexUnion::canCombine(R"(\bword\b\d\s\\)"));
+
+    EXPECT_FALSE(RegexUnion::canCombine(R"((a)\1)"));
+    EXPECT_FALSE(RegexUnion::canCombine(R"((?<name>a)\k<name>)"));
+    EXPECT_FALSE(RegexUnion::canCombine(R"((?P<name>a))"));
+    EXPECT_FALSE(RegexUnion::canCombine(R"((?|(a)|(b)))"));
+    EXPECT_FALSE(RegexUnion::canCombine(R"((a)(?1))"));
+    EXPECT_FALSE(RegexUnion::canCombine(R"((*UTF)a)"));
+    EXPECT_FALSE(RegexUnion::canCombine(R"(\Qa)"));
+    EXPECT_FALSE(RegexUnion::canCombine(R"((?x)a # comment)"));
+}
+
+TEST(RegexUnion, FirstMatch)
+{
+    RegexUnion regexes;
+    ASSERT_TRUE(regexes.add(regex("b+"), 10));
+    ASSERT_TRUE(regexes.add(regex("(a)(b)"), 20));
+    ASSERT_TRUE(regexes.add(regex("^c", true), 30));
+    ASSERT_FALSE(regexes.add(regex("(a)\\1"), 40));
+    ASSERT_FALSE(regexes.add(regex("(invalid"), 50));
+    ASSERT_FALSE(regexes.add(
+        QRegularExpression("a", QRegularExpression::MultilineOption), 60));
+    regexes.build();
+
+    ASSERT_FALSE(regexes.empty());
+    EXPECT_EQ(firstMatch(regexes, "xx"), -1);
+    EXPECT_EQ(firstMatch(regexes, "xbb"), 10);
+    EXPECT_EQ(firstMatch(regexes, "xAB"), 20);
+    EXPECT_EQ(firstMatch(regexes, "cab"), 30);
+    EXPECT_EQ(firstMatch(regexes, "Cab"), 20);
+    EXPECT_EQ(firstMatch(regexes, "xC"), -1);
+}
+
+TEST(RegexUnion, ForEachMatch)
+{
+    RegexUnion regexes;
+    ASSERT_TRUE(regexes.add(regex("(f)(o)o"), 0));
+    ASSERT_TRUE(regexes.add(regex("(b)ar"), 1));
+    regexes.build();
+
+    std::vector<std::pair<std::size_t, QString>> matches;
+    regexes.forEachMatch(
+        "bar foo FOO baz",
+        [&](std::size_t id, const QRegularExpressionMatch &match, int group) {
+            matches.emplace_back(id, match.captured(group));
+        });
+
+    std::vector<std::pair<std::size_t, QString>> expected{
+        {1, "bar"},
+        {0, "foo"},
+        {0, "FOO"},
+    };
+    ASSERT_EQ(matches, expected);
+}
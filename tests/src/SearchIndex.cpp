@@ -0,0 +1,205 @@
+#include "messages/search/SearchIndex.hpp"
+
+#include "messages/LimitedQueue.hpp"
+#include "messages/Message.hpp"
+#include "messages/search/AuthorPredicate.hpp"
+#include "messages/search/BadgePredicate.hpp"
+#include "messages/search/MessageFlagsPredicate.hpp"
+#include "messages/search/RegexPredicate.hpp"
+#include "messages/search/SubstringPredicate.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "Test.hpp"
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+MessagePtr makeMessage(const QString &login, const QString &text,
+                       MessageFlags flags = {},
+                       std::vector<Badge> badges = {})
+{
+    auto message = std::make_shared<Message>();
+    message->loginName = login;
+    message->displayName = login.toUpper();
+    message->channelName = "pajlada";
+    message->searchText = login + ": " + text;
+    message->flags = flags;
+    message->badges = std::move(badges);
+    return message;
+}
+
+LimitedQueueSnapshot<MessagePtr> makeSnapshot()
+{
+    std::vector<MessagePtr> messages{
+        makeMessage("forsen", "Clap"),
+        makeMessage("pajlada", "Kappa 123", {},
+                    {Badge("moderator", "1"), Badge("subscriber", "3012")}),
+        makeMessage("forsen", "KAPPA", MessageFlag::Highlighted),
+        makeMessage("nymn", "xd", MessageFlag::FirstMessage,
+                    {Badge("subscriber", "12")}),
+        makeMessage("nymn", "kappapride", {}, {Badge("vip", "1")}),
+        makeMessage("forsen", "pa 2 a 1"),
+    };
+
+    LimitedQueue<MessagePtr> queue(messages.size());
+    queue.pushFront(messages);
+    return queue.getSnapshot();
+}
+
+/// Returns the positions of the messages `predicate` applies to
+SearchIndex::Positions matching(
+    const LimitedQueueSnapshot<MessagePtr> &snapshot,
+    MessagePredicate &predicate)
+{
+    SearchIndex::Positions positions;
+    for (uint32_t i = 0; i < snapshot.size(); i++)
+    {
+        if (predicate.appliesTo(*snapshot[i]))
+        {
+            positions.push_back(i);
+        }
+    }
+    return positions;
+}
+
+}  // namespace
+
+TEST(SearchIndex, Text)
+{
+    auto snapshot = makeSnapshot();
+    SearchIndex index(snapshot);
+    ASSERT_EQ(index.size(), 6);
+
+    ASSERT_EQ(index.withText(u"kappa"), SearchIndex::Positions({1, 2, 4}));
+    ASSERT_EQ(index.withText(u"KaPpA"), SearchIndex::Positions({1, 2, 4}));
+    ASSERT_EQ(index.withText(u"pepega"), SearchIndex::Positions());
+    ASSERT_EQ(index.withText(u"xd"), std::nullopt);
+}
+
+TEST(SearchIndex, Lookups)
+{
+    auto snapshot = makeSnapshot();
+    SearchIndex index(snapshot);
+
+    ASSERT_EQ(index.byAuthor("Forsen"), SearchIndex::Positions({0, 2, 5}));
+    ASSERT_EQ(index.byAuthor("NYMN"), SearchIndex::Positions({3, 4}));
+    ASSERT_EQ(index.byAuthor("someone"), SearchIndex::Positions());
+    ASSERT_EQ(index.inChannel("PAJLADA"),
+              SearchIndex::Positions({0, 1, 2, 3, 4, 5}));
+    ASSERT_EQ(index.withBadge("subscriber"), SearchIndex::Positions({1, 3}));
+}
+
+TEST(SearchIndex, Candidates)
+{
+    auto snapshot = makeSnapshot();
+    SearchIndex index(snapshot);
+
+    AuthorPredicate author("forsen,nymn", false);
+    ASSERT_EQ(author.candidates(index),
+              SearchIndex::Positions({0, 2, 3, 4, 5}));
+    ASSERT_EQ(author.candidates(index), matching(snapshot, author));
+
+    BadgePredicate badge("mod,vip", false);
+    ASSERT_EQ(badge.candidates(index), matching(snapshot, badge));
+
+    // candidates might not match
+    SubstringPredicate substring("pa 1");
+    ASSERT_EQ(substring.candidates(index), SearchIndex::Positions({1, 5}));
+    ASSERT_EQ(matching(snapshot, substring), SearchIndex::Positions({1}));
+
+    // all messages have to be checked
+    AuthorPredicate negated("forsen", true);
+    ASSERT_EQ(negated.candidates(index), std::nullopt);
+    RegexPredicate regex("kap+a", false);
+    ASSERT_EQ(regex.candidates(index), std::nullopt);
+    // flags change after messages are added
+    MessageFlagsPredicate flags("highlighted", false);
+    ASSERT_EQ(flags.candidates(index), std::nullopt);
+}
+
+TEST(SearchIndex, Updates)
+{
+    SearchIndex index;
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_EQ(index.byAuthor("forsen"), SearchIndex::Positions());
+
+    std::vector<MessagePtr> messages{
+        makeMessage("forsen", "Clap"),
+        makeMessage("pajlada", "Kappa 123"),
+        makeMessage("forsen", "KAPPA"),
+    };
+    index.append(messages);
+    ASSERT_EQ(index.size(), 3);
+    ASSERT_EQ(index.byAuthor("forsen"), SearchIndex::Positions({0, 2}));
+    ASSERT_EQ(index.withText(u"kappa"), SearchIndex::Positions({1, 2}));
+
+    // positions move when messages are removed from the start
+    index.removeFront(1);
+    ASSERT_EQ(index.size(), 2);
+    ASSERT_EQ(index.byAuthor("forsen"), SearchIndex::Positions({1}));
+    ASSERT_EQ(index.withText(u"clap"), SearchIndex::Positions());
+
+    std::vector<MessagePtr> older{
+        makeMessage("nymn", "xd"),
+        makeMessage("forsen", "kappapride"),
+    };
+    index.prepend(older);
+    ASSERT_EQ(index.size(), 4);
+    ASSERT_EQ(index.byAuthor("forsen"), SearchIndex::Positions({1, 3}));
+    ASSERT_EQ(index.withText(u"kappa"), SearchIndex::Positions({1, 2, 3}));
+
+    index.replace(2, messages[1], makeMessage("nymn", "Clap"));
+    ASSERT_EQ(index.byAuthor("pajlada"), SearchIndex::Positions());
+    ASSERT_EQ(index.byAuthor("nymn"), SearchIndex::Positions({0, 2}));
+    ASSERT_EQ(index.withText(u"kappa"), SearchIndex::Positions({1, 3}));
+    ASSERT_EQ(index.withText(u"clap"), SearchIndex::Positions({2}));
+
+    // out of range
+    index.replace(4, messages[0], messages[0]);
+    ASSERT_EQ(index.size(), 4);
+
+    index.removeFront(10);
+    ASSERT_EQ(index.size(), 0);
+    ASSERT_EQ(index.byAuthor("forsen"), SearchIndex::Positions());
+}
+
+TEST(SearchIndex, UpdatesMatchSnapshot)
+{
+    constexpr size_t LIMIT = 100;
+    LimitedQueue<MessagePtr> queue(LIMIT);
+    SearchIndex index;
+
+    // Push enough messages to remove stale keys a few times
+    for (size_t i = 0; i < 5000; i++)
+    {
+        std::vector<MessagePtr> messages{
+            makeMessage(i % 3 == 0 ? "forsen" : "nymn",
+                        QString("message %1").arg(i)),
+        };
+        std::vector<MessagePtr> deleted;
+        queue.pushBack(messages, &deleted);
+        index.append(messages);
+        index.removeFront(deleted.size());
+    }
+
+    auto snapshot = queue.getSnapshot();
+    ASSERT_EQ(index.size(), snapshot.size());
+
+    AuthorPredicate author("forsen", false);
+    ASSERT_EQ(author.candidates(index), matching(snapshot, author));
+    SubstringPredicate substring("message 4950");
+    ASSERT_EQ(substring.candidates(index), SearchIndex::Positions({50}));
+    ASSERT_EQ(matching(snapshot, substring), SearchIndex::Positions({50}));
+}
+
+TEST(SearchIndex, Combine)
+{
+    SearchIndex::Positions a{1, 3, 5, 7};
+    SearchIndex::Positions b{2, 3, 4, 7, 9};
+
+    ASSERT_EQ(SearchIndex::intersect(a, b), SearchIndex::Positions({3, 7}));
+    ASSERT_EQ(SearchIndex::unite(a, b),
+              SearchIndex::Positions({1, 2, 3, 4, 5, 7, 9}));
+}
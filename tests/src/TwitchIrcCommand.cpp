@@ -0,0 +1,23 @@
+#include "providers/twitch/TwitchIrcCommand.hpp"
+
+#include "Test.hpp"
+
+using namespace chatterino;
+
+TEST(TwitchIrcCommand, Parse)
+{
+    EXPECT_EQ(parseTwitchIrcCommand(std::string_view("PRIVMSG")),
+              TwitchIrcCommand::Privmsg);
+    EXPECT_EQ(parseTwitchIrcCommand(u"USERNOTICE"),
+              TwitchIrcCommand::UserNotice);
+    EXPECT_EQ(parseTwitchIrcCommand(u"GLOBALUSERSTATE"),
+              TwitchIrcCommand::GlobalUserState);
+    EXPECT_EQ(parseTwitchIrcCommand(u"CAP"), TwitchIrcCommand::Cap);
+    EXPECT_EQ(parseTwitchIrcCommand(u"WHISPER"), TwitchIrcCommand::Whisper);
+    EXPECT_EQ(parseTwitchIrcCommand(u""), TwitchIrcCommand::Unknown);
+    EXPECT_EQ(parseTwitchIrcCommand(u"privmsg"), TwitchIrcCommand::Unknown);
+    EXPECT_EQ(parseTwitchIrcCommand(u"001"), TwitchIrcCommand::Unknown);
+    EXPECT_EQ(parseTwitchIrcCommand(u"VERYLONGUNKNOWNCOMMAND"),
+              TwitchIrcCommand::Unknown);
+    EXPECT_EQ(parseTwitchIrcCommand(u"JOİN"), TwitchIrcCommand::Unknown);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "mocks/BaseApplication.hpp"
+#include "mocks/Logging.hpp"
+
+#include <QStringList>
+
+namespace chatterino::testlib {
+
+/// Application for tests that add messages to channels (which logs them)
+class LoggingApplication : public mock::BaseApplication
+{
+public:
+    LoggingApplication() = default;
+
+    ILogging *getChatLogger() override
+    {
+        return &this->logging;
+    }
+
+    mock::EmptyLogging logging;
+};
+
+/// Returns the texts of `items` in order. Items are messages (or pointers to
+/// them) with a `messageText`, or log entries with a `text`.
+QStringList texts(const auto &items)
+{
+    QStringList list;
+    for (const auto &item : items)
+    {
+        if constexpr (requires { item->messageText; })
+        {
+            list.append(item->messageText);
+        }
+        else
+        {
+            list.append(item.text);
+        }
+    }
+    return list;
+}
+
+}  // namespace chatterino::testlib